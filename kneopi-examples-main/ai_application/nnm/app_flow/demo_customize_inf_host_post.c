@@ -0,0 +1,281 @@
+/*
+ * Kneron Application general functions
+ *
+ * Copyright (C) 2021 Kneron, Inc. All rights reserved.
+ *
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+#include "demo_customize_inf_host_post.h"
+#include "demo_customize_inf_parallel.h"
+
+#define SLOT_FREE       0
+#define SLOT_QUEUED     1
+#define SLOT_RUNNING    2
+#define SLOT_DONE       3
+
+// run the post-process of a raw output into the result slot of the job
+static int host_post_run(demo_customize_inf_host_post_t *ctx, demo_customize_inf_host_post_slot_t *slot)
+{
+    demo_customize_inf_host_post_config_t *config = &ctx->config;
+    struct ex_raw_output_s *raw_output = slot->job.raw_output;
+    struct kdp_image_s image;
+
+    int status = user_post_raw_output_to_image(raw_output, config->post_proc_config,
+                                               slot->result + config->result_offset, config->result_size - config->result_offset, &image);
+    if (KP_SUCCESS != status)
+        return status;
+
+    if (0 > config->post_proc_func(raw_output->model_id, &image))
+        return KP_FW_CONFIG_POST_PROC_ERROR_NO_SPACE_106;
+
+    return KP_SUCCESS;
+}
+
+// deliver the done jobs in submit order, called with the mutex held by the only delivering worker
+static void host_post_deliver(demo_customize_inf_host_post_t *ctx)
+{
+    bool report = false;
+
+    while (true) {
+        demo_customize_inf_host_post_slot_t *slot = &ctx->slots[ctx->next_deliver % ctx->config.depth];
+
+        if ((ctx->next_deliver == ctx->next_submit) || (SLOT_DONE != slot->state)) {
+            if (false == report)
+                break;
+
+            // a job done while the mutex was released for the report is not delivered by its worker, check again
+            report = false;
+            pthread_mutex_unlock(&ctx->mutex);
+            demo_customize_inf_host_post_report(ctx);
+            pthread_mutex_lock(&ctx->mutex);
+            continue;
+        }
+
+        uint32_t seq = ctx->next_deliver;
+
+        pthread_mutex_unlock(&ctx->mutex);
+        ctx->config.deliver(&slot->job, seq, slot->status, slot->result);
+        pthread_mutex_lock(&ctx->mutex);
+
+        uint64_t now_ns = demo_customize_inf_parallel_now_ns();
+        double latency_ms = (now_ns - slot->submit_ns) / 1000000.0;
+        demo_customize_inf_host_post_stats_t *stats = &ctx->stats;
+
+        stats->frames++;
+        if (KP_SUCCESS != slot->status)
+            stats->errors++;
+        ctx->latency_sum_ms += latency_ms;
+        stats->latency_avg_ms = ctx->latency_sum_ms / stats->frames;
+        if (latency_ms > stats->latency_max_ms)
+            stats->latency_max_ms = latency_ms;
+        if (now_ns > ctx->first_ns)
+            stats->fps = stats->frames * 1000000000.0 / (now_ns - ctx->first_ns);
+
+        if (0 == stats->frames % DEMO_CUSTOMIZE_INF_REPORT_FRAMES)
+            report = true;
+
+        slot->state = SLOT_FREE;
+        ctx->next_deliver++;
+        pthread_cond_broadcast(&ctx->cond_space);
+    }
+}
+
+static void *host_post_worker_thread(void *arg)
+{
+    demo_customize_inf_host_post_t *ctx = (demo_customize_inf_host_post_t *)arg;
+
+    pthread_mutex_lock(&ctx->mutex);
+
+    while (true) {
+        while ((false == ctx->stop) && (ctx->next_claim == ctx->next_submit))
+            pthread_cond_wait(&ctx->cond_job, &ctx->mutex);
+
+        if (ctx->next_claim == ctx->next_submit)
+            break;
+
+        // jobs are claimed in submit order, so the oldest job is always the first to run
+        demo_customize_inf_host_post_slot_t *slot = &ctx->slots[ctx->next_claim % ctx->config.depth];
+        ctx->next_claim++;
+        slot->state = SLOT_RUNNING;
+
+        pthread_mutex_unlock(&ctx->mutex);
+
+        uint64_t start_ns = demo_customize_inf_parallel_now_ns();
+        int status = host_post_run(ctx, slot);
+        double post_ms = (demo_customize_inf_parallel_now_ns() - start_ns) / 1000000.0;
+
+        pthread_mutex_lock(&ctx->mutex);
+
+        slot->status = status;
+        slot->state = SLOT_DONE;
+        ctx->posts++;
+        ctx->post_sum_ms += post_ms;
+        ctx->stats.post_avg_ms = ctx->post_sum_ms / ctx->posts;
+        if (post_ms > ctx->stats.post_max_ms)
+            ctx->stats.post_max_ms = post_ms;
+
+        // a later job may be done first, it waits for the worker of the older job to deliver it
+        if (false == ctx->delivering) {
+            ctx->delivering = true;
+            host_post_deliver(ctx);
+            ctx->delivering = false;
+        }
+    }
+
+    pthread_mutex_unlock(&ctx->mutex);
+
+    return NULL;
+}
+
+int demo_customize_inf_host_post_start(demo_customize_inf_host_post_t *ctx, const demo_customize_inf_host_post_config_t *config)
+{
+    int worker_num = 0;
+
+    if ((true == ctx->started) || (NULL == config->post_proc_func) || (NULL == config->deliver) ||
+        (1 > config->worker_num) || (DEMO_CUSTOMIZE_INF_HOST_POST_MAX_WORKER < config->worker_num) ||
+        (1 > config->depth) || (config->result_offset >= config->result_size)) {
+        printf("[%s] Error: %s invalid configuration\n", __FUNCTION__, ctx->name);
+        return KP_ERROR_INVALID_PARAM_12;
+    }
+
+    ctx->config = *config;
+    ctx->slots = (demo_customize_inf_host_post_slot_t *)calloc(config->depth, sizeof(demo_customize_inf_host_post_slot_t));
+    if (NULL == ctx->slots)
+        goto FUNC_ERROR;
+
+    for (int i = 0; i < config->depth; i++) {
+        ctx->slots[i].result = (uint8_t *)calloc(1, config->result_size);
+        if (NULL == ctx->slots[i].result)
+            goto FUNC_ERROR;
+    }
+
+    ctx->stop = false;
+    ctx->delivering = false;
+    ctx->next_submit = ctx->next_claim = ctx->next_deliver = 0;
+    memset(&ctx->stats, 0, sizeof(ctx->stats));
+    ctx->stats.worker_num = config->worker_num;
+    ctx->first_ns = 0;
+    ctx->posts = 0;
+    ctx->post_sum_ms = ctx->latency_sum_ms = 0;
+
+    for (worker_num = 0; worker_num < config->worker_num; worker_num++) {
+        if (0 != pthread_create(&ctx->workers[worker_num], NULL, host_post_worker_thread, ctx))
+            break;
+    }
+
+    if (0 == worker_num)
+        goto FUNC_ERROR;
+
+    ctx->config.worker_num = ctx->stats.worker_num = worker_num;
+    ctx->started = true;
+
+    printf("[%s] %s: %d workers, %d jobs in flight\n", __FUNCTION__, ctx->name, worker_num, config->depth);
+
+    return KP_SUCCESS;
+
+FUNC_ERROR:
+    printf("[%s] Error: %s start failed\n", __FUNCTION__, ctx->name);
+
+    if (NULL != ctx->slots) {
+        for (int i = 0; i < config->depth; i++)
+            free(ctx->slots[i].result);
+        free(ctx->slots);
+        ctx->slots = NULL;
+    }
+
+    return KP_FW_CONFIG_POST_PROC_ERROR_MALLOC_FAILED_105;
+}
+
+int demo_customize_inf_host_post_submit(demo_customize_inf_host_post_t *ctx, const demo_customize_inf_host_post_job_t *job)
+{
+    int ret = KP_FW_FIFOQ_NOT_READY_126;
+
+    pthread_mutex_lock(&ctx->mutex);
+
+    while ((true == ctx->started) && (false == ctx->stop) && (ctx->next_submit - ctx->next_deliver >= (uint32_t)ctx->config.depth))
+        pthread_cond_wait(&ctx->cond_space, &ctx->mutex);
+
+    if ((true == ctx->started) && (false == ctx->stop)) {
+        demo_customize_inf_host_post_slot_t *slot = &ctx->slots[ctx->next_submit % ctx->config.depth];
+
+        slot->job = *job;
+        slot->status = KP_SUCCESS;
+        slot->submit_ns = demo_customize_inf_parallel_now_ns();
+        slot->state = SLOT_QUEUED;
+
+        if (0 == ctx->first_ns)
+            ctx->first_ns = slot->submit_ns;
+
+        ctx->next_submit++;
+        if (ctx->next_submit - ctx->next_deliver > ctx->stats.in_flight_max)
+            ctx->stats.in_flight_max = ctx->next_submit - ctx->next_deliver;
+
+        pthread_cond_signal(&ctx->cond_job);
+        ret = KP_SUCCESS;
+    }
+
+    pthread_mutex_unlock(&ctx->mutex);
+
+    return ret;
+}
+
+void demo_customize_inf_host_post_stop(demo_customize_inf_host_post_t *ctx)
+{
+    pthread_mutex_lock(&ctx->mutex);
+
+    if (false == ctx->started) {
+        pthread_mutex_unlock(&ctx->mutex);
+        return;
+    }
+
+    // the workers keep running until every submitted job is delivered
+    while (ctx->next_deliver != ctx->next_submit)
+        pthread_cond_wait(&ctx->cond_space, &ctx->mutex);
+
+    ctx->stop = true;
+    pthread_cond_broadcast(&ctx->cond_job);
+    pthread_cond_broadcast(&ctx->cond_space);
+
+    pthread_mutex_unlock(&ctx->mutex);
+
+    for (int i = 0; i < ctx->config.worker_num; i++)
+        pthread_join(ctx->workers[i], NULL);
+
+    demo_customize_inf_host_post_report(ctx);
+
+    pthread_mutex_lock(&ctx->mutex);
+
+    for (int i = 0; i < ctx->config.depth; i++)
+        free(ctx->slots[i].result);
+    free(ctx->slots);
+    ctx->slots = NULL;
+    ctx->started = false;
+
+    pthread_mutex_unlock(&ctx->mutex);
+}
+
+void demo_customize_inf_host_post_get_stats(demo_customize_inf_host_post_t *ctx, demo_customize_inf_host_post_stats_t *stats)
+{
+    pthread_mutex_lock(&ctx->mutex);
+    *stats = ctx->stats;
+    pthread_mutex_unlock(&ctx->mutex);
+}
+
+void demo_customize_inf_host_post_report(demo_customize_inf_host_post_t *ctx)
+{
+    demo_customize_inf_host_post_stats_t stats;
+
+    demo_customize_inf_host_post_get_stats(ctx, &stats);
+    if (0 == stats.frames)
+        return;
+
+    printf("[%s] %s (%d workers): %u results, %u errors, %.2f fps, post avg %.2f ms max %.2f ms, "
+           "latency avg %.2f ms max %.2f ms, %u in flight max\n",
+           __FUNCTION__, ctx->name, stats.worker_num, stats.frames, stats.errors, stats.fps,
+           stats.post_avg_ms, stats.post_max_ms, stats.latency_avg_ms, stats.latency_max_ms, stats.in_flight_max);
+}
@@ -17,8 +17,8 @@
 #include "demo_customize_inf_multiple_models.h"
 #include "user_post_process_classifier.h"
 #include "user_post_process_yolov5.h"
+#include "user_post_mem_manager.h"
 
-static bool is_init                                         = false;
 static struct ex_object_detection_result_s *yolo_pd_result  = NULL;
 static struct ex_classifier_top_n_result_s *imagenet_result = NULL;
 
@@ -51,40 +51,20 @@ static ex_yolo_post_proc_config_t post_proc_params_v5s_480_256_3 = {
                                    {{0, 0}, {0, 0}, {0, 0}}},
 };
 
-static bool init_temp_buffer()
-{
-    if (false == is_init) {
-        /* allocate DDR memory for ncpu/npu output result */
-        yolo_pd_result = (struct ex_object_detection_result_s *)malloc(sizeof(struct ex_object_detection_result_s));
-        if (NULL == yolo_pd_result)
-            return false;
-
-        imagenet_result = (struct ex_classifier_top_n_result_s *)malloc(sizeof(struct ex_classifier_top_n_result_s));
-        if (NULL == imagenet_result)
-            return false;
-
-        is_init = true;
-    }
-
-    return true;
-}
+// only the background and person scores are read
+static struct ex_classifier_post_proc_config_s post_proc_params_classifier = {
+    .top_n                      = 2,
+};
 
-static bool deinit_temp_buffer()
+static bool init_temp_buffer()
 {
-    if(is_init == true)
-    {
-        // free DDR memory for ncpu/npu output restult
-        if(NULL != yolo_pd_result)
-            free(yolo_pd_result);
-
-        if(NULL != imagenet_result)
-            free(imagenet_result);
-
-        is_init = false;
-    }
+    /* the ncpu/npu output result of the previous job is dropped, the buffers come from the arena of this thread */
+    ex_post_mem_reset();
 
+    yolo_pd_result = (struct ex_object_detection_result_s *)ex_post_mem_alloc(sizeof(struct ex_object_detection_result_s));
+    imagenet_result = (struct ex_classifier_top_n_result_s *)ex_post_mem_alloc(sizeof(struct ex_classifier_top_n_result_s));
 
-    return true;
+    return (NULL != yolo_pd_result) && (NULL != imagenet_result);
 }
 
 static int inference_pedestrian_detection(demo_customize_inf_multiple_models_header_t *_input_header,
@@ -152,7 +132,7 @@ static int inference_pedestrian_classification(demo_customize_inf_multiple_model
 
     // setting pre/post-proc configuration
     inf_config.pre_proc_config                      = NULL;
-    inf_config.post_proc_config                     = NULL;
+    inf_config.post_proc_config                     = (void *)&post_proc_params_classifier;
     inf_config.post_proc_func                       = user_post_classifier_top_n;
 
     // set up imagenet result output buffer for ncpu/npu
@@ -196,7 +176,7 @@ void demo_customize_inf_multiple_model(int job_id, int num_input_buf, void **inf
     output_result->header_stamp.total_size  = sizeof(demo_customize_inf_multiple_models_result_t);
     output_result->header_stamp.job_id      = job_id;
 
-    // this app needs extra DDR buffers for ncpu result
+    // this app needs extra DDR buffers for ncpu result, taken for each job without a heap call
     int status = init_temp_buffer();
     if (!status) {
         // notify host error !
@@ -256,5 +236,7 @@ void demo_customize_inf_multiple_model(int job_id, int num_input_buf, void **inf
 
 void demo_customize_inf_multiple_model_deinit()
 {
-    deinit_temp_buffer();
+    // the temp buffers live in the post-process arena, nothing to free
+    yolo_pd_result = NULL;
+    imagenet_result = NULL;
 }
\ No newline at end of file
@@ -0,0 +1,162 @@
+/*
+ * Kneron Application general functions
+ *
+ * Copyright (C) 2021 Kneron, Inc. All rights reserved.
+ *
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "vmf_nnm_fifoq_manager.h"
+
+#include "demo_customize_inf_parallel.h"
+
+uint64_t demo_customize_inf_parallel_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+void demo_customize_inf_parallel_set_mode(demo_customize_inf_parallel_t *ctx, bool parallel)
+{
+    pthread_mutex_lock(&ctx->mutex);
+
+    ctx->parallel = parallel;
+    memset(ctx->slots, 0, sizeof(ctx->slots));
+    memset(&ctx->stats, 0, sizeof(ctx->stats));
+    ctx->stats.parallel = parallel;
+    ctx->first_ns = ctx->last_ns = 0;
+    ctx->executes = 0;
+    ctx->execute_sum_ms = ctx->latency_sum_ms = 0;
+
+    pthread_mutex_unlock(&ctx->mutex);
+
+    printf("[%s] %s: %s mode\n", __FUNCTION__, ctx->name, parallel ? "parallel" : "serial");
+}
+
+int demo_customize_inf_parallel_begin(demo_customize_inf_parallel_t *ctx, uintptr_t result_buf, uintptr_t result_phy_addr, int result_buf_size)
+{
+    int ret = KP_FW_FIFOQ_NOT_READY_126;
+
+    pthread_mutex_lock(&ctx->mutex);
+
+    for (int i = 0; i < DEMO_CUSTOMIZE_INF_PARALLEL_DEPTH; i++) {
+        demo_customize_inf_slot_t *slot = &ctx->slots[i];
+
+        if (true == slot->used)
+            continue;
+
+        slot->used = true;
+        slot->result_buf = result_buf;
+        slot->result_phy_addr = result_phy_addr;
+        slot->result_buf_size = result_buf_size;
+        slot->start_ns = demo_customize_inf_parallel_now_ns();
+
+        if (0 == ctx->first_ns)
+            ctx->first_ns = slot->start_ns;
+
+        ret = KP_SUCCESS;
+        break;
+    }
+
+    pthread_mutex_unlock(&ctx->mutex);
+
+    if (KP_SUCCESS != ret)
+        printf("[%s] Error: %s has %d results in flight\n", __FUNCTION__, ctx->name, DEMO_CUSTOMIZE_INF_PARALLEL_DEPTH);
+
+    return ret;
+}
+
+void demo_customize_inf_parallel_executed(demo_customize_inf_parallel_t *ctx, uint64_t start_ns)
+{
+    double execute_ms = (demo_customize_inf_parallel_now_ns() - start_ns) / 1000000.0;
+
+    pthread_mutex_lock(&ctx->mutex);
+    ctx->executes++;
+    ctx->execute_sum_ms += execute_ms;
+    ctx->stats.execute_avg_ms = ctx->execute_sum_ms / ctx->executes;
+    pthread_mutex_unlock(&ctx->mutex);
+}
+
+void demo_customize_inf_parallel_complete(demo_customize_inf_parallel_t *ctx, uintptr_t result_buf, int status)
+{
+    demo_customize_inf_slot_t slot;
+    bool found = false;
+    bool report = false;
+
+    pthread_mutex_lock(&ctx->mutex);
+
+    for (int i = 0; i < DEMO_CUSTOMIZE_INF_PARALLEL_DEPTH; i++) {
+        if ((true == ctx->slots[i].used) && (result_buf == ctx->slots[i].result_buf)) {
+            slot = ctx->slots[i];
+            ctx->slots[i].used = false;
+            found = true;
+            break;
+        }
+    }
+
+    if (true == found) {
+        uint64_t now_ns = demo_customize_inf_parallel_now_ns();
+        double latency_ms = (now_ns - slot.start_ns) / 1000000.0;
+        demo_customize_inf_stats_t *stats = &ctx->stats;
+
+        ctx->last_ns = now_ns;
+        ctx->latency_sum_ms += latency_ms;
+
+        stats->frames++;
+        if (KP_SUCCESS != status)
+            stats->errors++;
+        stats->latency_avg_ms = ctx->latency_sum_ms / stats->frames;
+        if (latency_ms > stats->latency_max_ms)
+            stats->latency_max_ms = latency_ms;
+        if (ctx->last_ns > ctx->first_ns)
+            stats->fps = stats->frames * 1000000000.0 / (ctx->last_ns - ctx->first_ns);
+
+        report = (0 == stats->frames % DEMO_CUSTOMIZE_INF_REPORT_FRAMES);
+    }
+
+    pthread_mutex_unlock(&ctx->mutex);
+
+    if (false == found) {
+        printf("[%s] Error: %s result buffer %p is not in flight\n", __FUNCTION__, ctx->name, (void *)result_buf);
+        return;
+    }
+
+    // header_stamp is a must to correctly transfer result data back to host SW
+    kp_inference_header_stamp_t *header_stamp = (kp_inference_header_stamp_t *)slot.result_buf;
+    header_stamp->magic_type  = KDP2_MAGIC_TYPE_INFERENCE;
+    header_stamp->total_size  = ctx->result_size;
+    header_stamp->job_id      = ctx->job_id;
+    header_stamp->status_code = status;
+
+    // send output result buffer back to host SW
+    VMF_NNM_Fifoq_Manager_Result_Enqueue(slot.result_buf, slot.result_phy_addr, slot.result_buf_size, -1, false);
+
+    if (true == report)
+        demo_customize_inf_parallel_report(ctx);
+}
+
+void demo_customize_inf_parallel_get_stats(demo_customize_inf_parallel_t *ctx, demo_customize_inf_stats_t *stats)
+{
+    pthread_mutex_lock(&ctx->mutex);
+    *stats = ctx->stats;
+    pthread_mutex_unlock(&ctx->mutex);
+}
+
+void demo_customize_inf_parallel_report(demo_customize_inf_parallel_t *ctx)
+{
+    demo_customize_inf_stats_t stats;
+
+    demo_customize_inf_parallel_get_stats(ctx, &stats);
+    if (0 == stats.frames)
+        return;
+
+    printf("[%s] %s (%s): %u results, %u errors, %.2f fps, execute avg %.2f ms, latency avg %.2f ms max %.2f ms\n",
+           __FUNCTION__, ctx->name, stats.parallel ? "parallel" : "serial", stats.frames, stats.errors, stats.fps,
+           stats.execute_avg_ms, stats.latency_avg_ms, stats.latency_max_ms);
+}
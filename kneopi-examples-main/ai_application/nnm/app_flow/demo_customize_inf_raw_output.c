@@ -0,0 +1,174 @@
+/*
+ * Kneron Application general functions
+ *
+ * Copyright (C) 2021 Kneron, Inc. All rights reserved.
+ *
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+#include "model_type.h"
+#include "vmf_nnm_inference_app.h"
+#include "vmf_nnm_fifoq_manager.h"
+
+#include "demo_customize_inf_raw_output.h"
+#include "user_post_process_raw_output.h"
+#include "user_post_process_yolov5.h"
+#include "user_pre_process_yolov5.h"
+
+static ex_yolo_post_proc_config_t post_proc_params_v5s = {
+    .prob_thresh                = 0.15,
+    .nms_thresh                 = 0.5,
+    .max_detection              = YOLO_RAW_OUTPUT_BOX_MAX,
+    .max_detection_per_class    = YOLO_RAW_OUTPUT_BOX_MAX,
+    .nms_mode                   = EX_NMS_MODE_SINGLE_CLASS,
+    .anchor_layer_num           = 3,
+    .anchor_cell_num_per_layer  = 3,
+    .data                       = {{{10, 13}, {16, 30}, {33, 23}},
+                                   {{30, 61}, {62, 45}, {59, 119}},
+                                   {{116, 90}, {156, 198}, {373, 326}},
+                                   {{0, 0}, {0, 0}, {0, 0}},
+                                   {{0, 0}, {0, 0}, {0, 0}}},
+};
+
+static demo_customize_inf_host_post_t g_host_post = DEMO_CUSTOMIZE_INF_HOST_POST_INITIALIZER("demo_customize_inf_raw_output");
+static demo_customize_inf_raw_output_deliver_fn g_deliver = NULL;
+
+void demo_customize_inf_raw_output(int job_id, int num_input_buf, void **inf_input_buf_list)
+{
+    // 'inf_input_buf' and 'inf_result_buf' are provided by kdp2 middleware
+    // the content of 'inf_input_buf' is transmitted from host SW = header + image
+    // 'inf_result_buf' is used to carry the raw NPU output back to host SW = header + raw output (from ncpu)
+
+    // verify that the input data number meets the requirements of the model
+    if (1 != num_input_buf) {
+        VMF_NNM_Fifoq_Manager_Status_Code_Enqueue(job_id, KP_FW_WRONG_INPUT_BUFFER_COUNT_110);
+        return;
+    }
+
+    int result_buf_size;
+    uintptr_t inf_result_buf;
+    uintptr_t inf_result_phy_addr;
+
+    if (KP_SUCCESS != VMF_NNM_Fifoq_Manager_Result_Get_Free_Buffer(&inf_result_buf, &inf_result_phy_addr, &result_buf_size, -1)) {
+        printf("[%s] get result free buffer failed\n", __FUNCTION__);
+        return;
+    }
+
+    demo_customize_inf_raw_output_header_t *input_header  = (demo_customize_inf_raw_output_header_t *)inf_input_buf_list[0];
+    demo_customize_inf_raw_output_result_t *output_result = (demo_customize_inf_raw_output_result_t *)inf_result_buf;
+    struct ex_raw_output_s *raw_output                    = &output_result->raw_output;
+
+    // the ncpu copies the npu output after the raw output header, the rest of the result buffer
+    raw_output->status          = KP_FW_CONFIG_POST_PROC_ERROR_NO_SPACE_106;
+    raw_output->capacity        = (result_buf_size > (int)DEMO_CUSTOMIZE_INF_RAW_OUTPUT_DATA_OFFSET) ? (result_buf_size - DEMO_CUSTOMIZE_INF_RAW_OUTPUT_DATA_OFFSET) : 0;
+    raw_output->output_num      = 0;
+    raw_output->output_mem_len  = 0;
+
+    // config image preprocessing and model settings
+    VMF_NNM_INFERENCE_APP_CONFIG_T inf_config;
+    memset(&inf_config, 0, sizeof(VMF_NNM_INFERENCE_APP_CONFIG_T)); // for safety let default 'bool' to 'false'
+
+    // image buffer address should be just after the header
+    inf_config.num_image                    = 1;
+    inf_config.image_list[0].image_buf      = (void *)((uintptr_t)input_header + sizeof(demo_customize_inf_raw_output_header_t));
+    inf_config.image_list[0].image_width    = input_header->width;
+    inf_config.image_list[0].image_height   = input_header->height;
+    inf_config.image_list[0].image_channel  = 3;                                        // assume RGB565
+    inf_config.image_list[0].image_format   = KP_IMAGE_FORMAT_RGB565;                   // assume RGB565
+    inf_config.image_list[0].image_norm     = KP_NORMALIZE_KNERON;                      // this depends on model
+    inf_config.image_list[0].image_resize   = KP_RESIZE_ENABLE;                         // enable resize
+    inf_config.image_list[0].image_padding  = KP_PADDING_CORNER;                        // enable padding on corner
+    inf_config.model_id                     = KNERON_YOLOV5S_COCO80_640_640_3;          // this depends on model
+
+    // setting pre/post-proc configuration, the post-process only copies the npu output, host SW decodes it
+    inf_config.pre_proc_config              = NULL;
+    inf_config.pre_proc_func                = user_pre_process_yolov5;
+    inf_config.post_proc_config             = NULL;
+    inf_config.post_proc_func               = user_post_raw_output;
+
+    // set up raw output buffer for ncpu/npu
+    inf_config.ncpu_result_buf              = (void *)raw_output;
+
+    // run preprocessing and inference, trigger ncpu/npu to do the work
+    int inf_status = VMF_NNM_Inference_App_Execute(&inf_config);
+    if (KP_SUCCESS == inf_status)
+        inf_status = raw_output->status;
+
+    // header_stamp is a must to correctly transfer result data back to host SW
+    output_result->header_stamp.magic_type  = KDP2_MAGIC_TYPE_INFERENCE;
+    output_result->header_stamp.total_size  = DEMO_CUSTOMIZE_INF_RAW_OUTPUT_DATA_OFFSET + raw_output->output_mem_len;
+    output_result->header_stamp.job_id      = job_id;
+    output_result->header_stamp.status_code = inf_status;
+
+    // send output result buffer back to host SW
+    VMF_NNM_Fifoq_Manager_Result_Enqueue(inf_result_buf, inf_result_phy_addr, result_buf_size, -1, false);
+}
+
+void demo_customize_inf_raw_output_deinit()
+{
+    //there is no temp buffer need to release in this model
+}
+
+static void host_post_deliver(const demo_customize_inf_host_post_job_t *job, uint32_t seq, int status, void *result)
+{
+    demo_customize_inf_raw_output_yolo_result_t *yolo_result = (demo_customize_inf_raw_output_yolo_result_t *)result;
+
+    yolo_result->header_stamp.magic_type    = KDP2_MAGIC_TYPE_INFERENCE;
+    yolo_result->header_stamp.total_size    = sizeof(demo_customize_inf_raw_output_yolo_result_t);
+    yolo_result->header_stamp.job_id        = DEMO_KL730_CUSTOMIZE_INF_RAW_OUTPUT_JOB_ID;
+    yolo_result->header_stamp.status_code   = status;
+    yolo_result->inf_number                 = seq;
+
+    if (KP_SUCCESS != status)
+        memset(&yolo_result->yolo_result, 0, sizeof(kp_custom_raw_output_yolo_result_t));
+
+    g_deliver(yolo_result, job->buf_addr, job->phy_buf_addr, job->buf_size);
+}
+
+int demo_customize_inf_raw_output_host_post_start(int worker_num, demo_customize_inf_raw_output_deliver_fn deliver)
+{
+    demo_customize_inf_host_post_config_t config;
+
+    memset(&config, 0, sizeof(config));
+
+    // the example allocates DEMO_CUSTOMIZE_INF_RAW_OUTPUT_RESULT_COUNT() result buffers for this depth
+    config.worker_num       = worker_num;
+    config.depth            = DEMO_CUSTOMIZE_INF_RAW_OUTPUT_HOST_POST_DEPTH(worker_num);
+    config.post_proc_func   = user_post_yolov5_no_sigmoid;
+    config.post_proc_config = (void *)&post_proc_params_v5s;
+    config.result_size      = sizeof(demo_customize_inf_raw_output_yolo_result_t);
+    config.result_offset    = offsetof(demo_customize_inf_raw_output_yolo_result_t, yolo_result);
+    config.deliver          = host_post_deliver;
+
+    g_deliver = deliver;
+
+    return demo_customize_inf_host_post_start(&g_host_post, &config);
+}
+
+int demo_customize_inf_raw_output_host_post_submit(uintptr_t buf_addr, uintptr_t phy_buf_addr, int buf_size)
+{
+    demo_customize_inf_raw_output_result_t *output_result = (demo_customize_inf_raw_output_result_t *)buf_addr;
+    demo_customize_inf_host_post_job_t job;
+
+    job.buf_addr        = buf_addr;
+    job.phy_buf_addr    = phy_buf_addr;
+    job.buf_size        = buf_size;
+    job.raw_output      = &output_result->raw_output;
+
+    return demo_customize_inf_host_post_submit(&g_host_post, &job);
+}
+
+void demo_customize_inf_raw_output_host_post_stop(void)
+{
+    demo_customize_inf_host_post_stop(&g_host_post);
+}
+
+void demo_customize_inf_raw_output_host_post_get_stats(demo_customize_inf_host_post_stats_t *stats)
+{
+    demo_customize_inf_host_post_get_stats(&g_host_post, stats);
+}
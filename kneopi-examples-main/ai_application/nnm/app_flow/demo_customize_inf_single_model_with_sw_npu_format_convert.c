@@ -6,6 +6,7 @@
  */
 
 #include <stdint.h>
+#include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
@@ -15,6 +16,7 @@
 #include "vmf_nnm_fifoq_manager.h"
 
 #include "demo_customize_inf_single_model_with_sw_npu_format_convert.h"
+#include "demo_customize_inf_parallel.h"
 #include "user_post_process_yolov5.h"
 #include "user_pre_process_yolov5_with_sw_npu_format_convert.h"
 
@@ -34,6 +36,22 @@ static ex_yolo_post_proc_config_t post_proc_params_v5s  = {
                                    {{0, 0}, {0, 0}, {0, 0}}},
 };
 
+static demo_customize_inf_parallel_t g_parallel = DEMO_CUSTOMIZE_INF_PARALLEL_INITIALIZER("demo_customize_inf_single_model_with_sw_npu_format_convert",
+                                                                                           DEMO_KL730_CUSTOMIZE_INF_SINGLE_MODEL_WITH_SW_NPU_FORMAT_CONVERT_JOB_ID,
+                                                                                           sizeof(demo_customize_inf_single_model_with_sw_npu_format_convert_result_t));
+
+// invoked when the ncpu post-process of a frame is done, only for a successful execute in the parallel mode
+static void result_callback(int status, void *inf_result_buf, int inf_result_buf_size, void *ncpu_result_buf)
+{
+    (void)inf_result_buf;
+    (void)inf_result_buf_size;
+
+    // 'ncpu_result_buf' is the 'yolo_result' member of the result buffer given to the execute
+    uintptr_t result_buf = (uintptr_t)ncpu_result_buf - offsetof(demo_customize_inf_single_model_with_sw_npu_format_convert_result_t, yolo_result);
+
+    demo_customize_inf_parallel_complete(&g_parallel, result_buf, status);
+}
+
 void demo_customize_inf_single_model_with_sw_npu_format_convert(int job_id, int num_input_buf, void **inf_input_buf_list)
 {
     // 'inf_input_buf' and 'inf_result_buf' are provided by kdp2 middleware
@@ -71,6 +89,14 @@ void demo_customize_inf_single_model_with_sw_npu_format_convert(int job_id, int
         return;
     }
 
+    // keep the result buffer until its result is complete, the callback gets only the ncpu result buffer
+    int begin_status = demo_customize_inf_parallel_begin(&g_parallel, inf_result_buf, inf_result_phy_addr, result_buf_size);
+    if (KP_SUCCESS != begin_status) {
+        VMF_NNM_Fifoq_Manager_Result_Put_Free_Buffer(inf_result_buf, inf_result_phy_addr, result_buf_size, -1);
+        VMF_NNM_Fifoq_Manager_Status_Code_Enqueue(job_id, begin_status);
+        return;
+    }
+
     demo_customize_inf_single_model_with_sw_npu_format_convert_header_t *input_header  = (demo_customize_inf_single_model_with_sw_npu_format_convert_header_t *)inf_input_buf_list[0];
     demo_customize_inf_single_model_with_sw_npu_format_convert_result_t *output_result = (demo_customize_inf_single_model_with_sw_npu_format_convert_result_t *)inf_result_buf;
 
@@ -98,23 +124,40 @@ void demo_customize_inf_single_model_with_sw_npu_format_convert(int job_id, int
     // set up pd result output buffer for ncpu/npu
     inf_config.ncpu_result_buf              = (void *)&(output_result->yolo_result);    // give result buffer for ncpu/npu, callback will carry it
 
+    // in the parallel mode the execute returns when the npu is done, the ncpu post-process of this frame overlaps
+    // the pre-process and npu of the next one and the result callback sends the result back to host SW
+    inf_config.enable_parallel              = g_parallel.parallel;
+    inf_config.result_callback              = result_callback;
+    inf_config.inf_result_buf               = (void *)inf_result_buf;
+    inf_config.inf_result_buf_size          = result_buf_size;
+
     // run preprocessing and inference, trigger ncpu/npu to do the work
     // if enable_parallel=true (works only for single model), result callback is needed
     // however if inference error then no callback will be invoked
+    uint64_t start_ns = demo_customize_inf_parallel_now_ns();
     ret = VMF_NNM_Inference_App_Execute(&inf_config);
+    demo_customize_inf_parallel_executed(&g_parallel, start_ns);
+
+    if ((false == inf_config.enable_parallel) || (KP_SUCCESS != ret)) {
+        // header_stamp is filled and the result is sent back to host SW here
+        demo_customize_inf_parallel_complete(&g_parallel, inf_result_buf, ret);
+    }
+}
 
-    // header_stamp is a must to correctly transfer result data back to host SW
-    output_result->header_stamp.magic_type  = KDP2_MAGIC_TYPE_INFERENCE;
-    output_result->header_stamp.total_size  = sizeof(demo_customize_inf_single_model_with_sw_npu_format_convert_result_t);
-    output_result->header_stamp.job_id      = job_id;
-    output_result->header_stamp.status_code = ret;
+void demo_customize_inf_single_model_with_sw_npu_format_convert_set_parallel(bool enable)
+{
+    demo_customize_inf_parallel_set_mode(&g_parallel, enable);
+}
 
-    // send output result buffer back to host SW
-    VMF_NNM_Fifoq_Manager_Result_Enqueue(inf_result_buf, inf_result_phy_addr, result_buf_size, -1, false);
+void demo_customize_inf_single_model_with_sw_npu_format_convert_get_stats(demo_customize_inf_stats_t *stats)
+{
+    demo_customize_inf_parallel_get_stats(&g_parallel, stats);
 }
 
 void demo_customize_inf_single_model_with_sw_npu_format_convert_deinit()
 {
+    demo_customize_inf_parallel_report(&g_parallel);
+
     if (true == g_isInit) {
         if (KP_SUCCESS != user_pre_process_yolov5_with_sw_npu_format_convert_deinit()) {
             printf("[%s] user_pre_process_yolov5_with_sw_npu_format_convert_deinit fail ...\n", __FUNCTION__);
@@ -0,0 +1,328 @@
+/*
+ * Kneron Application general functions
+ *
+ * Copyright (C) 2021 Kneron, Inc. All rights reserved.
+ *
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <pthread.h>
+
+#include "model_type.h"
+#include "vmf_nnm_inference_app.h"
+#include "vmf_nnm_fifoq_manager.h"
+
+#include "demo_customize_inf_tiled.h"
+#include "demo_customize_inf_parallel.h"
+#include "user_post_process_yolov5.h"
+#include "user_utils.h"
+#include "user_post_mem_manager.h"
+
+static struct ex_object_detection_result_s *tile_result     = NULL;
+static struct ex_bounding_box_s *tile_boxes                 = NULL;     // boxes of all tiles of a frame
+static struct ex_bounding_box_s *nms_temp_boxes             = NULL;
+static struct ex_bounding_box_s *merged_boxes               = NULL;
+
+static ex_yolo_post_proc_config_t post_proc_params_v5s = {
+    .prob_thresh                = 0.15,
+    .nms_thresh                 = 0.5,
+    .max_detection              = TILED_TILE_BOX_MAX,
+    .max_detection_per_class    = TILED_TILE_BOX_MAX,
+    .nms_mode                   = EX_NMS_MODE_SINGLE_CLASS,
+    .anchor_layer_num           = 3,
+    .anchor_cell_num_per_layer  = 3,
+    .data                       = {{{10, 13}, {16, 30}, {33, 23}},
+                                   {{30, 61}, {62, 45}, {59, 119}},
+                                   {{116, 90}, {156, 198}, {373, 326}},
+                                   {{0, 0}, {0, 0}, {0, 0}},
+                                   {{0, 0}, {0, 0}, {0, 0}}},
+};
+
+static pthread_mutex_t stats_mutex = PTHREAD_MUTEX_INITIALIZER;
+static demo_customize_inf_tiled_stats_t stats;
+static uint64_t first_ns;
+static double frame_sum_ms;
+static double merge_sum_ms;
+static uint64_t tiles_sum;
+static uint64_t tile_boxes_sum;
+static uint64_t boxes_sum;
+
+static bool init_temp_buffer()
+{
+    /* the buffers of the previous frame are dropped, the ncpu/npu output result and the cross-tile merge come from
+       the arena of this thread */
+    ex_post_mem_reset();
+
+    tile_result = (struct ex_object_detection_result_s *)ex_post_mem_alloc(sizeof(struct ex_object_detection_result_s));
+    tile_boxes = (struct ex_bounding_box_s *)ex_post_mem_alloc(TILED_TILE_MAX * TILED_TILE_BOX_MAX * sizeof(struct ex_bounding_box_s));
+    nms_temp_boxes = (struct ex_bounding_box_s *)ex_post_mem_alloc(TILED_TILE_MAX * TILED_TILE_BOX_MAX * sizeof(struct ex_bounding_box_s));
+    merged_boxes = (struct ex_bounding_box_s *)ex_post_mem_alloc(TILED_BOX_MAX * sizeof(struct ex_bounding_box_s));
+
+    return (NULL != tile_result) && (NULL != tile_boxes) && (NULL != nms_temp_boxes) && (NULL != merged_boxes);
+}
+
+/*
+ * Tiles of one axis: 'count' tiles of the same length spread evenly from the first to the last pixel. The length
+ * is the smallest that keeps at least 'overlap' pixels between neighbours, starts and lengths are even for the
+ * YUV420 chroma planes.
+ */
+static void tile_span(uint32_t size, uint32_t count, uint32_t overlap, uint32_t index, int32_t *start, int32_t *length)
+{
+    uint32_t tile_length = (size + (count - 1) * overlap + count - 1) / count;
+
+    tile_length = (tile_length + 1) & ~1u;
+    if (tile_length > size)
+        tile_length = size;
+
+    *length = (int32_t)tile_length;
+    *start = (1 < count) ? (int32_t)(((size - tile_length) * index / (count - 1)) & ~1u) : 0;
+}
+
+static int inference_tile(demo_customize_inf_tiled_header_t *_input_header,
+                          int32_t left, int32_t top, int32_t width, int32_t height,
+                          struct ex_object_detection_result_s *_tile_result /* output */)
+{
+    // config image preprocessing and model settings
+    VMF_NNM_INFERENCE_APP_CONFIG_T inf_config;
+    memset(&inf_config, 0, sizeof(VMF_NNM_INFERENCE_APP_CONFIG_T)); // for safety let default 'bool' to 'false'
+
+    // image buffer address should be just after the header
+    inf_config.num_image                            = 1;
+    inf_config.image_list[0].image_buf              = (void *)((uintptr_t)_input_header + sizeof(demo_customize_inf_tiled_header_t));
+    inf_config.image_list[0].image_width            = _input_header->width;
+    inf_config.image_list[0].image_height           = _input_header->height;
+    inf_config.image_list[0].image_channel          = 3;                                    // assume RGB565
+    inf_config.image_list[0].image_format           = KP_IMAGE_FORMAT_RGB565;               // assume RGB565
+    inf_config.image_list[0].image_norm             = KP_NORMALIZE_KNERON;                  // this depends on model
+    inf_config.image_list[0].image_resize           = KP_RESIZE_ENABLE;                     // enable resize
+    inf_config.image_list[0].image_padding          = KP_PADDING_CORNER;                    // enable padding on corner
+    inf_config.model_id                             = KNERON_YOLOV5S_COCO80_640_640_3;      // this depends on model
+
+    // set crop box, the post-process adds its offset when the boxes are remapped to the frame
+    inf_config.image_list[0].enable_crop            = true;                                 // enable crop image in ncpu/npu
+    inf_config.image_list[0].crop_area.crop_number  = 0;
+    inf_config.image_list[0].crop_area.x1           = left;
+    inf_config.image_list[0].crop_area.y1           = top;
+    inf_config.image_list[0].crop_area.width        = width;
+    inf_config.image_list[0].crop_area.height       = height;
+
+    // setting pre/post-proc configuration
+    inf_config.pre_proc_config                      = NULL;
+    inf_config.post_proc_config                     = (void *)&post_proc_params_v5s;        // yolo post-process configurations for yolo v5 series
+    inf_config.post_proc_func                       = user_post_yolov5_no_sigmoid;
+
+    // set up tile result output buffer for ncpu/npu
+    inf_config.ncpu_result_buf                      = (void *)_tile_result;
+
+    return VMF_NNM_Inference_App_Execute(&inf_config);
+}
+
+static void update_stats(uint32_t tile_cols, uint32_t tile_rows, uint32_t tile_count, bool roi, int status,
+                         uint64_t start_ns, uint64_t merge_ns, uint32_t tile_box_count, uint32_t box_count)
+{
+    uint64_t now_ns = demo_customize_inf_parallel_now_ns();
+    bool report = false;
+
+    pthread_mutex_lock(&stats_mutex);
+
+    // the numbers are per tile count, a new layout starts them again
+    if ((tile_cols != stats.tile_cols) || (tile_rows != stats.tile_rows)) {
+        memset(&stats, 0, sizeof(stats));
+        stats.tile_cols = tile_cols;
+        stats.tile_rows = tile_rows;
+        first_ns = start_ns;
+        frame_sum_ms = merge_sum_ms = 0;
+        tiles_sum = tile_boxes_sum = boxes_sum = 0;
+    }
+
+    stats.frames++;
+    if (true == roi)
+        stats.roi_frames++;
+
+    if (KP_SUCCESS != status) {
+        stats.errors++;
+    } else {
+        uint32_t good = stats.frames - stats.errors;
+
+        frame_sum_ms += (now_ns - start_ns) / 1000000.0;
+        merge_sum_ms += (now_ns - merge_ns) / 1000000.0;
+        tiles_sum += tile_count;
+        tile_boxes_sum += tile_box_count;
+        boxes_sum += box_count;
+
+        stats.frame_avg_ms = frame_sum_ms / good;
+        stats.merge_avg_ms = merge_sum_ms / good;
+        stats.tile_avg_ms = (frame_sum_ms - merge_sum_ms) / tiles_sum;
+        stats.tile_boxes_avg = (double)tile_boxes_sum / good;
+        stats.boxes_avg = (double)boxes_sum / good;
+    }
+
+    if (now_ns > first_ns)
+        stats.fps = stats.frames * 1000000000.0 / (now_ns - first_ns);
+
+    report = (0 == stats.frames % DEMO_CUSTOMIZE_INF_REPORT_FRAMES);
+
+    pthread_mutex_unlock(&stats_mutex);
+
+    if (true == report)
+        demo_customize_inf_tiled_report();
+}
+
+void demo_customize_inf_tiled(int job_id, int num_input_buf, void **inf_input_buf_list)
+{
+    // 'inf_input_buf' and 'inf_result_buf' are provided by kdp2 middleware
+    // the content of 'inf_input_buf' is transmitted from host SW = header + image
+    // 'inf_result_buf' is used to carry inference result back to host SW = header + merged result of all tiles
+
+    // verify that the input data number meets the requirements of the model
+    if (1 != num_input_buf) {
+        VMF_NNM_Fifoq_Manager_Status_Code_Enqueue(job_id, KP_FW_WRONG_INPUT_BUFFER_COUNT_110);
+        return;
+    }
+
+    int inf_status = KP_SUCCESS;
+    int result_buf_size;
+    uintptr_t inf_result_buf;
+    uintptr_t inf_result_phy_addr;
+    uint64_t start_ns = demo_customize_inf_parallel_now_ns();
+    uint64_t merge_ns = start_ns;
+
+    if (KP_SUCCESS != VMF_NNM_Fifoq_Manager_Result_Get_Free_Buffer(&inf_result_buf, &inf_result_phy_addr, &result_buf_size, -1)) {
+        printf("[%s] get result free buffer failed\n", __FUNCTION__);
+        return;
+    }
+
+    demo_customize_inf_tiled_header_t *input_header     = (demo_customize_inf_tiled_header_t *)inf_input_buf_list[0];
+    demo_customize_inf_tiled_result_t *output_result    = (demo_customize_inf_tiled_result_t *)inf_result_buf;
+    kp_custom_tiled_yolo_result_t *yolo_result          = &output_result->yolo_result;
+
+    uint32_t tile_cols  = input_header->tile_cols;
+    uint32_t tile_rows  = input_header->tile_rows;
+    uint32_t roi_count  = input_header->roi_count;
+    uint32_t tile_count = (0 < roi_count) ? roi_count : tile_cols * tile_rows;
+    uint32_t class_num  = 0;
+    int tile_box_count  = 0;
+
+    // pre set up result header stuff
+    // header_stamp is a must to correctly transfer result data back to host SW
+    output_result->header_stamp.magic_type  = KDP2_MAGIC_TYPE_INFERENCE;
+    output_result->header_stamp.total_size  = sizeof(demo_customize_inf_tiled_result_t);
+    output_result->header_stamp.job_id      = job_id;
+    output_result->inf_number               = input_header->inf_number;
+    output_result->tile_count               = tile_count;
+    output_result->roi_count                = roi_count;
+    output_result->tile_box_count           = 0;
+    output_result->inf_time_us              = 0;
+    yolo_result->class_count                = 0;
+    yolo_result->box_count                  = 0;
+
+    if ((0 == tile_cols) || (0 == tile_rows) || (TILED_TILE_MAX < tile_cols * tile_rows) || (TILED_TILE_MAX < roi_count)) {
+        printf("[%s] Error: %u x %u tiles, %u crops, at most %d\n", __FUNCTION__, tile_cols, tile_rows, roi_count, TILED_TILE_MAX);
+        inf_status = KP_FW_INVALID_INPUT_CROP_PARAM_112;
+        goto FUNC_OUT;
+    }
+
+    for (uint32_t i = 0; i < roi_count; i++) {
+        demo_customize_inf_tiled_roi_t *roi = &input_header->rois[i];
+
+        if ((0 > roi->x1) || (0 > roi->y1) || (0 >= roi->width) || (0 >= roi->height) ||
+            (input_header->width < (uint32_t)(roi->x1 + roi->width)) || (input_header->height < (uint32_t)(roi->y1 + roi->height))) {
+            printf("[%s] Error: crop %u (%d, %d) %d x %d out of the frame\n", __FUNCTION__, i, roi->x1, roi->y1, roi->width, roi->height);
+            inf_status = KP_FW_INVALID_INPUT_CROP_PARAM_112;
+            goto FUNC_OUT;
+        }
+    }
+
+    // this app needs extra DDR buffers for ncpu result
+    if (!init_temp_buffer()) {
+        inf_status = KP_FW_DDR_MALLOC_FAILED_102;
+        goto FUNC_OUT;
+    }
+
+    // all tiles of the frame or the crops of the header, the boxes come back remapped to the frame by the post-process
+    for (uint32_t i = 0; i < tile_count; i++) {
+        int32_t left, top, width, height;
+
+        if (0 < roi_count) {
+            left = input_header->rois[i].x1;
+            top = input_header->rois[i].y1;
+            width = input_header->rois[i].width;
+            height = input_header->rois[i].height;
+        } else {
+            tile_span(input_header->width, tile_cols, input_header->overlap, i % tile_cols, &left, &width);
+            tile_span(input_header->height, tile_rows, input_header->overlap, i / tile_cols, &top, &height);
+        }
+
+        inf_status = inference_tile(input_header, left, top, width, height, tile_result);
+        if (KP_SUCCESS != inf_status)
+            goto FUNC_OUT;
+
+        class_num = tile_result->class_count;
+        memcpy(&tile_boxes[tile_box_count], tile_result->boxes, tile_result->box_count * sizeof(struct ex_bounding_box_s));
+        tile_box_count += tile_result->box_count;
+    }
+
+    // one NMS over the boxes of all tiles, the duplicates of an object in two tiles overlap
+    merge_ns = demo_customize_inf_parallel_now_ns();
+
+    yolo_result->class_count    = class_num;
+    yolo_result->box_count      = ex_nms_bbox(tile_boxes,
+                                              nms_temp_boxes,
+                                              class_num,
+                                              tile_box_count,
+                                              TILED_BOX_MAX,
+                                              TILED_BOX_MAX,
+                                              merged_boxes,
+                                              post_proc_params_v5s.prob_thresh,
+                                              post_proc_params_v5s.nms_thresh,
+                                              EX_NMS_MODE_SINGLE_CLASS);
+
+    for (uint32_t i = 0; i < yolo_result->box_count; i++)
+        memcpy(&yolo_result->boxes[i], &merged_boxes[i], sizeof(kp_bounding_box_t));
+
+    output_result->tile_box_count   = tile_box_count;
+    output_result->inf_time_us      = (uint32_t)((demo_customize_inf_parallel_now_ns() - start_ns) / 1000);
+
+FUNC_OUT:
+    output_result->header_stamp.status_code = inf_status;
+
+    // the result buffer belongs to the host SW once it is enqueued
+    update_stats(tile_cols, tile_rows, tile_count, 0 < roi_count, inf_status, start_ns, merge_ns,
+                 output_result->tile_box_count, yolo_result->box_count);
+
+    // send output result buffer back to host SW
+    VMF_NNM_Fifoq_Manager_Result_Enqueue(inf_result_buf, inf_result_phy_addr, result_buf_size, -1, false);
+}
+
+void demo_customize_inf_tiled_deinit()
+{
+    // the temp buffers live in the post-process arena, nothing to free
+    tile_result = NULL;
+    tile_boxes = nms_temp_boxes = merged_boxes = NULL;
+}
+
+void demo_customize_inf_tiled_get_stats(demo_customize_inf_tiled_stats_t *_stats)
+{
+    pthread_mutex_lock(&stats_mutex);
+    *_stats = stats;
+    pthread_mutex_unlock(&stats_mutex);
+}
+
+void demo_customize_inf_tiled_report(void)
+{
+    demo_customize_inf_tiled_stats_t tiled_stats;
+
+    demo_customize_inf_tiled_get_stats(&tiled_stats);
+    if (0 == tiled_stats.frames)
+        return;
+
+    printf("[%s] %u x %u tiles: %u results (%u of crops), %u errors, %.2f fps, frame avg %.2f ms, tile avg %.2f ms, " \
+           "merge avg %.3f ms, boxes avg %.1f -> %.1f\n",
+           __FUNCTION__, tiled_stats.tile_cols, tiled_stats.tile_rows, tiled_stats.frames, tiled_stats.roi_frames, tiled_stats.errors, tiled_stats.fps,
+           tiled_stats.frame_avg_ms, tiled_stats.tile_avg_ms, tiled_stats.merge_avg_ms,
+           tiled_stats.tile_boxes_avg, tiled_stats.boxes_avg);
+}
@@ -0,0 +1,129 @@
+#ifndef DEMO_CUSTOMIZE_INF_HOST_POST_H
+#define DEMO_CUSTOMIZE_INF_HOST_POST_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+
+#include "kp_struct.h"
+#include "ncpu_gen_struct.h"
+#include "user_post_process_raw_output.h"
+
+/**
+ * @brief Host post-process worker pool for raw NPU outputs.
+ *
+ * The inference only copies the NPU output (user_post_raw_output) and the result FIFO buffer holding it is
+ * submitted here. A pool of worker threads runs the real post-process on the raw outputs concurrently, each into
+ * its own result slot, and the results are delivered in submit order: the worker finishing the oldest pending
+ * job delivers it and every following job that is already done. The result FIFO buffer is handed back with the
+ * result, so it stays untouched until the delivery.
+ */
+
+#define DEMO_CUSTOMIZE_INF_HOST_POST_MAX_WORKER    8       /**< max number of worker threads */
+
+/**
+ * @brief a raw output waiting for its post-process
+ */
+typedef struct
+{
+    uintptr_t buf_addr;                     /**< result FIFO buffer holding the raw output */
+    uintptr_t phy_buf_addr;
+    int buf_size;
+    struct ex_raw_output_s *raw_output;     /**< raw output in the buffer */
+} demo_customize_inf_host_post_job_t;
+
+/**
+ * @brief called in submit order with the post-processed result of a job, from one worker thread at a time.
+ *
+ * @param[in] job the submitted job, the callback owns its result FIFO buffer.
+ * @param[in] seq submit sequence number of the job.
+ * @param[in] status KP_SUCCESS, or the error of the raw output or of the post-process.
+ * @param[in] result result slot of the job, valid until the callback returns.
+ */
+typedef void (*demo_customize_inf_host_post_deliver_fn)(const demo_customize_inf_host_post_job_t *job, uint32_t seq, int status, void *result);
+
+typedef struct
+{
+    int worker_num;                                     /**< worker threads, 1 to DEMO_CUSTOMIZE_INF_HOST_POST_MAX_WORKER */
+    int depth;                                          /**< jobs in flight (queued, running or waiting for delivery) */
+    int (*post_proc_func)(int model_id, struct kdp_image_s *image_p);
+    void *post_proc_config;                             /**< given to the post-process as its parameters */
+    int result_size;                                    /**< bytes of a result slot */
+    int result_offset;                                  /**< the post-process writes at this offset of the slot */
+    demo_customize_inf_host_post_deliver_fn deliver;
+} demo_customize_inf_host_post_config_t;
+
+/**
+ * @brief throughput of the pool since it was started
+ */
+typedef struct
+{
+    int worker_num;
+    uint32_t frames;            /**< delivered results */
+    uint32_t errors;            /**< results with a non-zero status */
+    uint32_t in_flight_max;     /**< most jobs submitted and not yet delivered */
+    double fps;                 /**< results per second from the first submit to the last delivery */
+    double post_avg_ms;         /**< post-process time of a job on one worker */
+    double post_max_ms;
+    double latency_avg_ms;      /**< submit to delivery */
+    double latency_max_ms;
+} demo_customize_inf_host_post_stats_t;
+
+typedef struct
+{
+    int state;
+    demo_customize_inf_host_post_job_t job;
+    int status;
+    uint64_t submit_ns;
+    uint8_t *result;
+} demo_customize_inf_host_post_slot_t;
+
+typedef struct
+{
+    const char *name;                                   /**< pool name in the reports */
+    demo_customize_inf_host_post_config_t config;
+    bool started;
+    bool stop;
+    bool delivering;                                    /**< a worker is delivering the done jobs */
+    pthread_mutex_t mutex;
+    pthread_cond_t cond_job;                            /**< a job is submitted or the pool stops */
+    pthread_cond_t cond_space;                          /**< a job is delivered */
+    pthread_t workers[DEMO_CUSTOMIZE_INF_HOST_POST_MAX_WORKER];
+    demo_customize_inf_host_post_slot_t *slots;         /**< 'depth' slots, job 'seq' uses slots[seq % depth] */
+    uint32_t next_submit;                               /**< seq of the next submitted job */
+    uint32_t next_claim;                                /**< seq of the next job for a worker */
+    uint32_t next_deliver;                              /**< seq of the next delivered job */
+    demo_customize_inf_host_post_stats_t stats;
+    uint64_t first_ns;
+    uint32_t posts;
+    double post_sum_ms;
+    double latency_sum_ms;
+} demo_customize_inf_host_post_t;
+
+#define DEMO_CUSTOMIZE_INF_HOST_POST_INITIALIZER(pool_name) \
+    { .name = (pool_name), .mutex = PTHREAD_MUTEX_INITIALIZER, .cond_job = PTHREAD_COND_INITIALIZER, .cond_space = PTHREAD_COND_INITIALIZER }
+
+/**
+ * @brief allocate the result slots and start the worker threads.
+ *
+ * @return KP_SUCCESS, KP_ERROR_INVALID_PARAM_12 or KP_FW_CONFIG_POST_PROC_ERROR_MALLOC_FAILED_105.
+ */
+int demo_customize_inf_host_post_start(demo_customize_inf_host_post_t *ctx, const demo_customize_inf_host_post_config_t *config);
+
+/**
+ * @brief queue a raw output for the post-process, blocks while 'depth' jobs are in flight.
+ *
+ * @return KP_SUCCESS, or KP_FW_FIFOQ_NOT_READY_126 when the pool is not running (the caller keeps the buffer).
+ */
+int demo_customize_inf_host_post_submit(demo_customize_inf_host_post_t *ctx, const demo_customize_inf_host_post_job_t *job);
+
+/**
+ * @brief deliver every submitted job, then stop the worker threads and free the result slots.
+ */
+void demo_customize_inf_host_post_stop(demo_customize_inf_host_post_t *ctx);
+
+void demo_customize_inf_host_post_get_stats(demo_customize_inf_host_post_t *ctx, demo_customize_inf_host_post_stats_t *stats);
+
+void demo_customize_inf_host_post_report(demo_customize_inf_host_post_t *ctx);
+
+#endif // DEMO_CUSTOMIZE_INF_HOST_POST_H
@@ -0,0 +1,102 @@
+#ifndef DEMO_CUSTOMIZE_INF_PARALLEL_H
+#define DEMO_CUSTOMIZE_INF_PARALLEL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+
+#include "kp_struct.h"
+
+/**
+ * @brief Result bookkeeping shared by the customize single model flows.
+ *
+ * In the serial mode VMF_NNM_Inference_App_Execute() returns after pre-process, NPU and the NCPU post-process of
+ * a frame are all done. With enable_parallel the call returns once the NPU is done, the post-process of frame N
+ * runs on the NCPU while the app function already starts frame N+1, and the result callback carries only the
+ * result buffer. The buffers handed to the inference app are kept here until they are completed, so the callback
+ * can fill the header stamp and enqueue the result with its physical address.
+ */
+
+#define DEMO_CUSTOMIZE_INF_PARALLEL_DEPTH   4       /**< result buffers in flight, NPU + NCPU need 2 */
+#define DEMO_CUSTOMIZE_INF_REPORT_FRAMES    100     /**< results between two throughput reports */
+
+/**
+ * @brief throughput of one flow since the mode was selected
+ */
+typedef struct
+{
+    bool parallel;              /**< NPU of frame N+1 overlaps the post-process of frame N */
+    uint32_t frames;            /**< results sent back to host SW */
+    uint32_t errors;            /**< results with a non-zero status code */
+    double fps;                 /**< results per second from the first execute to the last result */
+    double execute_avg_ms;      /**< time the app function is blocked in VMF_NNM_Inference_App_Execute() */
+    double latency_avg_ms;      /**< execute called to result enqueued */
+    double latency_max_ms;
+} demo_customize_inf_stats_t;
+
+typedef struct
+{
+    bool used;
+    uintptr_t result_buf;
+    uintptr_t result_phy_addr;
+    int result_buf_size;
+    uint64_t start_ns;
+} demo_customize_inf_slot_t;
+
+typedef struct
+{
+    const char *name;           /**< flow name in the reports */
+    int job_id;
+    uint32_t result_size;       /**< header_stamp.total_size of a result */
+    bool parallel;
+    pthread_mutex_t mutex;
+    demo_customize_inf_slot_t slots[DEMO_CUSTOMIZE_INF_PARALLEL_DEPTH];
+    demo_customize_inf_stats_t stats;
+    uint64_t first_ns;
+    uint64_t last_ns;
+    uint32_t executes;
+    double execute_sum_ms;
+    double latency_sum_ms;
+} demo_customize_inf_parallel_t;
+
+#define DEMO_CUSTOMIZE_INF_PARALLEL_INITIALIZER(flow_name, flow_job_id, flow_result_size) \
+    { .name = (flow_name), .job_id = (flow_job_id), .result_size = (flow_result_size), .mutex = PTHREAD_MUTEX_INITIALIZER }
+
+/**
+ * @brief select the serial or the parallel mode and restart the statistics, call it before the first inference.
+ */
+void demo_customize_inf_parallel_set_mode(demo_customize_inf_parallel_t *ctx, bool parallel);
+
+/**
+ * @brief keep a result buffer until demo_customize_inf_parallel_complete() is called for it.
+ *
+ * @return KP_SUCCESS, or KP_FW_FIFOQ_NOT_READY_126 when too many results are in flight.
+ */
+int demo_customize_inf_parallel_begin(demo_customize_inf_parallel_t *ctx, uintptr_t result_buf, uintptr_t result_phy_addr, int result_buf_size);
+
+/**
+ * @brief record the time spent in VMF_NNM_Inference_App_Execute() for a frame.
+ */
+void demo_customize_inf_parallel_executed(demo_customize_inf_parallel_t *ctx, uint64_t start_ns);
+
+/**
+ * @brief fill the header stamp of a kept result buffer and send it back to host SW.
+ *
+ * Called from the app function in the serial mode or when the execute failed, and from the result callback in
+ * the parallel mode.
+ */
+void demo_customize_inf_parallel_complete(demo_customize_inf_parallel_t *ctx, uintptr_t result_buf, int status);
+
+/**
+ * @brief get the statistics since demo_customize_inf_parallel_set_mode().
+ */
+void demo_customize_inf_parallel_get_stats(demo_customize_inf_parallel_t *ctx, demo_customize_inf_stats_t *stats);
+
+/**
+ * @brief print the statistics of the flow.
+ */
+void demo_customize_inf_parallel_report(demo_customize_inf_parallel_t *ctx);
+
+uint64_t demo_customize_inf_parallel_now_ns(void);
+
+#endif // DEMO_CUSTOMIZE_INF_PARALLEL_H
@@ -0,0 +1,90 @@
+#ifndef DEMO_CUSTOMIZE_INF_RAW_OUTPUT_H
+#define DEMO_CUSTOMIZE_INF_RAW_OUTPUT_H
+
+#define DEMO_KL730_CUSTOMIZE_INF_RAW_OUTPUT_JOB_ID      4003
+#define YOLO_RAW_OUTPUT_BOX_MAX                         100     /**< maximum number of bounding boxes for Yolo models */
+#define DEMO_CUSTOMIZE_INF_RAW_OUTPUT_RESULT_SIZE       (4 * 1024 * 1024)   /**< result buffer for the raw output of a YOLOv5s 640x640 */
+
+/**< raw outputs held by the host post-process, two per worker: one post-processed while the next is already queued */
+#define DEMO_CUSTOMIZE_INF_RAW_OUTPUT_HOST_POST_DEPTH(worker_num)   (2 * (worker_num))
+/**< result buffers of the raw output job, the host post-process depth plus the one the NCPU fills and the one
+     the receive side is submitting */
+#define DEMO_CUSTOMIZE_INF_RAW_OUTPUT_RESULT_COUNT(worker_num)      (DEMO_CUSTOMIZE_INF_RAW_OUTPUT_HOST_POST_DEPTH(worker_num) + 2)
+
+#include <stddef.h>
+
+#include "kp_struct.h"
+#include "demo_customize_inf_host_post.h"
+#include "user_post_process_raw_output.h"
+
+/**
+ * @brief describe a yolo output result after post-processing
+ */
+typedef struct
+{
+    uint32_t class_count;                               /**< total class count */
+    uint32_t box_count;                                 /**< boxes of all classes */
+    kp_bounding_box_t boxes[YOLO_RAW_OUTPUT_BOX_MAX];   /**< box information */
+} __attribute__((aligned(4))) kp_custom_raw_output_yolo_result_t;
+
+typedef struct
+{
+    /* header stamp is necessary for data transfer between host and device */
+    kp_inference_header_stamp_t header_stamp;
+    uint32_t width;
+    uint32_t height;
+} __attribute__((aligned(4))) demo_customize_inf_raw_output_header_t;
+
+// result (header + raw NPU output) sent back by the inference
+typedef struct
+{
+    /* header stamp is necessary for data transfer between host and device */
+    kp_inference_header_stamp_t header_stamp;
+    struct ex_raw_output_s raw_output;                  /**< must be the last member, the NPU output data follows */
+} __attribute__((aligned(EX_RAW_OUTPUT_DATA_ALIGN))) demo_customize_inf_raw_output_result_t;
+
+/**< result buffer bytes before the NPU output data, a buffer of this plus the model output size holds a raw output */
+#define DEMO_CUSTOMIZE_INF_RAW_OUTPUT_DATA_OFFSET       (offsetof(demo_customize_inf_raw_output_result_t, raw_output) + offsetof(struct ex_raw_output_s, data))
+
+// result (header + data) after the host post-process, delivered in inference order
+typedef struct
+{
+    /* header stamp is necessary for data transfer between host and device */
+    kp_inference_header_stamp_t header_stamp;
+    uint32_t inf_number;                                /**< sequence number of the raw output */
+    kp_custom_raw_output_yolo_result_t yolo_result;
+} __attribute__((aligned(4))) demo_customize_inf_raw_output_yolo_result_t;
+
+/**
+ * @brief called in inference order with a post-processed result, the callback returns the result FIFO buffer.
+ */
+typedef void (*demo_customize_inf_raw_output_deliver_fn)(demo_customize_inf_raw_output_yolo_result_t *result, uintptr_t buf_addr, uintptr_t phy_buf_addr, int buf_size);
+
+void demo_customize_inf_raw_output(int job_id, int num_input_buf, void **inf_input_buf_list);
+void demo_customize_inf_raw_output_deinit();
+
+/**
+ * @brief start the host post-process workers of the raw outputs.
+ *
+ * @param[in] worker_num number of worker threads.
+ * @param[in] deliver called in inference order with each result.
+ *
+ * @return KP_SUCCESS, otherwise the workers are not started.
+ */
+int demo_customize_inf_raw_output_host_post_start(int worker_num, demo_customize_inf_raw_output_deliver_fn deliver);
+
+/**
+ * @brief post-process a raw output received from the result FIFO on the host workers.
+ *
+ * @return KP_SUCCESS, otherwise the caller keeps the result FIFO buffer.
+ */
+int demo_customize_inf_raw_output_host_post_submit(uintptr_t buf_addr, uintptr_t phy_buf_addr, int buf_size);
+
+/**
+ * @brief deliver every submitted raw output and stop the host post-process workers.
+ */
+void demo_customize_inf_raw_output_host_post_stop(void);
+
+void demo_customize_inf_raw_output_host_post_get_stats(demo_customize_inf_host_post_stats_t *stats);
+
+#endif // DEMO_CUSTOMIZE_INF_RAW_OUTPUT_H
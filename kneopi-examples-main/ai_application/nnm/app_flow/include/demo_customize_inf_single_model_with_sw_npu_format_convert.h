@@ -4,7 +4,10 @@
 #define DEMO_KL730_CUSTOMIZE_INF_SINGLE_MODEL_WITH_SW_NPU_FORMAT_CONVERT_JOB_ID 4002
 #define YOLO_BOX_MAX                                                            100     /**< maximum number of bounding boxes for Yolo models */
 
+#include <stdbool.h>
+
 #include "kp_struct.h"
+#include "demo_customize_inf_parallel.h"
 
 /**
  * @brief In this customized inference example, we will focus 
@@ -44,4 +47,15 @@ typedef struct
 void demo_customize_inf_single_model_with_sw_npu_format_convert(int job_id, int num_input_buf, void **inf_input_buf_list);
 void demo_customize_inf_single_model_with_sw_npu_format_convert_deinit();
 
+/**
+ * @brief select the serial (default) or the parallel mode, in the parallel mode the NCPU post-process of frame N
+ *        overlaps the NPU of frame N+1 and the result is sent back from the result callback.
+ */
+void demo_customize_inf_single_model_with_sw_npu_format_convert_set_parallel(bool enable);
+
+/**
+ * @brief get the throughput since demo_customize_inf_single_model_with_sw_npu_format_convert_set_parallel().
+ */
+void demo_customize_inf_single_model_with_sw_npu_format_convert_get_stats(demo_customize_inf_stats_t *stats);
+
 #endif // DEMO_CUSTOMIZE_INF_SINGLE_MODEL_WITH_SW_NPU_FORMAT_CONVERT_H
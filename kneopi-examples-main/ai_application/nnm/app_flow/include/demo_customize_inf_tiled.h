@@ -0,0 +1,105 @@
+#ifndef DEMO_CUSTOMIZE_INF_TILED_H
+#define DEMO_CUSTOMIZE_INF_TILED_H
+
+#define DEMO_KL730_CUSTOMIZE_INF_TILED_JOB_ID   4004
+#define TILED_BOX_MAX                           200     /**< maximum number of bounding boxes after the cross-tile merge */
+#define TILED_TILE_BOX_MAX                      100     /**< maximum number of bounding boxes of one tile */
+#define TILED_TILE_MAX                          16      /**< maximum number of tiles of a frame */
+
+#include <stdint.h>
+
+#include "kp_struct.h"
+
+/**
+ * @brief Tiled inference of a high resolution frame.
+ *
+ * The frame is split into tile_cols x tile_rows tiles overlapping by 'overlap' pixels, each tile is cropped by the
+ * ncpu from the frame in the image buffer and resized to the model input, so small objects keep more pixels than
+ * in a downscale of the whole frame. The post-process remaps the boxes of a tile to the frame with its crop offset,
+ * the boxes of all tiles go through one more NMS to merge the duplicates of the objects on the seams. An object
+ * narrower than the overlap is found whole in at least one tile.
+ *
+ * With roi_count set the tile grid is skipped and only the crops of the header are inferred, the host places them
+ * around the objects of the previous frames and the same merge applies.
+ */
+
+/**
+ * @brief a crop of the frame, the start and the size are even
+ */
+typedef struct
+{
+    int32_t x1;
+    int32_t y1;
+    int32_t width;
+    int32_t height;
+} __attribute__((aligned(4))) demo_customize_inf_tiled_roi_t;
+
+/**
+ * @brief describe a yolo output result after the cross-tile merge
+ */
+typedef struct
+{
+    uint32_t class_count;                   /**< total class count */
+    uint32_t box_count;                     /**< boxes of all classes */
+    kp_bounding_box_t boxes[TILED_BOX_MAX]; /**< box information, in frame coordinates */
+} __attribute__((aligned(4))) kp_custom_tiled_yolo_result_t;
+
+typedef struct
+{
+    /* header stamp is necessary for data transfer between host and device */
+    kp_inference_header_stamp_t header_stamp;
+    uint32_t inf_number;
+    uint32_t width;
+    uint32_t height;
+    uint32_t tile_cols;                     /**< 1 x 1 is the whole frame downscaled to the model */
+    uint32_t tile_rows;
+    uint32_t overlap;                       /**< pixels shared by two neighbour tiles */
+    uint32_t roi_count;                     /**< 0: the tile grid, otherwise only the crops below */
+    demo_customize_inf_tiled_roi_t rois[TILED_TILE_MAX];
+} __attribute__((aligned(4))) demo_customize_inf_tiled_header_t;
+
+// result (header + data) for 'Customize Inference Tiled'
+typedef struct
+{
+    /* header stamp is necessary for data transfer between host and device */
+    kp_inference_header_stamp_t header_stamp;
+    uint32_t inf_number;
+    uint32_t tile_count;                    /**< inferred tiles or crops */
+    uint32_t roi_count;                     /**< crops of the header, 0 for the tile grid */
+    uint32_t tile_box_count;                /**< boxes of all tiles before the merge */
+    uint32_t inf_time_us;                   /**< all tiles and the merge on the device */
+    kp_custom_tiled_yolo_result_t yolo_result;
+} __attribute__((aligned(4))) demo_customize_inf_tiled_result_t;
+
+/**
+ * @brief throughput of the tiled flow since the tile count last changed
+ */
+typedef struct
+{
+    uint32_t tile_cols;
+    uint32_t tile_rows;
+    uint32_t frames;                        /**< results sent back to host SW */
+    uint32_t roi_frames;                    /**< results of the header crops, a crop counts as a tile below */
+    uint32_t errors;                        /**< results with a non-zero status code */
+    double fps;                             /**< results per second from the first tile to the last result */
+    double frame_avg_ms;                    /**< all tiles and the merge of a frame */
+    double tile_avg_ms;                     /**< one tile inference */
+    double merge_avg_ms;                    /**< the cross-tile NMS */
+    double tile_boxes_avg;                  /**< boxes of a frame before the merge */
+    double boxes_avg;                       /**< boxes of a frame after the merge */
+} demo_customize_inf_tiled_stats_t;
+
+void demo_customize_inf_tiled(int job_id, int num_input_buf, void **inf_input_buf_list);
+void demo_customize_inf_tiled_deinit();
+
+/**
+ * @brief get the throughput of the current tile count.
+ */
+void demo_customize_inf_tiled_get_stats(demo_customize_inf_tiled_stats_t *stats);
+
+/**
+ * @brief print the throughput of the current tile count.
+ */
+void demo_customize_inf_tiled_report(void);
+
+#endif // DEMO_CUSTOMIZE_INF_TILED_H
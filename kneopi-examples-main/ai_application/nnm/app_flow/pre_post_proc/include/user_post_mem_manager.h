@@ -8,14 +8,68 @@
 #define USER_POST_MEM_MANAGER_H_
 
 #include <stdlib.h>
+#include <stdint.h>
 
 #include "base.h"
 
+/******************************************************************
+ * public define values
+*******************************************************************/
+/*
+ * The working buffers of the jobs and post-processes are carved from one region reserved at load time. Each thread
+ * running a job or a post-process takes an arena of the region on its first allocation and bumps a pointer in it,
+ * the arena goes back to the region when the thread exits. Nothing on the inference path calls the heap.
+ */
+#define EX_POST_MEM_ARENA_NUM       12                  /**< arenas of the region, the dispatcher, the NCPU post-process and the host post-process workers */
+#define EX_POST_MEM_ARENA_SIZE      (256 * 1024)        /**< bytes of an arena, the tiled job with its YOLO post-process needs about 120 KB */
+#define EX_POST_MEM_ALIGN           64                  /**< every allocation starts on a cache line */
+
+/******************************************************************
+ * public struct defined
+*******************************************************************/
+/**
+ * @brief usage of the region since load
+ */
+typedef struct {
+    uint32_t arena_num;         /**< most arenas taken at once */
+    uint32_t arena_size;        /**< bytes of an arena */
+    uint32_t high_water;        /**< most bytes used at once in an arena */
+    uint32_t failed;            /**< allocations beyond an arena or of a thread without a free arena */
+} ex_post_mem_stats_t;
+
 /******************************************************************
  * public functions
 *******************************************************************/
+/**
+ * @brief allocate from the arena of the calling thread.
+ *
+ * @return the buffer, aligned to EX_POST_MEM_ALIGN, or NULL when the arena is full.
+ */
+void* ex_post_mem_alloc(size_t len);
+
+/**
+ * @brief drop every allocation of the calling thread, a job calls it before taking its working buffers.
+ */
+void ex_post_mem_reset(void);
+
+/**
+ * @brief get the usage of the region.
+ */
+void ex_post_mem_get_stats(ex_post_mem_stats_t *stats);
 
+/**
+ * @brief print the usage of the region, nothing if no thread allocated.
+ */
+void ex_post_mem_report(void);
+
+/**
+ * @brief working buffer of a post-process, *gp is allocated from the arena of the calling thread.
+ */
 void* ex_get_gp(void **gp, size_t len);
+
+/**
+ * @brief give back *gp and every allocation after it, the post-process calls it before returning.
+ */
 void ex_free_gp(void **gp);
 
 #endif  // USER_POST_MEM_MANAGER_H_
@@ -12,6 +12,13 @@
 
 #define EX_CLASSIFIER_MAX_SIZE_TOP_N (1000)                                     /**< max number of top N classification result */
 
+/**
+ * @brief describe a classifier post process configuration, given as post_proc_config
+ */
+struct ex_classifier_post_proc_config_s {
+    uint32_t top_n;                                                             /**< number of results kept, 0 (or no configuration) keeps all classes */
+};
+
 /**
  * @brief describe a yolo pre-post process configurations for yolo series
  */
@@ -28,5 +35,10 @@ struct ex_classifier_top_n_result_s {
     struct ex_classifier_result_s top_n_results[EX_CLASSIFIER_MAX_SIZE_TOP_N];  /**< array of top N classifier results */
 };
 
+/**
+ * @brief softmax top N of a classifier output, the results are sorted by score and top_n_num of them are valid.
+ *        The denominator is taken from a histogram of the int8 logits and only the kept classes are dequantized,
+ *        so the cost is one read per class plus a heap insert for the classes entering the top N.
+ */
 int user_post_classifier_top_n(int model_id, struct kdp_image_s *image_p);
 #endif
@@ -0,0 +1,58 @@
+/*
+ * User Post Processing function for the raw NPU output
+ *
+ * Copyright (C) 2021 Kneron, Inc. All rights reserved.
+ *
+ */
+#ifndef USER_POST_PROCESS_RAW_OUTPUT_H
+#define USER_POST_PROCESS_RAW_OUTPUT_H
+
+#include "ncpu_gen_struct.h"
+
+#define EX_RAW_OUTPUT_MAX_TENSOR_NUM    (16)                                    /**< max number of output tensors */
+#define EX_RAW_OUTPUT_DATA_ALIGN        (16)                                    /**< alignment of the copied NPU output */
+
+/**
+ * @brief describe a raw NPU output, written by user_post_raw_output() in place of a post-process (the
+ *        IMAGE_FORMAT_BYPASS_POST / IMAGE_FORMAT_RAW_OUTPUT flow) so the real post-process can run elsewhere.
+ *
+ * The tensor base pointers are made relative to 'data'. The shape and quantization information of the tensors
+ * still reference the loaded model, so a raw output is only valid while its model stays loaded.
+ */
+struct ex_raw_output_s {
+    int32_t status;                                                             /**< KP_SUCCESS, or why nothing was copied */
+    uint32_t capacity;                                                          /**< bytes available for 'data', set before the inference */
+    int32_t model_id;                                                           /**< model of the output */
+    uint32_t output_num;                                                        /**< number of valid tensors */
+    uint32_t output_mem_len;                                                    /**< bytes of 'data' */
+    uint32_t output_format;                                                     /**< output data format from NPU */
+    struct kdp_img_raw_s raw_img;                                               /**< crop, padding and scale of the pre-process, for the box remap */
+    kdp_pre_proc_t preproc_node;                                                /**< model input node, for the model dimensions */
+    ngs_tensor_t tensors[EX_RAW_OUTPUT_MAX_TENSOR_NUM];                         /**< output tensors, base pointer relative to 'data' */
+    uint8_t data[] __attribute__((aligned(EX_RAW_OUTPUT_DATA_ALIGN)));          /**< copy of the NPU output memory */
+};
+
+/**
+ * @brief copy the NPU output of the inference and its metadata to the result buffer instead of post-processing it.
+ *
+ * The result buffer is a struct ex_raw_output_s whose 'capacity' is set by the caller.
+ *
+ * @return size of the raw output in bytes.
+ */
+int user_post_raw_output(int model_id, struct kdp_image_s *image_p);
+
+/**
+ * @brief set up an image structure on a raw output so a post-process function (e.g. user_post_yolov5_no_sigmoid)
+ *        can run on it outside of the inference.
+ *
+ * @param[in] raw the raw output, its tensors are updated by the post-process.
+ * @param[in] post_proc_config configuration of the post-process.
+ * @param[out] result result buffer of the post-process.
+ * @param[in] result_len size of the result buffer.
+ * @param[out] image_p image structure given to the post-process.
+ *
+ * @return KP_SUCCESS, otherwise the raw output is not usable.
+ */
+int user_post_raw_output_to_image(struct ex_raw_output_s *raw, void *post_proc_config, void *result, int result_len, struct kdp_image_s *image_p);
+
+#endif
@@ -60,6 +60,13 @@ int ex_get_output_tensor(struct kdp_image_s *image_p, int tensor_index, ngs_tens
  */
 int8_t *ex_get_scalar_int8(ngs_tensor_t* tensor, uint32_t* scalar_index_list, uint32_t scalar_index_list_len);
 
+/**
+ * @brief get the base pointer and the npu strides of one axis of an int8 tensor, the other indices being 0.
+ *        scalar i of the axis is base[i * stride + (i >> 4) * group_stride], so a whole axis is read without
+ *        resolving the index list of every scalar.
+ */
+int ex_get_axis_stride_int8(ngs_tensor_t *tensor, uint32_t axis, int8_t **base, uint32_t *stride, uint32_t *group_stride);
+
 /**
  * @brief get the int16 scalar from tensor.
  */
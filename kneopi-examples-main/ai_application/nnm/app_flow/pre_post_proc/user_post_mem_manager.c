@@ -5,33 +5,156 @@
  *
  */
 #include <stdio.h>
+#include <stdbool.h>
+#include <pthread.h>
 
 #include "user_post_mem_manager.h"
 
+/******************************************************************
+ * local struct defined
+*******************************************************************/
+typedef struct {
+    bool taken;                 /**< owned by a running thread */
+    uint8_t *base;
+    size_t used;
+    size_t high_water;
+} ex_post_mem_arena_t;
+
+/******************************************************************
+ * local variable initialization
+*******************************************************************/
+static uint8_t ex_post_mem_region[EX_POST_MEM_ARENA_NUM * EX_POST_MEM_ARENA_SIZE] __attribute__((aligned(EX_POST_MEM_ALIGN)));
+static ex_post_mem_arena_t ex_post_mem_arenas[EX_POST_MEM_ARENA_NUM];
+static uint32_t ex_post_mem_taken                   = 0;
+static uint32_t ex_post_mem_taken_max               = 0;
+static uint32_t ex_post_mem_failed                  = 0;
+static pthread_once_t ex_post_mem_once              = PTHREAD_ONCE_INIT;
+static pthread_key_t ex_post_mem_key;
+static __thread ex_post_mem_arena_t *ex_post_mem    = NULL;
+
+/******************************************************************
+ * local util function
+*******************************************************************/
+/* the arena goes back to the region when its thread exits */
+static void put_arena(void *arena)
+{
+    __atomic_store_n(&((ex_post_mem_arena_t *)arena)->taken, false, __ATOMIC_RELEASE);
+    __atomic_sub_fetch(&ex_post_mem_taken, 1, __ATOMIC_RELAXED);
+}
+
+static void init_region(void)
+{
+    for (int i = 0; i < EX_POST_MEM_ARENA_NUM; i++)
+        ex_post_mem_arenas[i].base = &ex_post_mem_region[i * EX_POST_MEM_ARENA_SIZE];
+
+    pthread_key_create(&ex_post_mem_key, put_arena);
+}
+
+static ex_post_mem_arena_t* get_arena(void)
+{
+    if (NULL != ex_post_mem)
+        return ex_post_mem;
+
+    pthread_once(&ex_post_mem_once, init_region);
+
+    for (int i = 0; i < EX_POST_MEM_ARENA_NUM; i++) {
+        if (false == __atomic_exchange_n(&ex_post_mem_arenas[i].taken, true, __ATOMIC_ACQUIRE)) {
+            uint32_t taken = __atomic_add_fetch(&ex_post_mem_taken, 1, __ATOMIC_RELAXED);
+            uint32_t taken_max = __atomic_load_n(&ex_post_mem_taken_max, __ATOMIC_RELAXED);
+
+            while ((taken > taken_max) &&
+                   !__atomic_compare_exchange_n(&ex_post_mem_taken_max, &taken_max, taken, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+                ;
+
+            ex_post_mem = &ex_post_mem_arenas[i];
+            ex_post_mem->used = 0;
+            pthread_setspecific(ex_post_mem_key, ex_post_mem);
+            return ex_post_mem;
+        }
+    }
+
+    return NULL;
+}
+
 /******************************************************************
  * main function
 *******************************************************************/
-void* ex_get_gp(void **gp, size_t len)
+void* ex_post_mem_alloc(size_t len)
 {
-    if (*gp == NULL) {
-        *gp = realloc(*gp, len);
-        if (*gp == NULL)
-            printf("ncpu: ERROR: kneron_realloc %lu in get_gp()\n", (long unsigned int)len);
+    ex_post_mem_arena_t *arena  = get_arena();
+    size_t offset               = 0;
+
+    if (NULL == arena) {
+        if (0 == __atomic_fetch_add(&ex_post_mem_failed, 1, __ATOMIC_RELAXED))
+            printf("ncpu: ERROR: no free arena of %d in ex_post_mem_alloc()\n", EX_POST_MEM_ARENA_NUM);
+        return NULL;
+    }
+
+    offset = (arena->used + EX_POST_MEM_ALIGN - 1) & ~((size_t)EX_POST_MEM_ALIGN - 1);
+    if (EX_POST_MEM_ARENA_SIZE - offset < len || EX_POST_MEM_ARENA_SIZE < offset) {
+        __atomic_fetch_add(&ex_post_mem_failed, 1, __ATOMIC_RELAXED);
+        printf("ncpu: ERROR: %lu bytes over the arena (%lu of %d used) in ex_post_mem_alloc()\n",
+               (long unsigned int)len, (long unsigned int)arena->used, EX_POST_MEM_ARENA_SIZE);
+        return NULL;
+    }
+
+    arena->used = offset + len;
+    if (arena->used > arena->high_water)
+        __atomic_store_n(&arena->high_water, arena->used, __ATOMIC_RELAXED);
+
+    return arena->base + offset;
+}
+
+void ex_post_mem_reset(void)
+{
+    if (NULL != ex_post_mem)
+        ex_post_mem->used = 0;
+}
+
+void ex_post_mem_get_stats(ex_post_mem_stats_t *stats)
+{
+    stats->arena_num    = __atomic_load_n(&ex_post_mem_taken_max, __ATOMIC_RELAXED);
+    stats->arena_size   = EX_POST_MEM_ARENA_SIZE;
+    stats->high_water   = 0;
+    stats->failed       = __atomic_load_n(&ex_post_mem_failed, __ATOMIC_RELAXED);
+
+    for (int i = 0; i < EX_POST_MEM_ARENA_NUM; i++) {
+        size_t high_water = __atomic_load_n(&ex_post_mem_arenas[i].high_water, __ATOMIC_RELAXED);
+
+        if (high_water > stats->high_water)
+            stats->high_water = (uint32_t)high_water;
     }
+}
+
+void ex_post_mem_report(void)
+{
+    ex_post_mem_stats_t stats;
+
+    ex_post_mem_get_stats(&stats);
+    if ((0 == stats.high_water) && (0 == stats.failed))
+        return;
+
+    printf("[post mem] high water %u of %u bytes per arena, %u of %d arenas used, %u failed allocations\n",
+           stats.high_water, stats.arena_size, stats.arena_num, EX_POST_MEM_ARENA_NUM, stats.failed);
+}
+
+void* ex_get_gp(void **gp, size_t len)
+{
+    *gp = ex_post_mem_alloc(len);
 
     return *gp;
 }
 
 void ex_free_gp(void **gp)
 {
-    #ifdef FREE
-        if (NULL != *gp) {
-            free(*gp);
-            *gp = NULL;
-        }
-    #else
-        (void)gp;
-    #endif
+    uint8_t *buf = (uint8_t *)*gp;
+
+    // a bump allocator frees by moving its top back to the buffer
+    if ((NULL != ex_post_mem) && (NULL != buf) &&
+        (ex_post_mem->base <= buf) && (buf < ex_post_mem->base + EX_POST_MEM_ARENA_SIZE))
+        ex_post_mem->used = (size_t)(buf - ex_post_mem->base);
+
+    *gp = NULL;
 
     return;
 }
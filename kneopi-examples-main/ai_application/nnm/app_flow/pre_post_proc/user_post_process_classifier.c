@@ -5,6 +5,8 @@
  *
  */
 #include <math.h>
+#include <stdbool.h>
+#include <string.h>
 
 #include "base.h"
 #include "ipc.h"
@@ -15,7 +17,7 @@
 /******************************************************************
  * local define values
 *******************************************************************/
-// N/A
+#define INT8_LEVELS     (256)       /**< histogram bins of the int8 logits */
 
 /******************************************************************
  * local struct defined
@@ -30,24 +32,52 @@
 /******************************************************************
  * local util function
 *******************************************************************/
-static int float_comparator(float a, float b) {
-    float diff = a - b;
-
-    if (diff < 0)
-        return 1;
-    else if (diff > 0)
-        return -1;
-    return 0;
+/**
+ * @brief order of the top N min-heap, a lower score is worse and a tie keeps the lower class number.
+ */
+static inline bool is_worse(const struct ex_classifier_result_s *a, const struct ex_classifier_result_s *b)
+{
+    return (a->score < b->score) || ((a->score == b->score) && (a->class_num > b->class_num));
+}
+
+static void heap_sift_down(struct ex_classifier_result_s *heap, int size, int idx)
+{
+    struct ex_classifier_result_s item = heap[idx];
+
+    while (true) {
+        int child = 2 * idx + 1;
+
+        if (child >= size)
+            break;
+
+        if ((child + 1 < size) && is_worse(&heap[child + 1], &heap[child]))
+            child++;
+
+        if (!is_worse(&heap[child], &item))
+            break;
+
+        heap[idx] = heap[child];
+        idx = child;
+    }
+
+    heap[idx] = item;
 }
 
-static int comparator_callback(const void *pa, const void *pb)
+static void heap_sift_up(struct ex_classifier_result_s *heap, int idx)
 {
-    float a, b;
+    struct ex_classifier_result_s item = heap[idx];
+
+    while (idx > 0) {
+        int parent = (idx - 1) / 2;
 
-    a = ((struct ex_classifier_result_s *)pa)->score;
-    b = ((struct ex_classifier_result_s *)pb)->score;
+        if (!is_worse(&item, &heap[parent]))
+            break;
 
-    return float_comparator(a, b);
+        heap[idx] = heap[parent];
+        idx = parent;
+    }
+
+    heap[idx] = item;
 }
 
 /******************************************************************
@@ -59,6 +89,7 @@ int user_post_classifier_top_n(int model_id, struct kdp_image_s *image_p)
 
     /* get result buffer */
     struct ex_classifier_top_n_result_s *result_p = (struct ex_classifier_top_n_result_s *)(POSTPROC_RESULT_MEM_ADDR(image_p));
+    struct ex_classifier_post_proc_config_s *classifier_config = (struct ex_classifier_post_proc_config_s *)POSTPROC_PARAMS_P(image_p);
 
     /* initialize */
     ngs_tensor_t *tensor                                            = NULL;
@@ -66,18 +97,24 @@ int user_post_classifier_top_n(int model_id, struct kdp_image_s *image_p)
     int32_t *shape                                                  = NULL;
     float div                                                       = 0;
     float scale                                                     = 0;
-    float data                                                      = 0;
-    float scaled_data                                               = 0;
 
-    uint32_t scalar_index_list[2]                                   = {0};
-    uint32_t scalar_index_list_len                                  = 2;
+    int8_t *base                                                    = NULL;
+    uint32_t stride                                                 = 0;
+    uint32_t group_stride                                           = 0;
 
+    uint32_t histogram[INT8_LEVELS]                                 = {0};
+    int class_count                                                 = 0;
+    int top_n                                                       = 0;
+    int heap_size                                                   = 0;
+
+    float max_data                                                  = 0;
     float sum                                                       = 0.0;
-    float max_scaled_data                                           = -INFINITY;
     double offset                                                   = 0.0;
 
     struct ex_classifier_result_s *top_n_results                    = NULL;
 
+    result_p->top_n_num = 0;
+
     /* get output node */
     if (0 != ex_get_output_tensor(image_p, 0, &tensor))
         goto FUNC_OUT;
@@ -92,46 +129,80 @@ int user_post_classifier_top_n(int model_id, struct kdp_image_s *image_p)
     if (NULL == shape)
         goto FUNC_OUT;
 
+    /* get the class axis, logits are read with its npu strides */
+    if (KP_SUCCESS != ex_get_axis_stride_int8(tensor, 1, &base, &stride, &group_stride))
+        goto FUNC_OUT;
+
     /* calculate quantization params */
     div     = ex_pow2(quantization_parameters_v1->quantized_fixed_point_descriptor[0].radix);
     scale   = quantization_parameters_v1->quantized_fixed_point_descriptor[0].scale.scale_float32;
     scale   = 1.0f / (div * scale);
 
     /* setting number of category */
-    result_p->top_n_num = shape[1];
+    class_count = shape[1];
+    top_n       = class_count;
+    if ((NULL != classifier_config) && (0 < classifier_config->top_n) && ((int)classifier_config->top_n < top_n))
+        top_n = classifier_config->top_n;
+    if (EX_CLASSIFIER_MAX_SIZE_TOP_N < top_n)
+        top_n = EX_CLASSIFIER_MAX_SIZE_TOP_N;
 
-    /* retrieve ouput feature map & do post process */
     /**
-     * safe implementation to avoid NaN result
-     * ref 1: https://stackoverflow.com/questions/9906136/implementation-of-a-softmax-activation-function-for-neural-networks
-     * ref 2: https://codereview.stackexchange.com/questions/180467/implementing-softmax-in-c
+     * select the top N on the quantized logits with a bounded min-heap (the dequantization is monotonic), and
+     * count every logit value for the softmax denominator
      */
     top_n_results = result_p->top_n_results;
 
-    for (int ch = 0; ch < shape[1]; ch++) {
-        scalar_index_list[0]        = 0;
-        scalar_index_list[1]        = ch;
-        data                        = (float)*ex_get_scalar_int8(tensor, scalar_index_list, scalar_index_list_len);
-        scaled_data                 = ex_do_div_scale_optim(data, scale);
+    for (int ch = 0; ch < class_count; ch++) {
+        int8_t data = base[ch * stride + (ch >> 4) * group_stride];
 
-        top_n_results[ch].class_num = ch;
-        top_n_results[ch].score     = scaled_data;
+        histogram[data + 128]++;
 
-        if (max_scaled_data < scaled_data) {
-            max_scaled_data = scaled_data;
+        if (heap_size < top_n) {
+            top_n_results[heap_size].class_num  = ch;
+            top_n_results[heap_size].score      = (float)data;
+            heap_sift_up(top_n_results, heap_size);
+            heap_size++;
+        } else if ((float)data > top_n_results[0].score) {
+            top_n_results[0].class_num          = ch;
+            top_n_results[0].score              = (float)data;
+            heap_sift_down(top_n_results, heap_size, 0);
         }
     }
 
-    for (int ch = 0; ch < shape[1]; ch++) {
-        sum += expf(top_n_results[ch].score - max_scaled_data);
+    if (0 == heap_size)
+        goto FUNC_OUT;
+
+    /* heap sort, the worst entry moves to the end so the results are in descending order */
+    for (int end = heap_size - 1; end > 0; end--) {
+        struct ex_classifier_result_s worst = top_n_results[0];
+
+        top_n_results[0]    = top_n_results[end];
+        top_n_results[end]  = worst;
+        heap_sift_down(top_n_results, end, 0);
+    }
+
+    /**
+     * safe implementation to avoid NaN result
+     * ref 1: https://stackoverflow.com/questions/9906136/implementation-of-a-softmax-activation-function-for-neural-networks
+     * ref 2: https://codereview.stackexchange.com/questions/180467/implementing-softmax-in-c
+     *
+     * at most 256 exponentials for the denominator whatever the number of classes
+     */
+    max_data = ex_do_div_scale_optim(top_n_results[0].score, scale);
+
+    for (int level = 0; level < INT8_LEVELS; level++) {
+        if (0 == histogram[level])
+            continue;
+
+        sum += histogram[level] * expf(ex_do_div_scale_optim((float)(level - 128), scale) - max_data);
     }
 
-    offset = (double)max_scaled_data + log(sum);
-    for (int ch = 0; ch < shape[1]; ch++) {
-        top_n_results[ch].score = expf(top_n_results[ch].score - offset);
+    offset = (double)max_data + log(sum);
+    for (int i = 0; i < heap_size; i++) {
+        top_n_results[i].score = expf(ex_do_div_scale_optim(top_n_results[i].score, scale) - offset);
     }
 
-    qsort(top_n_results, result_p->top_n_num, sizeof(struct ex_classifier_result_s), comparator_callback);
+    result_p->top_n_num = heap_size;
 
 FUNC_OUT:
     return sizeof(struct ex_classifier_top_n_result_s);
@@ -0,0 +1,119 @@
+/*
+ * Kneron Example raw NPU output Post-Processing.
+ *
+ * Copyright (C) 2023 Kneron, Inc. All rights reserved.
+ *
+ */
+#include <stdio.h>
+#include <string.h>
+
+#include "base.h"
+#include "ipc.h"
+#include "kdpio.h"
+#include "user_post_process_raw_output.h"
+
+/******************************************************************
+ * local define values
+*******************************************************************/
+// N/A
+
+/******************************************************************
+ * local struct defined
+*******************************************************************/
+// N/A
+
+/******************************************************************
+ * local variable initialization
+*******************************************************************/
+// N/A
+
+/******************************************************************
+ * main function
+*******************************************************************/
+int user_post_raw_output(int model_id, struct kdp_image_s *image_p)
+{
+    struct ex_raw_output_s *raw     = (struct ex_raw_output_s *)POSTPROC_RESULT_MEM_ADDR(image_p);
+    uintptr_t output_addr           = POSTPROC_OUTPUT_MEM_ADDR(image_p);
+    uint32_t output_len             = (uint32_t)POSTPROC_OUTPUT_MEM_LEN(image_p);
+    uint32_t output_num             = POSTPROC_OUTPUT_NUM(image_p);
+
+    raw->model_id       = model_id;
+    raw->output_num     = 0;
+    raw->output_mem_len = 0;
+    raw->output_format  = POSTPROC_OUTPUT_FORMAT(image_p);
+
+    if (output_num > EX_RAW_OUTPUT_MAX_TENSOR_NUM) {
+        printf("raw output fail: %u tensors, max %d ...\n", output_num, EX_RAW_OUTPUT_MAX_TENSOR_NUM);
+        raw->status = KP_FW_CONFIG_POST_PROC_ERROR_NO_SPACE_106;
+        goto FUNC_OUT;
+    }
+
+    if (output_len > raw->capacity) {
+        printf("raw output fail: %u bytes of NPU output, %u bytes of space ...\n", output_len, raw->capacity);
+        raw->status = KP_FW_CONFIG_POST_PROC_ERROR_NO_SPACE_106;
+        goto FUNC_OUT;
+    }
+
+    raw->raw_img        = *image_p->raw_img_p;
+    raw->preproc_node   = image_p->model_preproc.node_p[0];
+
+    /* make every tensor relative to the copied output memory */
+    for (uint32_t i = 0; i < output_num; i++) {
+        ngs_tensor_t *tensor = &raw->tensors[i];
+
+        *tensor = POSTPROC_OUTPUT_TENSOR_LIST(image_p)[i];
+
+        if (NGS_MODEL_TENSOR_ADDRESS_MODE_RELATIVE != tensor->base_pointer_address_mode) {
+            if ((tensor->base_pointer < output_addr) || (tensor->base_pointer >= output_addr + output_len)) {
+                printf("raw output fail: tensor %u is outside of the NPU output ...\n", i);
+                raw->status = KP_FW_CONFIG_POST_PROC_ERROR_NO_SPACE_106;
+                goto FUNC_OUT;
+            }
+
+            tensor->base_pointer_offset         = tensor->base_pointer - output_addr;
+            tensor->base_pointer_address_mode   = NGS_MODEL_TENSOR_ADDRESS_MODE_RELATIVE;
+        }
+
+        tensor->base_pointer = 0;
+    }
+
+    memcpy(raw->data, (void *)output_addr, output_len);
+
+    raw->output_num     = output_num;
+    raw->output_mem_len = output_len;
+    raw->status         = KP_SUCCESS;
+
+FUNC_OUT:
+    return sizeof(struct ex_raw_output_s) + raw->output_mem_len;
+}
+
+int user_post_raw_output_to_image(struct ex_raw_output_s *raw, void *post_proc_config, void *result, int result_len, struct kdp_image_s *image_p)
+{
+    if ((NULL == raw) || (NULL == result) || (NULL == image_p)) {
+        printf("raw output to image fail: NULL pointer paramaters ...\n");
+        return KP_FW_CONFIG_POST_PROC_ERROR_NO_SPACE_106;
+    }
+
+    if ((KP_SUCCESS != raw->status) || (0 == raw->output_num)) {
+        return (KP_SUCCESS != raw->status) ? raw->status : KP_FW_CONFIG_POST_PROC_ERROR_NO_SPACE_106;
+    }
+
+    memset(image_p, 0, sizeof(struct kdp_image_s));
+
+    image_p->raw_img_p                  = &raw->raw_img;
+    image_p->model_id                   = raw->model_id;
+
+    image_p->model_preproc.input_num    = 1;
+    image_p->model_preproc.node_p       = &raw->preproc_node;
+
+    image_p->postproc.output_num        = raw->output_num;
+    image_p->postproc.output_mem_addr   = (uintptr_t)raw->data;
+    image_p->postproc.output_mem_len    = (int32_t)raw->output_mem_len;
+    image_p->postproc.output_format     = raw->output_format;
+    image_p->postproc.result_mem_addr   = (uintptr_t)result;
+    image_p->postproc.result_mem_len    = result_len;
+    image_p->postproc.tensors_p         = raw->tensors;
+    image_p->postproc.params_p          = post_proc_config;
+
+    return KP_SUCCESS;
+}
@@ -62,19 +62,21 @@ struct ex_yolo_v5_post_globals_s
 /******************************************************************
  * local variable initialization
 *******************************************************************/
-struct ex_yolo_v5_post_globals_s *yolo_v5_gp    = NULL;
-static float prob_threshold                     = DEFAULT_PROBABILITY_THRESHOLD;
-static float iou_threshold                      = DEFAULT_IOU_THRESHOLD;
-static uint32_t max_detection_box               = DEFAULT_MAX_YOLO_V5_DETECT_BOX;
-static uint32_t max_detection_box_per_class     = DEFAULT_MAX_YOLO_V5_DETECT_BOX_PER_CLASS;
-static ex_nms_mode_t nms_mode                   = DEFAULT_NMS_MODE;
+/* per thread, so the host post-process workers (demo_customize_inf_host_post) can run it concurrently, the working buffer
+   comes from the arena of the thread (user_post_mem_manager) and is given back before returning */
+__thread struct ex_yolo_v5_post_globals_s *yolo_v5_gp   = NULL;
+static __thread float prob_threshold                    = DEFAULT_PROBABILITY_THRESHOLD;
+static __thread float iou_threshold                     = DEFAULT_IOU_THRESHOLD;
+static __thread uint32_t max_detection_box              = DEFAULT_MAX_YOLO_V5_DETECT_BOX;
+static __thread uint32_t max_detection_box_per_class    = DEFAULT_MAX_YOLO_V5_DETECT_BOX_PER_CLASS;
+static __thread ex_nms_mode_t nms_mode                  = DEFAULT_NMS_MODE;
 static float default_anchors[EX_MAX_YOLO_ANCHOR_LAYER_NUM][EX_MAX_YOLO_ANCHOR_CELL_NUM_PER_LAYER][2] \
                                                 = {{{10, 13}, {16, 30}, {33, 23}},
                                                    {{30, 61}, {62, 45}, {59, 119}},
                                                    {{116 ,90}, {156, 198}, {373, 326}},
                                                    {{0 ,0}, {0, 0}, {0, 0}},
                                                    {{0 ,0}, {0, 0}, {0, 0}}};
-static float anchors[EX_MAX_YOLO_ANCHOR_LAYER_NUM][EX_MAX_YOLO_ANCHOR_CELL_NUM_PER_LAYER][2] \
+static __thread float anchors[EX_MAX_YOLO_ANCHOR_LAYER_NUM][EX_MAX_YOLO_ANCHOR_CELL_NUM_PER_LAYER][2] \
                                                 = {{{0}}};
 
 /******************************************************************
@@ -153,6 +155,10 @@ int user_post_yolov5_no_sigmoid(int model_id, struct kdp_image_s *image_p)
 
     /* init working buffer */
     yolo_v5_gp = (struct ex_yolo_v5_post_globals_s*)ex_get_gp((void**)&yolo_v5_gp, sizeof(struct ex_yolo_v5_post_globals_s));
+    if (NULL == yolo_v5_gp) {
+        result->box_count = 0;
+        goto FUNC_OUT;
+    }
 
     /* initialize */
     struct ex_bounding_box_s *boxes                                 = yolo_v5_gp->boxes;
@@ -205,6 +205,68 @@ FUNC_OUT:
     return scalar;
 }
 
+/**
+ * @brief get the base pointer and the npu strides of one axis of an int8 tensor.
+ */
+int ex_get_axis_stride_int8(ngs_tensor_t *tensor, uint32_t axis, int8_t **base, uint32_t *stride, uint32_t *group_stride)
+{
+    ngs_tensor_shape_info_v2_t *tensor_shape_info_v2    = NULL;
+    uint32_t npu_channel_group_stride_tmp               = 0;
+    uint32_t npu_channel_group_stride                   = 0;
+    uint32_t channel_idx                                = 0;
+
+    if ((NULL == tensor) ||
+        (NULL == base) ||
+        (NULL == stride) ||
+        (NULL == group_stride)) {
+        printf("get axis stride int8 fail: NULL pointer paramaters ...\n");
+        return KP_ERROR_INVALID_PARAM_12;
+    }
+
+    if ((DRAM_FMT_16W1C8B != tensor->data_layout) &&
+        (DRAM_FMT_1W16C8B != tensor->data_layout) &&
+        (DRAM_FMT_1W16C8B_CH_COMPACT != tensor->data_layout) &&
+        (DRAM_FMT_RAW8B != tensor->data_layout)) {
+        printf("get axis stride int8 fail: invalid NPU data layout ...\n");
+        return KP_ERROR_INVALID_PARAM_12;
+    }
+
+    if (NGS_MODEL_TENSOR_SHAPE_INFO_VERSION_2 != tensor->tensor_shape_info.version) {
+        printf("get axis stride int8 fail: invalid source tensor shape version ...\n");
+        return KP_ERROR_INVALID_PARAM_12;
+    }
+
+    tensor_shape_info_v2 = &(tensor->tensor_shape_info.tensor_shape_info_data.v2);
+
+    if (axis >= tensor_shape_info_v2->shape_len) {
+        printf("get axis stride int8 fail: invalid axis ...\n");
+        return KP_ERROR_INVALID_PARAM_12;
+    }
+
+    *base           = (int8_t *)tensor->base_pointer;
+    *stride         = tensor_shape_info_v2->stride_npu[axis];
+    *group_stride   = 0;
+
+    /* same channel group rule as ex_get_scalar_int8() */
+    if (DRAM_FMT_1W16C8B == tensor->data_layout) {
+        for (int i = 0; i < (int)tensor_shape_info_v2->shape_len; i++) {
+            if (1 == tensor_shape_info_v2->stride_npu[i]) {
+                channel_idx = i;
+                continue;
+            }
+
+            npu_channel_group_stride_tmp = tensor_shape_info_v2->stride_npu[i] * tensor_shape_info_v2->shape[i];
+            if (npu_channel_group_stride_tmp > npu_channel_group_stride)
+                npu_channel_group_stride = npu_channel_group_stride_tmp;
+        }
+
+        if (axis == channel_idx)
+            *group_stride = npu_channel_group_stride - 16;
+    }
+
+    return KP_SUCCESS;
+}
+
 /**
  * @brief get the int16 scalar from tensor.
  */
@@ -0,0 +1,303 @@
+/**
+ * @file        nnm_admission.c
+ * @brief       Admission control of the NNM image FIFO queue
+ * @version     0.1
+ * @date        2021-03-22
+ *
+ * @copyright   Copyright (c) 2021 Kneron Inc. All rights reserved.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "nnm_admission.h"
+
+#define NNM_ADMISSION_HISTORY       64      //! frames tracked in flight, more than any image FIFO
+#define NNM_ADMISSION_STALL_MS      2000    //! frames in flight without any result for this long are given up
+#define NNM_ADMISSION_SMOOTHING     0.125   //! weight of the newest sample in the smoothed times
+
+typedef struct {
+    bool pending;
+    bool replaced;                          //! taken as replaced in a full queue, its result may still come
+    uint32_t inf_number;
+    uint64_t submit_ns;
+} NNM_ADMISSION_FRAME_T;
+
+static pthread_mutex_t _mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t _cond_result;
+static bool _opened = false;
+
+static NNM_ADMISSION_CONFIG_T _config;
+static NNM_ADMISSION_STATS_T _stats;
+static NNM_ADMISSION_FRAME_T _frames[NNM_ADMISSION_HISTORY];
+static uint32_t _last_result = 0;           //! inference number of the newest result
+static uint64_t _decide_ns = 0;
+static uint64_t _first_ns = 0;
+static uint64_t _result_ns = 0;             //! newest result, or the first submit
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+static void smooth(double *value, double sample)
+{
+    *value = (0 == *value) ? sample : (*value + (sample - *value) * NNM_ADMISSION_SMOOTHING);
+}
+
+/* one frame runs and the others are queued, more are queued when the host needs longer than the NPU to fill one */
+static uint32_t target_in_flight(void)
+{
+    uint32_t target = 1;
+
+    if (NNM_ADMISSION_MODE_MAX_THROUGHPUT == _config.mode) {
+        target = 2;
+        if ((0 < _stats.service_ms) && (0 < _stats.prep_ms))
+            target += (uint32_t)(_stats.prep_ms / _stats.service_ms);
+    } else if (NNM_ADMISSION_MODE_DROPPABLE == _config.mode) {
+        target = _config.max_in_flight;
+    }
+
+    return (target < _config.max_in_flight) ? target : _config.max_in_flight;
+}
+
+/* the results of the frames in flight are not coming, e.g. after an inference error */
+static void release_stalled(uint64_t now)
+{
+    if ((0 == _stats.in_flight) || (now - _result_ns < (uint64_t)NNM_ADMISSION_STALL_MS * 1000000ull))
+        return;
+
+    printf("[%s] %u frames in flight without a result for %d ms, given up\n", __func__, _stats.in_flight, NNM_ADMISSION_STALL_MS);
+
+    for (int i = 0; i < NNM_ADMISSION_HISTORY; i++)
+        _frames[i].pending = false;
+
+    _stats.lost += _stats.in_flight;
+    _stats.in_flight = 0;
+    _result_ns = now;
+}
+
+/* a frame went into a full queue, the oldest queued frame was replaced, the oldest frame in flight is running */
+static void replace_oldest_queued(uint32_t newest)
+{
+    bool running = true;
+
+    for (uint32_t n = newest - NNM_ADMISSION_HISTORY + 1; n != newest; n++) {
+        NNM_ADMISSION_FRAME_T *frame = &_frames[n % NNM_ADMISSION_HISTORY];
+
+        if ((false == frame->pending) || (n != frame->inf_number))
+            continue;
+
+        if (true == running) {
+            running = false;
+            continue;
+        }
+
+        frame->pending = false;
+        frame->replaced = true;
+        _stats.replaced++;
+        _stats.in_flight--;
+        return;
+    }
+}
+
+int nnm_admission_open(const NNM_ADMISSION_CONFIG_T *config)
+{
+    pthread_condattr_t attr;
+
+    if ((NNM_ADMISSION_MODE_MAX_THROUGHPUT < config->mode) || (0 == config->max_in_flight)) {
+        printf("[%s] Error: invalid mode %d with %u buffers\n", __func__, config->mode, config->max_in_flight);
+        return -1;
+    }
+
+    pthread_mutex_lock(&_mutex);
+
+    if (false == _opened) {
+        pthread_condattr_init(&attr);
+        pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+        pthread_cond_init(&_cond_result, &attr);
+        pthread_condattr_destroy(&attr);
+        _opened = true;
+    }
+
+    _config = *config;
+    if (NNM_ADMISSION_HISTORY < _config.max_in_flight)
+        _config.max_in_flight = NNM_ADMISSION_HISTORY;
+
+    memset(&_stats, 0, sizeof(_stats));
+    memset(_frames, 0, sizeof(_frames));
+    _stats.mode = _config.mode;
+    _stats.target_in_flight = target_in_flight();
+    _last_result = 0;
+    _decide_ns = _first_ns = _result_ns = 0;
+
+    pthread_mutex_unlock(&_mutex);
+
+    return 0;
+}
+
+NNM_ADMISSION_DECISION_E nnm_admission_decide(int timeout_ms)
+{
+    NNM_ADMISSION_DECISION_E decision = NNM_ADMISSION_SUBMIT;
+    uint64_t deadline_ns = now_ns() + (uint64_t)timeout_ms * 1000000ull;
+    struct timespec deadline;
+
+    deadline.tv_sec = deadline_ns / 1000000000ull;
+    deadline.tv_nsec = deadline_ns % 1000000000ull;
+
+    pthread_mutex_lock(&_mutex);
+
+    if ((false == _opened) || (NNM_ADMISSION_MODE_DROPPABLE == _config.mode)) {
+        decision = NNM_ADMISSION_REPLACE;
+        goto FUNC_OUT;
+    }
+
+    while (_stats.in_flight >= (_stats.target_in_flight = target_in_flight())) {
+        // every buffer is in flight, a newer frame is worth more than the queued one
+        if ((NNM_ADMISSION_MODE_MAX_THROUGHPUT == _config.mode) && (_stats.target_in_flight == _config.max_in_flight)) {
+            decision = NNM_ADMISSION_REPLACE;
+            break;
+        }
+
+        release_stalled(now_ns());
+        if (_stats.in_flight < _stats.target_in_flight)
+            break;
+
+        if (ETIMEDOUT == pthread_cond_timedwait(&_cond_result, &_mutex, &deadline)) {
+            decision = NNM_ADMISSION_DROP;
+            break;
+        }
+    }
+
+FUNC_OUT:
+    _decide_ns = now_ns();
+    pthread_mutex_unlock(&_mutex);
+
+    return decision;
+}
+
+void nnm_admission_mark_submitted(uint32_t inf_number, uint32_t skipped)
+{
+    uint64_t now = now_ns();
+    NNM_ADMISSION_FRAME_T *frame = &_frames[inf_number % NNM_ADMISSION_HISTORY];
+
+    pthread_mutex_lock(&_mutex);
+
+    if (0 == _stats.submitted) {
+        _first_ns = _result_ns = now;
+        _last_result = inf_number - 1;
+    } else if (0 == _stats.in_flight) {
+        _result_ns = now;   // the stall timeout starts with the first frame in flight
+    }
+
+    // the results of this old frame are long overdue
+    if (true == frame->pending) {
+        _stats.lost++;
+        _stats.in_flight--;
+    }
+
+    frame->pending = true;
+    frame->replaced = false;
+    frame->inf_number = inf_number;
+    frame->submit_ns = now;
+
+    _stats.submitted++;
+    _stats.skipped += skipped;
+    _stats.in_flight++;
+    if (_stats.in_flight > _config.max_in_flight)
+        replace_oldest_queued(inf_number);
+    if (_stats.in_flight > _stats.in_flight_max)
+        _stats.in_flight_max = _stats.in_flight;
+
+    if ((0 != _decide_ns) && (now > _decide_ns))
+        smooth(&_stats.prep_ms, (now - _decide_ns) / 1000000.0);
+
+    pthread_mutex_unlock(&_mutex);
+}
+
+void nnm_admission_mark_result(uint32_t inf_number)
+{
+    uint64_t now = now_ns();
+    NNM_ADMISSION_FRAME_T *frame = &_frames[inf_number % NNM_ADMISSION_HISTORY];
+
+    pthread_mutex_lock(&_mutex);
+
+    if ((0 == _stats.submitted) || (0 >= (int32_t)(inf_number - _last_result))) {
+        pthread_mutex_unlock(&_mutex);
+        return;
+    }
+
+    // results come in submit order, the frames in between were replaced in the queue
+    uint32_t first = (inf_number - _last_result < NNM_ADMISSION_HISTORY) ? (_last_result + 1) : (inf_number - NNM_ADMISSION_HISTORY + 1);
+
+    for (uint32_t n = first; n != inf_number; n++) {
+        NNM_ADMISSION_FRAME_T *replaced = &_frames[n % NNM_ADMISSION_HISTORY];
+
+        if ((true == replaced->pending) && (n == replaced->inf_number)) {
+            replaced->pending = false;
+            _stats.replaced++;
+            _stats.in_flight--;
+        }
+    }
+
+    // the queue replaced another frame than the one taken as replaced, that one is found missing later
+    if ((true == frame->replaced) && (inf_number == frame->inf_number)) {
+        frame->replaced = false;
+        frame->pending = true;
+        _stats.replaced--;
+        _stats.in_flight++;
+    }
+
+    if ((true == frame->pending) && (inf_number == frame->inf_number)) {
+        // the NPU started on the frame at its submit, or when the previous frame was done
+        uint64_t start_ns = (frame->submit_ns > _result_ns) ? frame->submit_ns : _result_ns;
+        double latency_ms = (now - frame->submit_ns) / 1000000.0;
+
+        smooth(&_stats.service_ms, (now - start_ns) / 1000000.0);
+
+        frame->pending = false;
+        _stats.in_flight--;
+        _stats.completed++;
+
+        smooth(&_stats.latency_ms, latency_ms);
+        if (latency_ms > _stats.latency_max_ms)
+            _stats.latency_max_ms = latency_ms;
+
+        if (now > _first_ns)
+            _stats.fps = _stats.completed * 1000000000.0 / (now - _first_ns);
+    }
+
+    _last_result = inf_number;
+    _result_ns = now;
+    _stats.target_in_flight = target_in_flight();
+
+    pthread_cond_broadcast(&_cond_result);
+    pthread_mutex_unlock(&_mutex);
+}
+
+void nnm_admission_get_stats(NNM_ADMISSION_STATS_T *stats)
+{
+    pthread_mutex_lock(&_mutex);
+    *stats = _stats;
+    pthread_mutex_unlock(&_mutex);
+}
+
+const char *nnm_admission_mode_name(NNM_ADMISSION_MODE_E mode)
+{
+    switch (mode) {
+    case NNM_ADMISSION_MODE_DROPPABLE:
+        return "droppable";
+    case NNM_ADMISSION_MODE_MIN_LATENCY:
+        return "min-latency";
+    case NNM_ADMISSION_MODE_MAX_THROUGHPUT:
+        return "max-throughput";
+    default:
+        return "unknown";
+    }
+}
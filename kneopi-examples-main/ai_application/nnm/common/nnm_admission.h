@@ -0,0 +1,118 @@
+/**
+ * @file        nnm_admission.h
+ * @brief       Admission control of the NNM image FIFO queue
+ *
+ * Decides for every frame ready on the host whether it is submitted, replaces the frame waiting in the image
+ * FIFO queue or is dropped, from the frames in flight and the measured NPU service time. The frames are matched
+ * to their results by the inference number, results come back in submit order, so a missing number is a frame
+ * replaced in the queue.
+ *
+ * @version     0.1
+ * @date        2021-03-22
+ *
+ * @copyright   Copyright (c) 2021 Kneron Inc. All rights reserved.
+ */
+
+#ifndef __NNM_ADMISSION_H
+#define __NNM_ADMISSION_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief admission policy
+ */
+typedef enum {
+    NNM_ADMISSION_MODE_DROPPABLE = 0,       //! every frame is submitted, the oldest queued frame is replaced on a full queue
+    NNM_ADMISSION_MODE_MIN_LATENCY = 1,     //! at most one frame in flight, the newest frame goes in when its result is back
+    NNM_ADMISSION_MODE_MAX_THROUGHPUT = 2,  //! keeps enough frames queued that the NPU never waits for the host
+} NNM_ADMISSION_MODE_E;
+
+/**
+ * @brief what to do with the frame ready on the host
+ */
+typedef enum {
+    NNM_ADMISSION_SUBMIT = 0,               //! a buffer is free, get it without dropping
+    NNM_ADMISSION_REPLACE = 1,              //! get a buffer droppable, the oldest queued frame is replaced when the queue is full
+    NNM_ADMISSION_DROP = 2,                 //! not now, the frame is superseded by a newer one
+} NNM_ADMISSION_DECISION_E;
+
+/**
+ * @brief describe the controlled queue
+ */
+typedef struct {
+    NNM_ADMISSION_MODE_E mode;
+    uint32_t max_in_flight;                 //! image FIFO buffers
+} NNM_ADMISSION_CONFIG_T;
+
+/**
+ * @brief counters of the controller, times are smoothed over the last results
+ */
+typedef struct {
+    NNM_ADMISSION_MODE_E mode;
+    uint32_t submitted;                     //! frames enqueued for inference
+    uint32_t skipped;                       //! frames captured but never submitted, a newer frame was submitted instead
+    uint32_t replaced;                      //! submitted frames replaced in the queue, they have no result
+    uint32_t lost;                          //! frames in flight given up after a stall
+    uint32_t completed;                     //! results of submitted frames
+    uint32_t in_flight;                     //! submitted frames without a result
+    uint32_t in_flight_max;
+    uint32_t target_in_flight;              //! current limit of the mode
+    double fps;                             //! results per second since the first submit
+    double service_ms;                      //! time the NPU spends on a frame
+    double prep_ms;                         //! decision to enqueue of a frame on the host
+    double latency_ms;                      //! submit to result
+    double latency_max_ms;
+} NNM_ADMISSION_STATS_T;
+
+/**
+ * @brief reset the counters and set the policy.
+ *
+ * @param[in] config the controlled queue.
+ *
+ * @return 0 means sucessful, otherwise failed.
+ */
+int nnm_admission_open(const NNM_ADMISSION_CONFIG_T *config);
+
+/**
+ * @brief decide for the frame ready on the host, waits for a result while the mode holds frames back.
+ *
+ * @param[in] timeout_ms longest wait for a result.
+ *
+ * @return the decision, NNM_ADMISSION_DROP after the timeout.
+ */
+NNM_ADMISSION_DECISION_E nnm_admission_decide(int timeout_ms);
+
+/**
+ * @brief record a frame enqueued for inference.
+ *
+ * @param[in] inf_number inference number in the image header.
+ * @param[in] skipped frames captured since the previous submitted frame which were not submitted.
+ */
+void nnm_admission_mark_submitted(uint32_t inf_number, uint32_t skipped);
+
+/**
+ * @brief record a result, may be called from another thread than the submits.
+ *
+ * @param[in] inf_number inference number in the result.
+ */
+void nnm_admission_mark_result(uint32_t inf_number);
+
+/**
+ * @brief get the counters since nnm_admission_open().
+ */
+void nnm_admission_get_stats(NNM_ADMISSION_STATS_T *stats);
+
+/**
+ * @brief name of a mode for the reports.
+ */
+const char *nnm_admission_mode_name(NNM_ADMISSION_MODE_E mode);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __NNM_ADMISSION_H
@@ -0,0 +1,114 @@
+/**
+ * @file        nnm_fifoq_pool.c
+ * @brief       FIFO queue buffers sized from the streams of an example
+ * @version     0.1
+ * @date        2021-03-22
+ *
+ * @copyright   Copyright (c) 2021 Kneron Inc. All rights reserved.
+ */
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include <vmf_nnm_fifoq_manager.h>
+
+#include "nnm_fifoq_pool.h"
+
+static NNM_FIFOQ_POOL_STREAM_T _streams[NNM_FIFOQ_POOL_MAX_STREAMS];
+static int _stream_count = 0;
+static NNM_FIFOQ_POOL_STATS_T _stats;
+static bool _allocated = false;
+
+static uint32_t size_class(uint32_t size)
+{
+    return (size + NNM_FIFOQ_POOL_PAGE_SIZE - 1) / NNM_FIFOQ_POOL_PAGE_SIZE * NNM_FIFOQ_POOL_PAGE_SIZE;
+}
+
+uint32_t nnm_fifoq_pool_image_size(kp_image_format_t format, uint32_t width, uint32_t height)
+{
+    uint32_t pixels = width * height;
+
+    switch (format) {
+    case KP_IMAGE_FORMAT_RAW8:
+        return pixels;
+    case KP_IMAGE_FORMAT_YUV420:
+        return pixels + pixels / 2;
+    case KP_IMAGE_FORMAT_RGB565:
+    case KP_IMAGE_FORMAT_YUYV:
+        return pixels * 2;
+    default:
+        return pixels * 4;
+    }
+}
+
+int nnm_fifoq_pool_add_stream(const NNM_FIFOQ_POOL_STREAM_T *stream)
+{
+    if ((NNM_FIFOQ_POOL_MAX_STREAMS <= _stream_count) || (0 == stream->image_count) || (0 == stream->result_count) ||
+        (0 == stream->image_size) || (0 == stream->result_size)) {
+        printf("[%s] Error: stream %s of %u x %u bytes images, %u x %u bytes results (%d of %d streams)\n", __func__,
+               (NULL != stream->name) ? stream->name : "", stream->image_count, stream->image_size, stream->result_count,
+               stream->result_size, _stream_count, NNM_FIFOQ_POOL_MAX_STREAMS);
+        return -1;
+    }
+
+    _streams[_stream_count++] = *stream;
+
+    return 0;
+}
+
+int nnm_fifoq_pool_allocate(void)
+{
+    uint64_t needed_bytes = 0;
+
+    if (0 == _stream_count) {
+        printf("[%s] Error: no stream\n", __func__);
+        return -1;
+    }
+
+    memset(&_stats, 0, sizeof(_stats));
+
+    for (int i = 0; i < _stream_count; i++) {
+        uint32_t image_class = size_class(NNM_FIFOQ_POOL_HEADER_SIZE + _streams[i].image_size);
+        uint32_t result_class = size_class(_streams[i].result_size);
+
+        if (image_class > _stats.image_size)
+            _stats.image_size = image_class;
+        if (result_class > _stats.result_size)
+            _stats.result_size = result_class;
+
+        _stats.image_count += _streams[i].image_count;
+        _stats.result_count += _streams[i].result_count;
+        needed_bytes += (uint64_t)image_class * _streams[i].image_count + (uint64_t)result_class * _streams[i].result_count;
+
+        printf("[NNM] fifoq pool: stream %s, images %u x %u KB, results %u x %u KB\n", (NULL != _streams[i].name) ? _streams[i].name : "",
+               _streams[i].image_count, image_class / 1024, _streams[i].result_count, result_class / 1024);
+    }
+
+    _stats.committed_bytes = (uint64_t)_stats.image_size * _stats.image_count + (uint64_t)_stats.result_size * _stats.result_count;
+    _stats.slack_bytes = _stats.committed_bytes - needed_bytes;
+
+    VMF_NNM_Fifoq_Manager_Allocate_Buffer(_stats.image_count, _stats.image_size, _stats.result_count, _stats.result_size);
+    _allocated = true;
+
+    printf("[NNM] fifoq pool: committed %llu KB, images %u x %u KB, results %u x %u KB, %llu KB over the stream classes\n",
+           (unsigned long long)(_stats.committed_bytes / 1024), _stats.image_count, _stats.image_size / 1024,
+           _stats.result_count, _stats.result_size / 1024, (unsigned long long)(_stats.slack_bytes / 1024));
+
+    return 0;
+}
+
+void nnm_fifoq_pool_get_stats(NNM_FIFOQ_POOL_STATS_T *stats)
+{
+    *stats = _stats;
+}
+
+void nnm_fifoq_pool_release(void)
+{
+    if (true == _allocated)
+        VMF_NNM_Fifoq_Manager_Release_All_Buffer();
+
+    _allocated = false;
+    _stream_count = 0;
+    memset(&_stats, 0, sizeof(_stats));
+}
@@ -0,0 +1,96 @@
+/**
+ * @file        nnm_fifoq_pool.h
+ * @brief       FIFO queue buffers sized from the streams of an example
+ *
+ * Each stream declares the largest image it submits, from its source geometry and format after any scaling, and
+ * the largest result of its job, from the result structure of the job. A size is rounded up to whole pages,
+ * which is its size class. The FIFO queue manager has one image pool and one result pool, so the buffers of all
+ * streams take the largest class and streams of the same class share it without slack. The committed DMA memory
+ * of both pools is printed at allocation.
+ *
+ * @version     0.1
+ * @date        2021-03-22
+ *
+ * @copyright   Copyright (c) 2021 Kneron Inc. All rights reserved.
+ */
+
+#ifndef __NNM_FIFOQ_POOL_H
+#define __NNM_FIFOQ_POOL_H
+
+#include <stdint.h>
+
+#include "kp_struct.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define NNM_FIFOQ_POOL_MAX_STREAMS      4
+#define NNM_FIFOQ_POOL_HEADER_SIZE      1024        //! inference header in front of an image, every job header fits
+#define NNM_FIFOQ_POOL_PAGE_SIZE        4096        //! size class granularity
+
+/**
+ * @brief describe the buffers of one stream
+ */
+typedef struct {
+    const char *name;                       //! for the report
+    uint32_t image_size;                    //! largest image, the header is added
+    uint32_t image_count;
+    uint32_t result_size;                   //! largest result with its header
+    uint32_t result_count;
+} NNM_FIFOQ_POOL_STREAM_T;
+
+/**
+ * @brief the committed pools
+ */
+typedef struct {
+    uint32_t image_size;                    //! size class of an image buffer
+    uint32_t image_count;
+    uint32_t result_size;                   //! size class of a result buffer
+    uint32_t result_count;
+    uint64_t committed_bytes;               //! both pools
+    uint64_t slack_bytes;                   //! over the classes of each stream, the cost of sharing one pool
+} NNM_FIFOQ_POOL_STATS_T;
+
+/**
+ * @brief bytes of one image.
+ *
+ * @param[in] format image format.
+ * @param[in] width image width.
+ * @param[in] height image height.
+ *
+ * @return the size, 4 bytes per pixel for an unknown format.
+ */
+uint32_t nnm_fifoq_pool_image_size(kp_image_format_t format, uint32_t width, uint32_t height);
+
+/**
+ * @brief declare a stream before nnm_fifoq_pool_allocate().
+ *
+ * @param[in] stream the buffers of the stream.
+ *
+ * @return 0 means sucessful, otherwise failed.
+ */
+int nnm_fifoq_pool_add_stream(const NNM_FIFOQ_POOL_STREAM_T *stream);
+
+/**
+ * @brief allocate the FIFO queue buffers of all declared streams and print the committed memory.
+ *
+ * @return 0 means sucessful, -1 if no stream is declared.
+ */
+int nnm_fifoq_pool_allocate(void);
+
+/**
+ * @brief get the committed pools.
+ */
+void nnm_fifoq_pool_get_stats(NNM_FIFOQ_POOL_STATS_T *stats);
+
+/**
+ * @brief release the FIFO queue buffers and forget the streams.
+ */
+void nnm_fifoq_pool_release(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __NNM_FIFOQ_POOL_H
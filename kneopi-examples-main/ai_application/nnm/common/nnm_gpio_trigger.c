@@ -0,0 +1,305 @@
+/**
+ * @file        nnm_gpio_trigger.c
+ * @brief       GPIO edge trigger source for NNM examples
+ * @version     0.1
+ * @date        2021-03-22
+ *
+ * @copyright   Copyright (c) 2021 Kneron Inc. All rights reserved.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+
+#include <gpiod.h>
+
+#include "nnm_gpio_trigger.h"
+
+#define NNM_GPIO_TRIGGER_CONSUMER   "nnm-trigger"
+
+static struct gpiod_line_request *_request = NULL;
+static struct gpiod_edge_event_buffer *_event_buffer = NULL;
+static int _epoll_fd = -1;
+static int _wakeup_fd = -1;
+
+/* edges read from the request but not returned yet, only touched by the waiting thread */
+static NNM_GPIO_TRIGGER_EVENT_T _queue[NNM_GPIO_TRIGGER_QUEUE_SIZE];
+static int _queue_head = 0;
+static int _queue_count = 0;
+static unsigned long _last_seqno = 0;
+
+/* the submit latency is recorded by the send thread */
+static pthread_mutex_t _mutex_stats = PTHREAD_MUTEX_INITIALIZER;
+static NNM_GPIO_TRIGGER_STATS_T _stats;
+static double _dispatch_sum_ms = 0;
+static double _capture_sum_ms = 0;
+static double _submit_sum_ms = 0;
+
+uint64_t nnm_gpio_trigger_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+static void update_latency(uint64_t timestamp_ns, uint64_t now_ns, uint32_t count, double *sum_ms, double *avg_ms, double *max_ms)
+{
+    double latency_ms = (now_ns > timestamp_ns) ? (now_ns - timestamp_ns) / 1000000.0 : 0;
+
+    *sum_ms += latency_ms;
+    *avg_ms = *sum_ms / count;
+    if (latency_ms > *max_ms)
+        *max_ms = latency_ms;
+}
+
+static void queue_push(const NNM_GPIO_TRIGGER_EVENT_T *event)
+{
+    if (NNM_GPIO_TRIGGER_QUEUE_SIZE == _queue_count) {
+        _queue_head = (_queue_head + 1) % NNM_GPIO_TRIGGER_QUEUE_SIZE;
+        _queue_count--;
+        _stats.dropped++;
+    }
+    _queue[(_queue_head + _queue_count) % NNM_GPIO_TRIGGER_QUEUE_SIZE] = *event;
+    _queue_count++;
+}
+
+/**
+ * Read all pending edges of the request in one call. A gap in the line sequence numbers means the kernel
+ * dropped edges from its own queue.
+ */
+static int read_edge_events(void)
+{
+    uint64_t now_ns;
+    int count, i;
+
+    count = gpiod_line_request_read_edge_events(_request, _event_buffer, NNM_GPIO_TRIGGER_QUEUE_SIZE);
+    if (count < 0) {
+        perror("gpiod_line_request_read_edge_events");
+        return -1;
+    }
+    now_ns = nnm_gpio_trigger_now_ns();
+
+    pthread_mutex_lock(&_mutex_stats);
+    for (i = 0; i < count; i++) {
+        struct gpiod_edge_event *edge = gpiod_edge_event_buffer_get_event(_event_buffer, i);
+        NNM_GPIO_TRIGGER_EVENT_T event;
+
+        event.timestamp_ns = gpiod_edge_event_get_timestamp_ns(edge);
+        event.received_ns = now_ns;
+        event.seqno = gpiod_edge_event_get_line_seqno(edge);
+        event.rising = (GPIOD_EDGE_EVENT_RISING_EDGE == gpiod_edge_event_get_event_type(edge));
+
+        if (_last_seqno != 0 && event.seqno > _last_seqno + 1)
+            _stats.dropped += event.seqno - _last_seqno - 1;
+        _last_seqno = event.seqno;
+
+        _stats.events++;
+        update_latency(event.timestamp_ns, now_ns, _stats.events, &_dispatch_sum_ms, &_stats.dispatch_avg_ms, &_stats.dispatch_max_ms);
+
+        queue_push(&event);
+    }
+    pthread_mutex_unlock(&_mutex_stats);
+
+    return count;
+}
+
+int nnm_gpio_trigger_open(const NNM_GPIO_TRIGGER_CONFIG_T *config)
+{
+    struct gpiod_chip *chip = NULL;
+    struct gpiod_line_settings *settings = NULL;
+    struct gpiod_line_config *line_cfg = NULL;
+    struct gpiod_request_config *req_cfg = NULL;
+    struct epoll_event ev;
+    int ret = -1;
+
+    if (NULL != _request) {
+        printf("[%s] Error: trigger is already open\n", __FUNCTION__);
+        return -1;
+    }
+
+    chip = gpiod_chip_open(config->chip_path);
+    if (!chip) {
+        printf("[%s] Error: open %s failed (%s)\n", __FUNCTION__, config->chip_path, strerror(errno));
+        return -1;
+    }
+
+    settings = gpiod_line_settings_new();
+    if (!settings)
+        goto close_chip;
+
+    gpiod_line_settings_set_direction(settings, GPIOD_LINE_DIRECTION_INPUT);
+    gpiod_line_settings_set_edge_detection(settings,
+        (NNM_GPIO_TRIGGER_EDGE_RISING == config->edge) ? GPIOD_LINE_EDGE_RISING :
+        (NNM_GPIO_TRIGGER_EDGE_FALLING == config->edge) ? GPIOD_LINE_EDGE_FALLING : GPIOD_LINE_EDGE_BOTH);
+    if (NNM_GPIO_TRIGGER_BIAS_PULL_UP == config->bias)
+        gpiod_line_settings_set_bias(settings, GPIOD_LINE_BIAS_PULL_UP);
+    else if (NNM_GPIO_TRIGGER_BIAS_PULL_DOWN == config->bias)
+        gpiod_line_settings_set_bias(settings, GPIOD_LINE_BIAS_PULL_DOWN);
+    gpiod_line_settings_set_debounce_period_us(settings, config->debounce_us);
+    // the latencies are measured against clock_gettime(CLOCK_MONOTONIC)
+    gpiod_line_settings_set_event_clock(settings, GPIOD_LINE_CLOCK_MONOTONIC);
+
+    line_cfg = gpiod_line_config_new();
+    if (!line_cfg)
+        goto free_settings;
+
+    if (gpiod_line_config_add_line_settings(line_cfg, &config->offset, 1, settings))
+        goto free_line_config;
+
+    req_cfg = gpiod_request_config_new();
+    if (!req_cfg)
+        goto free_line_config;
+
+    gpiod_request_config_set_consumer(req_cfg, NNM_GPIO_TRIGGER_CONSUMER);
+    gpiod_request_config_set_event_buffer_size(req_cfg, NNM_GPIO_TRIGGER_QUEUE_SIZE);
+
+    _request = gpiod_chip_request_lines(chip, req_cfg, line_cfg);
+    if (!_request) {
+        printf("[%s] Error: request line %u of %s failed (%s)\n", __FUNCTION__, config->offset, config->chip_path, strerror(errno));
+        goto free_request_config;
+    }
+
+    _event_buffer = gpiod_edge_event_buffer_new(NNM_GPIO_TRIGGER_QUEUE_SIZE);
+    _wakeup_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    _epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (!_event_buffer || _wakeup_fd < 0 || _epoll_fd < 0) {
+        printf("[%s] Error: allocate trigger resources failed\n", __FUNCTION__);
+        goto free_request_config;
+    }
+
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.fd = gpiod_line_request_get_fd(_request);
+    if (epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, ev.data.fd, &ev) != 0)
+        goto free_request_config;
+    ev.data.fd = _wakeup_fd;
+    if (epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, ev.data.fd, &ev) != 0)
+        goto free_request_config;
+
+    _queue_head = 0;
+    _queue_count = 0;
+    _last_seqno = 0;
+    memset(&_stats, 0, sizeof(_stats));
+    _dispatch_sum_ms = _capture_sum_ms = _submit_sum_ms = 0;
+
+    printf("[%s] trigger on line %u of %s, edge %d, debounce %u us\n", __FUNCTION__, config->offset, config->chip_path, config->edge, config->debounce_us);
+    ret = 0;
+
+free_request_config:
+    if (req_cfg)
+        gpiod_request_config_free(req_cfg);
+free_line_config:
+    gpiod_line_config_free(line_cfg);
+free_settings:
+    gpiod_line_settings_free(settings);
+close_chip:
+    // the line request stays valid after the chip is closed
+    gpiod_chip_close(chip);
+
+    if (0 != ret)
+        nnm_gpio_trigger_close();
+
+    return ret;
+}
+
+int nnm_gpio_trigger_wait(NNM_GPIO_TRIGGER_EVENT_T *event, int timeout_ms)
+{
+    struct epoll_event ev[2];
+    uint64_t value;
+    int count, i;
+
+    if (NULL == _request)
+        return -1;
+
+    while (0 == _queue_count) {
+        count = epoll_wait(_epoll_fd, ev, 2, timeout_ms);
+        if (count < 0) {
+            if (EINTR == errno)
+                return 1;
+            perror("epoll_wait");
+            return -1;
+        }
+        if (0 == count)
+            return 1;
+
+        for (i = 0; i < count; i++) {
+            if (ev[i].data.fd == _wakeup_fd) {
+                if (read(_wakeup_fd, &value, sizeof(value)) < 0 && EAGAIN != errno)
+                    perror("read wakeup");
+                return 1;
+            }
+            if (read_edge_events() < 0)
+                return -1;
+        }
+    }
+
+    *event = _queue[_queue_head];
+    _queue_head = (_queue_head + 1) % NNM_GPIO_TRIGGER_QUEUE_SIZE;
+    _queue_count--;
+
+    return 0;
+}
+
+void nnm_gpio_trigger_wakeup(void)
+{
+    uint64_t value = 1;
+
+    if (_wakeup_fd >= 0 && write(_wakeup_fd, &value, sizeof(value)) < 0) {
+        // counter is saturated, the waiting thread wakes up anyway
+    }
+}
+
+void nnm_gpio_trigger_mark_captured(uint64_t timestamp_ns)
+{
+    uint64_t now_ns = nnm_gpio_trigger_now_ns();
+
+    pthread_mutex_lock(&_mutex_stats);
+    _stats.captured++;
+    update_latency(timestamp_ns, now_ns, _stats.captured, &_capture_sum_ms, &_stats.capture_avg_ms, &_stats.capture_max_ms);
+    pthread_mutex_unlock(&_mutex_stats);
+}
+
+void nnm_gpio_trigger_mark_submitted(uint64_t timestamp_ns)
+{
+    uint64_t now_ns = nnm_gpio_trigger_now_ns();
+
+    pthread_mutex_lock(&_mutex_stats);
+    _stats.submitted++;
+    update_latency(timestamp_ns, now_ns, _stats.submitted, &_submit_sum_ms, &_stats.submit_avg_ms, &_stats.submit_max_ms);
+    pthread_mutex_unlock(&_mutex_stats);
+}
+
+void nnm_gpio_trigger_get_stats(NNM_GPIO_TRIGGER_STATS_T *stats)
+{
+    pthread_mutex_lock(&_mutex_stats);
+    *stats = _stats;
+    pthread_mutex_unlock(&_mutex_stats);
+}
+
+void nnm_gpio_trigger_close(void)
+{
+    if (_epoll_fd >= 0) {
+        close(_epoll_fd);
+        _epoll_fd = -1;
+    }
+    if (_wakeup_fd >= 0) {
+        close(_wakeup_fd);
+        _wakeup_fd = -1;
+    }
+    if (_event_buffer) {
+        gpiod_edge_event_buffer_free(_event_buffer);
+        _event_buffer = NULL;
+    }
+    if (_request) {
+        gpiod_line_request_release(_request);
+        _request = NULL;
+    }
+    _queue_count = 0;
+}
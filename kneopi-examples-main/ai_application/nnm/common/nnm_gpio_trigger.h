@@ -0,0 +1,139 @@
+/**
+ * @file        nnm_gpio_trigger.h
+ * @brief       GPIO edge trigger source for NNM examples
+ *
+ * Requests one GPIO line with edge detection through libgpiod v2 and turns its edges into trigger events stamped
+ * by the kernel (CLOCK_MONOTONIC) at interrupt time. The input thread of an example waits on the trigger with
+ * epoll instead of polling the line, captures the newest frame as soon as an edge arrives and submits it, and
+ * the trigger-to-capture and trigger-to-submit latencies are measured against the kernel timestamp.
+ *
+ * @version     0.1
+ * @date        2021-03-22
+ *
+ * @copyright   Copyright (c) 2021 Kneron Inc. All rights reserved.
+ */
+
+#ifndef __NNM_GPIO_TRIGGER_H
+#define __NNM_GPIO_TRIGGER_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define NNM_GPIO_TRIGGER_QUEUE_SIZE     16          // pending events, the oldest is dropped when full
+
+/**
+ * @brief edges which fire a trigger
+ */
+typedef enum {
+    NNM_GPIO_TRIGGER_EDGE_RISING = 1,
+    NNM_GPIO_TRIGGER_EDGE_FALLING = 2,
+    NNM_GPIO_TRIGGER_EDGE_BOTH = 3,
+} NNM_GPIO_TRIGGER_EDGE_E;
+
+/**
+ * @brief bias of the input line
+ */
+typedef enum {
+    NNM_GPIO_TRIGGER_BIAS_AS_IS = 0,
+    NNM_GPIO_TRIGGER_BIAS_PULL_UP = 1,
+    NNM_GPIO_TRIGGER_BIAS_PULL_DOWN = 2,
+} NNM_GPIO_TRIGGER_BIAS_E;
+
+/**
+ * @brief describe the trigger line
+ */
+typedef struct {
+    const char *chip_path;                  //! e.g. "/dev/gpiochip0"
+    unsigned int offset;                    //! line offset on the chip
+    NNM_GPIO_TRIGGER_EDGE_E edge;
+    NNM_GPIO_TRIGGER_BIAS_E bias;
+    unsigned int debounce_us;               //! 0 disables debouncing
+} NNM_GPIO_TRIGGER_CONFIG_T;
+
+/**
+ * @brief one edge of the trigger line
+ */
+typedef struct {
+    uint64_t timestamp_ns;                  //! kernel timestamp of the edge, CLOCK_MONOTONIC
+    uint64_t received_ns;                   //! when it was read from the line request
+    unsigned long seqno;                    //! sequence number of the edge on the line
+    int rising;                             //! 1 for a rising edge, 0 for a falling edge
+} NNM_GPIO_TRIGGER_EVENT_T;
+
+/**
+ * @brief statistics of the trigger source, latencies are from the kernel timestamp of the edge
+ */
+typedef struct {
+    uint32_t events;                        //! edges read from the line
+    uint32_t dropped;                       //! edges lost in the kernel or on a full queue
+    uint32_t captured;                      //! frames captured for an edge
+    uint32_t submitted;                     //! frames submitted for an edge
+    double dispatch_avg_ms;                 //! edge to read by the waiting thread
+    double dispatch_max_ms;
+    double capture_avg_ms;                  //! edge to frame copied into the input buffer
+    double capture_max_ms;
+    double submit_avg_ms;                   //! edge to frame enqueued for inference
+    double submit_max_ms;
+} NNM_GPIO_TRIGGER_STATS_T;
+
+/**
+ * @brief request the line with edge detection and set up the epoll set.
+ *
+ * @param[in] config the trigger line.
+ *
+ * @return 0 means sucessful, otherwise failed.
+ */
+int nnm_gpio_trigger_open(const NNM_GPIO_TRIGGER_CONFIG_T *config);
+
+/**
+ * @brief wait for the next trigger, edges which arrived while the caller was busy are returned first.
+ *
+ * @param[out] event the trigger event.
+ * @param[in] timeout_ms -1 waits forever.
+ *
+ * @return 0 on an event, 1 on timeout or nnm_gpio_trigger_wakeup(), -1 on error or when the trigger is closed.
+ */
+int nnm_gpio_trigger_wait(NNM_GPIO_TRIGGER_EVENT_T *event, int timeout_ms);
+
+/**
+ * @brief wake up nnm_gpio_trigger_wait(), safe to call from a signal handler.
+ */
+void nnm_gpio_trigger_wakeup(void);
+
+/**
+ * @brief current time on the clock of the kernel timestamps.
+ */
+uint64_t nnm_gpio_trigger_now_ns(void);
+
+/**
+ * @brief record that the frame of an edge is in the input buffer.
+ *
+ * @param[in] timestamp_ns kernel timestamp of the edge.
+ */
+void nnm_gpio_trigger_mark_captured(uint64_t timestamp_ns);
+
+/**
+ * @brief record that the frame of an edge is enqueued for inference, may be called from another thread.
+ *
+ * @param[in] timestamp_ns kernel timestamp of the edge.
+ */
+void nnm_gpio_trigger_mark_submitted(uint64_t timestamp_ns);
+
+/**
+ * @brief get the statistics since nnm_gpio_trigger_open().
+ */
+void nnm_gpio_trigger_get_stats(NNM_GPIO_TRIGGER_STATS_T *stats);
+
+/**
+ * @brief release the line request, must not be called while a thread waits on the trigger.
+ */
+void nnm_gpio_trigger_close(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __NNM_GPIO_TRIGGER_H
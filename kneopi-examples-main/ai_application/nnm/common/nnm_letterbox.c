@@ -0,0 +1,90 @@
+/**
+ * @file        nnm_letterbox.c
+ * @brief       Letterboxed model resolution frames for NNM examples
+ * @version     0.1
+ * @date        2021-03-22
+ *
+ * @copyright   Copyright (c) 2021 Kneron Inc. All rights reserved.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "nnm_letterbox.h"
+
+#define NNM_LETTERBOX_BLACK_Y   16          //! video range black
+#define NNM_LETTERBOX_BLACK_UV  128
+
+static float clip(float value, float max)
+{
+    if (value < 0)
+        return 0;
+    if (value > max)
+        return max;
+    return value;
+}
+
+int nnm_letterbox_init(NNM_LETTERBOX_T *letterbox, unsigned int src_width, unsigned int src_height,
+                       unsigned int model_width, unsigned int model_height)
+{
+    memset(letterbox, 0, sizeof(NNM_LETTERBOX_T));
+
+    if ((0 == src_width) || (0 == src_height) || (0 != model_width % 2) || (0 != model_height % 2) ||
+        (NNM_LETTERBOX_WIDTH_ALIGN > model_width) || (2 > model_height)) {
+        printf("[%s] Error: invalid letterbox %ux%u to %ux%u\n", __func__, src_width, src_height, model_width, model_height);
+        return -1;
+    }
+
+    // the side limiting the scale fills the model, the other one is padded at the end
+    if ((uint64_t)src_width * model_height >= (uint64_t)src_height * model_width) {
+        letterbox->scaled_width = model_width;
+        letterbox->scaled_height = (unsigned int)((uint64_t)src_height * model_width / src_width);
+    } else {
+        letterbox->scaled_width = (unsigned int)((uint64_t)src_width * model_height / src_height);
+        letterbox->scaled_height = model_height;
+    }
+
+    // YUV420 planes and the scaler stride
+    letterbox->scaled_width &= ~(NNM_LETTERBOX_WIDTH_ALIGN - 1);
+    letterbox->scaled_height &= ~1u;
+
+    if ((0 == letterbox->scaled_width) || (0 == letterbox->scaled_height)) {
+        printf("[%s] Error: %ux%u does not fit in %ux%u\n", __func__, src_width, src_height, model_width, model_height);
+        return -1;
+    }
+
+    letterbox->src_width = src_width;
+    letterbox->src_height = src_height;
+    letterbox->model_width = model_width;
+    letterbox->model_height = model_height;
+    letterbox->scale_x = (float)src_width / letterbox->scaled_width;
+    letterbox->scale_y = (float)src_height / letterbox->scaled_height;
+
+    return 0;
+}
+
+unsigned int nnm_letterbox_canvas_size(const NNM_LETTERBOX_T *letterbox)
+{
+    return letterbox->model_width * letterbox->model_height * 3 / 2;
+}
+
+void nnm_letterbox_fill_canvas(const NNM_LETTERBOX_T *letterbox, uint8_t *canvas)
+{
+    unsigned int luma_size = letterbox->model_width * letterbox->model_height;
+
+    memset(canvas, NNM_LETTERBOX_BLACK_Y, luma_size);
+    memset(canvas + luma_size, NNM_LETTERBOX_BLACK_UV, luma_size / 2);
+}
+
+void nnm_letterbox_remap_boxes(const NNM_LETTERBOX_T *letterbox, kp_bounding_box_t *boxes, uint32_t box_count)
+{
+    float max_x = (float)(letterbox->scaled_width - 1);
+    float max_y = (float)(letterbox->scaled_height - 1);
+
+    for (uint32_t i = 0; i < box_count; i++) {
+        boxes[i].x1 = clip(boxes[i].x1, max_x) * letterbox->scale_x;
+        boxes[i].y1 = clip(boxes[i].y1, max_y) * letterbox->scale_y;
+        boxes[i].x2 = clip(boxes[i].x2, max_x) * letterbox->scale_x;
+        boxes[i].y2 = clip(boxes[i].y2, max_y) * letterbox->scale_y;
+    }
+}
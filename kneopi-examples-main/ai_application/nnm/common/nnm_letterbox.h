@@ -0,0 +1,84 @@
+/**
+ * @file        nnm_letterbox.h
+ * @brief       Letterboxed model resolution frames for NNM examples
+ *
+ * The scaler of the video source outputs the frame at model scale with its aspect ratio kept, it is copied into
+ * the top-left corner of a model resolution canvas whose padding is filled once. The canvas is submitted for
+ * inference instead of the full resolution frame, which stays for the display only, so the NCPU does not resize
+ * and the image FIFO buffers are sized for the model. The boxes of the results are in canvas coordinates and
+ * are remapped to the full resolution frame.
+ *
+ * @version     0.1
+ * @date        2021-03-22
+ *
+ * @copyright   Copyright (c) 2021 Kneron Inc. All rights reserved.
+ */
+
+#ifndef __NNM_LETTERBOX_H
+#define __NNM_LETTERBOX_H
+
+#include <stdint.h>
+
+#include "kp_struct.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define NNM_LETTERBOX_WIDTH_ALIGN   16      //! the scaled frame width is a multiple of this for the scaler stride
+
+/**
+ * @brief geometry of a letterboxed frame
+ */
+typedef struct {
+    unsigned int src_width;                 //! full resolution frame, the boxes are remapped to it
+    unsigned int src_height;
+    unsigned int model_width;               //! canvas submitted for inference
+    unsigned int model_height;
+    unsigned int scaled_width;              //! frame scaled with its aspect ratio kept, at the top-left corner
+    unsigned int scaled_height;
+    float scale_x;                          //! full resolution pixels per canvas pixel
+    float scale_y;
+} NNM_LETTERBOX_T;
+
+/**
+ * @brief compute the geometry of the letterbox.
+ *
+ * @param[out] letterbox the geometry.
+ * @param[in] src_width full resolution frame.
+ * @param[in] src_height
+ * @param[in] model_width input of the model.
+ * @param[in] model_height
+ *
+ * @return 0 means sucessful, otherwise failed.
+ */
+int nnm_letterbox_init(NNM_LETTERBOX_T *letterbox, unsigned int src_width, unsigned int src_height,
+                       unsigned int model_width, unsigned int model_height);
+
+/**
+ * @brief size of the YUV420 canvas in bytes.
+ */
+unsigned int nnm_letterbox_canvas_size(const NNM_LETTERBOX_T *letterbox);
+
+/**
+ * @brief fill the YUV420 canvas with black, only the scaled frame is written afterwards so it is done once.
+ *
+ * @param[in] letterbox the geometry.
+ * @param[out] canvas nnm_letterbox_canvas_size() bytes, Y then Cb then Cr planes.
+ */
+void nnm_letterbox_fill_canvas(const NNM_LETTERBOX_T *letterbox, uint8_t *canvas);
+
+/**
+ * @brief remap boxes from the canvas to the full resolution frame, boxes are clipped to the scaled frame first.
+ *
+ * @param[in] letterbox the geometry.
+ * @param[in,out] boxes the boxes.
+ * @param[in] box_count number of boxes.
+ */
+void nnm_letterbox_remap_boxes(const NNM_LETTERBOX_T *letterbox, kp_bounding_box_t *boxes, uint32_t box_count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __NNM_LETTERBOX_H
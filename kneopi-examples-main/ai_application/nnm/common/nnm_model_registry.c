@@ -0,0 +1,160 @@
+/**
+ * @file        nnm_model_registry.c
+ * @brief       resident model registry for NNM examples
+ * @version     0.1
+ * @date        2021-03-22
+ *
+ * @copyright   Copyright (c) 2021 Kneron Inc. All rights reserved.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/time.h>
+
+#include <vmf_nnm_inference_app.h>
+
+#include "nnm_model_registry.h"
+
+static NNM_MODEL_NEF_T _nef_list[NNM_MODEL_REGISTRY_MAX_NEF];
+static int _nef_count = 0;
+
+static double get_time_ms(void)
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec * 1000.0 + tv.tv_usec / 1000.0;
+}
+
+static void release_nef(NNM_MODEL_NEF_T *nef)
+{
+    free(nef->path);
+    memset(nef, 0, sizeof(NNM_MODEL_NEF_T));
+}
+
+static int add_nef(const char *path)
+{
+    NNM_MODEL_NEF_T *nef;
+
+    for (int i = 0; i < _nef_count; i++) {
+        if (0 == strcmp(_nef_list[i].path, path))
+            return 0;
+    }
+
+    if (NNM_MODEL_REGISTRY_MAX_NEF <= _nef_count) {
+        printf("[%s] Error: at most %d NEF files can be registered\n", __func__, NNM_MODEL_REGISTRY_MAX_NEF);
+        return -1;
+    }
+
+    // a missing file fails the registration, before any NEF file is loaded
+    if (0 != access(path, R_OK)) {
+        printf("[%s] Error: cannot read %s (%s)\n", __func__, path, strerror(errno));
+        return -1;
+    }
+
+    nef = &_nef_list[_nef_count];
+    memset(nef, 0, sizeof(NNM_MODEL_NEF_T));
+    nef->path = strdup(path);
+    if (NULL == nef->path)
+        return -1;
+
+    _nef_count++;
+
+    return 0;
+}
+
+int nnm_model_registry_add(const char *nef_paths)
+{
+    char *paths;
+    char *save_ptr = NULL;
+    int ret = 0;
+
+    if (NULL == nef_paths)
+        return -1;
+
+    paths = strdup(nef_paths);
+    if (NULL == paths)
+        return -1;
+
+    for (char *path = strtok_r(paths, ",", &save_ptr); NULL != path; path = strtok_r(NULL, ",", &save_ptr)) {
+        char *end = path + strlen(path);
+
+        while (' ' == *path || '\t' == *path)
+            path++;
+        while (end > path && (' ' == end[-1] || '\t' == end[-1]))
+            *--end = '\0';
+
+        if ('\0' == *path)
+            continue;
+
+        if (0 != add_nef(path)) {
+            ret = -1;
+            break;
+        }
+    }
+
+    free(paths);
+
+    return (0 == ret) ? _nef_count : -1;
+}
+
+int nnm_model_registry_load_all(void)
+{
+    if (0 == _nef_count)
+        return -1;
+
+    for (int i = 0; i < _nef_count; i++) {
+        NNM_MODEL_NEF_T *nef = &_nef_list[i];
+        double start;
+        int ret;
+
+        if (true == nef->loaded)
+            continue;
+
+        start = get_time_ms();
+        ret = VMF_NNM_Load_Model_From_File(nef->path);
+        nef->load_ms = get_time_ms() - start;
+        if (KP_SUCCESS != ret) {
+            printf("[%s] Error: load %s failed (%d)\n", __func__, nef->path, ret);
+            return -1;
+        }
+        nef->loaded = true;
+    }
+
+    return 0;
+}
+
+int nnm_model_registry_load(const char *nef_paths)
+{
+    double start = get_time_ms();
+
+    if (0 >= nnm_model_registry_add(nef_paths))
+        return -1;
+
+    if (0 != nnm_model_registry_load_all())
+        return -1;
+
+    nnm_model_registry_print();
+    printf("[NNM] model startup total %.2f ms\n", get_time_ms() - start);
+
+    return 0;
+}
+
+void nnm_model_registry_print(void)
+{
+    for (int i = 0; i < _nef_count; i++) {
+        const NNM_MODEL_NEF_T *nef = &_nef_list[i];
+
+        printf("[NNM] %s: load %.2f ms\n", nef->path, nef->load_ms);
+    }
+}
+
+void nnm_model_registry_release(void)
+{
+    for (int i = 0; i < _nef_count; i++)
+        release_nef(&_nef_list[i]);
+
+    _nef_count = 0;
+}
@@ -0,0 +1,74 @@
+/**
+ * @file        nnm_model_registry.h
+ * @brief       resident model registry for NNM examples
+ *
+ * All registered NEF files are loaded into NNM once at startup with VMF_NNM_Load_Model_From_File() and stay
+ * resident, switching between their models only needs a different model ID / job ID. The load time of each
+ * NEF file is printed at startup.
+ *
+ * @version     0.1
+ * @date        2021-03-22
+ *
+ * @copyright   Copyright (c) 2021 Kneron Inc. All rights reserved.
+ */
+
+#ifndef __NNM_MODEL_REGISTRY_H
+#define __NNM_MODEL_REGISTRY_H
+
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define NNM_MODEL_REGISTRY_MAX_NEF          8       /**< maximum number of registered NEF files */
+
+/**
+ * @brief describe one registered NEF file
+ */
+typedef struct {
+    char *path;
+    bool loaded;                            //! loaded into NNM
+    double load_ms;                         //! time of VMF_NNM_Load_Model_From_File()
+} NNM_MODEL_NEF_T;
+
+/**
+ * @brief register NEF files, a file registered before is skipped.
+ *
+ * @param[in] nef_paths one NEF path or a comma separated list of NEF paths.
+ *
+ * @return number of registered NEF files, -1 if any of them cannot be read.
+ */
+int nnm_model_registry_add(const char *nef_paths);
+
+/**
+ * @brief load all registered NEF files which are not loaded yet into NNM.
+ *
+ * @return 0 means sucessful, -1 if nothing is registered or a NEF file fails to load.
+ */
+int nnm_model_registry_load_all(void);
+
+/**
+ * @brief register and load NEF files, then print the load time of each file.
+ *
+ * @param[in] nef_paths one NEF path or a comma separated list of NEF paths.
+ *
+ * @return 0 means sucessful, otherwise failed.
+ */
+int nnm_model_registry_load(const char *nef_paths);
+
+/**
+ * @brief print registered NEF files and their load time.
+ */
+void nnm_model_registry_print(void);
+
+/**
+ * @brief clear the registry.
+ */
+void nnm_model_registry_release(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __NNM_MODEL_REGISTRY_H
@@ -0,0 +1,242 @@
+/**
+ * @file        nnm_motion.c
+ * @brief       Motion gate of the frames submitted for inference
+ * @version     0.1
+ * @date        2021-03-22
+ *
+ * @copyright   Copyright (c) 2021 Kneron Inc. All rights reserved.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#include "nnm_motion.h"
+
+static pthread_mutex_t _mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static NNM_MOTION_CONFIG_T _config;
+static NNM_MOTION_STATS_T _stats;
+static uint8_t *_current = NULL;            //! downscaled frame, rows of _plane_width with the padding at 0
+static uint8_t *_background = NULL;
+static unsigned int _plane_width = 0;       //! multiple of the block size
+static unsigned int _scaled_width = 0;      //! downscaled pixels of the frame
+static unsigned int _scaled_height = 0;
+static unsigned int _block_cols = 0;
+static unsigned int _block_rows = 0;
+static bool _has_background = false;
+static unsigned int _since_submit = 0;
+static double _changed_sum = 0;
+static double _analyze_sum_ms = 0;
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+/* 2 x 2 average at the top-left of each downscale x downscale cell, it takes out most of the sensor noise */
+static void downscale_plane(const uint8_t *y, unsigned int stride)
+{
+    unsigned int step = _config.downscale;
+
+    for (unsigned int row = 0; row < _scaled_height; row++) {
+        const uint8_t *src0 = y + (size_t)row * step * stride;
+        const uint8_t *src1 = src0 + stride;
+        uint8_t *dst = _current + (size_t)row * _plane_width;
+
+        for (unsigned int col = 0; col < _scaled_width; col++) {
+            unsigned int x = col * step;
+            dst[col] = (uint8_t)((src0[x] + src0[x + 1] + src1[x] + src1[x + 1] + 2) >> 2);
+        }
+    }
+}
+
+/* sum of absolute differences of one block against the background, which moves toward the frame in the same pass */
+static uint32_t block_sad_update(unsigned int block_row, unsigned int block_col)
+{
+    size_t offset = (size_t)block_row * NNM_MOTION_BLOCK_SIZE * _plane_width + block_col * NNM_MOTION_BLOCK_SIZE;
+    int shift = (int)_config.learn_shift;
+
+#if defined(__ARM_NEON)
+    uint16x8_t acc = vdupq_n_u16(0);
+    int16x8_t rshift = vdupq_n_s16(-shift);
+
+    for (unsigned int i = 0; i < NNM_MOTION_BLOCK_SIZE; i++, offset += _plane_width) {
+        uint8x16_t cur = vld1q_u8(_current + offset);
+        uint8x16_t bg = vld1q_u8(_background + offset);
+
+        // 16 rows of at most 2 x 255 per lane fit in 16 bits
+        acc = vpadalq_u8(acc, vabdq_u8(cur, bg));
+
+        int16x8_t diff_lo = vreinterpretq_s16_u16(vsubl_u8(vget_low_u8(cur), vget_low_u8(bg)));
+        int16x8_t diff_hi = vreinterpretq_s16_u16(vsubl_u8(vget_high_u8(cur), vget_high_u8(bg)));
+        int16x8_t bg_lo = vaddq_s16(vreinterpretq_s16_u16(vmovl_u8(vget_low_u8(bg))), vrshlq_s16(diff_lo, rshift));
+        int16x8_t bg_hi = vaddq_s16(vreinterpretq_s16_u16(vmovl_u8(vget_high_u8(bg))), vrshlq_s16(diff_hi, rshift));
+
+        vst1q_u8(_background + offset, vcombine_u8(vqmovun_s16(bg_lo), vqmovun_s16(bg_hi)));
+    }
+
+    uint64x2_t sum = vpaddlq_u32(vpaddlq_u16(acc));
+    return (uint32_t)(vgetq_lane_u64(sum, 0) + vgetq_lane_u64(sum, 1));
+#else
+    uint32_t sad = 0;
+
+    for (unsigned int i = 0; i < NNM_MOTION_BLOCK_SIZE; i++, offset += _plane_width) {
+        for (unsigned int j = 0; j < NNM_MOTION_BLOCK_SIZE; j++) {
+            int cur = _current[offset + j];
+            int bg = _background[offset + j];
+            int diff = cur - bg;
+
+            sad += (diff < 0) ? -diff : diff;
+
+            // rounding shift as vrshl, the same background as the NEON path
+            if (0 < shift)
+                diff = (diff + (1 << (shift - 1))) >> shift;
+            _background[offset + j] = (uint8_t)(bg + diff);
+        }
+    }
+
+    return sad;
+#endif
+}
+
+int nnm_motion_open(const NNM_MOTION_CONFIG_T *config)
+{
+    size_t plane_size;
+
+    if ((2 > config->downscale) || (8 < config->learn_shift) || (0 == config->min_blocks) ||
+        (NNM_MOTION_BLOCK_SIZE * config->downscale > config->width) || (NNM_MOTION_BLOCK_SIZE * config->downscale > config->height)) {
+        printf("[%s] Error: invalid gate of %ux%u downscaled by %u, learn shift %u\n", __func__,
+               config->width, config->height, config->downscale, config->learn_shift);
+        return -1;
+    }
+
+    nnm_motion_close();
+
+    pthread_mutex_lock(&_mutex);
+
+    _config = *config;
+    _scaled_width = _config.width / _config.downscale;
+    _scaled_height = _config.height / _config.downscale;
+    _block_cols = (_scaled_width + NNM_MOTION_BLOCK_SIZE - 1) / NNM_MOTION_BLOCK_SIZE;
+    _block_rows = (_scaled_height + NNM_MOTION_BLOCK_SIZE - 1) / NNM_MOTION_BLOCK_SIZE;
+    _plane_width = _block_cols * NNM_MOTION_BLOCK_SIZE;
+    plane_size = (size_t)_plane_width * _block_rows * NNM_MOTION_BLOCK_SIZE;
+
+    // the padding of both planes stays 0 and adds nothing to the differences
+    _current = (uint8_t *)calloc(1, plane_size);
+    _background = (uint8_t *)calloc(1, plane_size);
+
+    memset(&_stats, 0, sizeof(_stats));
+    _stats.blocks = _block_cols * _block_rows;
+    _has_background = false;
+    _since_submit = 0;
+    _changed_sum = _analyze_sum_ms = 0;
+
+    pthread_mutex_unlock(&_mutex);
+
+    if ((NULL == _current) || (NULL == _background)) {
+        printf("[%s] Error: allocate %zu bytes failed\n", __func__, 2 * plane_size);
+        nnm_motion_close();
+        return -1;
+    }
+
+    printf("[%s] %ux%u in %ux%u blocks of %ux%u pixels\n", __func__, _config.width, _config.height, _block_cols, _block_rows,
+           NNM_MOTION_BLOCK_SIZE * _config.downscale, NNM_MOTION_BLOCK_SIZE * _config.downscale);
+
+    return 0;
+}
+
+void nnm_motion_analyze(const uint8_t *y, unsigned int stride, NNM_MOTION_RESULT_T *result)
+{
+    uint64_t start_ns = now_ns();
+    double analyze_ms;
+
+    memset(result, 0, sizeof(NNM_MOTION_RESULT_T));
+
+    pthread_mutex_lock(&_mutex);
+
+    if (NULL == _current) {
+        pthread_mutex_unlock(&_mutex);
+        result->submit = true;
+        return;
+    }
+
+    downscale_plane(y, stride);
+
+    if (false == _has_background) {
+        memcpy(_background, _current, (size_t)_plane_width * _block_rows * NNM_MOTION_BLOCK_SIZE);
+        _has_background = true;
+        result->changed_blocks = _stats.blocks;
+        result->submit = true;
+    } else {
+        for (unsigned int block_row = 0; block_row < _block_rows; block_row++) {
+            unsigned int rows = _scaled_height - block_row * NNM_MOTION_BLOCK_SIZE;
+
+            if (NNM_MOTION_BLOCK_SIZE < rows)
+                rows = NNM_MOTION_BLOCK_SIZE;
+
+            for (unsigned int block_col = 0; block_col < _block_cols; block_col++) {
+                unsigned int cols = _scaled_width - block_col * NNM_MOTION_BLOCK_SIZE;
+
+                if (NNM_MOTION_BLOCK_SIZE < cols)
+                    cols = NNM_MOTION_BLOCK_SIZE;
+
+                // the mean over the pixels of the frame in the block, the ones at the edges are partly padding
+                if (block_sad_update(block_row, block_col) > _config.threshold * rows * cols)
+                    result->changed_blocks++;
+            }
+        }
+
+        result->submit = (result->changed_blocks >= _config.min_blocks);
+    }
+
+    if (true == result->submit) {
+        _stats.motion++;
+        _changed_sum += result->changed_blocks;
+        _stats.changed_blocks_avg = _changed_sum / _stats.motion;
+        _since_submit = 0;
+    } else if ((0 != _config.refresh_frames) && (++_since_submit >= _config.refresh_frames)) {
+        result->submit = result->refresh = true;
+        _stats.refreshed++;
+        _since_submit = 0;
+    } else {
+        _stats.skipped++;
+    }
+
+    analyze_ms = (now_ns() - start_ns) / 1000000.0;
+    _stats.frames++;
+    _analyze_sum_ms += analyze_ms;
+    _stats.analyze_avg_ms = _analyze_sum_ms / _stats.frames;
+    if (analyze_ms > _stats.analyze_max_ms)
+        _stats.analyze_max_ms = analyze_ms;
+
+    pthread_mutex_unlock(&_mutex);
+}
+
+void nnm_motion_get_stats(NNM_MOTION_STATS_T *stats)
+{
+    pthread_mutex_lock(&_mutex);
+    *stats = _stats;
+    pthread_mutex_unlock(&_mutex);
+}
+
+void nnm_motion_close(void)
+{
+    pthread_mutex_lock(&_mutex);
+
+    free(_current);
+    free(_background);
+    _current = _background = NULL;
+    _has_background = false;
+
+    pthread_mutex_unlock(&_mutex);
+}
@@ -0,0 +1,96 @@
+/**
+ * @file        nnm_motion.h
+ * @brief       Motion gate of the frames submitted for inference
+ *
+ * The Y plane of each captured frame is downscaled by averaging, compared block by block with a background
+ * which follows the scene slowly, and only a frame with enough changed blocks is submitted. On a static scene
+ * the NPU idles and the last result stays valid, a refresh submits a frame every so often anyway so a change
+ * the background has absorbed still reaches the model.
+ *
+ * @version     0.1
+ * @date        2021-03-22
+ *
+ * @copyright   Copyright (c) 2021 Kneron Inc. All rights reserved.
+ */
+
+#ifndef __NNM_MOTION_H
+#define __NNM_MOTION_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define NNM_MOTION_BLOCK_SIZE   16          //! blocks are 16 x 16 pixels of the downscaled plane
+
+/**
+ * @brief describe the motion gate
+ */
+typedef struct {
+    unsigned int width;                     //! Y plane of the captured frames
+    unsigned int height;
+    unsigned int downscale;                 //! frame pixels per downscaled pixel in each direction, 2 or more
+    unsigned int threshold;                 //! mean absolute difference of a changed block, in Y levels
+    unsigned int min_blocks;                //! changed blocks of a frame with motion
+    unsigned int learn_shift;               //! the background moves 1/2^learn_shift of the way to each frame
+    unsigned int refresh_frames;            //! a static frame is submitted after this many skipped ones, 0: never
+} NNM_MOTION_CONFIG_T;
+
+/**
+ * @brief decision for one frame
+ */
+typedef struct {
+    bool submit;                            //! motion, refresh or the first frame
+    bool refresh;                           //! submitted without motion
+    unsigned int changed_blocks;
+} NNM_MOTION_RESULT_T;
+
+/**
+ * @brief counters since nnm_motion_open()
+ */
+typedef struct {
+    uint32_t frames;                        //! analyzed frames
+    uint32_t motion;                        //! submitted on motion, the first frame included
+    uint32_t refreshed;                     //! submitted on refresh
+    uint32_t skipped;                       //! static frames not submitted, the last result is reused
+    uint32_t blocks;                        //! blocks of a frame
+    double changed_blocks_avg;              //! over the frames with motion
+    double analyze_avg_ms;
+    double analyze_max_ms;
+} NNM_MOTION_STATS_T;
+
+/**
+ * @brief allocate the downscaled planes, the first analyzed frame is the initial background.
+ *
+ * @param[in] config the gate.
+ *
+ * @return 0 means sucessful, otherwise failed.
+ */
+int nnm_motion_open(const NNM_MOTION_CONFIG_T *config);
+
+/**
+ * @brief analyze a frame and update the background.
+ *
+ * @param[in] y Y plane of config width x height.
+ * @param[in] stride bytes per row of the Y plane.
+ * @param[out] result the decision.
+ */
+void nnm_motion_analyze(const uint8_t *y, unsigned int stride, NNM_MOTION_RESULT_T *result);
+
+/**
+ * @brief get the counters since nnm_motion_open().
+ */
+void nnm_motion_get_stats(NNM_MOTION_STATS_T *stats);
+
+/**
+ * @brief free the downscaled planes.
+ */
+void nnm_motion_close(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __NNM_MOTION_H
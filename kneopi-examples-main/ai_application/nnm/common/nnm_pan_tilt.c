@@ -0,0 +1,264 @@
+/**
+ * @file        nnm_pan_tilt.c
+ * @brief       Pan/tilt tracking for NNM examples
+ * @version     0.1
+ * @date        2021-03-22
+ *
+ * @copyright   Copyright (c) 2021 Kneron Inc. All rights reserved.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <math.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "pca9685.h"
+
+#include "nnm_pan_tilt.h"
+
+#define NNM_PAN_TILT_DT_DEFAULT     0.05        // s, first step after the target is found
+#define NNM_PAN_TILT_DT_MAX         0.2         // s, a longer gap is a stall, not motion to integrate
+#define NNM_PAN_TILT_INTEGRAL_MAX   1.0         // one second at an offset of half a frame
+
+/**
+ * @brief state of one axis
+ */
+typedef struct {
+    NNM_PAN_TILT_PID_T gains;
+    double angle;
+    double integral;
+    double prev_error;
+} NNM_PAN_TILT_AXIS_T;
+
+static pca9685_t *_pca9685 = NULL;
+static NNM_PAN_TILT_CONFIG_T _config;
+static NNM_PAN_TILT_AXIS_T _pan;
+static NNM_PAN_TILT_AXIS_T _tilt;
+
+/* the target of the last result, nearest box of the class is kept while it is tracked */
+static bool _tracking = false;
+static double _target_x = 0;
+static double _target_y = 0;
+static int _lost_count = 0;
+static uint64_t _last_step_ns = 0;
+
+static pthread_mutex_t _mutex_stats = PTHREAD_MUTEX_INITIALIZER;
+static NNM_PAN_TILT_STATS_T _stats;
+static double _latency_sum_ms = 0;
+static double _write_sum_ms = 0;
+
+uint64_t nnm_pan_tilt_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+static void reset_axis(NNM_PAN_TILT_AXIS_T *axis)
+{
+    axis->integral = 0;
+    axis->prev_error = 0;
+}
+
+/**
+ * One PID step, error is the target offset from the center in half frames (-1 to 1).
+ * The output is a rate, the angle moves by rate * dt.
+ */
+static void step_axis(NNM_PAN_TILT_AXIS_T *axis, double error, double dt, bool first)
+{
+    double derivative = 0;
+    double rate;
+
+    if (fabs(error) < _config.dead_zone)
+        error = 0;
+
+    axis->integral += error * dt;
+    if (axis->integral > NNM_PAN_TILT_INTEGRAL_MAX) axis->integral = NNM_PAN_TILT_INTEGRAL_MAX;
+    if (axis->integral < -NNM_PAN_TILT_INTEGRAL_MAX) axis->integral = -NNM_PAN_TILT_INTEGRAL_MAX;
+
+    if (false == first)
+        derivative = (error - axis->prev_error) / dt;
+    axis->prev_error = error;
+
+    rate = axis->gains.kp * error + axis->gains.ki * axis->integral + axis->gains.kd * derivative;
+    if (axis->gains.invert)
+        rate = -rate;
+
+    axis->angle += rate * dt;
+    if (axis->angle < 0) axis->angle = 0;
+    if (axis->angle > _config.max_angle) axis->angle = _config.max_angle;
+}
+
+static double angle_to_pulse_us(double angle)
+{
+    return _config.min_pulse_us + angle * (_config.max_pulse_us - _config.min_pulse_us) / _config.max_angle;
+}
+
+/* box of the target class nearest to the last target, or the best scored one when nothing is tracked */
+static const kp_bounding_box_t *select_target(const kp_bounding_box_t *boxes, uint32_t box_count)
+{
+    const kp_bounding_box_t *target = NULL;
+    double best = 0;
+
+    for (uint32_t i = 0; i < box_count; i++) {
+        const kp_bounding_box_t *box = &boxes[i];
+        double value;
+
+        if (_config.target_class >= 0 && box->class_num != _config.target_class)
+            continue;
+
+        if (true == _tracking) {
+            double dx = (box->x1 + box->x2) / 2 - _target_x;
+            double dy = (box->y1 + box->y2) / 2 - _target_y;
+            value = -(dx * dx + dy * dy);
+        } else {
+            value = box->score;
+        }
+
+        if (NULL == target || value > best) {
+            target = box;
+            best = value;
+        }
+    }
+
+    return target;
+}
+
+int nnm_pan_tilt_open(const NNM_PAN_TILT_CONFIG_T *config)
+{
+    if (NULL != _pca9685) {
+        printf("[%s] Error: pan/tilt is already open\n", __FUNCTION__);
+        return -1;
+    }
+    if (config->frame_width <= 0 || config->frame_height <= 0 || config->max_angle <= 0) {
+        printf("[%s] Error: invalid frame %dx%d or max angle %.1f\n", __FUNCTION__, config->frame_width, config->frame_height, config->max_angle);
+        return -1;
+    }
+
+    _config = *config;
+
+    // servo frame rate, 20ms
+    _pca9685 = pca9685_open(config->i2c_bus, config->i2c_addr, 50);
+    if (NULL == _pca9685) {
+        printf("[%s] Error: open PCA9685 0x%02x on /dev/i2c-%d failed\n", __FUNCTION__, config->i2c_addr, config->i2c_bus);
+        return -1;
+    }
+
+    memset(&_pan, 0, sizeof(_pan));
+    memset(&_tilt, 0, sizeof(_tilt));
+    _pan.gains = config->pan;
+    _tilt.gains = config->tilt;
+    _pan.angle = _tilt.angle = config->max_angle / 2;
+
+    _tracking = false;
+    _lost_count = 0;
+    _last_step_ns = 0;
+
+    memset(&_stats, 0, sizeof(_stats));
+    _latency_sum_ms = _write_sum_ms = 0;
+    _stats.pan = _pan.angle;
+    _stats.tilt = _tilt.angle;
+
+    pca9685_set_pulse_us(_pca9685, config->pan_channel, angle_to_pulse_us(_pan.angle));
+    pca9685_set_pulse_us(_pca9685, config->tilt_channel, angle_to_pulse_us(_tilt.angle));
+    if (0 != pca9685_flush(_pca9685)) {
+        nnm_pan_tilt_close();
+        return -1;
+    }
+
+    printf("[%s] pan channel %d, tilt channel %d, target class %d\n", __FUNCTION__, config->pan_channel, config->tilt_channel, config->target_class);
+
+    return 0;
+}
+
+void nnm_pan_tilt_update(const kp_bounding_box_t *boxes, uint32_t box_count, uint64_t dequeue_ns)
+{
+    const kp_bounding_box_t *target;
+    pca9685_stats_t pca_stats;
+    unsigned long flushes;
+    uint64_t write_start_ns, now_ns;
+    double dt;
+    bool first;
+
+    if (NULL == _pca9685)
+        return;
+
+    pthread_mutex_lock(&_mutex_stats);
+    _stats.results++;
+    pthread_mutex_unlock(&_mutex_stats);
+
+    target = select_target(boxes, box_count);
+    if (NULL == target) {
+        // hold the servos, forget the target after a while
+        if (true == _tracking && ++_lost_count >= _config.lost_results) {
+            _tracking = false;
+            reset_axis(&_pan);
+            reset_axis(&_tilt);
+        }
+        return;
+    }
+
+    first = (false == _tracking);
+    dt = first ? NNM_PAN_TILT_DT_DEFAULT : (dequeue_ns - _last_step_ns) / 1000000000.0;
+    if (dt <= 0 || dt > NNM_PAN_TILT_DT_MAX)
+        dt = NNM_PAN_TILT_DT_MAX;
+
+    _target_x = (target->x1 + target->x2) / 2;
+    _target_y = (target->y1 + target->y2) / 2;
+    _tracking = true;
+    _lost_count = 0;
+    _last_step_ns = dequeue_ns;
+
+    step_axis(&_pan, (_target_x - _config.frame_width / 2.0) / (_config.frame_width / 2.0), dt, first);
+    step_axis(&_tilt, (_target_y - _config.frame_height / 2.0) / (_config.frame_height / 2.0), dt, first);
+
+    // both channels in one transaction, nothing is sent when the pulses did not change
+    pca9685_get_stats(_pca9685, &pca_stats);
+    flushes = pca_stats.flushes;
+    write_start_ns = nnm_pan_tilt_now_ns();
+
+    pca9685_set_pulse_us(_pca9685, _config.pan_channel, angle_to_pulse_us(_pan.angle));
+    pca9685_set_pulse_us(_pca9685, _config.tilt_channel, angle_to_pulse_us(_tilt.angle));
+    pca9685_flush(_pca9685);
+
+    now_ns = nnm_pan_tilt_now_ns();
+    pca9685_get_stats(_pca9685, &pca_stats);
+
+    pthread_mutex_lock(&_mutex_stats);
+    _stats.tracked++;
+    _stats.pan = _pan.angle;
+    _stats.tilt = _tilt.angle;
+    if (pca_stats.flushes != flushes) {
+        double latency_ms = (now_ns - dequeue_ns) / 1000000.0;
+        double write_ms = (now_ns - write_start_ns) / 1000000.0;
+
+        _stats.updates++;
+        _latency_sum_ms += latency_ms;
+        _write_sum_ms += write_ms;
+        _stats.latency_avg_ms = _latency_sum_ms / _stats.updates;
+        _stats.write_avg_ms = _write_sum_ms / _stats.updates;
+        if (latency_ms > _stats.latency_max_ms)
+            _stats.latency_max_ms = latency_ms;
+        if (write_ms > _stats.write_max_ms)
+            _stats.write_max_ms = write_ms;
+    }
+    pthread_mutex_unlock(&_mutex_stats);
+}
+
+void nnm_pan_tilt_get_stats(NNM_PAN_TILT_STATS_T *stats)
+{
+    pthread_mutex_lock(&_mutex_stats);
+    *stats = _stats;
+    pthread_mutex_unlock(&_mutex_stats);
+}
+
+void nnm_pan_tilt_close(void)
+{
+    if (NULL != _pca9685) {
+        pca9685_close(_pca9685);
+        _pca9685 = NULL;
+    }
+}
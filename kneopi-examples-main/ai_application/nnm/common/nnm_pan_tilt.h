@@ -0,0 +1,109 @@
+/**
+ * @file        nnm_pan_tilt.h
+ * @brief       Pan/tilt tracking for NNM examples
+ *
+ * Steers two servos on a PCA9685 (peripherals/C/pca9685) so the tracked detection stays in the middle of the
+ * frame. Every dequeued result runs one PID step per axis on the normalized offset of the target from the frame
+ * center; the output is an angular rate, so the gains do not depend on the inference rate. Both servos are
+ * written in one I2C transaction and the latency from result dequeue to the end of that write is measured.
+ *
+ * @version     0.1
+ * @date        2021-03-22
+ *
+ * @copyright   Copyright (c) 2021 Kneron Inc. All rights reserved.
+ */
+
+#ifndef __NNM_PAN_TILT_H
+#define __NNM_PAN_TILT_H
+
+#include <stdint.h>
+
+#include "kp_struct.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief PID gains of one axis, the output is in degrees per second for an offset of half a frame
+ */
+typedef struct {
+    double kp;
+    double ki;
+    double kd;
+    int invert;                             //! 1 when the servo turns the camera the other way
+} NNM_PAN_TILT_PID_T;
+
+/**
+ * @brief describe the pan/tilt unit
+ */
+typedef struct {
+    int i2c_bus;                            //! /dev/i2c-<bus> of the PCA9685
+    int i2c_addr;                           //! e.g. 0x40
+    int pan_channel;                        //! PCA9685 channel of the pan servo
+    int tilt_channel;                       //! PCA9685 channel of the tilt servo
+    double min_pulse_us;                    //! pulse at 0 degrees
+    double max_pulse_us;                    //! pulse at max_angle
+    double max_angle;                       //! degrees, both servos start in the middle
+    NNM_PAN_TILT_PID_T pan;
+    NNM_PAN_TILT_PID_T tilt;
+    double dead_zone;                       //! offset from the center ignored, fraction of half a frame
+    int target_class;                       //! class of the tracked detections, -1 for any class
+    int lost_results;                       //! results without a target before the integrators are reset
+    int frame_width;                        //! frame the boxes are in
+    int frame_height;
+} NNM_PAN_TILT_CONFIG_T;
+
+/**
+ * @brief statistics of the control loop
+ */
+typedef struct {
+    uint32_t results;                       //! results passed to nnm_pan_tilt_update()
+    uint32_t tracked;                       //! results with a target
+    uint32_t updates;                       //! PWM updates sent
+    double pan;                             //! current angles
+    double tilt;
+    double latency_avg_ms;                  //! result dequeue to PWM update written
+    double latency_max_ms;
+    double write_avg_ms;                    //! I2C write of one PWM update
+    double write_max_ms;
+} NNM_PAN_TILT_STATS_T;
+
+/**
+ * @brief open the PCA9685, center the servos and reset the controllers.
+ *
+ * @param[in] config the pan/tilt unit.
+ *
+ * @return 0 means sucessful, otherwise failed.
+ */
+int nnm_pan_tilt_open(const NNM_PAN_TILT_CONFIG_T *config);
+
+/**
+ * @brief run one control step for a result and write the servos when their pulse changes.
+ *
+ * @param[in] boxes detections of the result, in the frame of the config.
+ * @param[in] box_count number of detections.
+ * @param[in] dequeue_ns nnm_pan_tilt_now_ns() when the result was dequeued.
+ */
+void nnm_pan_tilt_update(const kp_bounding_box_t *boxes, uint32_t box_count, uint64_t dequeue_ns);
+
+/**
+ * @brief current time on the clock of dequeue_ns.
+ */
+uint64_t nnm_pan_tilt_now_ns(void);
+
+/**
+ * @brief get the statistics since nnm_pan_tilt_open().
+ */
+void nnm_pan_tilt_get_stats(NNM_PAN_TILT_STATS_T *stats);
+
+/**
+ * @brief turn the servos off and close the PCA9685.
+ */
+void nnm_pan_tilt_close(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __NNM_PAN_TILT_H
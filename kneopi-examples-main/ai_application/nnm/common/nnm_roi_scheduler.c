@@ -0,0 +1,281 @@
+/**
+ * @file        nnm_roi_scheduler.c
+ * @brief       Region of interest scheduling from the previous detections
+ * @version     0.1
+ * @date        2021-03-22
+ *
+ * @copyright   Copyright (c) 2021 Kneron Inc. All rights reserved.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "nnm_roi_scheduler.h"
+
+#define NNM_ROI_MATCH_IOU       0.5f        //! a box of the crops and a box of the full frame are the same object
+
+static pthread_mutex_t _mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static NNM_ROI_SCHEDULER_CONFIG_T _config;
+static NNM_ROI_STATS_T _stats;
+static kp_bounding_box_t _boxes[NNM_ROI_BOX_MAX];  //! the latest result
+static uint32_t _box_count = 0;
+static bool _boxes_from_crops = false;
+static unsigned int _since_full = 0;
+static double _crops_sum = 0;
+static double _pixels_sum = 0;
+static double _full_sum_ms = 0;
+static double _roi_sum_ms = 0;
+static uint32_t _full_results = 0;
+static uint32_t _roi_results = 0;
+static uint32_t _ref_matched = 0;
+static uint32_t _roi_matched = 0;
+
+static int32_t clamp(int32_t value, int32_t low, int32_t high)
+{
+    return (value < low) ? low : ((value > high) ? high : value);
+}
+
+/* grow a box by the expand fraction and to the smallest crop, keep it in the frame with an even start and size */
+static void box_to_roi(const kp_bounding_box_t *box, NNM_ROI_T *roi)
+{
+    float width = box->x2 - box->x1;
+    float height = box->y2 - box->y1;
+    float center_x = (box->x1 + box->x2) / 2;
+    float center_y = (box->y1 + box->y2) / 2;
+
+    width += 2 * width * _config.expand;
+    height += 2 * height * _config.expand;
+    if (width < _config.min_size)
+        width = _config.min_size;
+    if (height < _config.min_size)
+        height = _config.min_size;
+
+    int32_t x1 = clamp((int32_t)(center_x - width / 2), 0, _config.frame_width) & ~1;
+    int32_t y1 = clamp((int32_t)(center_y - height / 2), 0, _config.frame_height) & ~1;
+    int32_t x2 = clamp((int32_t)(center_x + width / 2 + 1), 0, _config.frame_width) & ~1;
+    int32_t y2 = clamp((int32_t)(center_y + height / 2 + 1), 0, _config.frame_height) & ~1;
+
+    roi->x = x1;
+    roi->y = y1;
+    roi->width = x2 - x1;
+    roi->height = y2 - y1;
+}
+
+static bool roi_overlap(const NNM_ROI_T *a, const NNM_ROI_T *b)
+{
+    return (a->x < b->x + b->width) && (b->x < a->x + a->width) &&
+           (a->y < b->y + b->height) && (b->y < a->y + a->height);
+}
+
+static void roi_union(NNM_ROI_T *a, const NNM_ROI_T *b)
+{
+    int32_t x2 = (a->x + a->width > b->x + b->width) ? a->x + a->width : b->x + b->width;
+    int32_t y2 = (a->y + a->height > b->y + b->height) ? a->y + a->height : b->y + b->height;
+
+    a->x = (a->x < b->x) ? a->x : b->x;
+    a->y = (a->y < b->y) ? a->y : b->y;
+    a->width = x2 - a->x;
+    a->height = y2 - a->y;
+}
+
+/* crops around the latest boxes, an overlap of two crops becomes their union so no object is inferred twice */
+static uint32_t build_rois(NNM_ROI_T *rois)
+{
+    NNM_ROI_T box_rois[NNM_ROI_BOX_MAX];
+    uint32_t count = 0;
+    bool merged = true;
+
+    // a box out of the frame leaves an empty crop
+    for (uint32_t i = 0; i < _box_count; i++) {
+        box_to_roi(&_boxes[i], &box_rois[count]);
+        if ((0 < box_rois[count].width) && (0 < box_rois[count].height))
+            count++;
+    }
+
+    // a union may reach a crop it did not overlap before, merge until nothing overlaps
+    while (true == merged) {
+        merged = false;
+
+        for (uint32_t i = 0; i < count; i++) {
+            for (uint32_t j = i + 1; j < count; j++) {
+                if (false == roi_overlap(&box_rois[i], &box_rois[j]))
+                    continue;
+
+                roi_union(&box_rois[i], &box_rois[j]);
+                box_rois[j] = box_rois[--count];
+                merged = true;
+                j = i;
+            }
+        }
+    }
+
+    if (count <= _config.max_rois)
+        memcpy(rois, box_rois, count * sizeof(NNM_ROI_T));
+
+    return count;
+}
+
+static float box_iou(const kp_bounding_box_t *a, const kp_bounding_box_t *b)
+{
+    float width = ((a->x2 < b->x2) ? a->x2 : b->x2) - ((a->x1 > b->x1) ? a->x1 : b->x1);
+    float height = ((a->y2 < b->y2) ? a->y2 : b->y2) - ((a->y1 > b->y1) ? a->y1 : b->y1);
+    float inter, area;
+
+    if ((0 >= width) || (0 >= height))
+        return 0;
+
+    inter = width * height;
+    area = (a->x2 - a->x1) * (a->y2 - a->y1) + (b->x2 - b->x1) * (b->y2 - b->y1) - inter;
+
+    return (0 < area) ? inter / area : 0;
+}
+
+/* greedy match of the full frame boxes with the boxes of the crops before them, same class and enough overlap */
+static uint32_t match_boxes(const kp_bounding_box_t *boxes, uint32_t box_count)
+{
+    bool used[NNM_ROI_BOX_MAX] = {false};
+    uint32_t matched = 0;
+
+    for (uint32_t i = 0; i < box_count; i++) {
+        int best = -1;
+        float best_iou = NNM_ROI_MATCH_IOU;
+
+        for (uint32_t j = 0; j < _box_count; j++) {
+            float iou;
+
+            if ((true == used[j]) || (boxes[i].class_num != _boxes[j].class_num))
+                continue;
+
+            iou = box_iou(&boxes[i], &_boxes[j]);
+            if (iou >= best_iou) {
+                best_iou = iou;
+                best = (int)j;
+            }
+        }
+
+        if (0 <= best) {
+            used[best] = true;
+            matched++;
+        }
+    }
+
+    return matched;
+}
+
+int nnm_roi_scheduler_open(const NNM_ROI_SCHEDULER_CONFIG_T *config)
+{
+    if ((0 == config->frame_width) || (0 == config->frame_height) || (0 == config->refresh_frames) ||
+        (0 > config->expand) || (0 == config->max_rois) || (NNM_ROI_MAX < config->max_rois)) {
+        printf("[%s] Error: invalid scheduler of %ux%u, refresh %u, at most %u crops (%d)\n", __func__,
+               config->frame_width, config->frame_height, config->refresh_frames, config->max_rois, NNM_ROI_MAX);
+        return -1;
+    }
+
+    pthread_mutex_lock(&_mutex);
+
+    _config = *config;
+    memset(&_stats, 0, sizeof(_stats));
+    _box_count = 0;
+    _boxes_from_crops = false;
+    _since_full = 0;
+    _crops_sum = _pixels_sum = _full_sum_ms = _roi_sum_ms = 0;
+    _full_results = _roi_results = _ref_matched = _roi_matched = 0;
+
+    pthread_mutex_unlock(&_mutex);
+
+    printf("[%s] %ux%u, full frame every %u frames, expand %.2f, crops of at least %u pixels, at most %u\n", __func__,
+           _config.frame_width, _config.frame_height, _config.refresh_frames, _config.expand, _config.min_size, _config.max_rois);
+
+    return 0;
+}
+
+void nnm_roi_scheduler_plan(NNM_ROI_PLAN_T *plan)
+{
+    uint32_t count = 0;
+
+    memset(plan, 0, sizeof(NNM_ROI_PLAN_T));
+
+    pthread_mutex_lock(&_mutex);
+
+    _stats.frames++;
+    _since_full++;
+
+    if ((1 == _stats.frames) || (_since_full >= _config.refresh_frames)) {
+        plan->full_frame = true;
+    } else {
+        count = (0 < _box_count) ? build_rois(plan->rois) : 0;
+
+        // nothing to track, or more crops than a frame may take and the full frame costs less
+        if ((0 == count) || (count > _config.max_rois)) {
+            plan->full_frame = true;
+            _stats.forced_full++;
+        }
+    }
+
+    if (true == plan->full_frame) {
+        _stats.full_frames++;
+        _since_full = 0;
+        _pixels_sum += 1.0;
+    } else {
+        double pixels = 0;
+
+        plan->roi_count = count;
+        for (uint32_t i = 0; i < count; i++)
+            pixels += (double)plan->rois[i].width * plan->rois[i].height;
+
+        _stats.roi_frames++;
+        _crops_sum += count;
+        _stats.crops_avg = _crops_sum / _stats.roi_frames;
+        _pixels_sum += pixels / ((double)_config.frame_width * _config.frame_height);
+    }
+
+    _stats.pixel_ratio = _pixels_sum / _stats.frames;
+
+    pthread_mutex_unlock(&_mutex);
+}
+
+void nnm_roi_scheduler_update(const kp_bounding_box_t *boxes, uint32_t box_count, bool full_frame, uint32_t inf_time_us)
+{
+    if (NNM_ROI_BOX_MAX < box_count)
+        box_count = NNM_ROI_BOX_MAX;
+
+    pthread_mutex_lock(&_mutex);
+
+    if (true == full_frame) {
+        // the full frame is the reference of the crops just before it
+        if (true == _boxes_from_crops) {
+            uint32_t matched = match_boxes(boxes, box_count);
+
+            _stats.checks++;
+            _stats.ref_boxes += box_count;
+            _stats.roi_boxes += _box_count;
+            _ref_matched += matched;
+            _roi_matched += matched;
+            _stats.recall = (0 < _stats.ref_boxes) ? (double)_ref_matched / _stats.ref_boxes : 1.0;
+            _stats.precision = (0 < _stats.roi_boxes) ? (double)_roi_matched / _stats.roi_boxes : 1.0;
+        }
+
+        _full_results++;
+        _full_sum_ms += inf_time_us / 1000.0;
+        _stats.full_ms = _full_sum_ms / _full_results;
+    } else {
+        _roi_results++;
+        _roi_sum_ms += inf_time_us / 1000.0;
+        _stats.roi_ms = _roi_sum_ms / _roi_results;
+    }
+
+    memcpy(_boxes, boxes, box_count * sizeof(kp_bounding_box_t));
+    _box_count = box_count;
+    _boxes_from_crops = !full_frame;
+
+    pthread_mutex_unlock(&_mutex);
+}
+
+void nnm_roi_scheduler_get_stats(NNM_ROI_STATS_T *stats)
+{
+    pthread_mutex_lock(&_mutex);
+    *stats = _stats;
+    pthread_mutex_unlock(&_mutex);
+}
@@ -0,0 +1,117 @@
+/**
+ * @file        nnm_roi_scheduler.h
+ * @brief       Region of interest scheduling from the previous detections
+ *
+ * Objects move little between two frames, so most frames only need the model around the boxes of the latest
+ * result. The boxes are expanded, overlapping ones are merged into one crop, and the frame is submitted with
+ * these crops only. A full frame pass every refresh_frames frames, or when there is nothing to track, finds the
+ * new objects. At each full pass after crops the boxes of the full pass are matched with the boxes of the last
+ * crops, which gives the recall and the precision of the crops against the full frame.
+ *
+ * @version     0.1
+ * @date        2021-03-22
+ *
+ * @copyright   Copyright (c) 2021 Kneron Inc. All rights reserved.
+ */
+
+#ifndef __NNM_ROI_SCHEDULER_H
+#define __NNM_ROI_SCHEDULER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "kp_struct.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define NNM_ROI_MAX             16          //! crops of a frame
+#define NNM_ROI_BOX_MAX         200         //! boxes of a result kept to plan the next frame
+
+/**
+ * @brief a crop in frame pixels, the start and the size are even for the YUV420 chroma planes
+ */
+typedef struct {
+    int32_t x;
+    int32_t y;
+    int32_t width;
+    int32_t height;
+} NNM_ROI_T;
+
+/**
+ * @brief describe the scheduler
+ */
+typedef struct {
+    unsigned int frame_width;
+    unsigned int frame_height;
+    unsigned int refresh_frames;            //! a full frame pass every this many frames, 1: every frame
+    float expand;                           //! a box grows by this fraction of its size on each side
+    unsigned int min_size;                  //! smallest side of a crop
+    unsigned int max_rois;                  //! more crops than this and the full frame pass runs instead
+} NNM_ROI_SCHEDULER_CONFIG_T;
+
+/**
+ * @brief what to infer on the next frame
+ */
+typedef struct {
+    bool full_frame;
+    uint32_t roi_count;                     //! 0 with a full frame pass
+    NNM_ROI_T rois[NNM_ROI_MAX];
+} NNM_ROI_PLAN_T;
+
+/**
+ * @brief counters since nnm_roi_scheduler_open()
+ */
+typedef struct {
+    uint32_t frames;                        //! planned frames
+    uint32_t full_frames;                   //! full frame passes
+    uint32_t forced_full;                   //! full frame passes before the refresh, no boxes or too many crops
+    uint32_t roi_frames;                    //! frames with crops only
+    double crops_avg;                       //! crops of a frame with crops
+    double pixel_ratio;                     //! frame pixels cropped over the pixels of full frames, all frames
+    uint32_t checks;                        //! full frame passes right after crops
+    uint32_t ref_boxes;                     //! boxes of these full frame passes
+    uint32_t roi_boxes;                     //! boxes of the crops before them
+    double recall;                          //! boxes of the full frame also found in the crops
+    double precision;                       //! boxes of the crops also found in the full frame
+    double full_ms;                         //! device time of a full frame pass
+    double roi_ms;                          //! device time of a frame with crops
+} NNM_ROI_STATS_T;
+
+/**
+ * @brief reset the scheduler, the first frame is a full frame pass.
+ *
+ * @param[in] config the scheduler.
+ *
+ * @return 0 means sucessful, otherwise failed.
+ */
+int nnm_roi_scheduler_open(const NNM_ROI_SCHEDULER_CONFIG_T *config);
+
+/**
+ * @brief plan the next submitted frame from the latest result.
+ *
+ * @param[out] plan full frame or the crops.
+ */
+void nnm_roi_scheduler_plan(NNM_ROI_PLAN_T *plan);
+
+/**
+ * @brief record a result, may be called from another thread than the plans.
+ *
+ * @param[in] boxes the boxes in frame coordinates.
+ * @param[in] box_count number of boxes.
+ * @param[in] full_frame the result of a full frame pass.
+ * @param[in] inf_time_us device time of the frame.
+ */
+void nnm_roi_scheduler_update(const kp_bounding_box_t *boxes, uint32_t box_count, bool full_frame, uint32_t inf_time_us);
+
+/**
+ * @brief get the counters since nnm_roi_scheduler_open().
+ */
+void nnm_roi_scheduler_get_stats(NNM_ROI_STATS_T *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __NNM_ROI_SCHEDULER_H
@@ -0,0 +1,324 @@
+/**
+ * @file        nnm_spi_lcd.c
+ * @brief       SPI LCD preview sink for NNM examples
+ * @version     0.1
+ * @date        2021-03-22
+ *
+ * @copyright   Copyright (c) 2021 Kneron Inc. All rights reserved.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <sys/time.h>
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#include "DEV_Config.h"
+#include "LCD_1in3.h"
+#include "LCD_1in54.h"
+#include "GUI_Paint.h"
+#include "GUI_Flush.h"
+
+#include "nnm_spi_lcd.h"
+
+#define NNM_SPI_LCD_WIDTH       240
+#define NNM_SPI_LCD_HEIGHT      240
+#define NNM_SPI_LCD_TEXT_Y      4           // first text line, the next one is Font12.Height + 4 below
+
+/**
+ * @brief describe one supported panel
+ */
+typedef struct {
+    double size;
+    void (*init)(UBYTE scan_dir);
+    PAINT_DISPLAY_WINDOWS display_windows;
+} NNM_SPI_LCD_PANEL_T;
+
+static const NNM_SPI_LCD_PANEL_T _panels[] = {
+    {1.3,   LCD_1IN3_Init,  LCD_1IN3_DisplayWindows},
+    {1.54,  LCD_1IN54_Init, LCD_1IN54_DisplayWindows},
+};
+
+static UWORD *_image[2] = {NULL, NULL};
+static bool _opened = false;
+
+/* video area on the panel and the source column of each of its pixels, updated when the frame size changes */
+static int _src_width = 0;
+static int _src_height = 0;
+static int _dst_x = 0;
+static int _dst_y = 0;
+static int _dst_width = 0;
+static int _dst_height = 0;
+static uint16_t _src_x[NNM_SPI_LCD_WIDTH];
+
+static uint8_t _row_y[NNM_SPI_LCD_WIDTH];
+static uint8_t _row_u[NNM_SPI_LCD_WIDTH];
+static uint8_t _row_v[NNM_SPI_LCD_WIDTH];
+
+static double _convert_ms = 0;
+
+static double get_time_ms(void)
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec * 1000.0 + tv.tv_usec / 1000.0;
+}
+
+static inline uint8_t clamp_u8(int value)
+{
+    return (value < 0) ? 0 : ((value > 255) ? 255 : value);
+}
+
+/**
+ * BT.601 limited range YUV to RGB565 in Q6 fixed point, the same math as the NEON path. Pixels are stored
+ * big endian, which is the byte order the panel expects and the one GUI_Paint keeps in its image.
+ */
+static void yuv_row_to_rgb565(const uint8_t *y, const uint8_t *u, const uint8_t *v, uint16_t *dst, int count)
+{
+    int i = 0;
+
+#if defined(__ARM_NEON)
+    const int16x8_t c16 = vdupq_n_s16(16);
+    const int16x8_t c128 = vdupq_n_s16(128);
+    const uint8_t mask_rb = 0xF8;
+    const uint8_t mask_g = 0xE0;
+
+    for (; i + 8 <= count; i += 8) {
+        int16x8_t yy = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vld1_u8(y + i))), c16);
+        int16x8_t uu = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vld1_u8(u + i))), c128);
+        int16x8_t vv = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vld1_u8(v + i))), c128);
+        int16x8_t yl = vmulq_n_s16(yy, 74);
+
+        //! saturating adds, values out of int16 range are clamped to 0 or 255 by vqrshrun anyway
+        uint8x8_t r = vqrshrun_n_s16(vqaddq_s16(yl, vmulq_n_s16(vv, 102)), 6);
+        uint8x8_t g = vqrshrun_n_s16(vqsubq_s16(yl, vaddq_s16(vmulq_n_s16(vv, 52), vmulq_n_s16(uu, 25))), 6);
+        uint8x8_t b = vqrshrun_n_s16(vqaddq_s16(yl, vmulq_n_s16(uu, 129)), 6);
+
+        //! high byte RRRRRGGG, low byte GGGBBBBB, interleaved store writes them in panel order
+        uint8x8x2_t px;
+        px.val[0] = vorr_u8(vand_u8(r, vdup_n_u8(mask_rb)), vshr_n_u8(g, 5));
+        px.val[1] = vorr_u8(vand_u8(vshl_n_u8(g, 3), vdup_n_u8(mask_g)), vshr_n_u8(b, 3));
+        vst2_u8((uint8_t *)(dst + i), px);
+    }
+#endif
+
+    for (; i < count; i++) {
+        int yl = (y[i] - 16) * 74;
+        int uu = u[i] - 128;
+        int vv = v[i] - 128;
+        uint8_t r = clamp_u8((yl + 102 * vv + 32) >> 6);
+        uint8_t g = clamp_u8((yl - 52 * vv - 25 * uu + 32) >> 6);
+        uint8_t b = clamp_u8((yl + 129 * uu + 32) >> 6);
+        uint8_t *out = (uint8_t *)(dst + i);
+
+        out[0] = (r & 0xF8) | (g >> 5);
+        out[1] = ((g << 3) & 0xE0) | (b >> 3);
+    }
+}
+
+/**
+ * Fit the frame into the panel keeping its aspect ratio, the video area is centered and the rest is black.
+ */
+static void setup_video_area(int width, int height)
+{
+    if (width * NNM_SPI_LCD_HEIGHT >= height * NNM_SPI_LCD_WIDTH) {
+        _dst_width = NNM_SPI_LCD_WIDTH;
+        _dst_height = height * NNM_SPI_LCD_WIDTH / width;
+    } else {
+        _dst_width = width * NNM_SPI_LCD_HEIGHT / height;
+        _dst_height = NNM_SPI_LCD_HEIGHT;
+    }
+    if (_dst_width < 1)
+        _dst_width = 1;
+    if (_dst_height < 1)
+        _dst_height = 1;
+
+    _dst_x = (NNM_SPI_LCD_WIDTH - _dst_width) / 2;
+    _dst_y = (NNM_SPI_LCD_HEIGHT - _dst_height) / 2;
+
+    //! sample at the center of each destination pixel, even column so U and V belong to the same pixel pair
+    for (int x = 0; x < _dst_width; x++)
+        _src_x[x] = (uint16_t)((((2 * x + 1) * width) / (2 * _dst_width)) & ~1);
+
+    _src_width = width;
+    _src_height = height;
+
+    Paint_Clear(BLACK);
+    printf("[NNM] spi lcd: %dx%d frame is shown at (%d, %d) %dx%d\n", width, height, _dst_x, _dst_y, _dst_width, _dst_height);
+}
+
+int nnm_spi_lcd_open(double size)
+{
+    const NNM_SPI_LCD_PANEL_T *panel = NULL;
+    UDOUBLE image_size = NNM_SPI_LCD_WIDTH * NNM_SPI_LCD_HEIGHT * 2;
+
+    if (_opened)
+        return 0;
+
+    for (size_t i = 0; i < sizeof(_panels) / sizeof(_panels[0]); i++) {
+        if (_panels[i].size == size)
+            panel = &_panels[i];
+    }
+    if (NULL == panel) {
+        printf("[NNM] spi lcd: %.2f inch panel is not supported, use 1.3 or 1.54\n", size);
+        return -1;
+    }
+
+    if (0 != DEV_ModuleInit()) {
+        printf("[NNM] spi lcd: DEV_ModuleInit failed\n");
+        DEV_ModuleExit();
+        return -1;
+    }
+    panel->init(HORIZONTAL);
+
+    _image[0] = (UWORD *)malloc(image_size);
+    _image[1] = (UWORD *)malloc(image_size);
+    if ((NULL == _image[0]) || (NULL == _image[1])) {
+        printf("[NNM] spi lcd: allocate image failed\n");
+        goto ERROR;
+    }
+
+    Paint_NewImage(_image[0], NNM_SPI_LCD_WIDTH, NNM_SPI_LCD_HEIGHT, ROTATE_0, BLACK, 16);
+    Paint_Clear(BLACK);
+    Paint_Flush(panel->display_windows);
+
+    if (0 != GUI_Flush_Init(_image[0], _image[1], panel->display_windows))
+        goto ERROR;
+
+    _src_width = 0;
+    _src_height = 0;
+    _convert_ms = 0;
+    _opened = true;
+    printf("[NNM] spi lcd: %.2f inch %dx%d, SPI transfer size %u\n", size, NNM_SPI_LCD_WIDTH, NNM_SPI_LCD_HEIGHT,
+           (unsigned)DEV_SPI_Get_Transfer_Size());
+
+    return 0;
+
+ERROR:
+    free(_image[0]);
+    free(_image[1]);
+    _image[0] = _image[1] = NULL;
+    DEV_ModuleExit();
+    return -1;
+}
+
+void nnm_spi_lcd_draw_yuv420(const uint8_t *yuv, int width, int height)
+{
+    if (!_opened || (NULL == yuv) || (width < 2) || (height < 2))
+        return;
+
+    double start = get_time_ms();
+
+    if ((width != _src_width) || (height != _src_height))
+        setup_video_area(width, height);
+
+    const uint8_t *plane_u = yuv + width * height;
+    const uint8_t *plane_v = plane_u + (width / 2) * (height / 2);
+
+    for (int y = 0; y < _dst_height; y++) {
+        int sy = ((2 * y + 1) * height) / (2 * _dst_height);
+        const uint8_t *src_y = yuv + sy * width;
+        const uint8_t *src_u = plane_u + (sy / 2) * (width / 2);
+        const uint8_t *src_v = plane_v + (sy / 2) * (width / 2);
+
+        //! gather the sampled row, then convert it straight into the Paint image
+        for (int x = 0; x < _dst_width; x++) {
+            int sx = _src_x[x];
+            _row_y[x] = src_y[sx];
+            _row_u[x] = src_u[sx >> 1];
+            _row_v[x] = src_v[sx >> 1];
+        }
+        yuv_row_to_rgb565(_row_y, _row_u, _row_v, Paint.Image + (_dst_y + y) * Paint.WidthByte + _dst_x, _dst_width);
+    }
+
+    Paint_SetDirty(_dst_x, _dst_y, _dst_x + _dst_width, _dst_y + _dst_height);
+    _convert_ms += get_time_ms() - start;
+}
+
+void nnm_spi_lcd_draw_box(int x1, int y1, int x2, int y2, uint16_t color)
+{
+    if (!_opened || (0 == _src_width))
+        return;
+
+    int right = _dst_x + _dst_width - 1;
+    int bottom = _dst_y + _dst_height - 1;
+
+    x1 = _dst_x + x1 * _dst_width / _src_width;
+    x2 = _dst_x + x2 * _dst_width / _src_width;
+    y1 = _dst_y + y1 * _dst_height / _src_height;
+    y2 = _dst_y + y2 * _dst_height / _src_height;
+
+    x1 = (x1 < _dst_x) ? _dst_x : ((x1 > right) ? right : x1);
+    x2 = (x2 < _dst_x) ? _dst_x : ((x2 > right) ? right : x2);
+    y1 = (y1 < _dst_y) ? _dst_y : ((y1 > bottom) ? bottom : y1);
+    y2 = (y2 < _dst_y) ? _dst_y : ((y2 > bottom) ? bottom : y2);
+
+    if ((x2 <= x1) || (y2 <= y1))
+        return;
+
+    Paint_DrawRectangle(x1, y1, x2, y2, color, DOT_PIXEL_1X1, DRAW_FILL_EMPTY);
+}
+
+void nnm_spi_lcd_draw_text(int line, const char *text)
+{
+    if (!_opened || (NULL == text) || (line < 0) || (line > 1))
+        return;
+
+    UWORD y = NNM_SPI_LCD_TEXT_Y + line * (Font12.Height + 4);
+    size_t max_len = (NNM_SPI_LCD_WIDTH - 2) / Font12.Width;
+    char str[NNM_SPI_LCD_WIDTH / 4];
+
+    snprintf(str, sizeof(str), "%.*s", (int)max_len, text);
+
+    //! glyphs are drawn opaque and only the rest of the line is cleared, unchanged pixels are not sent again.
+    //! Paint_DrawString_EN() sets the glyph pixels to its last color argument.
+    Paint_DrawString_EN(2, y, str, &Font12, BLACK, NNM_SPI_LCD_WHITE);
+    Paint_ClearWindow(2 + strlen(str) * Font12.Width, y, NNM_SPI_LCD_WIDTH, y + Font12.Height, BLACK);
+}
+
+void nnm_spi_lcd_submit(void)
+{
+    if (!_opened)
+        return;
+
+    GUI_Flush_Submit();
+}
+
+void nnm_spi_lcd_get_stats(NNM_SPI_LCD_STATS_T *stats)
+{
+    GUI_FLUSH_STATS flush_stats;
+
+    GUI_Flush_GetStats(&flush_stats);
+    stats->frames = flush_stats.Frames;
+    stats->convert_ms = _convert_ms;
+    stats->transfer_ms = flush_stats.Transfer_ms;
+    stats->wait_ms = flush_stats.Wait_ms;
+    stats->elapsed_ms = flush_stats.Elapsed_ms;
+}
+
+void nnm_spi_lcd_close(void)
+{
+    NNM_SPI_LCD_STATS_T stats;
+
+    if (!_opened)
+        return;
+
+    GUI_Flush_Wait();
+    nnm_spi_lcd_get_stats(&stats);
+    if (stats.frames > 0) {
+        printf("[NNM] spi lcd: %u frames, %.2f fps, convert %.2f ms/frame, transfer %.2f ms/frame, waited %.2f ms/frame\n",
+               stats.frames, (stats.elapsed_ms > 0) ? stats.frames * 1000.0 / stats.elapsed_ms : 0.0,
+               stats.convert_ms / stats.frames, stats.transfer_ms / stats.frames, stats.wait_ms / stats.frames);
+    }
+    GUI_Flush_Exit();
+    DEV_ModuleExit();
+
+    free(_image[0]);
+    free(_image[1]);
+    _image[0] = _image[1] = NULL;
+    _opened = false;
+}
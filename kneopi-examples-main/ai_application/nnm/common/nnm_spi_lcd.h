@@ -0,0 +1,93 @@
+/**
+ * @file        nnm_spi_lcd.h
+ * @brief       SPI LCD preview sink for NNM examples
+ *
+ * Draws the YUV420 input frames and the inference results of an NNM example on a 240x240 Waveshare SPI LCD
+ * (peripherals/C/spi_display). Each frame is downscaled and converted to byte-swapped RGB565 in one pass straight
+ * into the GUI_Paint image, boxes and text are drawn with the Paint primitives and the frame is sent by the
+ * GUI_Flush thread, so the preview runs at the frame rate of the SPI bus without an OpenCV window.
+ *
+ * @version     0.1
+ * @date        2021-03-22
+ *
+ * @copyright   Copyright (c) 2021 Kneron Inc. All rights reserved.
+ */
+
+#ifndef __NNM_SPI_LCD_H
+#define __NNM_SPI_LCD_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* RGB565 colors, same values as GUI_Paint.h */
+#define NNM_SPI_LCD_WHITE       0xFFFF
+#define NNM_SPI_LCD_BLACK       0x0000
+#define NNM_SPI_LCD_RED         0xF800
+#define NNM_SPI_LCD_GREEN       0x07E0
+#define NNM_SPI_LCD_YELLOW      0xFFE0
+
+/**
+ * @brief statistics of the preview sink
+ */
+typedef struct {
+    uint32_t frames;                        //! submitted frames
+    double convert_ms;                      //! time of downscale + color conversion
+    double transfer_ms;                     //! time of SPI transfers
+    double wait_ms;                         //! time waiting for the previous frame to be sent
+    double elapsed_ms;                      //! from the first submit to the end of the last transfer
+} NNM_SPI_LCD_STATS_T;
+
+/**
+ * @brief initialize the SPI LCD, the Paint double buffer and the flush thread.
+ *
+ * @param[in] size panel size in inch, 1.3 or 1.54 (both 240x240).
+ *
+ * @return 0 means sucessful, otherwise failed.
+ */
+int nnm_spi_lcd_open(double size);
+
+/**
+ * @brief downscale a YUV420 (I420) frame into the video area of the panel, aspect ratio is kept.
+ *
+ * @param[in] yuv Y plane followed by the U and V planes.
+ * @param[in] width width of the frame, the stride of the Y plane.
+ * @param[in] height height of the frame.
+ */
+void nnm_spi_lcd_draw_yuv420(const uint8_t *yuv, int width, int height);
+
+/**
+ * @brief draw a box, coordinates are in the frame of the last nnm_spi_lcd_draw_yuv420().
+ */
+void nnm_spi_lcd_draw_box(int x1, int y1, int x2, int y2, uint16_t color);
+
+/**
+ * @brief draw a text line above the video area.
+ *
+ * @param[in] line line index, 0 or 1.
+ * @param[in] text text to draw.
+ */
+void nnm_spi_lcd_draw_text(int line, const char *text);
+
+/**
+ * @brief send the current frame in the background, only blocks while the previous frame is being sent.
+ */
+void nnm_spi_lcd_submit(void);
+
+/**
+ * @brief get the statistics since nnm_spi_lcd_open().
+ */
+void nnm_spi_lcd_get_stats(NNM_SPI_LCD_STATS_T *stats);
+
+/**
+ * @brief send the last frame, stop the flush thread and release the panel.
+ */
+void nnm_spi_lcd_close(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __NNM_SPI_LCD_H
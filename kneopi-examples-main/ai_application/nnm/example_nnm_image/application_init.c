@@ -17,6 +17,9 @@
 #include "demo_customize_inf_single_model.h"
 #include "demo_customize_inf_multiple_models.h"
 #include "demo_customize_inf_single_model_with_sw_npu_format_convert.h"
+#include "demo_customize_inf_raw_output.h"
+#include "demo_customize_inf_tiled.h"
+#include "user_post_mem_manager.h"
 
 static void _app_func(int num_input_buf, void** inf_input_buf_list);
 
@@ -47,6 +50,12 @@ void _app_func(int num_input_buf, void** inf_input_buf_list)
     case DEMO_KL730_CUSTOMIZE_INF_SINGLE_MODEL_WITH_SW_NPU_FORMAT_CONVERT_JOB_ID:
         demo_customize_inf_single_model_with_sw_npu_format_convert(job_id, num_input_buf, (void**)inf_input_buf_list);
         break;
+    case DEMO_KL730_CUSTOMIZE_INF_RAW_OUTPUT_JOB_ID:
+        demo_customize_inf_raw_output(job_id, num_input_buf, (void**)inf_input_buf_list);
+        break;
+    case DEMO_KL730_CUSTOMIZE_INF_TILED_JOB_ID:
+        demo_customize_inf_tiled(job_id, num_input_buf, (void**)inf_input_buf_list);
+        break;
     default:
         VMF_NNM_Fifoq_Manager_Status_Code_Enqueue(job_id, KP_FW_ERROR_UNKNOWN_APP);
         printf("unsupported job_id %d \n",job_id);
@@ -71,6 +80,12 @@ void _app_func_deinit(unsigned int job_id)
     case DEMO_KL730_CUSTOMIZE_INF_SINGLE_MODEL_WITH_SW_NPU_FORMAT_CONVERT_JOB_ID:
         demo_customize_inf_single_model_with_sw_npu_format_convert_deinit();
         break;
+    case DEMO_KL730_CUSTOMIZE_INF_RAW_OUTPUT_JOB_ID:
+        demo_customize_inf_raw_output_deinit();
+        break;
+    case DEMO_KL730_CUSTOMIZE_INF_TILED_JOB_ID:
+        demo_customize_inf_tiled_deinit();
+        break;
     default:
         printf("%s, unsupported job_id %d \n",__func__,job_id);
         break;
@@ -90,12 +105,23 @@ void app_initialize(void)
     return;
 }
 
+void app_set_parallel_inference(bool enable)
+{
+    demo_customize_inf_single_model_set_parallel(enable);
+    demo_customize_inf_single_model_with_sw_npu_format_convert_set_parallel(enable);
+}
+
 void app_destroy(void)
 {
     _app_func_deinit(KDP2_INF_ID_APP_YOLO);
     _app_func_deinit(DEMO_KL730_CUSTOMIZE_INF_SINGLE_MODEL_JOB_ID);
     _app_func_deinit(DEMO_KL730_CUSTOMIZE_INF_MULTIPLE_MODEL_JOB_ID);
     _app_func_deinit(DEMO_KL730_CUSTOMIZE_INF_SINGLE_MODEL_WITH_SW_NPU_FORMAT_CONVERT_JOB_ID);
+    _app_func_deinit(DEMO_KL730_CUSTOMIZE_INF_RAW_OUTPUT_JOB_ID);
+    _app_func_deinit(DEMO_KL730_CUSTOMIZE_INF_TILED_JOB_ID);
+
+    // high water of the post-process arenas, to size EX_POST_MEM_ARENA_SIZE
+    ex_post_mem_report();
 
     VMF_NNM_Inference_App_Destroy();
     VMF_NNM_Fifoq_Manager_Destroy();
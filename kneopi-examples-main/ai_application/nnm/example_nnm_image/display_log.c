@@ -12,6 +12,8 @@
 #include "demo_customize_inf_single_model.h"
 #include "demo_customize_inf_multiple_models.h"
 #include "demo_customize_inf_single_model_with_sw_npu_format_convert.h"
+#include "demo_customize_inf_raw_output.h"
+#include "demo_customize_inf_tiled.h"
 
 #include "example_shared_struct.h"
 #include "kp_struct.h"
@@ -107,6 +109,42 @@ int print_result_on_log()
                                                                                                 customize_yolo_result->boxes[i].class_num);
         }
     }
+    else if (DEMO_KL730_CUSTOMIZE_INF_RAW_OUTPUT_JOB_ID == header_stamp->job_id)
+    {
+        demo_customize_inf_raw_output_yolo_result_t *app_customize_result = (demo_customize_inf_raw_output_yolo_result_t *)header_stamp;
+        kp_custom_raw_output_yolo_result_t *customize_yolo_result = (kp_custom_raw_output_yolo_result_t *)&app_customize_result->yolo_result;
+
+        printf("[Customize Result] Inf Number %u, Box Count = %u\n", app_customize_result->inf_number, customize_yolo_result->box_count);
+        for (uint32_t i = 0; i < customize_yolo_result->box_count; i++) {
+            printf("    [%d] x1 = %f, y1 = %f, x2 = %f, y2 = %f, score = %f, class_num = %d\n", i,
+                                                                                                customize_yolo_result->boxes[i].x1,
+                                                                                                customize_yolo_result->boxes[i].y1,
+                                                                                                customize_yolo_result->boxes[i].x2,
+                                                                                                customize_yolo_result->boxes[i].y2,
+                                                                                                customize_yolo_result->boxes[i].score,
+                                                                                                customize_yolo_result->boxes[i].class_num);
+        }
+    }
+    else if (DEMO_KL730_CUSTOMIZE_INF_TILED_JOB_ID == header_stamp->job_id)
+    {
+        demo_customize_inf_tiled_result_t *app_customize_result = (demo_customize_inf_tiled_result_t *)header_stamp;
+        kp_custom_tiled_yolo_result_t *customize_yolo_result = (kp_custom_tiled_yolo_result_t *)&app_customize_result->yolo_result;
+
+        printf("[Customize Result] Inf Number %u, %u Tiles, Box Count = %u (%u before merge), %.2f ms\n", app_customize_result->inf_number,
+                                                                                                          app_customize_result->tile_count,
+                                                                                                          customize_yolo_result->box_count,
+                                                                                                          app_customize_result->tile_box_count,
+                                                                                                          app_customize_result->inf_time_us / 1000.0);
+        for (uint32_t i = 0; i < customize_yolo_result->box_count; i++) {
+            printf("    [%d] x1 = %f, y1 = %f, x2 = %f, y2 = %f, score = %f, class_num = %d\n", i,
+                                                                                                customize_yolo_result->boxes[i].x1,
+                                                                                                customize_yolo_result->boxes[i].y1,
+                                                                                                customize_yolo_result->boxes[i].x2,
+                                                                                                customize_yolo_result->boxes[i].y2,
+                                                                                                customize_yolo_result->boxes[i].score,
+                                                                                                customize_yolo_result->boxes[i].class_num);
+        }
+    }
     else
     {
         ret = KP_FW_ERROR_UNKNOWN_APP;
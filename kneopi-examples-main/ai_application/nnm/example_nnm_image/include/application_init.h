@@ -27,6 +27,8 @@
 #ifndef KDP2_APP_INFERENCE_INIT_730_H
 #define KDP2_APP_INFERENCE_INIT_730_H
 
+#include <stdbool.h>
+
 #include "kp_struct.h"
 
 /**
@@ -36,6 +38,15 @@
  */
 void app_initialize(void);
 
+/**
+ * @brief       Select the serial or the parallel NPU/NCPU mode of the customize single model flows
+ *
+ * @param[in]   enable true lets the NCPU post-process of frame N run while the NPU computes frame N+1
+ *
+ * @return      void
+ */
+void app_set_parallel_inference(bool enable);
+
 /**
  * @brief Add application layer destroy code
  */
@@ -40,6 +40,15 @@ typedef struct
     char* pszImageFormat;           //! Input image format
     float fFps;                     // feed image fps
     unsigned int dwLoopTime;        //! Inference loop time
+    unsigned int dwParallelInf;     //! 1: NCPU post-process overlaps the next NPU run (customize single model jobs)
+    unsigned int dwHostPostWorkers; //! host post-process threads for the raw output job
+    unsigned int dwTileCols;        //! tiles of a frame for the tiled job
+    unsigned int dwTileRows;
+    unsigned int dwTileOverlap;     //! pixels shared by two neighbour tiles
+    unsigned int dwRoiRefreshFrames;//! tiled job: crops around the previous boxes, a full pass every this many frames, 0: off
+    float fRoiExpand;               //! a box grows by this fraction of its size on each side
+    unsigned int dwRoiMinSize;      //! smallest side of a crop
+    unsigned int dwRoiMaxCrops;     //! more crops than this and the full pass runs instead
 } EXAMPLE_IMAGE_INIT_OPT_T;
 
 /**
@@ -55,6 +64,11 @@ typedef struct {
     int input_image_width;
     int input_image_height;
     int input_image_format;
+
+    /* Used by the tiled job */
+    unsigned int tile_cols;
+    unsigned int tile_rows;
+    unsigned int tile_overlap;
 } NNM_SHARED_INPUT_T;
 
 /**
@@ -15,8 +15,11 @@
 #include "demo_customize_inf_single_model.h"
 #include "demo_customize_inf_multiple_models.h"
 #include "demo_customize_inf_single_model_with_sw_npu_format_convert.h"
+#include "demo_customize_inf_raw_output.h"
+#include "demo_customize_inf_tiled.h"
 
 #include "example_shared_struct.h"
+#include "nnm_roi_scheduler.h"
 #include "kp_struct.h"
 #include "model_type.h"
 
@@ -33,6 +36,7 @@ volatile bool _blSendInfRunning = true;
 volatile bool _blResultRunning = true;
 
 bool _enable_inf_droppable = false;
+bool _enable_roi_schedule = false;      // tiled job: crops around the previous boxes between the full passes
 
 unsigned int _image_count = 0;
 unsigned int _result_count = 0;
@@ -191,6 +195,71 @@ int prepare_inference_header(uintptr_t buf_addr, int job_id)
         _input_data.input_ready_inf = false;
         pthread_mutex_unlock(&_mutex_image);
     }
+    else if (DEMO_KL730_CUSTOMIZE_INF_RAW_OUTPUT_JOB_ID == job_id)
+    {
+        pthread_mutex_lock(&_mutex_image);
+        demo_customize_inf_raw_output_header_t *app_customize_header = (demo_customize_inf_raw_output_header_t *)buf_addr;
+        kp_inference_header_stamp_t *header_stamp = &app_customize_header->header_stamp;
+        int image_size = _input_data.input_buf_size;
+
+        header_stamp->magic_type = KDP2_MAGIC_TYPE_INFERENCE;
+        header_stamp->total_size = sizeof(demo_customize_inf_raw_output_header_t) + (uint32_t)image_size;
+        header_stamp->total_image = 1;
+        header_stamp->image_index = 0;
+        header_stamp->job_id = DEMO_KL730_CUSTOMIZE_INF_RAW_OUTPUT_JOB_ID;
+
+        app_customize_header->width = _input_data.input_image_width;
+        app_customize_header->height = _input_data.input_image_height;
+
+        memcpy((void *)(buf_addr + sizeof(demo_customize_inf_raw_output_header_t)), (void *)_input_data.input_buf_address, image_size);
+
+        _input_data.input_ready_inf = false;
+        pthread_mutex_unlock(&_mutex_image);
+    }
+    else if (DEMO_KL730_CUSTOMIZE_INF_TILED_JOB_ID == job_id)
+    {
+        pthread_mutex_lock(&_mutex_image);
+        demo_customize_inf_tiled_header_t *app_customize_header = (demo_customize_inf_tiled_header_t *)buf_addr;
+        kp_inference_header_stamp_t *header_stamp = &app_customize_header->header_stamp;
+        int image_size = _input_data.input_buf_size;
+
+        static uint32_t inf_number = 0;
+        inf_number = inf_number + 1;
+        inf_number %= 0xFFFFFFFF;   //To avoid overflow
+
+        header_stamp->magic_type = KDP2_MAGIC_TYPE_INFERENCE;
+        header_stamp->total_size = sizeof(demo_customize_inf_tiled_header_t) + (uint32_t)image_size;
+        header_stamp->total_image = 1;
+        header_stamp->image_index = 0;
+        header_stamp->job_id = DEMO_KL730_CUSTOMIZE_INF_TILED_JOB_ID;
+
+        app_customize_header->inf_number = inf_number;
+        app_customize_header->width = _input_data.input_image_width;
+        app_customize_header->height = _input_data.input_image_height;
+        app_customize_header->tile_cols = _input_data.tile_cols;
+        app_customize_header->tile_rows = _input_data.tile_rows;
+        app_customize_header->overlap = _input_data.tile_overlap;
+        app_customize_header->roi_count = 0;
+
+        if (true == _enable_roi_schedule) {
+            NNM_ROI_PLAN_T plan;
+
+            nnm_roi_scheduler_plan(&plan);
+
+            app_customize_header->roi_count = plan.roi_count;
+            for (uint32_t i = 0; i < plan.roi_count; i++) {
+                app_customize_header->rois[i].x1 = plan.rois[i].x;
+                app_customize_header->rois[i].y1 = plan.rois[i].y;
+                app_customize_header->rois[i].width = plan.rois[i].width;
+                app_customize_header->rois[i].height = plan.rois[i].height;
+            }
+        }
+
+        memcpy((void *)(buf_addr + sizeof(demo_customize_inf_tiled_header_t)), (void *)_input_data.input_buf_address, image_size);
+
+        _input_data.input_ready_inf = false;
+        pthread_mutex_unlock(&_mutex_image);
+    }
     else
     {
         printf("[%s] Error: Job ID %u\n", __FUNCTION__, job_id);
@@ -273,6 +342,29 @@ EXIT_FREAD_IMAGE_THREAD:
     return NULL;
 }
 
+// called by the host post-process workers in inference order, the raw output buffer goes back to the queue
+void example_deliver_host_post_result(demo_customize_inf_raw_output_yolo_result_t *result, uintptr_t buf_addr, uintptr_t phy_buf_addr, int buf_size)
+{
+    if (KP_SUCCESS != result->header_stamp.status_code) {
+        printf("[%s] Error: Inf Number %u status_code %d\n", __FUNCTION__, result->inf_number, result->header_stamp.status_code);
+    }
+    else {
+        pthread_mutex_lock(&_mutex_result);
+
+        if (_inf_result.result_buffer_size < (int)sizeof(demo_customize_inf_raw_output_yolo_result_t)) {
+            _inf_result.result_buffer = (uintptr_t)realloc((void *)_inf_result.result_buffer, sizeof(demo_customize_inf_raw_output_yolo_result_t));
+            _inf_result.result_buffer_size = sizeof(demo_customize_inf_raw_output_yolo_result_t);
+        }
+
+        memcpy((void *)_inf_result.result_buffer, (void *)result, sizeof(demo_customize_inf_raw_output_yolo_result_t));
+        _inf_result.result_ready_display = true;
+
+        pthread_mutex_unlock(&_mutex_result);
+    }
+
+    VMF_NNM_Fifoq_Manager_Result_Put_Free_Buffer(buf_addr, phy_buf_addr, buf_size, -1);
+}
+
 void *example_recv_result_thread(void *)
 {
     kp_inference_header_stamp_t *header_stamp;
@@ -289,22 +381,41 @@ void *example_recv_result_thread(void *)
         } else if (KP_SUCCESS != ret) {
             printf("[%s] Error: FIFO queue error %d.\n", __FUNCTION__, ret);
             goto EXIT_UPDATE_RESULT_THREAD;
-        } else if (_inf_result.result_buffer_size < buf_size) {
-            _inf_result.result_buffer = (uintptr_t)realloc((void *)_inf_result.result_buffer, buf_size);
-            _inf_result.result_buffer_size = buf_size;
         }
 
         _result_count++;
 
         header_stamp = (kp_inference_header_stamp_t *)buf_addr;
 
+        // a raw NPU output is post-processed on the host workers, they return the buffer to the queue
+        if (DEMO_KL730_CUSTOMIZE_INF_RAW_OUTPUT_JOB_ID == header_stamp->job_id) {
+            if (KP_SUCCESS == demo_customize_inf_raw_output_host_post_submit(buf_addr, phy_buf_addr, buf_size))
+                continue;
+
+            printf("[%s] Error: host post-process is not running\n", __FUNCTION__);
+            goto EXIT_UPDATE_RESULT_THREAD_PUT_FREE_QUEUE;
+        }
+
         if (KP_SUCCESS != header_stamp->status_code) {
             printf("[%s] Error: status_code %d\n", __FUNCTION__, header_stamp->status_code);
             goto EXIT_UPDATE_RESULT_THREAD_PUT_FREE_QUEUE;
         }
 
+        // the boxes of this frame place the crops of the next ones
+        if ((true == _enable_roi_schedule) && (DEMO_KL730_CUSTOMIZE_INF_TILED_JOB_ID == header_stamp->job_id)) {
+            demo_customize_inf_tiled_result_t *tiled_result = (demo_customize_inf_tiled_result_t *)buf_addr;
+
+            nnm_roi_scheduler_update(tiled_result->yolo_result.boxes, tiled_result->yolo_result.box_count,
+                                     0 == tiled_result->roi_count, tiled_result->inf_time_us);
+        }
+
         pthread_mutex_lock(&_mutex_result);
 
+        if (_inf_result.result_buffer_size < buf_size) {
+            _inf_result.result_buffer = (uintptr_t)realloc((void *)_inf_result.result_buffer, buf_size);
+            _inf_result.result_buffer_size = buf_size;
+        }
+
         memcpy((void *)_inf_result.result_buffer, (void *)buf_addr, buf_size);
         _inf_result.result_ready_display = true;
 
@@ -324,6 +435,9 @@ EXIT_UPDATE_RESULT_THREAD_PUT_FREE_QUEUE:
 
 EXIT_UPDATE_RESULT_THREAD:
 
+    // deliver the raw outputs still in the host post-process before the result buffer is freed
+    demo_customize_inf_raw_output_host_post_stop();
+
     if (0 != _inf_result.result_buffer) {
         free((void *)_inf_result.result_buffer);
     }
@@ -57,7 +57,8 @@ FUNC_OUT:
     return kp_format;
 }
 
-static unsigned char* read_file_to_raw_buffer(void *arg, kp_image_format_t *p_image_format, uint32_t* p_image_buffer_size)
+// the file is one frame or a recorded clip of frames one after the other, all of them stay in memory
+static unsigned char* read_file_to_raw_buffer(void *arg, kp_image_format_t *p_image_format, uint32_t* p_image_buffer_size, uint32_t* p_frame_count)
 {
     EXAMPLE_IMAGE_INIT_OPT_T *pInitOpt = (EXAMPLE_IMAGE_INIT_OPT_T *)arg;
     struct stat tInputState;
@@ -97,23 +98,24 @@ static unsigned char* read_file_to_raw_buffer(void *arg, kp_image_format_t *p_im
         goto FUNC_OUT;
     }
 
-    if (tInputState.st_size != (int)image_buffer_size) {
+    if ((0 == image_buffer_size) || (0 == tInputState.st_size) || (0 != tInputState.st_size % image_buffer_size)) {
         printf("%s() image format mismatch: file size: %d, buf size by image width, height: %d\n", __func__, (int)tInputState.st_size, image_buffer_size);
         goto FUNC_OUT;
     }
 
-    image_buffer = (unsigned char *)malloc(sizeof(unsigned char) * image_buffer_size);
+    image_buffer = (unsigned char *)malloc(sizeof(unsigned char) * tInputState.st_size);
     if(!image_buffer) {
         printf("%s() image_buffer failed.\n", __func__);
         goto FUNC_OUT;
     }
-    if(fread((void *)image_buffer, image_buffer_size, 1, pFile) != 1) {
+    if(fread((void *)image_buffer, tInputState.st_size, 1, pFile) != 1) {
         printf("[%s] File read size is not equal to file size\n",  pInitOpt->pszImageName);
         goto FUNC_OUT;
     }
-    printf("image_buffer addr = 0x%p \n", image_buffer);
+    printf("image_buffer addr = 0x%p, %d frames \n", image_buffer, (int)(tInputState.st_size / image_buffer_size));
 
     *p_image_buffer_size = image_buffer_size;
+    *p_frame_count = tInputState.st_size / image_buffer_size;
 
 FUNC_OUT:
     if(pFile)
@@ -132,22 +134,26 @@ void *example_fread_image_thread(void *arg)
     float spend = 0.0, sleepTime = 0.0;
 
     uint32_t image_buffer_size = 0;
+    uint32_t frame_count = 1;
     kp_image_format_t image_format;
     unsigned char* image_buffer = NULL;
     int image_pixel_size = 0;
 
     _loop_time = pInitOpt->dwLoopTime;
-    image_buffer = (unsigned char *)read_file_to_raw_buffer(pInitOpt, &image_format, &image_buffer_size);
+    image_buffer = (unsigned char *)read_file_to_raw_buffer(pInitOpt, &image_format, &image_buffer_size, &frame_count);
 
     while (true == _blImageRunning)
     {
         gettimeofday(&tGetTime1, NULL);
 
         pthread_mutex_lock(&_mutex_image);
-        _input_data.input_buf_address = (uintptr_t)image_buffer;
+        _input_data.input_buf_address = (uintptr_t)image_buffer + (ImgSendCount % frame_count) * image_buffer_size;
         _input_data.input_image_width = pInitOpt->dwImageWidth;
         _input_data.input_image_height = pInitOpt->dwImageHeight;
         _input_data.input_image_format = image_format;
+        _input_data.tile_cols = pInitOpt->dwTileCols;
+        _input_data.tile_rows = pInitOpt->dwTileRows;
+        _input_data.tile_overlap = pInitOpt->dwTileOverlap;
 
         switch(image_format) {
         case KP_IMAGE_FORMAT_RAW8:
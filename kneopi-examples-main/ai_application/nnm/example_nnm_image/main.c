@@ -36,11 +36,19 @@
 
 #include "application_init.h"
 #include "example_shared_struct.h"
+#include "nnm_model_registry.h"
+#include "nnm_roi_scheduler.h"
+#include "nnm_fifoq_pool.h"
+#include "kdp2_inf_app_yolo.h"
+#include "demo_customize_inf_single_model.h"
+#include "demo_customize_inf_multiple_models.h"
+#include "demo_customize_inf_single_model_with_sw_npu_format_convert.h"
+#include "demo_customize_inf_raw_output.h"
+#include "demo_customize_inf_tiled.h"
 
 #define IMAGE_BUFFER_COUNT      3
-#define IMAGE_BUFFER_SIZE       (2 * 1920 * 1080 + 1024)
 #define RESULT_BUFFER_COUNT     3
-#define RESULT_BUFFER_SIZE      (1024 * 1024)
+#define RESULT_BUFFER_SIZE      (1024 * 1024)           // result of an unknown job
 
 #define EXAMPLE_IMAGE_CONFIG_PATH "./ini/example_image.ini"
 
@@ -48,6 +56,8 @@ extern void *example_fread_image_thread(void *arg);
 extern void *example_send_inf_thread(void *arg);
 extern void *example_recv_result_thread(void *arg);
 extern void *example_display_log_thread(void *arg);
+extern kp_image_format_t string_to_kp_image_format(char *image_format_string);
+extern void example_deliver_host_post_result(demo_customize_inf_raw_output_yolo_result_t *result, uintptr_t buf_addr, uintptr_t phy_buf_addr, int buf_size);
 
 bool _blDispatchRunning = true;
 bool _blFifoqManagerRunning = true;
@@ -55,6 +65,7 @@ extern bool _blImageRunning;
 extern bool _blSendInfRunning;
 extern bool _blResultRunning;
 extern bool _blDisplayRunning;
+extern bool _enable_roi_schedule;
 
 
 int loadConfig(char* HostVerifyConfigPath, EXAMPLE_IMAGE_INIT_OPT_T* pExampleImageInit)
@@ -86,6 +97,15 @@ int loadConfig(char* HostVerifyConfigPath, EXAMPLE_IMAGE_INIT_OPT_T* pExampleIma
     pExampleImageInit->pszImageFormat = strdup(iniparser_getstring(ini, "nnm:ImageFormat", "YUV420"));
 
     pExampleImageInit->dwLoopTime = iniparser_getint(ini, "nnm:InfLoopTime", 10);
+    pExampleImageInit->dwParallelInf = iniparser_getint(ini, "nnm:ParallelInf", 0);
+    pExampleImageInit->dwHostPostWorkers = iniparser_getint(ini, "nnm:HostPostWorkers", 2);
+    pExampleImageInit->dwTileCols = iniparser_getint(ini, "nnm:TileCols", 1);
+    pExampleImageInit->dwTileRows = iniparser_getint(ini, "nnm:TileRows", 1);
+    pExampleImageInit->dwTileOverlap = iniparser_getint(ini, "nnm:TileOverlap", 64);
+    pExampleImageInit->dwRoiRefreshFrames = iniparser_getint(ini, "nnm:RoiRefreshFrames", 0);
+    pExampleImageInit->fRoiExpand = (float)iniparser_getdouble(ini, "nnm:RoiExpand", 0.5);
+    pExampleImageInit->dwRoiMinSize = iniparser_getint(ini, "nnm:RoiMinSize", 192);
+    pExampleImageInit->dwRoiMaxCrops = iniparser_getint(ini, "nnm:RoiMaxCrops", 4);
     //eGetImageBufMode = iniparser_getint(ini, "nnm:GetImageBufMode", 0);
     //eNniProcessMode = iniparser_getint(ini, "nnm:NniProcessMode", 0);
     if ((0 == strcmp("RGB565", pExampleImageInit->pszImageFormat)) ||
@@ -101,10 +121,55 @@ int loadConfig(char* HostVerifyConfigPath, EXAMPLE_IMAGE_INIT_OPT_T* pExampleIma
     printf("[NNM] Model: %s pszImageName: %s \n", pExampleImageInit->pszModelPath, pExampleImageInit->pszImageName);
 	printf("[NNM] Model: %s ImageWidth: %d ImageHeight: %d Fps: %f \n", pExampleImageInit->pszModelPath, pExampleImageInit->dwImageWidth, pExampleImageInit->dwImageHeight, pExampleImageInit->fFps);
 	printf("[NNM] Model: %s dwJobId: %d \n", pExampleImageInit->pszModelPath, pExampleImageInit->dwJobId);
+    printf("[NNM] ParallelInf: %d \n", pExampleImageInit->dwParallelInf);
+    printf("[NNM] HostPostWorkers: %d \n", pExampleImageInit->dwHostPostWorkers);
+    printf("[NNM] Tiles: %d x %d overlap %d \n", pExampleImageInit->dwTileCols, pExampleImageInit->dwTileRows, pExampleImageInit->dwTileOverlap);
+    printf("[NNM] ROI: refresh %d expand %.2f min size %d max crops %d \n", pExampleImageInit->dwRoiRefreshFrames, pExampleImageInit->fRoiExpand,
+           pExampleImageInit->dwRoiMinSize, pExampleImageInit->dwRoiMaxCrops);
     iniparser_freedict(ini);
 	return 0;
 }
 
+//! NPU work and the detections of the crops against the full passes, run again with RoiRefreshFrames = 1 for the full frame reference
+void report_roi_schedule(EXAMPLE_IMAGE_INIT_OPT_T* pExampleImageInit)
+{
+    NNM_ROI_STATS_T stats;
+    unsigned int tiles = pExampleImageInit->dwTileCols * pExampleImageInit->dwTileRows;
+
+    nnm_roi_scheduler_get_stats(&stats);
+    if (0 == stats.frames)
+        return;
+
+    printf("[NNM] ROI: %u frames, %u full passes (%u early), %u with crops (%.2f avg)\n",
+           stats.frames, stats.full_frames, stats.forced_full, stats.roi_frames, stats.crops_avg);
+    printf("[NNM] ROI: %.2f inferences per frame (%u every frame without crops), %.1f%% of the frame pixels cropped\n",
+           ((double)stats.full_frames * tiles + stats.roi_frames * stats.crops_avg) / stats.frames, tiles, 100.0 * stats.pixel_ratio);
+    printf("[NNM] ROI: device %.2f ms per full pass, %.2f ms per frame with crops\n", stats.full_ms, stats.roi_ms);
+    printf("[NNM] ROI: %u full passes after crops, recall %.1f%% of %u boxes, precision %.1f%% of %u boxes\n",
+           stats.checks, 100.0 * stats.recall, stats.ref_boxes, 100.0 * stats.precision, stats.roi_boxes);
+}
+
+//! largest result of the job
+static uint32_t example_result_size(unsigned int job_id)
+{
+    switch (job_id) {
+    case KDP2_INF_ID_APP_YOLO:
+        return sizeof(kdp2_ipc_app_yolo_result_t);
+    case DEMO_KL730_CUSTOMIZE_INF_SINGLE_MODEL_JOB_ID:
+        return sizeof(demo_customize_inf_single_model_result_t);
+    case DEMO_KL730_CUSTOMIZE_INF_MULTIPLE_MODEL_JOB_ID:
+        return sizeof(demo_customize_inf_multiple_models_result_t);
+    case DEMO_KL730_CUSTOMIZE_INF_SINGLE_MODEL_WITH_SW_NPU_FORMAT_CONVERT_JOB_ID:
+        return sizeof(demo_customize_inf_single_model_with_sw_npu_format_convert_result_t);
+    case DEMO_KL730_CUSTOMIZE_INF_RAW_OUTPUT_JOB_ID:
+        return DEMO_CUSTOMIZE_INF_RAW_OUTPUT_RESULT_SIZE;
+    case DEMO_KL730_CUSTOMIZE_INF_TILED_JOB_ID:
+        return sizeof(demo_customize_inf_tiled_result_t);
+    default:
+        return RESULT_BUFFER_SIZE;
+    }
+}
+
 void sig_kill(int signo)
 {
     _blDispatchRunning = false;
@@ -206,10 +271,62 @@ int main (int argc, char* argv[])
 
     printf("[%s] app_initialize \n", __func__);
     app_initialize();   //VMF_NNM_Inference_App_Init(_app_func);
+    app_set_parallel_inference(1 == ExampleImageInit.dwParallelInf);
+
+    //! load all models of ModelPath (comma separated), they stay resident until exit
+    if (0 != nnm_model_registry_load(ExampleImageInit.pszModelPath)) {
+        app_destroy();
+        ret = -1;
+        goto EXIT;
+    }
+
+    if ((DEMO_KL730_CUSTOMIZE_INF_TILED_JOB_ID == ExampleImageInit.dwJobId) && (0 != ExampleImageInit.dwRoiRefreshFrames)) {
+        //! crops around the boxes of the latest result, the tile grid every RoiRefreshFrames frames
+        NNM_ROI_SCHEDULER_CONFIG_T roi_config;
+
+        roi_config.frame_width = ExampleImageInit.dwImageWidth;
+        roi_config.frame_height = ExampleImageInit.dwImageHeight;
+        roi_config.refresh_frames = ExampleImageInit.dwRoiRefreshFrames;
+        roi_config.expand = ExampleImageInit.fRoiExpand;
+        roi_config.min_size = ExampleImageInit.dwRoiMinSize;
+        roi_config.max_rois = ExampleImageInit.dwRoiMaxCrops;
 
-    VMF_NNM_Load_Model_From_File(ExampleImageInit.pszModelPath);
+        _enable_roi_schedule = (0 == nnm_roi_scheduler_open(&roi_config));
+    }
 
-    VMF_NNM_Fifoq_Manager_Allocate_Buffer(IMAGE_BUFFER_COUNT, IMAGE_BUFFER_SIZE, RESULT_BUFFER_COUNT, RESULT_BUFFER_SIZE);
+    if (DEMO_KL730_CUSTOMIZE_INF_RAW_OUTPUT_JOB_ID == ExampleImageInit.dwJobId) {
+        //! the raw NPU output is post-processed on host threads, each of them holds a result buffer until its result is delivered
+        if (KP_SUCCESS != demo_customize_inf_raw_output_host_post_start(ExampleImageInit.dwHostPostWorkers, example_deliver_host_post_result)) {
+            app_destroy();
+            nnm_model_registry_release();
+            ret = -1;
+            goto EXIT;
+        }
+    }
+
+    //! FIFO queue buffers of the image geometry and the result of the job
+    {
+        NNM_FIFOQ_POOL_STREAM_T tStream;
+
+        tStream.name = ExampleImageInit.pszImageName;
+        tStream.image_size = nnm_fifoq_pool_image_size(string_to_kp_image_format(ExampleImageInit.pszImageFormat),
+                                                       ExampleImageInit.dwImageWidth, ExampleImageInit.dwImageHeight);
+        tStream.image_count = IMAGE_BUFFER_COUNT;
+        tStream.result_size = example_result_size(ExampleImageInit.dwJobId);
+        tStream.result_count = RESULT_BUFFER_COUNT;
+
+        //! the host post-process holds a raw output buffer for each job in flight until its result is delivered
+        if (DEMO_KL730_CUSTOMIZE_INF_RAW_OUTPUT_JOB_ID == ExampleImageInit.dwJobId)
+            tStream.result_count = DEMO_CUSTOMIZE_INF_RAW_OUTPUT_RESULT_COUNT(ExampleImageInit.dwHostPostWorkers);
+
+        if ((0 != nnm_fifoq_pool_add_stream(&tStream)) || (0 != nnm_fifoq_pool_allocate())) {
+            demo_customize_inf_raw_output_host_post_stop();
+            app_destroy();
+            nnm_model_registry_release();
+            ret = -1;
+            goto EXIT;
+        }
+    }
 
     pthread_create(&task_fread_image_handle, NULL, example_fread_image_thread, &ExampleImageInit);
     pthread_create(&task_send_inf_handle, NULL, example_send_inf_thread, &ExampleImageInit.dwJobId);
@@ -229,8 +346,16 @@ int main (int argc, char* argv[])
     pthread_join(task_buf_mgr_handle, NULL);
     pthread_join(task_inf_data_handle, NULL);
 
+    //! throughput of this tile count, run again with other TileCols/TileRows to compare
+    if (DEMO_KL730_CUSTOMIZE_INF_TILED_JOB_ID == ExampleImageInit.dwJobId)
+        demo_customize_inf_tiled_report();
+
+    if (true == _enable_roi_schedule)
+        report_roi_schedule(&ExampleImageInit);
+
     app_destroy();  //VMF_NNM_Inference_App_Destroy();
-    VMF_NNM_Fifoq_Manager_Release_All_Buffer();
+    nnm_fifoq_pool_release();
+    nnm_model_registry_release();
 EXIT:
 
     if (ExampleImageInit.pszModelPath)
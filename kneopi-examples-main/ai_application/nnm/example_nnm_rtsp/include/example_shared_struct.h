@@ -32,6 +32,8 @@ typedef struct
     unsigned int dwJobId;           //e.g. KDP2_INF_ID_APP_YOLO;
 
     char* pszRtspURL;
+    unsigned int dwMaxImageWidth;   //! largest frame of the stream, sizes the image FIFO buffers
+    unsigned int dwMaxImageHeight;
 } EXAMPLE_RTSP_INIT_OPT_T;
 
 /**
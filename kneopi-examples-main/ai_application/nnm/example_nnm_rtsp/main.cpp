@@ -39,13 +39,14 @@ extern "C" {
 
 #include "application_init.h"
 #include "example_shared_struct.h"
+#include "nnm_model_registry.h"
+#include "nnm_fifoq_pool.h"
+#include "kdp2_inf_app_yolo.h"
 
 //fifo queue buffer setting
 #define IMAGE_BUFFER_COUNT      3
-#define IMAGE_BUFFER_SIZE       1024 + (3840 * 2160 * 1.5) // header + YUV420
 
 #define RESULT_BUFFER_COUNT     3
-#define RESULT_BUFFER_SIZE      (1024 * 1024)
 
 
 #define EXAMPLE_RTSP_CONFIG_PATH "./ini/example_rtsp.ini"
@@ -82,8 +83,11 @@ int loadConfig(const char* HostFfmpegConfigPath, EXAMPLE_RTSP_INIT_OPT_T* pExamp
     pExampleRtspInit->dwJobId = iniparser_getint(ini, "nnm:JobId", 11);
 
     pExampleRtspInit->pszRtspURL = strdup(iniparser_getstring(ini, "nnm:RtspURL", "rtsp://stream.strba.sk:1935/strba/VYHLAD_JAZERO.stream"));
+    pExampleRtspInit->dwMaxImageWidth = iniparser_getint(ini, "nnm:MaxImageWidth", 3840);
+    pExampleRtspInit->dwMaxImageHeight = iniparser_getint(ini, "nnm:MaxImageHeight", 2160);
 
     printf("[NNM] RTSP URL: %s\n", pExampleRtspInit->pszRtspURL);
+    printf("[NNM] Max image: %ux%u\n", pExampleRtspInit->dwMaxImageWidth, pExampleRtspInit->dwMaxImageHeight);
     printf("[NNM] Model: %s dwJobId: %u\n", pExampleRtspInit->pszModelPath, pExampleRtspInit->dwJobId);
     iniparser_freedict(ini);
 
@@ -191,9 +195,30 @@ int main (int argc, char* argv[])
     printf("[%s] app_initialize \n", __func__);
     app_initialize();
 
-    VMF_NNM_Load_Model_From_File(ExampleRtspInit.pszModelPath);
+    //! load all models of ModelPath (comma separated), they stay resident until exit
+    if (0 != nnm_model_registry_load(ExampleRtspInit.pszModelPath)) {
+        app_destroy();
+        ret = -1;
+        goto EXIT;
+    }
+
+    //! FIFO queue buffers of the largest decoded YUV420 frame and the yolo result
+    {
+        NNM_FIFOQ_POOL_STREAM_T tStream;
+
+        tStream.name = ExampleRtspInit.pszRtspURL;
+        tStream.image_size = nnm_fifoq_pool_image_size(KP_IMAGE_FORMAT_YUV420, ExampleRtspInit.dwMaxImageWidth, ExampleRtspInit.dwMaxImageHeight);
+        tStream.image_count = IMAGE_BUFFER_COUNT;
+        tStream.result_size = sizeof(kdp2_ipc_app_yolo_result_t);
+        tStream.result_count = RESULT_BUFFER_COUNT;
 
-    VMF_NNM_Fifoq_Manager_Allocate_Buffer(IMAGE_BUFFER_COUNT, IMAGE_BUFFER_SIZE, RESULT_BUFFER_COUNT, RESULT_BUFFER_SIZE);
+        if ((0 != nnm_fifoq_pool_add_stream(&tStream)) || (0 != nnm_fifoq_pool_allocate())) {
+            app_destroy();
+            nnm_model_registry_release();
+            ret = -1;
+            goto EXIT;
+        }
+    }
 
     pthread_create(&task_webcam_image_handle, NULL, example_rtsp_input_thread, &ExampleRtspInit);
     pthread_create(&task_send_inf_handle, NULL, example_send_inf_thread, &ExampleRtspInit.dwJobId);
@@ -212,7 +237,8 @@ int main (int argc, char* argv[])
     pthread_join(task_inf_data_handle, NULL);
 
     app_destroy();
-    VMF_NNM_Fifoq_Manager_Release_All_Buffer();
+    nnm_fifoq_pool_release();
+    nnm_model_registry_release();
     ret = 0;
 
 EXIT:
@@ -16,6 +16,7 @@ extern "C" {
 
 #include "example_shared_struct.h"
 #include "kp_struct.h"
+#include "nnm_admission.h"
 
 volatile extern NNM_SHARED_INPUT_T _input_data;
 extern pthread_mutex_t _mutex_image;
@@ -37,7 +38,7 @@ volatile bool _blDisplayRunning = true;
 
 extern void sig_kill(int signo);
 
-int draw_display_image(cv::Mat *cv_img_display, const char *strImgFPS, const char *strInfFPS)
+int draw_display_image(cv::Mat *cv_img_display, const char *strImgFPS, const char *strInfFPS, const char *strLatency)
 {
     int ret = KP_SUCCESS;
     kp_inference_header_stamp_t *header_stamp = (kp_inference_header_stamp_t *)_inf_result.result_buffer;
@@ -56,6 +57,7 @@ int draw_display_image(cv::Mat *cv_img_display, const char *strImgFPS, const cha
 
         cv::putText(*cv_img_display, strImgFPS, cv::Point(5, 20), cv::FONT_HERSHEY_COMPLEX_SMALL, 1, cv::Scalar(50, 50, 255), 1);
         cv::putText(*cv_img_display, strInfFPS, cv::Point(5, 40), cv::FONT_HERSHEY_COMPLEX_SMALL, 1, cv::Scalar(50, 50, 255), 1);
+        cv::putText(*cv_img_display, strLatency, cv::Point(5, 60), cv::FONT_HERSHEY_COMPLEX_SMALL, 1, cv::Scalar(50, 50, 255), 1);
         cv::putText(*cv_img_display, "Press 'ESC' to exit", cv::Point(10, cv_img_display->rows - 10), cv::FONT_HERSHEY_COMPLEX_SMALL, 1, cv::Scalar(255, 255, 255), 2);
     }
     else
@@ -73,6 +75,8 @@ void *example_display_liveview_thread(void *)
     float time_spent = 0.0;
     char strImgFPS[50] = "Image FPS: ";
     char strInfFPS[50] = "Inference FPS: ";
+    char strLatency[80] = "Latency: ";
+    NNM_ADMISSION_STATS_T tAdmissionStats;
     cv::Mat cv_image_source;
     cv::Mat cv_image_display;
 
@@ -87,6 +91,9 @@ void *example_display_liveview_thread(void *)
             time_spent = (float)(time_end.tv_sec - time_begin.tv_sec) + (float)(time_end.tv_usec - time_begin.tv_usec) * .000001;
             sprintf(strImgFPS, "Image FPS: %.2lf", _image_count / time_spent);
             sprintf(strInfFPS, "Inference FPS: %.2lf", _result_count / time_spent);
+            nnm_admission_get_stats(&tAdmissionStats);
+            snprintf(strLatency, sizeof(strLatency), "Latency: %.1f ms, NPU %.1f ms, in flight %u/%u (%s)", tAdmissionStats.latency_ms,
+                     tAdmissionStats.service_ms, tAdmissionStats.in_flight, tAdmissionStats.target_in_flight, nnm_admission_mode_name(tAdmissionStats.mode));
             _image_count = 0;
             _result_count = 0;
 
@@ -117,7 +124,7 @@ void *example_display_liveview_thread(void *)
         /* Display image */
         if (false == cv_image_display.empty()) {
             if (true == _inf_result.result_ready_display) {
-                draw_display_image(&cv_image_display, strImgFPS, strInfFPS);
+                draw_display_image(&cv_image_display, strImgFPS, strInfFPS, strLatency);
             }
 
             cv::imshow("Inference Display", cv_image_display);
@@ -0,0 +1,116 @@
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <pthread.h>
+#include <sys/time.h>
+
+extern "C" {
+#include "kdp2_inf_app_yolo.h"
+}
+
+#include "example_shared_struct.h"
+#include "kp_struct.h"
+#include "nnm_spi_lcd.h"
+#include "nnm_admission.h"
+
+#define SPI_LCD_BOX_MAX     64          //! boxes drawn on the panel, a 240x240 preview can not show more
+
+volatile extern NNM_SHARED_INPUT_T _input_data;
+extern pthread_mutex_t _mutex_image;
+
+volatile extern NNM_SHARED_RESULT_T _inf_result;
+extern pthread_mutex_t _mutex_result;
+
+extern unsigned int _image_count;
+extern unsigned int _result_count;
+
+extern bool _blDisplayRunning;
+
+/* copy the boxes out of the result buffer, the lock is held as short as possible */
+static uint32_t copy_result_boxes(kp_bounding_box_t *boxes, uint32_t max_count)
+{
+    uint32_t box_count = 0;
+
+    pthread_mutex_lock(&_mutex_result);
+    kp_inference_header_stamp_t *header_stamp = (kp_inference_header_stamp_t *)_inf_result.result_buffer;
+
+    if ((true == _inf_result.result_ready_display) && (NULL != header_stamp) && (KDP2_INF_ID_APP_YOLO == header_stamp->job_id))
+    {
+        kdp2_ipc_app_yolo_result_t *app_yolo_result = (kdp2_ipc_app_yolo_result_t *)header_stamp;
+        kp_app_yolo_result_t *yolo_result = (kp_app_yolo_result_t *)&app_yolo_result->yolo_data;
+
+        box_count = (yolo_result->box_count < max_count) ? yolo_result->box_count : max_count;
+        memcpy(boxes, yolo_result->boxes, box_count * sizeof(kp_bounding_box_t));
+    }
+    pthread_mutex_unlock(&_mutex_result);
+
+    return box_count;
+}
+
+void *example_display_spi_lcd_thread(void *arg)
+{
+    EXAMPLE_SENSOR_INIT_OPT_T *pExampleSensorInit = (EXAMPLE_SENSOR_INIT_OPT_T*)arg;
+    struct timeval time_begin;
+    struct timeval time_end;
+    float time_spent = 0.0;
+    char strImgFPS[50] = "Image FPS: ";
+    char strInfFPS[50] = "Inference FPS: ";
+    NNM_ADMISSION_STATS_T tAdmissionStats;
+    kp_bounding_box_t boxes[SPI_LCD_BOX_MAX];
+    uint32_t box_count = 0;
+    bool blFrameDrawn = false;
+
+    if (0 != nnm_spi_lcd_open(pExampleSensorInit->fSpiLcdSize)) {
+        printf("[%s] open SPI LCD failed, inference keeps running without preview\n", __func__);
+        return NULL;
+    }
+
+    gettimeofday(&time_begin, NULL);
+
+    while (true == _blDisplayRunning) {
+
+        if (_result_count >= 60)
+        {
+            gettimeofday(&time_end, NULL);
+            time_spent = (float)(time_end.tv_sec - time_begin.tv_sec) + (float)(time_end.tv_usec - time_begin.tv_usec) * .000001;
+            sprintf(strImgFPS, "Image FPS: %.2lf", _image_count / time_spent);
+            nnm_admission_get_stats(&tAdmissionStats);
+            snprintf(strInfFPS, sizeof(strInfFPS), "Inference FPS: %.2lf %.0fms", _result_count / time_spent, tAdmissionStats.latency_ms);
+            _image_count = 0;
+            _result_count = 0;
+
+            gettimeofday(&time_begin, NULL);
+        }
+
+        /* Downscale and convert only the sampled pixels, the image lock is held for a fraction of a frame */
+        pthread_mutex_lock(&_mutex_image);
+        blFrameDrawn = (KP_IMAGE_FORMAT_YUV420 == _input_data.input_image_format) && (0 != _input_data.input_buf_address);
+        if (true == blFrameDrawn) {
+            nnm_spi_lcd_draw_yuv420((const uint8_t *)_input_data.input_buf_address,
+                                    _input_data.input_image_width, _input_data.input_image_height);
+        }
+        pthread_mutex_unlock(&_mutex_image);
+
+        if (false == blFrameDrawn) {
+            usleep(10000);
+            continue;
+        }
+
+        box_count = copy_result_boxes(boxes, SPI_LCD_BOX_MAX);
+        for (uint32_t i = 0; i < box_count; i++) {
+            nnm_spi_lcd_draw_box((int)boxes[i].x1, (int)boxes[i].y1, (int)boxes[i].x2, (int)boxes[i].y2, NNM_SPI_LCD_GREEN);
+        }
+
+        nnm_spi_lcd_draw_text(0, strImgFPS);
+        nnm_spi_lcd_draw_text(1, strInfFPS);
+
+        /* Blocks only while the previous frame is on the SPI bus, which paces the preview */
+        nnm_spi_lcd_submit();
+    }
+
+    nnm_spi_lcd_close();
+
+    return NULL;
+}
@@ -23,6 +23,7 @@
 
 #include "fec_api.h"
 #include "kp_struct.h"
+#include "nnm_letterbox.h"
 
 /**
  * @brief describe example sensor configuration
@@ -39,6 +40,48 @@ typedef struct
     unsigned int dwGetImageBufMode;     //! 0: block mode 1: non-block mode
     unsigned int dwImageWidth;          //! Input image width
     unsigned int dwImageHeight;         //! Input image height
+    unsigned int dwModelDownscale;      //! 1: the scaler letterboxes the frame to the model input for inference, the input image is displayed only
+    unsigned int dwModelWidth;          //! Model input width
+    unsigned int dwModelHeight;         //! Model input height
+    NNM_LETTERBOX_T tLetterbox;         //! geometry of the frame for inference when dwModelDownscale is 1
+
+    //! FIFO queue settings
+    unsigned int dwAdmissionMode;       //! 0: droppable 1: min-latency 2: max-throughput
+    unsigned int dwImageBufferCount;    //! image FIFO buffers
+    unsigned int dwResultBufferCount;   //! result FIFO buffers
+
+    //! motion gate settings
+    unsigned int dwMotionEnable;        //! 1: only frames with motion are submitted, not with the GPIO trigger
+    unsigned int dwMotionDownscale;     //! frame pixels per analyzed pixel in each direction
+    unsigned int dwMotionThreshold;     //! mean absolute Y difference of a changed block
+    unsigned int dwMotionMinBlocks;     //! changed blocks of a frame with motion
+    unsigned int dwMotionLearnShift;    //! the background follows the scene by 1/2^shift per frame
+    unsigned int dwMotionRefreshFrames; //! a static frame is submitted after this many skipped ones, 0: never
+
+    //! display settings
+    unsigned int dwDisplayMode;         //! 0: OpenCV window 1: SPI LCD
+    double fSpiLcdSize;                 //! SPI LCD size in inch, 1.3 or 1.54
+
+    //! GPIO trigger settings
+    char* pszTriggerChip;               //! GPIO chip of the trigger line, e.g. /dev/gpiochip0
+    int sdwTriggerLine;                 //! line offset, -1: free running, every frame is submitted
+    unsigned int dwTriggerEdge;         //! 1: rising 2: falling 3: both
+    unsigned int dwTriggerBias;         //! 0: as is 1: pull-up 2: pull-down
+    unsigned int dwTriggerDebounceUs;   //! debounce period in us, 0: disabled
+
+    //! pan/tilt tracking settings
+    unsigned int dwTrackingEnable;      //! 1: steer the PCA9685 servos toward the tracked detection
+    unsigned int dwTrackingI2cBus;      //! /dev/i2c-<bus> of the PCA9685
+    unsigned int dwTrackingI2cAddr;     //! PCA9685 address, e.g. 0x40
+    unsigned int dwTrackingPanChannel;  //! PCA9685 channel of the pan servo
+    unsigned int dwTrackingTiltChannel; //! PCA9685 channel of the tilt servo
+    int sdwTrackingClass;               //! class to track, -1: any class
+    double fTrackingKp;                 //! PID gains, degrees per second for an offset of half a frame
+    double fTrackingKi;
+    double fTrackingKd;
+    double fTrackingDeadZone;           //! offset from the center ignored, fraction of half a frame
+    unsigned int dwTrackingPanInvert;   //! 1: the pan servo turns the camera the other way
+    unsigned int dwTrackingTiltInvert;  //! 1: the tilt servo turns the camera the other way
 } EXAMPLE_SENSOR_INIT_OPT_T;
 
 /**
@@ -46,6 +89,7 @@ typedef struct
  */
 typedef struct {
     bool input_ready_inf;
+    unsigned int frame_number;          //! incremented for every captured frame
 
     uintptr_t input_buf_address;
     unsigned int input_buf_size;
@@ -54,6 +98,15 @@ typedef struct {
     int input_image_width;
     int input_image_height;
     int input_image_format;
+
+    /* Used when the frame for inference is letterboxed, otherwise the input buffer is submitted */
+    uintptr_t inf_buf_address;
+    unsigned int inf_buf_size;
+    int inf_image_width;
+    int inf_image_height;
+
+    /* Used when input is triggered by GPIO */
+    uint64_t trigger_timestamp_ns;      //! kernel timestamp of the edge, 0 when not triggered
 } NNM_SHARED_INPUT_T;
 
 /**
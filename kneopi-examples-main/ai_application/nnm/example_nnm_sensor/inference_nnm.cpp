@@ -18,6 +18,12 @@ extern "C" {
 #include "example_shared_struct.h"
 #include "kp_struct.h"
 #include "model_type.h"
+#include "nnm_gpio_trigger.h"
+#include "nnm_pan_tilt.h"
+#include "nnm_letterbox.h"
+#include "nnm_admission.h"
+
+#define ADMISSION_WAIT_MS   100     //! longest wait for a result before the running flags are checked again
 
 volatile extern NNM_SHARED_INPUT_T _input_data;
 extern pthread_mutex_t _mutex_image;
@@ -31,11 +37,15 @@ extern bool _blDisplayRunning;
 volatile bool _blSendInfRunning = true;
 volatile bool _blResultRunning = true;
 
-bool _enable_inf_droppable = true;
-
 unsigned int _image_count = 0;
 unsigned int _result_count = 0;
 
+/* kernel timestamp of the GPIO edge of the frame in the buffer being prepared, 0 when not triggered */
+static uint64_t _trigger_timestamp_ns = 0;
+
+/* captured frame number of the frame in the buffer being prepared */
+static unsigned int _frame_number = 0;
+
 NNM_SHARED_RESULT_T _inf_result = {0};
 pthread_mutex_t _mutex_result = PTHREAD_MUTEX_INITIALIZER;
 
@@ -90,7 +100,8 @@ int prepare_inference_header(uintptr_t buf_addr, int job_id)
         pthread_mutex_lock(&_mutex_image);
         kdp2_ipc_app_yolo_inf_header_t *app_yolo_header = (kdp2_ipc_app_yolo_inf_header_t *)buf_addr;
         kp_inference_header_stamp_t *header_stamp = &app_yolo_header->header_stamp;
-        int image_size = _input_data.input_buf_size;
+        bool blLetterbox = (0 != _input_data.inf_buf_address);
+        int image_size = blLetterbox ? _input_data.inf_buf_size : _input_data.input_buf_size;
 
         static uint32_t inf_number = 0;
         inf_number = inf_number + 1;
@@ -104,14 +115,17 @@ int prepare_inference_header(uintptr_t buf_addr, int job_id)
 
         app_yolo_header->inf_number = inf_number;
         app_yolo_header->model_id = KNERON_YOLOV5S_COCO80_640_640_3;
-        app_yolo_header->width = _input_data.input_image_width;
-        app_yolo_header->height = _input_data.input_image_height;
+        app_yolo_header->width = blLetterbox ? _input_data.inf_image_width : _input_data.input_image_width;
+        app_yolo_header->height = blLetterbox ? _input_data.inf_image_height : _input_data.input_image_height;
 
         app_yolo_header->image_format = _input_data.input_image_format;
         app_yolo_header->model_normalize = KP_NORMALIZE_KNERON;
 
-        memcpy((void *)(buf_addr + sizeof(kdp2_ipc_app_yolo_inf_header_t)), (void *)_input_data.input_buf_address, image_size);
+        memcpy((void *)(buf_addr + sizeof(kdp2_ipc_app_yolo_inf_header_t)),
+               (void *)(blLetterbox ? _input_data.inf_buf_address : _input_data.input_buf_address), image_size);
 
+        _trigger_timestamp_ns = _input_data.trigger_timestamp_ns;
+        _frame_number = _input_data.frame_number;
         _input_data.input_ready_inf = false;
         pthread_mutex_unlock(&_mutex_image);
     }
@@ -133,6 +147,9 @@ void *example_send_inf_thread(void *arg)
     uintptr_t phy_buf_addr = 0;  // contains a inference image or a command
     int buf_size = 0;           // buffer size should bigger than inference image size
     int sts = 0;
+    NNM_ADMISSION_DECISION_E eDecision;
+    unsigned int dwLastFrameNumber = 0;
+    bool blFirstFrame = true;
 
     while (true == _blSendInfRunning)
     {
@@ -140,9 +157,15 @@ void *example_send_inf_thread(void *arg)
             continue;
         }
 
+        // held back frames are superseded by newer ones in the input buffer
+        eDecision = nnm_admission_decide(ADMISSION_WAIT_MS);
+        if (NNM_ADMISSION_DROP == eDecision) {
+            continue;
+        }
+
         // take a free buffer to receive a inf image or a command
         if (true == VMF_NNM_Fifoq_Manager_Get_Fifoq_Allocated()) {
-            sts = VMF_NNM_Fifoq_Manager_Image_Get_Free_Buffer(&buf_addr, &phy_buf_addr, &buf_size, -1, _enable_inf_droppable);
+            sts = VMF_NNM_Fifoq_Manager_Image_Get_Free_Buffer(&buf_addr, &phy_buf_addr, &buf_size, -1, (NNM_ADMISSION_REPLACE == eDecision));
 
             if (KP_FW_FIFOQ_ACCESS_FAILED_125 == sts) {
                 continue;
@@ -156,6 +179,7 @@ void *example_send_inf_thread(void *arg)
             goto EXIT_FREAD_IMAGE_THREAD;
         }
 
+        _trigger_timestamp_ns = 0;
         sts = prepare_inference_header(buf_addr, *job_id);
         if (KP_SUCCESS != sts) {
             printf("[%s] Error: prepare_inference_header failed (%d)\n", __FUNCTION__, sts);
@@ -172,6 +196,17 @@ void *example_send_inf_thread(void *arg)
             }
 
             VMF_NNM_Fifoq_Manager_Image_Enqueue(header_stamp->total_image, header_stamp->image_index, buf_addr, phy_buf_addr, buf_size, 0, false);
+
+            if (0 != _trigger_timestamp_ns)
+                nnm_gpio_trigger_mark_submitted(_trigger_timestamp_ns);
+
+            if (KDP2_INF_ID_APP_YOLO == header_stamp->job_id) {
+                kdp2_ipc_app_yolo_inf_header_t *app_yolo_header = (kdp2_ipc_app_yolo_inf_header_t *)header_stamp;
+
+                nnm_admission_mark_submitted(app_yolo_header->inf_number, (true == blFirstFrame) ? 0 : (_frame_number - dwLastFrameNumber - 1));
+                dwLastFrameNumber = _frame_number;
+                blFirstFrame = false;
+            }
         }
         else
         {
@@ -197,17 +232,22 @@ EXIT_FREAD_IMAGE_THREAD:
     return NULL;
 }
 
-void *example_recv_result_thread(void *)
+void *example_recv_result_thread(void *arg)
 {
+    EXAMPLE_SENSOR_INIT_OPT_T *pExampleSensorInit = (EXAMPLE_SENSOR_INIT_OPT_T*)arg;
+    bool blTracking = (1 == pExampleSensorInit->dwTrackingEnable);
+    bool blLetterbox = (1 == pExampleSensorInit->dwModelDownscale);
     kp_inference_header_stamp_t *header_stamp;
     uintptr_t buf_addr = 0;
     uintptr_t phy_buf_addr = 0;
     int buf_size = 0;
     int sts = 0;
+    uint64_t dequeue_ns = 0;
 
     while (true == _blResultRunning) {
         // get result data from queue blocking wait
         int ret = VMF_NNM_Fifoq_Manager_Result_Dequeue(&buf_addr, &phy_buf_addr, &buf_size, -1);
+        dequeue_ns = nnm_pan_tilt_now_ns();
 
         if (KP_FW_FIFOQ_ACCESS_FAILED_125 == ret) {
             continue;
@@ -223,11 +263,23 @@ void *example_recv_result_thread(void *)
 
         header_stamp = (kp_inference_header_stamp_t *)buf_addr;
 
+        // a frame held back by the admission control may go in now
+        if (KDP2_INF_ID_APP_YOLO == header_stamp->job_id)
+            nnm_admission_mark_result(((kdp2_ipc_app_yolo_result_t *)header_stamp)->inf_number);
+
         if (KP_SUCCESS != header_stamp->status_code) {
             printf("[%s] Error: status_code %d\n", __FUNCTION__, header_stamp->status_code);
             goto EXIT_UPDATE_RESULT_THREAD_PUT_FREE_QUEUE;
         }
 
+        // boxes of a letterboxed frame are in model coordinates, the display and the tracking use the full resolution
+        if ((true == blLetterbox) && (KDP2_INF_ID_APP_YOLO == header_stamp->job_id)) {
+            kdp2_ipc_app_yolo_result_t *app_yolo_result = (kdp2_ipc_app_yolo_result_t *)header_stamp;
+            kp_app_yolo_result_t *yolo_result = (kp_app_yolo_result_t *)&app_yolo_result->yolo_data;
+
+            nnm_letterbox_remap_boxes(&pExampleSensorInit->tLetterbox, (kp_bounding_box_t *)yolo_result->boxes, yolo_result->box_count);
+        }
+
         pthread_mutex_lock(&_mutex_result);
 
         memcpy((void *)_inf_result.result_buffer, (void *)buf_addr, buf_size);
@@ -235,6 +287,14 @@ void *example_recv_result_thread(void *)
 
         pthread_mutex_unlock(&_mutex_result);
 
+        // one control step per result, read from the dequeued buffer so the display lock is not held
+        if ((true == blTracking) && (KDP2_INF_ID_APP_YOLO == header_stamp->job_id)) {
+            kdp2_ipc_app_yolo_result_t *app_yolo_result = (kdp2_ipc_app_yolo_result_t *)header_stamp;
+            kp_app_yolo_result_t *yolo_result = (kp_app_yolo_result_t *)&app_yolo_result->yolo_data;
+
+            nnm_pan_tilt_update((const kp_bounding_box_t *)yolo_result->boxes, yolo_result->box_count, dequeue_ns);
+        }
+
         // return free buf back to queue
         ret = VMF_NNM_Fifoq_Manager_Result_Put_Free_Buffer(buf_addr, phy_buf_addr, buf_size, -1);
         if (KP_FW_FIFOQ_ACCESS_FAILED_125 == ret) {
@@ -27,6 +27,9 @@ extern "C" {
 
 #include "example_shared_struct.h"
 #include "kp_struct.h"
+#include "nnm_gpio_trigger.h"
+#include "nnm_letterbox.h"
+#include "nnm_motion.h"
 
 #define VENC_VSRC_PIN       "vsrc_ssm"                  //! VMF_VSRC Output pin
 #define VENC_VSRC_C_PIN     "vsrc_ssm_c_0"              //! VMF_VSRC Customer Output pin
@@ -43,6 +46,8 @@ VMF_SRC_CONNECT_INFO_T connect_info;
 VMF_LAYOUT_T g_tLayout;
 VMF_VSRC_HANDLE_T* g_ptVsrcHandle = NULL;
 ssm_handle_t *gptSsmHandle;
+VMF_SRC_CONNECT_INFO_T model_connect_info;
+ssm_handle_t *gptModelSsmHandle = NULL;
 
 extern bool _blDispatchRunning;
 extern bool _blFifoqManagerRunning;
@@ -99,7 +104,8 @@ void dma2d_release(DMA_INFO_T* dma_info)
     MemBroker_FreeMemory(dma_info);
 }
 
-int dma2d_copy(VMF_DMA_HANDLE_T* dma_handle, VMF_DMA_DESCRIPTOR_T* dma_desc, void* dest, void* source, VMF_VSRC_SSM_OUTPUT_INFO_T* vsrc_ssm_info)
+/* copy the frame to the top-left corner of a YUV420 dest of dst_width x dst_height, which is at least the frame size */
+int dma2d_copy(VMF_DMA_HANDLE_T* dma_handle, VMF_DMA_DESCRIPTOR_T* dma_desc, void* dest, unsigned int dst_width, unsigned int dst_height, void* source, VMF_VSRC_SSM_OUTPUT_INFO_T* vsrc_ssm_info)
 {
     int ret = 0;
     VMF_DMA_ADDR_T dma_addr;
@@ -113,10 +119,10 @@ int dma2d_copy(VMF_DMA_HANDLE_T* dma_handle, VMF_DMA_DESCRIPTOR_T* dma_desc, voi
     dma_addr.dwSrcStride = vsrc_ssm_info->dwYStride;
 
     dma_addr.pbyDstYPhysAddr = (unsigned char*)MemBroker_GetPhysAddr(dest);
-    dma_addr.pbyDstCbPhysAddr = dma_addr.pbyDstYPhysAddr + vsrc_ssm_info->dwWidth* vsrc_ssm_info->dwHeight;
-    dma_addr.pbyDstCrPhysAddr = dma_addr.pbyDstCbPhysAddr + vsrc_ssm_info->dwWidth* vsrc_ssm_info->dwHeight/4;
-    dma_addr.dwDstStride = vsrc_ssm_info->dwWidth;
-    MemBroker_CacheFlush(dest, vsrc_ssm_info->dwWidth * vsrc_ssm_info->dwHeight * 1.5);
+    dma_addr.pbyDstCbPhysAddr = dma_addr.pbyDstYPhysAddr + dst_width * dst_height;
+    dma_addr.pbyDstCrPhysAddr = dma_addr.pbyDstCbPhysAddr + dst_width * dst_height/4;
+    dma_addr.dwDstStride = dst_width;
+    MemBroker_CacheFlush(dest, dst_width * dst_height * 1.5);
     ret |= VMF_DMA_Descriptor_Update_Addr(dma_desc, &dma_addr);
     ret |= VMF_DMA_Setup(dma_handle, &dma_desc, 1);
     ret |= VMF_DMA_Process(dma_handle);
@@ -275,6 +281,15 @@ void *example_sensor_image_thread(void *arg)
     unsigned int wait_cnt = 0;
     char azReaderSsmName[64];
     char tmpName[30] = {0};
+    bool blTriggered = (pExampleSensorInit->sdwTriggerLine >= 0);
+    NNM_GPIO_TRIGGER_EVENT_T tTrigger;
+    int ret = 0;
+    bool blDownscale = (1 == pExampleSensorInit->dwModelDownscale);
+    NNM_LETTERBOX_T *ptLetterbox = &pExampleSensorInit->tLetterbox;
+    ssm_handle_t *ptModelSsmHandle = NULL;
+    ssm_buffer_t model_ssm_buf;
+    bool blMotionGate = (1 == pExampleSensorInit->dwMotionEnable);
+    NNM_MOTION_RESULT_T tMotion;
 
     VMF_SSM_READER_SCHEME eImageBufMode = (VMF_SSM_READER_SCHEME)pExampleSensorInit->dwGetImageBufMode;
     DMA_INFO_T *pDmaInfo = dma2d_init();
@@ -306,6 +321,27 @@ void *example_sensor_image_thread(void *arg)
         printf("%s() failed, SSM_Reader_Init failed!\n", __func__);
     }
 
+    //! a second scaler output at model scale, copied into the letterbox canvas which is submitted for inference
+    memset(&model_ssm_buf, 0, sizeof(ssm_buffer_t));
+    if (true == blDownscale) {
+        VMF_BIND_Request(g_ptBind, ptLetterbox->scaled_width, ptLetterbox->scaled_height, ptLetterbox->scaled_width, 0, &model_connect_info);
+
+        gptModelSsmHandle = ptModelSsmHandle = SSM_Reader_Init(model_connect_info.szSrcPin);
+        if (!ptModelSsmHandle) {
+            printf("%s() failed, SSM_Reader_Init of the model scale output failed!\n", __func__);
+            goto EXIT_SENSOR_IMAGE_THREAD;
+        }
+
+        _input_data.inf_buf_address = (uintptr_t)MemBroker_GetMemory(nnm_letterbox_canvas_size(ptLetterbox), VMF_ALIGN_TYPE_128_BYTE);
+        if (0 == _input_data.inf_buf_address) {
+            printf("%s() failed, MemBroker_GetMemory of the letterbox failed!\n", __func__);
+            goto EXIT_SENSOR_IMAGE_THREAD;
+        }
+
+        //! only the scaled frame is copied afterwards, the padding stays
+        nnm_letterbox_fill_canvas(ptLetterbox, (uint8_t *)_input_data.inf_buf_address);
+    }
+
     //! wait for video source being ready.
     memset(&ssm_buf, 0, sizeof(ssm_buffer_t));
     while (SSM_Reader_ReturnReceiveNewestBuff(ptSsmHandle, &ssm_buf, eImageBufMode) < 0) {
@@ -315,8 +351,29 @@ void *example_sensor_image_thread(void *arg)
         }
     }
 
+    wait_cnt = 0;
+    while ((true == blDownscale) && (SSM_Reader_ReturnReceiveNewestBuff(ptModelSsmHandle, &model_ssm_buf, eImageBufMode) < 0)) {
+        if ((getyuv_retry_cnt < wait_cnt++) || (false == _blImageRunning)) {
+            printf("%s err: get model scale yuv failed, exit\n", __func__);
+            goto EXIT_SENSOR_IMAGE_THREAD;
+        }
+    }
+
     // run infinitely
     while (true == _blImageRunning) {
+        memset(&tTrigger, 0, sizeof(tTrigger));
+
+        //! triggered mode: sleep in epoll until an edge, then take the newest frame at once
+        if (true == blTriggered) {
+            ret = nnm_gpio_trigger_wait(&tTrigger, 100);
+            if (1 == ret) {
+                continue;   // timeout or woken up by sig_kill
+            } else if (0 != ret) {
+                printf("[%s] Error: wait for GPIO trigger failed\n", __func__);
+                goto EXIT_SENSOR_IMAGE_THREAD;
+            }
+        }
+
         SSM_Reader_ReturnReceiveNewestBuff(ptSsmHandle, &ssm_buf, eImageBufMode);//VMF_SSM_READER_BLOCK / VMF_SSM_READER_NONBLOCK
         VMF_VSRC_SSM_OUTPUT_INFO_T vsrc_ssm_info;
         VMF_VSRC_SSM_GetInfo(ssm_buf.buffer, &vsrc_ssm_info);
@@ -325,18 +382,52 @@ void *example_sensor_image_thread(void *arg)
             goto EXIT_SENSOR_IMAGE_THREAD;
         }
 
+        VMF_VSRC_SSM_OUTPUT_INFO_T model_ssm_info;
+        if (true == blDownscale) {
+            SSM_Reader_ReturnReceiveNewestBuff(ptModelSsmHandle, &model_ssm_buf, eImageBufMode);
+            if (!model_ssm_buf.buffer) {
+                printf("[%s] model_ssm_buf.buffer = %p, EXIT_SENSOR_IMAGE_THREAD \n", __func__, model_ssm_buf.buffer);
+                goto EXIT_SENSOR_IMAGE_THREAD;
+            }
+            VMF_VSRC_SSM_GetInfo(model_ssm_buf.buffer, &model_ssm_info);
+        }
+
         pthread_mutex_lock(&_mutex_image);
 
-        dma2d_copy(pDmaInfo->ptDmaHandle, pDmaInfo->ptDmaDesc, (void *)_input_data.input_buf_address, ssm_buf.buffer, &vsrc_ssm_info);
+        //! full resolution for the display, with the letterbox it is not submitted
+        dma2d_copy(pDmaInfo->ptDmaHandle, pDmaInfo->ptDmaDesc, (void *)_input_data.input_buf_address, vsrc_ssm_info.dwWidth, vsrc_ssm_info.dwHeight,
+                   ssm_buf.buffer, &vsrc_ssm_info);
+
+        if (true == blDownscale) {
+            dma2d_copy(pDmaInfo->ptDmaHandle, pDmaInfo->ptDmaDesc, (void *)_input_data.inf_buf_address, ptLetterbox->model_width, ptLetterbox->model_height,
+                       model_ssm_buf.buffer, &model_ssm_info);
+
+            _input_data.inf_image_width = ptLetterbox->model_width;
+            _input_data.inf_image_height = ptLetterbox->model_height;
+            _input_data.inf_buf_size = nnm_letterbox_canvas_size(ptLetterbox);
+        }
 
         _input_data.input_image_width = vsrc_ssm_info.dwWidth;
         _input_data.input_image_height = vsrc_ssm_info.dwHeight;
         _input_data.input_image_format = KP_IMAGE_FORMAT_YUV420;
 
         _input_data.input_buf_size = _input_data.input_image_width * _input_data.input_image_height * 1.5;
-        _input_data.input_ready_inf = true;
+        _input_data.trigger_timestamp_ns = tTrigger.timestamp_ns;
+        _input_data.frame_number++;
+
+        //! a static frame is displayed with the last result and not submitted, the NPU idles
+        memset(&tMotion, 0, sizeof(tMotion));
+        tMotion.submit = true;
+        if (true == blMotionGate)
+            nnm_motion_analyze((const uint8_t *)_input_data.input_buf_address, vsrc_ssm_info.dwWidth, &tMotion);
+
+        if (true == tMotion.submit)
+            _input_data.input_ready_inf = true;
 
         pthread_mutex_unlock(&_mutex_image);
+
+        if (true == blTriggered)
+            nnm_gpio_trigger_mark_captured(tTrigger.timestamp_ns);
     }
 
 EXIT_SENSOR_IMAGE_THREAD:
@@ -346,6 +437,11 @@ EXIT_SENSOR_IMAGE_THREAD:
         SSM_Release(ptSsmHandle);
     }
 
+    if (ptModelSsmHandle) {
+        SSM_Reader_ReturnBuff(ptModelSsmHandle, &model_ssm_buf);
+        SSM_Release(ptModelSsmHandle);
+    }
+
     if (g_ptBind)
         release_bind(g_ptBind);
 
@@ -355,6 +451,9 @@ EXIT_SENSOR_IMAGE_THREAD:
     if (0 != _input_data.input_buf_address)
         MemBroker_FreeMemory((void *)_input_data.input_buf_address);
 
+    if (0 != _input_data.inf_buf_address)
+        MemBroker_FreeMemory((void *)_input_data.inf_buf_address);
+
     if (NULL != pDmaInfo)
         dma2d_release(pDmaInfo);
 
@@ -42,12 +42,19 @@ extern "C" {
 
 #include "application_init.h"
 #include "example_shared_struct.h"
-
-//fifo queue buffer setting
+#include "nnm_model_registry.h"
+#include "nnm_gpio_trigger.h"
+#include "nnm_pan_tilt.h"
+#include "nnm_letterbox.h"
+#include "nnm_admission.h"
+#include "nnm_motion.h"
+#include "nnm_fifoq_pool.h"
+#include "kdp2_inf_app_yolo.h"
+
+//fifo queue buffer setting, default of the ini
 #define IMAGE_BUFFER_COUNT      3
 
 #define RESULT_BUFFER_COUNT     3
-#define RESULT_BUFFER_SIZE      512 * 1024
 
 #define EXAMPLE_SENSOR_CONFIG_PATH "./ini/example_sensor.ini"
 
@@ -57,6 +64,7 @@ extern void *example_sensor_image_thread(void *arg);
 extern void *example_send_inf_thread(void *arg);
 extern void *example_recv_result_thread(void *arg);
 extern void *example_display_liveview_thread(void *arg);
+extern void *example_display_spi_lcd_thread(void *arg);
 
 bool _blDispatchRunning = true;
 bool _blFifoqManagerRunning = true;
@@ -66,6 +74,7 @@ extern bool _blResultRunning;
 extern bool _blDisplayRunning;
 
 extern ssm_handle_t  	*gptSsmHandle;
+extern ssm_handle_t     *gptModelSsmHandle;
 
 int loadConfig(const char* HostSensorConfigPath, EXAMPLE_SENSOR_INIT_OPT_T* pExampleSensorInit)
 {
@@ -119,6 +128,42 @@ int loadConfig(const char* HostSensorConfigPath, EXAMPLE_SENSOR_INIT_OPT_T* pExa
     pExampleSensorInit->dwInferenceStream = iniparser_getint(ini, "nnm:InferenceStream", 2);
     pExampleSensorInit->dwJobId = iniparser_getint(ini, "nnm:JobId", 11);
     pExampleSensorInit->dwGetImageBufMode = iniparser_getint(ini, "nnm:GetImageBufMode", 0);
+    pExampleSensorInit->dwModelDownscale = iniparser_getint(ini, "nnm:ModelDownscale", 0);
+    pExampleSensorInit->dwModelWidth = iniparser_getint(ini, "nnm:ModelWidth", 640);
+    pExampleSensorInit->dwModelHeight = iniparser_getint(ini, "nnm:ModelHeight", 640);
+
+    pExampleSensorInit->dwAdmissionMode = iniparser_getint(ini, "fifoq:AdmissionMode", NNM_ADMISSION_MODE_DROPPABLE);
+    pExampleSensorInit->dwImageBufferCount = iniparser_getint(ini, "fifoq:ImageBufferCount", IMAGE_BUFFER_COUNT);
+    pExampleSensorInit->dwResultBufferCount = iniparser_getint(ini, "fifoq:ResultBufferCount", RESULT_BUFFER_COUNT);
+
+    pExampleSensorInit->dwMotionEnable = iniparser_getint(ini, "motion:Enable", 0);
+    pExampleSensorInit->dwMotionDownscale = iniparser_getint(ini, "motion:Downscale", 8);
+    pExampleSensorInit->dwMotionThreshold = iniparser_getint(ini, "motion:Threshold", 10);
+    pExampleSensorInit->dwMotionMinBlocks = iniparser_getint(ini, "motion:MinBlocks", 1);
+    pExampleSensorInit->dwMotionLearnShift = iniparser_getint(ini, "motion:LearnShift", 3);
+    pExampleSensorInit->dwMotionRefreshFrames = iniparser_getint(ini, "motion:RefreshFrames", 150);
+
+    pExampleSensorInit->dwDisplayMode = iniparser_getint(ini, "display:DisplayMode", 0);
+    pExampleSensorInit->fSpiLcdSize = iniparser_getdouble(ini, "display:SpiLcdSize", 1.3);
+
+    pExampleSensorInit->pszTriggerChip = strdup(iniparser_getstring(ini, "trigger:GpioChip", "/dev/gpiochip0"));
+    pExampleSensorInit->sdwTriggerLine = iniparser_getint(ini, "trigger:GpioLine", -1);
+    pExampleSensorInit->dwTriggerEdge = iniparser_getint(ini, "trigger:Edge", 1);
+    pExampleSensorInit->dwTriggerBias = iniparser_getint(ini, "trigger:Bias", 0);
+    pExampleSensorInit->dwTriggerDebounceUs = iniparser_getint(ini, "trigger:DebounceUs", 0);
+
+    pExampleSensorInit->dwTrackingEnable = iniparser_getint(ini, "tracking:Enable", 0);
+    pExampleSensorInit->dwTrackingI2cBus = iniparser_getint(ini, "tracking:I2cBus", 0);
+    pExampleSensorInit->dwTrackingI2cAddr = iniparser_getint(ini, "tracking:I2cAddr", 0x40);
+    pExampleSensorInit->dwTrackingPanChannel = iniparser_getint(ini, "tracking:PanChannel", 0);
+    pExampleSensorInit->dwTrackingTiltChannel = iniparser_getint(ini, "tracking:TiltChannel", 1);
+    pExampleSensorInit->sdwTrackingClass = iniparser_getint(ini, "tracking:TargetClass", 0);
+    pExampleSensorInit->fTrackingKp = iniparser_getdouble(ini, "tracking:Kp", 60.0);
+    pExampleSensorInit->fTrackingKi = iniparser_getdouble(ini, "tracking:Ki", 10.0);
+    pExampleSensorInit->fTrackingKd = iniparser_getdouble(ini, "tracking:Kd", 1.0);
+    pExampleSensorInit->fTrackingDeadZone = iniparser_getdouble(ini, "tracking:DeadZone", 0.03);
+    pExampleSensorInit->dwTrackingPanInvert = iniparser_getint(ini, "tracking:PanInvert", 0);
+    pExampleSensorInit->dwTrackingTiltInvert = iniparser_getint(ini, "tracking:TiltInvert", 1);
 
     if (pExampleSensorInit->dwEisEnable == 1) {
         FILE *fDeviceBufferEnable = NULL;
@@ -137,6 +182,16 @@ int loadConfig(const char* HostSensorConfigPath, EXAMPLE_SENSOR_INIT_OPT_T* pExa
 
     printf("[NNM] Model: %s ImageWidth: %d ImageHeight: %d\n", pExampleSensorInit->pszModelPath, pExampleSensorInit->dwImageWidth, pExampleSensorInit->dwImageHeight);
     printf("[NNM] Model: %s dwJobId: %d \n", pExampleSensorInit->pszModelPath, pExampleSensorInit->dwJobId);
+    printf("[NNM] ModelDownscale: %u ModelWidth: %u ModelHeight: %u\n", pExampleSensorInit->dwModelDownscale, pExampleSensorInit->dwModelWidth, pExampleSensorInit->dwModelHeight);
+    printf("[NNM] AdmissionMode: %s ImageBufferCount: %u ResultBufferCount: %u\n", nnm_admission_mode_name((NNM_ADMISSION_MODE_E)pExampleSensorInit->dwAdmissionMode),
+           pExampleSensorInit->dwImageBufferCount, pExampleSensorInit->dwResultBufferCount);
+    printf("[NNM] Motion: %u downscale %u threshold %u min blocks %u learn shift %u refresh %u\n", pExampleSensorInit->dwMotionEnable,
+           pExampleSensorInit->dwMotionDownscale, pExampleSensorInit->dwMotionThreshold, pExampleSensorInit->dwMotionMinBlocks,
+           pExampleSensorInit->dwMotionLearnShift, pExampleSensorInit->dwMotionRefreshFrames);
+    printf("[NNM] DisplayMode: %d SpiLcdSize: %.2f\n", pExampleSensorInit->dwDisplayMode, pExampleSensorInit->fSpiLcdSize);
+    printf("[NNM] Trigger: %s line %d edge %u\n", pExampleSensorInit->pszTriggerChip, pExampleSensorInit->sdwTriggerLine, pExampleSensorInit->dwTriggerEdge);
+    printf("[NNM] Tracking: %u PCA9685 0x%02x on i2c-%u Kp %.2f Ki %.2f Kd %.2f\n", pExampleSensorInit->dwTrackingEnable, pExampleSensorInit->dwTrackingI2cAddr,
+           pExampleSensorInit->dwTrackingI2cBus, pExampleSensorInit->fTrackingKp, pExampleSensorInit->fTrackingKi, pExampleSensorInit->fTrackingKd);
     iniparser_freedict(ini);
     return 0;
 }
@@ -145,6 +200,8 @@ void sig_kill(int signo)
 {
     if (gptSsmHandle)//get image sensor yuv data on HICO/HOST mode
         SSM_Reader_Wakeup(gptSsmHandle);
+    if (gptModelSsmHandle)
+        SSM_Reader_Wakeup(gptModelSsmHandle);
 
     _blDispatchRunning = false;
     _blFifoqManagerRunning = false;
@@ -154,6 +211,8 @@ void sig_kill(int signo)
     _blResultRunning = false;
     _blDisplayRunning = false;
 
+    //! after the flags, the image thread checks them when it wakes up
+    nnm_gpio_trigger_wakeup();
     VMF_NNM_Fifoq_Manager_Wakeup();
 }
 
@@ -220,6 +279,11 @@ void free_sensor_init(EXAMPLE_SENSOR_INIT_OPT_T* pExampleSensorInit) {
         free(pExampleSensorInit->pszModelPath);
         pExampleSensorInit->pszModelPath = NULL;
     }
+
+    if (pExampleSensorInit->pszTriggerChip) {
+        free(pExampleSensorInit->pszTriggerChip);
+        pExampleSensorInit->pszTriggerChip = NULL;
+    }
 }
 
 int main (int argc, char* argv[])
@@ -263,7 +327,25 @@ int main (int argc, char* argv[])
             goto EXIT;
     }
 
-    ImageBufferSize = ExampleSensorInit.dwImageWidth * ExampleSensorInit.dwImageHeight * 2 + 1024;
+    //! the YUV420 frame of the sensor, the pool adds the inference header
+    ImageBufferSize = nnm_fifoq_pool_image_size(KP_IMAGE_FORMAT_YUV420, ExampleSensorInit.dwImageWidth, ExampleSensorInit.dwImageHeight);
+
+    //! only the letterboxed YUV420 frame is submitted, the image FIFO buffers are sized for the model input
+    if (1 == ExampleSensorInit.dwModelDownscale) {
+        if (0 != nnm_letterbox_init(&ExampleSensorInit.tLetterbox, ExampleSensorInit.dwImageWidth, ExampleSensorInit.dwImageHeight,
+                                    ExampleSensorInit.dwModelWidth, ExampleSensorInit.dwModelHeight)) {
+            printf("[%s] model downscale disabled\n", __func__);
+            ExampleSensorInit.dwModelDownscale = 0;
+        } else {
+            uint32_t FullBufferSize = ImageBufferSize;
+
+            ImageBufferSize = nnm_letterbox_canvas_size(&ExampleSensorInit.tLetterbox);
+            printf("[NNM] letterbox: %ux%u scaled to %ux%u in %ux%u, image FIFO %u KB instead of %u KB\n",
+                   ExampleSensorInit.dwImageWidth, ExampleSensorInit.dwImageHeight, ExampleSensorInit.tLetterbox.scaled_width,
+                   ExampleSensorInit.tLetterbox.scaled_height, ExampleSensorInit.dwModelWidth, ExampleSensorInit.dwModelHeight,
+                   ExampleSensorInit.dwImageBufferCount * ImageBufferSize / 1024, ExampleSensorInit.dwImageBufferCount * FullBufferSize / 1024);
+        }
+    }
 
     //! register signal
     signal(SIGTERM, sig_kill);
@@ -281,14 +363,121 @@ int main (int argc, char* argv[])
     printf("[%s] app_initialize \n", __func__);
     app_initialize();
 
-    VMF_NNM_Load_Model_From_File(ExampleSensorInit.pszModelPath);
+    //! load all models of ModelPath (comma separated), they stay resident until exit
+    if (0 != nnm_model_registry_load(ExampleSensorInit.pszModelPath)) {
+        app_destroy();
+        ret = -1;
+        goto EXIT;
+    }
+
+    //! decides per frame between submit, replacing the queued frame and drop, from the frames in flight and the NPU time
+    {
+        NNM_ADMISSION_CONFIG_T tAdmissionConfig;
+
+        tAdmissionConfig.mode = (NNM_ADMISSION_MODE_E)ExampleSensorInit.dwAdmissionMode;
+        tAdmissionConfig.max_in_flight = ExampleSensorInit.dwImageBufferCount;
+
+        if (0 != nnm_admission_open(&tAdmissionConfig)) {
+            app_destroy();
+            nnm_model_registry_release();
+            ret = -1;
+            goto EXIT;
+        }
+    }
+
+    //! frames are only captured and submitted on the edges of the trigger line
+    if (ExampleSensorInit.sdwTriggerLine >= 0) {
+        NNM_GPIO_TRIGGER_CONFIG_T tTriggerConfig;
+
+        tTriggerConfig.chip_path = ExampleSensorInit.pszTriggerChip;
+        tTriggerConfig.offset = ExampleSensorInit.sdwTriggerLine;
+        tTriggerConfig.edge = (NNM_GPIO_TRIGGER_EDGE_E)ExampleSensorInit.dwTriggerEdge;
+        tTriggerConfig.bias = (NNM_GPIO_TRIGGER_BIAS_E)ExampleSensorInit.dwTriggerBias;
+        tTriggerConfig.debounce_us = ExampleSensorInit.dwTriggerDebounceUs;
+
+        if (0 != nnm_gpio_trigger_open(&tTriggerConfig)) {
+            app_destroy();
+            nnm_model_registry_release();
+            ret = -1;
+            goto EXIT;
+        }
+    }
 
-    VMF_NNM_Fifoq_Manager_Allocate_Buffer(IMAGE_BUFFER_COUNT, ImageBufferSize, RESULT_BUFFER_COUNT, RESULT_BUFFER_SIZE);
+    //! servos follow the detections at result rate, driven from the result thread
+    if (1 == ExampleSensorInit.dwTrackingEnable) {
+        NNM_PAN_TILT_CONFIG_T tPanTiltConfig;
+
+        memset(&tPanTiltConfig, 0, sizeof(tPanTiltConfig));
+        tPanTiltConfig.i2c_bus = ExampleSensorInit.dwTrackingI2cBus;
+        tPanTiltConfig.i2c_addr = ExampleSensorInit.dwTrackingI2cAddr;
+        tPanTiltConfig.pan_channel = ExampleSensorInit.dwTrackingPanChannel;
+        tPanTiltConfig.tilt_channel = ExampleSensorInit.dwTrackingTiltChannel;
+        tPanTiltConfig.min_pulse_us = 500;      // SG90, 0 degrees
+        tPanTiltConfig.max_pulse_us = 2400;     // SG90, 180 degrees
+        tPanTiltConfig.max_angle = 180;
+        tPanTiltConfig.pan.kp = tPanTiltConfig.tilt.kp = ExampleSensorInit.fTrackingKp;
+        tPanTiltConfig.pan.ki = tPanTiltConfig.tilt.ki = ExampleSensorInit.fTrackingKi;
+        tPanTiltConfig.pan.kd = tPanTiltConfig.tilt.kd = ExampleSensorInit.fTrackingKd;
+        tPanTiltConfig.pan.invert = ExampleSensorInit.dwTrackingPanInvert;
+        tPanTiltConfig.tilt.invert = ExampleSensorInit.dwTrackingTiltInvert;
+        tPanTiltConfig.dead_zone = ExampleSensorInit.fTrackingDeadZone;
+        tPanTiltConfig.target_class = ExampleSensorInit.sdwTrackingClass;
+        tPanTiltConfig.lost_results = 15;
+        tPanTiltConfig.frame_width = ExampleSensorInit.dwImageWidth;
+        tPanTiltConfig.frame_height = ExampleSensorInit.dwImageHeight;
+
+        if (0 != nnm_pan_tilt_open(&tPanTiltConfig)) {
+            printf("[%s] pan/tilt tracking disabled\n", __func__);
+            ExampleSensorInit.dwTrackingEnable = 0;
+        }
+    }
+
+    //! free running only, a triggered frame is always wanted
+    if (1 == ExampleSensorInit.dwMotionEnable) {
+        NNM_MOTION_CONFIG_T tMotionConfig;
+
+        tMotionConfig.width = ExampleSensorInit.dwImageWidth;
+        tMotionConfig.height = ExampleSensorInit.dwImageHeight;
+        tMotionConfig.downscale = ExampleSensorInit.dwMotionDownscale;
+        tMotionConfig.threshold = ExampleSensorInit.dwMotionThreshold;
+        tMotionConfig.min_blocks = ExampleSensorInit.dwMotionMinBlocks;
+        tMotionConfig.learn_shift = ExampleSensorInit.dwMotionLearnShift;
+        tMotionConfig.refresh_frames = ExampleSensorInit.dwMotionRefreshFrames;
+
+        if ((ExampleSensorInit.sdwTriggerLine >= 0) || (0 != nnm_motion_open(&tMotionConfig))) {
+            printf("[%s] motion gate disabled\n", __func__);
+            ExampleSensorInit.dwMotionEnable = 0;
+        }
+    }
+
+    //! FIFO queue buffers of the submitted frame and the yolo result
+    {
+        NNM_FIFOQ_POOL_STREAM_T tStream;
+
+        tStream.name = "sensor";
+        tStream.image_size = ImageBufferSize;
+        tStream.image_count = ExampleSensorInit.dwImageBufferCount;
+        tStream.result_size = sizeof(kdp2_ipc_app_yolo_result_t);
+        tStream.result_count = ExampleSensorInit.dwResultBufferCount;
+
+        if ((0 != nnm_fifoq_pool_add_stream(&tStream)) || (0 != nnm_fifoq_pool_allocate())) {
+            nnm_motion_close();
+            nnm_pan_tilt_close();
+            nnm_gpio_trigger_close();
+            app_destroy();
+            nnm_model_registry_release();
+            ret = -1;
+            goto EXIT;
+        }
+    }
 
     pthread_create(&task_sensor_image_handle, NULL, example_sensor_image_thread, &ExampleSensorInit);
     pthread_create(&task_send_inf_handle, NULL, example_send_inf_thread, &ExampleSensorInit.dwJobId);
-    pthread_create(&task_recv_result_handle, NULL, example_recv_result_thread, NULL);
-    pthread_create(&task_display_handle, NULL, example_display_liveview_thread, NULL);
+    pthread_create(&task_recv_result_handle, NULL, example_recv_result_thread, &ExampleSensorInit);
+    if (1 == ExampleSensorInit.dwDisplayMode)
+        pthread_create(&task_display_handle, NULL, example_display_spi_lcd_thread, &ExampleSensorInit);
+    else
+        pthread_create(&task_display_handle, NULL, example_display_liveview_thread, NULL);
 
     pthread_create(&task_buf_mgr_handle, NULL, VMF_NNM_Fifoq_Manager_Enqueue_Image_Thread, &_blFifoqManagerRunning);
     pthread_create(&task_inf_data_handle, NULL, VMF_NNM_Inference_Image_Dispatcher_Thread, &_blDispatchRunning);
@@ -301,8 +490,60 @@ int main (int argc, char* argv[])
     pthread_join(task_buf_mgr_handle, NULL);
     pthread_join(task_inf_data_handle, NULL);
 
+    {
+        NNM_ADMISSION_STATS_T tAdmissionStats;
+
+        nnm_admission_get_stats(&tAdmissionStats);
+        printf("[NNM] admission %s: %u submitted, %u completed, %u skipped, %u replaced, %u lost, %u in flight max\n",
+               nnm_admission_mode_name(tAdmissionStats.mode), tAdmissionStats.submitted, tAdmissionStats.completed, tAdmissionStats.skipped,
+               tAdmissionStats.replaced, tAdmissionStats.lost, tAdmissionStats.in_flight_max);
+        printf("[NNM] admission: %.2f fps, NPU service %.3f ms, prepare %.3f ms, latency %.3f ms max %.3f ms\n",
+               tAdmissionStats.fps, tAdmissionStats.service_ms, tAdmissionStats.prep_ms, tAdmissionStats.latency_ms, tAdmissionStats.latency_max_ms);
+    }
+
+    if (1 == ExampleSensorInit.dwMotionEnable) {
+        NNM_MOTION_STATS_T tMotionStats;
+        NNM_ADMISSION_STATS_T tAdmissionStats;
+
+        nnm_motion_get_stats(&tMotionStats);
+        nnm_admission_get_stats(&tAdmissionStats);
+        printf("[NNM] motion: %u frames, %u motion, %u refreshed, %u skipped, %.1f of %u blocks changed on motion, analyze %.3f/%.3f ms\n",
+               tMotionStats.frames, tMotionStats.motion, tMotionStats.refreshed, tMotionStats.skipped, tMotionStats.changed_blocks_avg,
+               tMotionStats.blocks, tMotionStats.analyze_avg_ms, tMotionStats.analyze_max_ms);
+        if (0 != tMotionStats.frames) {
+            printf("[NNM] motion: NPU spared %.1f%% of the frames, about %.1f s at %.3f ms per frame\n",
+                   100.0 * tMotionStats.skipped / tMotionStats.frames, tMotionStats.skipped * tAdmissionStats.service_ms / 1000.0,
+                   tAdmissionStats.service_ms);
+        }
+        nnm_motion_close();
+    }
+
+    if (ExampleSensorInit.sdwTriggerLine >= 0) {
+        NNM_GPIO_TRIGGER_STATS_T tTriggerStats;
+
+        nnm_gpio_trigger_get_stats(&tTriggerStats);
+        printf("[NNM] trigger: %u edges, %u dropped, %u captured, %u submitted\n",
+               tTriggerStats.events, tTriggerStats.dropped, tTriggerStats.captured, tTriggerStats.submitted);
+        printf("[NNM] trigger latency (avg/max ms): dispatch %.3f/%.3f capture %.3f/%.3f submit %.3f/%.3f\n",
+               tTriggerStats.dispatch_avg_ms, tTriggerStats.dispatch_max_ms, tTriggerStats.capture_avg_ms,
+               tTriggerStats.capture_max_ms, tTriggerStats.submit_avg_ms, tTriggerStats.submit_max_ms);
+        nnm_gpio_trigger_close();
+    }
+
+    if (1 == ExampleSensorInit.dwTrackingEnable) {
+        NNM_PAN_TILT_STATS_T tPanTiltStats;
+
+        nnm_pan_tilt_get_stats(&tPanTiltStats);
+        printf("[NNM] tracking: %u results, %u tracked, %u PWM updates, pan %.1f tilt %.1f\n",
+               tPanTiltStats.results, tPanTiltStats.tracked, tPanTiltStats.updates, tPanTiltStats.pan, tPanTiltStats.tilt);
+        printf("[NNM] tracking latency (avg/max ms): dequeue to PWM %.3f/%.3f I2C write %.3f/%.3f\n",
+               tPanTiltStats.latency_avg_ms, tPanTiltStats.latency_max_ms, tPanTiltStats.write_avg_ms, tPanTiltStats.write_max_ms);
+        nnm_pan_tilt_close();
+    }
+
     app_destroy();  //VMF_NNM_Inference_App_Destroy();
-    VMF_NNM_Fifoq_Manager_Release_All_Buffer();
+    nnm_fifoq_pool_release();
+    nnm_model_registry_release();
     ret = 0;
 
 EXIT:
@@ -44,13 +44,20 @@ int draw_display_image(cv::Mat *cv_img_display, const char *strImgFPS, const cha
 
     if (KDP2_INF_ID_APP_YOLO == header_stamp->job_id)
     {
+        char strTrackId[16];
+
         pthread_mutex_lock(&_mutex_result);
-        kdp2_ipc_app_yolo_result_t *app_yolo_result = (kdp2_ipc_app_yolo_result_t *)header_stamp;
-        kp_app_yolo_result_t *yolo_result = (kp_app_yolo_result_t *)&app_yolo_result->yolo_data;
+        bytetrack_object_t *track_objects = (bytetrack_object_t *)_inf_result.track_objects;
+
+        for (int i = 0; i < _inf_result.track_count; i++) {
+            kp_bounding_box_t *box = &track_objects[i].box;
+
+            cv::rectangle(*cv_img_display, cv::Point(box->x1, box->y1),
+                            cv::Point(box->x2, box->y2), cv::Scalar(50, 255, 50), 2);
 
-        for (uint32_t i = 0; i < yolo_result->box_count; i++) {
-            cv::rectangle(*cv_img_display, cv::Point(yolo_result->boxes[i].x1, yolo_result->boxes[i].y1),
-                            cv::Point(yolo_result->boxes[i].x2, yolo_result->boxes[i].y2), cv::Scalar(50, 255, 50), 2);
+            sprintf(strTrackId, "id %u", track_objects[i].track_id);
+            cv::putText(*cv_img_display, strTrackId, cv::Point(box->x1, (box->y1 > 15) ? box->y1 - 5 : box->y1 + 15),
+                        cv::FONT_HERSHEY_COMPLEX_SMALL, 1, cv::Scalar(50, 255, 50), 1);
         }
         pthread_mutex_unlock(&_mutex_result);
 
@@ -22,6 +22,7 @@
 #define EXAMPLE_SHARED_STRUCT_H
 
 #include "kp_struct.h"
+#include "bytetrack.h"
 
 /**
  * @brief describe example webcam configuration
@@ -35,6 +36,8 @@ typedef struct
     unsigned int dwImageWidth;      //! Input image width
     unsigned int dwImageHeight;     //! Input image height
     unsigned int dwFps;             // feed image fps
+    unsigned int dwMaxImageWidth;   //! largest frame the camera may deliver, sizes the image FIFO buffers
+    unsigned int dwMaxImageHeight;
 } EXAMPLE_WEBCAM_INIT_OPT_T;
 
 /**
@@ -59,6 +62,10 @@ typedef struct {
     int result_buffer_size;
     uintptr_t result_buffer;
     bool result_ready_display;
+
+    /* Used when result is YOLO boxes, tracked by bytetrack */
+    int track_count;
+    bytetrack_object_t track_objects[YOLO_GOOD_BOX_MAX];
 } NNM_SHARED_RESULT_T;
 
 #endif  // EXAMPLE_SHARED_STRUCT_H
\ No newline at end of file
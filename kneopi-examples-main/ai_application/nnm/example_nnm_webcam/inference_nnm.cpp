@@ -205,6 +205,12 @@ void *example_recv_result_thread(void *)
     int buf_size = 0;
     int sts = 0;
 
+    bytetrack_t *tracker = bytetrack_create(NULL);
+    if (NULL == tracker) {
+        printf("[%s] Error: create tracker failed.\n", __FUNCTION__);
+        goto EXIT_UPDATE_RESULT_THREAD;
+    }
+
     while (true == _blResultRunning) {
         // get result data from queue blocking wait
         int ret = VMF_NNM_Fifoq_Manager_Result_Dequeue(&buf_addr, &phy_buf_addr, &buf_size, -1);
@@ -231,6 +237,15 @@ void *example_recv_result_thread(void *)
         pthread_mutex_lock(&_mutex_result);
 
         memcpy((void *)_inf_result.result_buffer, (void *)buf_addr, buf_size);
+
+        // track the boxes once per result, so the display gets stable boxes and track IDs
+        if (KDP2_INF_ID_APP_YOLO == header_stamp->job_id) {
+            kp_app_yolo_result_t *yolo_result = &((kdp2_ipc_app_yolo_result_t *)header_stamp)->yolo_data;
+
+            _inf_result.track_count = bytetrack_update(tracker, yolo_result->box_count, yolo_result->boxes,
+                                                       YOLO_GOOD_BOX_MAX, _inf_result.track_objects);
+        }
+
         _inf_result.result_ready_display = true;
 
         pthread_mutex_unlock(&_mutex_result);
@@ -253,6 +268,8 @@ EXIT_UPDATE_RESULT_THREAD:
         free((void *)_inf_result.result_buffer);
     }
 
+    bytetrack_destroy(tracker);
+
     _blImageRunning = false;
     _blSendInfRunning = false;
     _blDisplayRunning = false;
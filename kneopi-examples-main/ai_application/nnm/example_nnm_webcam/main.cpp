@@ -38,11 +38,12 @@ extern "C" {
 
 #include "application_init.h"
 #include "example_shared_struct.h"
+#include "nnm_model_registry.h"
+#include "nnm_fifoq_pool.h"
+#include "kdp2_inf_app_yolo.h"
 
 #define IMAGE_BUFFER_COUNT      3
-#define IMAGE_BUFFER_SIZE       (4 * 1920 * 1080 + 1024)
 #define RESULT_BUFFER_COUNT     3
-#define RESULT_BUFFER_SIZE      (1024 * 1024)
 
 #define EXAMPLE_WEBCAM_CONFIG_PATH "./ini/example_webcam.ini"
 
@@ -83,6 +84,8 @@ int loadConfig(const char* HostVerifyConfigPath, EXAMPLE_WEBCAM_INIT_OPT_T* pExa
         printf("[Fps = 0], set a default fps %f.\n", pExampleWebCamInit->dwFps);
     }
     pExampleWebCamInit->pszCameraPath = strdup(iniparser_getstring(ini, "nnm:CameraPath", "/dev/video0"));
+    pExampleWebCamInit->dwMaxImageWidth = iniparser_getint(ini, "nnm:MaxImageWidth", pExampleWebCamInit->dwImageWidth);
+    pExampleWebCamInit->dwMaxImageHeight = iniparser_getint(ini, "nnm:MaxImageHeight", pExampleWebCamInit->dwImageHeight);
 
     printf("[NNM] Model: %s pszCameraPath: %s \n", pExampleWebCamInit->pszModelPath, pExampleWebCamInit->pszCameraPath);
 	printf("[NNM] Model: %s ImageWidth: %d ImageHeight: %d Fps: %u \n", pExampleWebCamInit->pszModelPath, pExampleWebCamInit->dwImageWidth, pExampleWebCamInit->dwImageHeight, pExampleWebCamInit->dwFps);
@@ -195,9 +198,30 @@ int main (int argc, char* argv[])
     printf("[%s] app_initialize \n", __func__);
     app_initialize();   //VMF_NNM_Inference_App_Init(_app_func);
 
-    VMF_NNM_Load_Model_From_File(ExampleWebCamInit.pszModelPath);
+    //! load all models of ModelPath (comma separated), they stay resident until exit
+    if (0 != nnm_model_registry_load(ExampleWebCamInit.pszModelPath)) {
+        app_destroy();
+        ret = -1;
+        goto EXIT;
+    }
+
+    //! FIFO queue buffers of the RGBA8888 camera frame and the yolo result
+    {
+        NNM_FIFOQ_POOL_STREAM_T tStream;
+
+        tStream.name = ExampleWebCamInit.pszCameraPath;
+        tStream.image_size = nnm_fifoq_pool_image_size(KP_IMAGE_FORMAT_RGBA8888, ExampleWebCamInit.dwMaxImageWidth, ExampleWebCamInit.dwMaxImageHeight);
+        tStream.image_count = IMAGE_BUFFER_COUNT;
+        tStream.result_size = sizeof(kdp2_ipc_app_yolo_result_t);
+        tStream.result_count = RESULT_BUFFER_COUNT;
 
-    VMF_NNM_Fifoq_Manager_Allocate_Buffer(IMAGE_BUFFER_COUNT, IMAGE_BUFFER_SIZE, RESULT_BUFFER_COUNT, RESULT_BUFFER_SIZE);
+        if ((0 != nnm_fifoq_pool_add_stream(&tStream)) || (0 != nnm_fifoq_pool_allocate())) {
+            app_destroy();
+            nnm_model_registry_release();
+            ret = -1;
+            goto EXIT;
+        }
+    }
 
     pthread_create(&task_webcam_image_handle, NULL, example_webcam_input_thread, &ExampleWebCamInit);
     pthread_create(&task_send_inf_handle, NULL, example_send_inf_thread, &ExampleWebCamInit.dwJobId);
@@ -216,7 +240,8 @@ int main (int argc, char* argv[])
     pthread_join(task_inf_data_handle, NULL);
 
     app_destroy();  //VMF_NNM_Inference_App_Destroy();
-    VMF_NNM_Fifoq_Manager_Release_All_Buffer();
+    nnm_fifoq_pool_release();
+    nnm_model_registry_release();
 EXIT:
 
     if (ExampleWebCamInit.pszModelPath)
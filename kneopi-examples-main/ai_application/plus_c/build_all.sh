@@ -4,7 +4,7 @@ BGREEN='\033[1;32m'
 BWHITE='\033[1;37m'
 NC='\033[0m'
 
-BUILD_ARR=("none" "scan_devices" "kl730_demo_generic_data_inference" "kl730_demo_generic_image_inference" "All basic examples" "kl730_demo_cam_generic_image_inference_drop_frame" "All examples")
+BUILD_ARR=("none" "scan_devices" "kl730_demo_generic_data_inference" "kl730_demo_generic_image_inference" "All basic examples" "kl730_demo_cam_generic_image_inference_drop_frame" "All examples" "pixel_convert_benchmark")
 
 rm -rf build
 rm -rf bin
@@ -26,13 +26,15 @@ else
 	echo "[5] kl730_demo_cam_generic_image_inference_drop_frame"
 	echo "---------------- All Examples ------------------"
 	echo "[6] All examples"
+	echo "---------------- Tools -------------------------"
+	echo "[7] pixel_convert_benchmark"
 	echo -e "$BWHITE"
-	read -p "Please enter 1-6: " BUILD_NUM
+	read -p "Please enter 1-7: " BUILD_NUM
 	echo -e "$NC"
 fi
 
 case $BUILD_NUM in
-	"1"|"2"|"3"|"5")
+	"1"|"2"|"3"|"5"|"7")
 		echo -e "\n$BGREEN[BUILD] ${BUILD_ARR[$BUILD_NUM]}$NC\n"
 		rm -rf build
 		mkdir build
@@ -0,0 +1,829 @@
+/**
+ * @file        bytetrack.cpp
+ * @brief       ByteTrack multi-object tracker
+ *
+ * Follows BYTETracker.update() of plus_python/utils/postprocess/bytetrack_postprocess.py step by step.
+ *
+ * Track states are kept as structure of arrays indexed by a track slot. With the constant velocity model
+ * of kalman_filter.py the 8x8 covariance never couples different measurement dimensions: x, y, a and h
+ * each only correlate with their own velocity. Every track therefore carries four symmetric 2x2 blocks,
+ * and predict/update are element-wise loops instead of 8x8 matrix products and Cholesky solves, with
+ * exactly the same result.
+ *
+ * @version     0.1
+ * @date        2021-03-22
+ *
+ * @copyright   Copyright (c) 2021 Kneron Inc. All rights reserved.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <new>
+#include <vector>
+#include <algorithm>
+
+#include "bytetrack.h"
+
+#define BYTETRACK_STD_WEIGHT_POSITION       (1.0f / 20)
+#define BYTETRACK_STD_WEIGHT_VELOCITY       (1.0f / 160)
+#define BYTETRACK_LOW_SCORE_THRESH          0.1f    // tau_low, detections below are dropped
+#define BYTETRACK_SECOND_MATCH_THRESH       0.5f    // low score detections to remaining tracks
+#define BYTETRACK_UNCONFIRMED_MATCH_THRESH  0.7f    // remaining detections to unconfirmed tracks
+#define BYTETRACK_DUPLICATE_IOU_DISTANCE    0.15f   // tracked and lost tracks overlapping by 85% are duplicates
+
+#define BYTETRACK_COST_INFEASIBLE           1e9
+
+enum
+{
+    TRACK_STATE_NEW = 0,
+    TRACK_STATE_TRACKED,
+    TRACK_STATE_LOST,
+    TRACK_STATE_REMOVED,
+};
+
+enum
+{
+    DIM_X = 0,      // box center x
+    DIM_Y,          // box center y
+    DIM_A,          // aspect ratio, width / height
+    DIM_H,          // box height
+    DIM_NUM,
+};
+
+typedef struct
+{
+    float x1, y1, x2, y2;
+    float score;
+    int32_t class_num;
+} DETECTION;
+
+struct bytetrack_s
+{
+    bytetrack_config_t config;
+    float det_thresh;
+    int max_time_lost;
+    int frame_id;
+    uint32_t last_track_id;
+
+    /* track slots, structure of arrays */
+    int slot_count;
+    std::vector<float> pos[DIM_NUM];        // mean of (x, y, a, h)
+    std::vector<float> vel[DIM_NUM];        // mean of the velocities
+    std::vector<float> cov_pp[DIM_NUM];     // covariance blocks [pp pv; pv vv] of each dimension
+    std::vector<float> cov_pv[DIM_NUM];
+    std::vector<float> cov_vv[DIM_NUM];
+    std::vector<float> score;
+    std::vector<int32_t> class_num;
+    std::vector<uint32_t> track_id;
+    std::vector<int> state;
+    std::vector<int> is_activated;
+    std::vector<int> last_frame;
+    std::vector<int> start_frame;
+    std::vector<int> mark;                  // scratch flag of list operations
+    std::vector<int> free_slots;
+
+    std::vector<int> tracked;               // tracked_stracks
+    std::vector<int> lost;                  // lost_stracks
+
+    /* per frame scratch buffers, kept to avoid allocations at frame rate */
+    std::vector<DETECTION> dets_high;
+    std::vector<DETECTION> dets_low;
+    std::vector<DETECTION> dets_remain;
+    std::vector<int> pool;
+    std::vector<int> unconfirmed;
+    std::vector<int> remain_tracks;
+    std::vector<int> activated;
+    std::vector<int> refind;
+    std::vector<int> lost_new;
+    std::vector<int> list_tmp;
+    std::vector<float> box_x1, box_y1, box_x2, box_y2;
+    std::vector<float> cost;
+    std::vector<int> row_match;
+    std::vector<int> col_match;
+
+    /* linear assignment workspace */
+    std::vector<int> la_rows, la_cols;
+    std::vector<int> la_row_cand, la_col_cand, la_row_cand_count, la_col_cand_count;
+    std::vector<double> la_u, la_v, la_minv;
+    std::vector<int> la_p, la_way;
+    std::vector<char> la_used;
+};
+
+static void resize_slots(bytetrack_t *t, int count)
+{
+    for (int d = 0; d < DIM_NUM; d++)
+    {
+        t->pos[d].resize(count);
+        t->vel[d].resize(count);
+        t->cov_pp[d].resize(count);
+        t->cov_pv[d].resize(count);
+        t->cov_vv[d].resize(count);
+    }
+    t->score.resize(count);
+    t->class_num.resize(count);
+    t->track_id.resize(count);
+    t->state.resize(count, TRACK_STATE_REMOVED);
+    t->is_activated.resize(count);
+    t->last_frame.resize(count);
+    t->start_frame.resize(count);
+    t->mark.resize(count, 0);
+}
+
+static int alloc_slot(bytetrack_t *t)
+{
+    if (t->free_slots.empty())
+    {
+        int count = t->slot_count;
+        int new_count = (count < 32) ? 32 : count * 2;
+
+        resize_slots(t, new_count);
+        for (int s = new_count - 1; s >= count; s--)
+            t->free_slots.push_back(s);
+        t->slot_count = new_count;
+    }
+
+    int slot = t->free_slots.back();
+    t->free_slots.pop_back();
+    return slot;
+}
+
+/******************************************************************************
+ * Kalman filter
+ ******************************************************************************/
+
+static void kalman_initiate(bytetrack_t *t, int s, const DETECTION *det)
+{
+    float w = det->x2 - det->x1;
+    float h = det->y2 - det->y1;
+    float std_pos = 2 * BYTETRACK_STD_WEIGHT_POSITION * h;
+    float std_vel = 10 * BYTETRACK_STD_WEIGHT_VELOCITY * h;
+
+    t->pos[DIM_X][s] = det->x1 + w / 2;
+    t->pos[DIM_Y][s] = det->y1 + h / 2;
+    t->pos[DIM_A][s] = w / h;
+    t->pos[DIM_H][s] = h;
+
+    for (int d = 0; d < DIM_NUM; d++)
+    {
+        float sp = (DIM_A == d) ? 1e-2f : std_pos;
+        float sv = (DIM_A == d) ? 1e-5f : std_vel;
+
+        t->vel[d][s] = 0;
+        t->cov_pp[d][s] = sp * sp;
+        t->cov_pv[d][s] = 0;
+        t->cov_vv[d][s] = sv * sv;
+    }
+}
+
+// STrack.multi_predict(), mean' = F * mean, P' = F * P * F^T + Q
+static void kalman_predict(bytetrack_t *t, const int *slots, int count)
+{
+    // the noise depends on the height before the prediction, DIM_H is the last dimension updated below
+    const float *h = t->pos[DIM_H].data();
+
+    // velocity of the height is reset for tracks which are not tracked in the last frame
+    for (int i = 0; i < count; i++)
+    {
+        if (TRACK_STATE_TRACKED != t->state[slots[i]])
+            t->vel[DIM_H][slots[i]] = 0;
+    }
+
+    for (int d = 0; d < DIM_NUM; d++)
+    {
+        float *pos = t->pos[d].data();
+        float *vel = t->vel[d].data();
+        float *pp = t->cov_pp[d].data();
+        float *pv = t->cov_pv[d].data();
+        float *vv = t->cov_vv[d].data();
+
+        for (int i = 0; i < count; i++)
+        {
+            int s = slots[i];
+            float sp = (DIM_A == d) ? 1e-2f : BYTETRACK_STD_WEIGHT_POSITION * h[s];
+            float sv = (DIM_A == d) ? 1e-5f : BYTETRACK_STD_WEIGHT_VELOCITY * h[s];
+
+            pos[s] += vel[s];
+            pp[s] += 2 * pv[s] + vv[s] + sp * sp;
+            pv[s] += vv[s];
+            vv[s] += sv * sv;
+        }
+    }
+}
+
+// KalmanFilter.update(), the projected covariance is diagonal so the Kalman gain is a scalar pair per dimension
+static void kalman_update(bytetrack_t *t, int s, const DETECTION *det)
+{
+    float w = det->x2 - det->x1;
+    float h = det->y2 - det->y1;
+    float measurement[DIM_NUM] = {det->x1 + w / 2, det->y1 + h / 2, w / h, h};
+    float std_pos = BYTETRACK_STD_WEIGHT_POSITION * t->pos[DIM_H][s];
+
+    for (int d = 0; d < DIM_NUM; d++)
+    {
+        float r = (DIM_A == d) ? 1e-1f : std_pos;
+        float pp = t->cov_pp[d][s];
+        float pv = t->cov_pv[d][s];
+        float vv = t->cov_vv[d][s];
+        float innovation_cov = pp + r * r;
+        float gain_p = pp / innovation_cov;
+        float gain_v = pv / innovation_cov;
+        float innovation = measurement[d] - t->pos[d][s];
+
+        t->pos[d][s] += gain_p * innovation;
+        t->vel[d][s] += gain_v * innovation;
+        t->cov_pp[d][s] = pp - gain_p * pp;
+        t->cov_pv[d][s] = pv - gain_p * pv;
+        t->cov_vv[d][s] = vv - gain_v * pv;
+    }
+}
+
+/******************************************************************************
+ * track operations of STrack
+ ******************************************************************************/
+
+static void track_activate(bytetrack_t *t, int s, const DETECTION *det)
+{
+    kalman_initiate(t, s, det);
+
+    t->score[s] = det->score;
+    t->class_num[s] = det->class_num;
+    t->track_id[s] = ++t->last_track_id;
+    t->state[s] = TRACK_STATE_TRACKED;
+    t->is_activated[s] = (1 == t->frame_id);    // tracks born after the first frame need a second hit
+    t->last_frame[s] = t->frame_id;
+    t->start_frame[s] = t->frame_id;
+}
+
+// STrack.update() and STrack.re_activate()
+static void track_update(bytetrack_t *t, int s, const DETECTION *det)
+{
+    kalman_update(t, s, det);
+
+    t->score[s] = det->score;
+    t->class_num[s] = det->class_num;
+    t->state[s] = TRACK_STATE_TRACKED;
+    t->is_activated[s] = 1;
+    t->last_frame[s] = t->frame_id;
+}
+
+static void track_boxes(bytetrack_t *t, const int *slots, int count)
+{
+    t->box_x1.resize(count);
+    t->box_y1.resize(count);
+    t->box_x2.resize(count);
+    t->box_y2.resize(count);
+
+    for (int i = 0; i < count; i++)
+    {
+        int s = slots[i];
+        float h = t->pos[DIM_H][s];
+        float w = t->pos[DIM_A][s] * h;
+
+        t->box_x1[i] = t->pos[DIM_X][s] - w / 2;
+        t->box_y1[i] = t->pos[DIM_Y][s] - h / 2;
+        t->box_x2[i] = t->box_x1[i] + w;
+        t->box_y2[i] = t->box_y1[i] + h;
+    }
+}
+
+/******************************************************************************
+ * matching
+ ******************************************************************************/
+
+// matching.iou_distance() (and matching.fuse_score() if fuse_score) between the boxes of track_boxes() and dets
+static void iou_cost_matrix(bytetrack_t *t, const int *slots, int track_count,
+                            const DETECTION *dets, int det_count, bool fuse_score, bool class_aware)
+{
+    track_boxes(t, slots, track_count);
+    t->cost.resize((size_t)track_count * det_count);
+
+    for (int i = 0; i < track_count; i++)
+    {
+        float tx1 = t->box_x1[i];
+        float ty1 = t->box_y1[i];
+        float tx2 = t->box_x2[i];
+        float ty2 = t->box_y2[i];
+        float track_area = (tx2 - tx1 + 1) * (ty2 - ty1 + 1);
+        float *cost = &t->cost[(size_t)i * det_count];
+
+        for (int j = 0; j < det_count; j++)
+        {
+            const DETECTION *det = &dets[j];
+            float iw = std::min(tx2, det->x2) - std::max(tx1, det->x1) + 1;
+            float ih = std::min(ty2, det->y2) - std::max(ty1, det->y1) + 1;
+            float inter = std::max(iw, 0.0f) * std::max(ih, 0.0f);
+            float det_area = (det->x2 - det->x1 + 1) * (det->y2 - det->y1 + 1);
+            float iou = inter / (track_area + det_area - inter);
+
+            cost[j] = 1 - (fuse_score ? iou * det->score : iou);
+        }
+
+        if (class_aware)
+        {
+            for (int j = 0; j < det_count; j++)
+            {
+                if (t->class_num[slots[i]] != dets[j].class_num)
+                    cost[j] = 1;
+            }
+        }
+    }
+}
+
+// e-maxx Hungarian (shortest augmenting path with potentials) on rows x (cols + rows) matrix,
+// column cols + i is the private "unmatched" choice of row i at cost thresh.
+static void hungarian_with_reject(bytetrack_t *t, int rows, int cols, float thresh)
+{
+    const std::vector<int> &row_index = t->la_rows;
+    const std::vector<int> &col_index = t->la_cols;
+    const int det_count = (int)t->col_match.size();
+    const int m = cols + rows;
+
+    t->la_u.assign(rows + 1, 0);
+    t->la_v.assign(m + 1, 0);
+    t->la_p.assign(m + 1, 0);
+    t->la_way.assign(m + 1, 0);
+    t->la_minv.resize(m + 1);
+    t->la_used.resize(m + 1);
+
+    double *u = t->la_u.data();
+    double *v = t->la_v.data();
+    double *minv = t->la_minv.data();
+    int *p = t->la_p.data();
+    int *way = t->la_way.data();
+    char *used = t->la_used.data();
+
+    for (int i = 1; i <= rows; i++)
+    {
+        int j0 = 0;
+
+        p[0] = i;
+        std::fill(minv, minv + m + 1, HUGE_VAL);
+        std::fill(used, used + m + 1, 0);
+
+        do
+        {
+            int i0 = p[j0];
+            int j1 = 0;
+            double delta = HUGE_VAL;
+            const float *cost_row = &t->cost[(size_t)row_index[i0 - 1] * det_count];
+
+            used[j0] = 1;
+
+            for (int j = 1; j <= m; j++)
+            {
+                if (used[j])
+                    continue;
+
+                double c;
+                if (j <= cols) {
+                    c = cost_row[col_index[j - 1]];
+                    if (c >= thresh)
+                        c = BYTETRACK_COST_INFEASIBLE;
+                } else {
+                    c = (j - cols == i0) ? thresh : BYTETRACK_COST_INFEASIBLE;
+                }
+
+                double cur = c - u[i0] - v[j];
+                if (cur < minv[j]) {
+                    minv[j] = cur;
+                    way[j] = j0;
+                }
+                if (minv[j] < delta) {
+                    delta = minv[j];
+                    j1 = j;
+                }
+            }
+
+            for (int j = 0; j <= m; j++)
+            {
+                if (used[j]) {
+                    u[p[j]] += delta;
+                    v[j] -= delta;
+                } else {
+                    minv[j] -= delta;
+                }
+            }
+
+            j0 = j1;
+        } while (0 != p[j0]);
+
+        do
+        {
+            int j1 = way[j0];
+            p[j0] = p[j1];
+            j0 = j1;
+        } while (0 != j0);
+    }
+
+    for (int j = 1; j <= cols; j++)
+    {
+        if (0 == p[j])
+            continue;
+
+        int row = row_index[p[j] - 1];
+        int col = col_index[j - 1];
+        t->row_match[row] = col;
+        t->col_match[col] = row;
+    }
+}
+
+// matching.linear_assignment(): minimum cost assignment of t->cost where pairs with cost >= thresh stay unmatched.
+// Results are in t->row_match and t->col_match, -1 for unmatched.
+static void linear_assignment(bytetrack_t *t, int rows, int cols, float thresh)
+{
+    t->row_match.assign(rows, -1);
+    t->col_match.assign(cols, -1);
+
+    if (0 == rows || 0 == cols)
+        return;
+
+    // count the feasible candidates of every row and column
+    t->la_row_cand_count.assign(rows, 0);
+    t->la_col_cand_count.assign(cols, 0);
+    t->la_row_cand.resize(rows);
+    t->la_col_cand.resize(cols);
+
+    for (int i = 0; i < rows; i++)
+    {
+        const float *cost = &t->cost[(size_t)i * cols];
+
+        for (int j = 0; j < cols; j++)
+        {
+            if (cost[j] < thresh) {
+                t->la_row_cand_count[i]++;
+                t->la_row_cand[i] = j;
+                t->la_col_cand_count[j]++;
+                t->la_col_cand[j] = i;
+            }
+        }
+    }
+
+    // a row and a column which are the only candidate of each other are matched in any optimal assignment,
+    // this resolves most pairs of a tracking frame without the O(n^3) solver
+    t->la_rows.clear();
+    t->la_cols.clear();
+
+    for (int i = 0; i < rows; i++)
+    {
+        if (0 == t->la_row_cand_count[i])
+            continue;
+
+        int j = t->la_row_cand[i];
+        if (1 == t->la_row_cand_count[i] && 1 == t->la_col_cand_count[j]) {
+            t->row_match[i] = j;
+            t->col_match[j] = i;
+        } else {
+            t->la_rows.push_back(i);
+        }
+    }
+
+    if (t->la_rows.empty())
+        return;
+
+    for (int j = 0; j < cols; j++)
+    {
+        if (0 < t->la_col_cand_count[j] && -1 == t->col_match[j])
+            t->la_cols.push_back(j);
+    }
+
+    hungarian_with_reject(t, (int)t->la_rows.size(), (int)t->la_cols.size(), thresh);
+}
+
+/******************************************************************************
+ * list operations of BYTETracker
+ ******************************************************************************/
+
+// joint_stracks(), append tracks of src not in dst yet
+static void joint_tracks(bytetrack_t *t, std::vector<int> &dst, const std::vector<int> &src)
+{
+    for (size_t i = 0; i < dst.size(); i++)
+        t->mark[dst[i]] = 1;
+
+    for (size_t i = 0; i < src.size(); i++)
+    {
+        if (!t->mark[src[i]]) {
+            t->mark[src[i]] = 1;
+            dst.push_back(src[i]);
+        }
+    }
+
+    for (size_t i = 0; i < dst.size(); i++)
+        t->mark[dst[i]] = 0;
+}
+
+// remove_duplicate_stracks(), of a tracked and a lost track overlapping each other, the younger one is dropped
+static void remove_duplicate_tracks(bytetrack_t *t)
+{
+    int tracked_count = (int)t->tracked.size();
+    int lost_count = (int)t->lost.size();
+
+    if (0 == tracked_count || 0 == lost_count)
+        return;
+
+    std::vector<DETECTION> &lost_boxes = t->dets_remain;
+    lost_boxes.resize(lost_count);
+    track_boxes(t, t->lost.data(), lost_count);
+
+    for (int j = 0; j < lost_count; j++)
+    {
+        lost_boxes[j].x1 = t->box_x1[j];
+        lost_boxes[j].y1 = t->box_y1[j];
+        lost_boxes[j].x2 = t->box_x2[j];
+        lost_boxes[j].y2 = t->box_y2[j];
+        lost_boxes[j].score = 1;
+        lost_boxes[j].class_num = t->class_num[t->lost[j]];
+    }
+
+    iou_cost_matrix(t, t->tracked.data(), tracked_count, lost_boxes.data(), lost_count, false, false);
+
+    // mark: 1 for dropped tracks
+    for (int i = 0; i < tracked_count; i++)
+    {
+        int p = t->tracked[i];
+
+        for (int j = 0; j < lost_count; j++)
+        {
+            if (t->cost[(size_t)i * lost_count + j] >= BYTETRACK_DUPLICATE_IOU_DISTANCE)
+                continue;
+
+            int q = t->lost[j];
+            if (t->last_frame[p] - t->start_frame[p] > t->last_frame[q] - t->start_frame[q])
+                t->mark[q] = 1;
+            else
+                t->mark[p] = 1;
+        }
+    }
+
+    for (int pass = 0; pass < 2; pass++)
+    {
+        std::vector<int> &list = (0 == pass) ? t->tracked : t->lost;
+        size_t kept = 0;
+
+        for (size_t i = 0; i < list.size(); i++)
+        {
+            if (t->mark[list[i]])
+                t->mark[list[i]] = 0;
+            else
+                list[kept++] = list[i];
+        }
+        list.resize(kept);
+    }
+}
+
+// return slots which are neither tracked nor lost to the free list
+static void release_unused_slots(bytetrack_t *t)
+{
+    for (size_t i = 0; i < t->tracked.size(); i++)
+        t->mark[t->tracked[i]] = 1;
+    for (size_t i = 0; i < t->lost.size(); i++)
+        t->mark[t->lost[i]] = 1;
+
+    t->free_slots.clear();
+    for (int s = t->slot_count - 1; s >= 0; s--)
+    {
+        if (t->mark[s])
+            t->mark[s] = 0;
+        else
+            t->free_slots.push_back(s);
+    }
+}
+
+/******************************************************************************
+ * APIs
+ ******************************************************************************/
+
+void bytetrack_get_default_config(bytetrack_config_t *config)
+{
+    config->track_thresh = 0.6f;
+    config->match_thresh = 0.9f;
+    config->frame_rate = 30;
+    config->track_buffer = 120;
+    config->class_aware = false;
+}
+
+bytetrack_t *bytetrack_create(const bytetrack_config_t *config)
+{
+    bytetrack_t *t = new (std::nothrow) bytetrack_t();
+    if (NULL == t) {
+        printf("Error! allocate bytetrack tracker failed\n");
+        return NULL;
+    }
+
+    if (NULL != config)
+        t->config = *config;
+    else
+        bytetrack_get_default_config(&t->config);
+
+    t->det_thresh = t->config.track_thresh + 0.1f;
+    t->max_time_lost = (int)(t->config.frame_rate / 30.0 * t->config.track_buffer);
+    t->frame_id = 0;
+    t->last_track_id = 0;
+    t->slot_count = 0;
+
+    return t;
+}
+
+void bytetrack_reset(bytetrack_t *tracker)
+{
+    if (NULL == tracker)
+        return;
+
+    tracker->tracked.clear();
+    tracker->lost.clear();
+    tracker->frame_id = 0;
+    release_unused_slots(tracker);
+}
+
+void bytetrack_destroy(bytetrack_t *tracker)
+{
+    delete tracker;
+}
+
+int bytetrack_update(bytetrack_t *tracker, uint32_t box_count, const kp_bounding_box_t *boxes,
+                     uint32_t max_objects, bytetrack_object_t *objects)
+{
+    bytetrack_t *t = tracker;
+
+    if (NULL == t || (0 < box_count && NULL == boxes) || (0 < max_objects && NULL == objects)) {
+        printf("Error! invalid parameters of bytetrack_update\n");
+        return -1;
+    }
+
+    t->frame_id++;
+
+    /* Step 1: split detections into high and low score ones */
+    t->dets_high.clear();
+    t->dets_low.clear();
+
+    for (uint32_t i = 0; i < box_count; i++)
+    {
+        const kp_bounding_box_t *box = &boxes[i];
+        DETECTION det = {box->x1, box->y1, box->x2, box->y2, box->score, box->class_num};
+
+        if (box->x2 <= box->x1 || box->y2 <= box->y1)
+            continue;
+
+        if (box->score > t->config.track_thresh)
+            t->dets_high.push_back(det);
+        else if (box->score > BYTETRACK_LOW_SCORE_THRESH && box->score < t->config.track_thresh)
+            t->dets_low.push_back(det);
+    }
+
+    t->unconfirmed.clear();
+    t->pool.clear();
+    t->activated.clear();
+    t->refind.clear();
+    t->lost_new.clear();
+
+    for (size_t i = 0; i < t->tracked.size(); i++)
+    {
+        int s = t->tracked[i];
+        if (t->is_activated[s])
+            t->pool.push_back(s);
+        else
+            t->unconfirmed.push_back(s);
+    }
+    joint_tracks(t, t->pool, t->lost);
+
+    /* Step 2: first association, with high score detections */
+    int pool_count = (int)t->pool.size();
+    int high_count = (int)t->dets_high.size();
+
+    kalman_predict(t, t->pool.data(), pool_count);
+
+    iou_cost_matrix(t, t->pool.data(), pool_count, t->dets_high.data(), high_count, true, t->config.class_aware);
+    linear_assignment(t, pool_count, high_count, t->config.match_thresh);
+
+    t->remain_tracks.clear();
+    for (int i = 0; i < pool_count; i++)
+    {
+        int s = t->pool[i];
+        int j = t->row_match[i];
+
+        if (0 > j) {
+            if (TRACK_STATE_TRACKED == t->state[s])
+                t->remain_tracks.push_back(s);
+            continue;
+        }
+
+        if (TRACK_STATE_TRACKED == t->state[s])
+            t->activated.push_back(s);
+        else
+            t->refind.push_back(s);
+        track_update(t, s, &t->dets_high[j]);
+    }
+
+    t->dets_remain.clear();
+    for (int j = 0; j < high_count; j++)
+    {
+        if (0 > t->col_match[j])
+            t->dets_remain.push_back(t->dets_high[j]);
+    }
+
+    /* Step 3: second association, remaining tracked tracks with low score detections */
+    int remain_count = (int)t->remain_tracks.size();
+    int low_count = (int)t->dets_low.size();
+
+    iou_cost_matrix(t, t->remain_tracks.data(), remain_count, t->dets_low.data(), low_count, false, t->config.class_aware);
+    linear_assignment(t, remain_count, low_count, BYTETRACK_SECOND_MATCH_THRESH);
+
+    for (int i = 0; i < remain_count; i++)
+    {
+        int s = t->remain_tracks[i];
+        int j = t->row_match[i];
+
+        if (0 <= j) {
+            t->activated.push_back(s);
+            track_update(t, s, &t->dets_low[j]);
+        } else {
+            t->state[s] = TRACK_STATE_LOST;
+            t->lost_new.push_back(s);
+        }
+    }
+
+    /* unconfirmed tracks, usually tracks with only one beginning frame */
+    int unconfirmed_count = (int)t->unconfirmed.size();
+    int det_remain_count = (int)t->dets_remain.size();
+
+    iou_cost_matrix(t, t->unconfirmed.data(), unconfirmed_count, t->dets_remain.data(), det_remain_count, true, t->config.class_aware);
+    linear_assignment(t, unconfirmed_count, det_remain_count, BYTETRACK_UNCONFIRMED_MATCH_THRESH);
+
+    for (int i = 0; i < unconfirmed_count; i++)
+    {
+        int s = t->unconfirmed[i];
+        int j = t->row_match[i];
+
+        if (0 <= j) {
+            t->activated.push_back(s);
+            track_update(t, s, &t->dets_remain[j]);
+        } else {
+            t->state[s] = TRACK_STATE_REMOVED;
+        }
+    }
+
+    /* Step 4: init new tracks */
+    for (int j = 0; j < det_remain_count; j++)
+    {
+        if (0 <= t->col_match[j] || t->dets_remain[j].score < t->det_thresh)
+            continue;
+
+        int s = alloc_slot(t);
+        track_activate(t, s, &t->dets_remain[j]);
+        t->activated.push_back(s);
+    }
+
+    /* Step 5: update state */
+    for (size_t i = 0; i < t->lost.size(); i++)
+    {
+        int s = t->lost[i];
+        if (t->frame_id - t->last_frame[s] > t->max_time_lost)
+            t->state[s] = TRACK_STATE_REMOVED;
+    }
+
+    t->list_tmp.clear();
+    for (size_t i = 0; i < t->tracked.size(); i++)
+    {
+        if (TRACK_STATE_TRACKED == t->state[t->tracked[i]])
+            t->list_tmp.push_back(t->tracked[i]);
+    }
+    joint_tracks(t, t->list_tmp, t->activated);
+    joint_tracks(t, t->list_tmp, t->refind);
+    t->tracked.swap(t->list_tmp);
+
+    // lost = lost - tracked + lost_new - removed, tracked tracks are exactly the ones in TRACKED state
+    t->list_tmp.clear();
+    for (size_t i = 0; i < t->lost.size(); i++)
+    {
+        if (TRACK_STATE_LOST == t->state[t->lost[i]])
+            t->list_tmp.push_back(t->lost[i]);
+    }
+    joint_tracks(t, t->list_tmp, t->lost_new);
+    t->lost.swap(t->list_tmp);
+
+    remove_duplicate_tracks(t);
+    release_unused_slots(t);
+
+    /* output activated tracks */
+    uint32_t count = 0;
+    for (size_t i = 0; i < t->tracked.size() && count < max_objects; i++)
+    {
+        int s = t->tracked[i];
+        if (!t->is_activated[s])
+            continue;
+
+        float h = t->pos[DIM_H][s];
+        float w = t->pos[DIM_A][s] * h;
+        bytetrack_object_t *object = &objects[count++];
+
+        object->track_id = t->track_id[s];
+        object->box.x1 = t->pos[DIM_X][s] - w / 2;
+        object->box.y1 = t->pos[DIM_Y][s] - h / 2;
+        object->box.x2 = object->box.x1 + w;
+        object->box.y2 = object->box.y1 + h;
+        object->box.score = t->score[s];
+        object->box.class_num = t->class_num[s];
+    }
+
+    return (int)count;
+}
@@ -0,0 +1,97 @@
+/**
+ * @file        bytetrack.h
+ * @brief       ByteTrack multi-object tracker APIs
+ *
+ * Native implementation of the ByteTrack tracker in plus_python/utils/postprocess (bytetrack_postprocess.py,
+ * kalman_filter.py and matching.py). It assigns stable track IDs to the bounding boxes of a detector, so it
+ * can be used with the results of the Kneron PLUS post process functions as well as the NNM YOLO application.
+ *
+ * @version     0.1
+ * @date        2021-03-22
+ *
+ * @copyright   Copyright (c) 2021 Kneron Inc. All rights reserved.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "kp_struct.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief ByteTrack tracker handle.
+ */
+typedef struct bytetrack_s bytetrack_t;
+
+/**
+ * @brief ByteTrack tracker configuration.
+ */
+typedef struct
+{
+    float track_thresh;                 /**< score separating high and low score detections, new tracks need track_thresh + 0.1 */
+    float match_thresh;                 /**< maximum matching cost (1 - iou * score) of the first association */
+    int frame_rate;                     /**< frame rate of the detection results */
+    int track_buffer;                   /**< frames a lost track is kept at 30 fps, scaled with frame_rate */
+    bool class_aware;                   /**< only match detections with tracks of the same class_num */
+} bytetrack_config_t;
+
+/**
+ * @brief describe a tracked object.
+ */
+typedef struct
+{
+    uint32_t track_id;                  /**< track ID, unique during the lifetime of the tracker */
+    kp_bounding_box_t box;              /**< Kalman filtered box, score and class_num of the last matched detection */
+} bytetrack_object_t;
+
+/**
+ * @brief get the default configuration, it is the same as BYTETracker() of plus_python.
+ *
+ * @param[out] config default configuration.
+ */
+void bytetrack_get_default_config(bytetrack_config_t *config);
+
+/**
+ * @brief create a tracker.
+ *
+ * @param[in] config tracker configuration, NULL for the default configuration.
+ *
+ * @return tracker handle, NULL if failed.
+ */
+bytetrack_t *bytetrack_create(const bytetrack_config_t *config);
+
+/**
+ * @brief feed the detection result of one frame into the tracker.
+ *
+ * @param[in] tracker tracker handle.
+ * @param[in] box_count number of detected boxes.
+ * @param[in] boxes detected boxes of the frame.
+ * @param[in] max_objects capacity of objects.
+ * @param[out] objects activated tracks of the frame.
+ *
+ * @return number of objects written, -1 if failed.
+ */
+int bytetrack_update(bytetrack_t *tracker, uint32_t box_count, const kp_bounding_box_t *boxes,
+                     uint32_t max_objects, bytetrack_object_t *objects);
+
+/**
+ * @brief drop all tracks, e.g. when the video source is changed. Track IDs are not reused.
+ *
+ * @param[in] tracker tracker handle.
+ */
+void bytetrack_reset(bytetrack_t *tracker);
+
+/**
+ * @brief release a tracker.
+ *
+ * @param[in] tracker tracker handle.
+ */
+void bytetrack_destroy(bytetrack_t *tracker);
+
+#ifdef __cplusplus
+}
+#endif
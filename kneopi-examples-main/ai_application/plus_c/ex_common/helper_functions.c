@@ -13,12 +13,17 @@
 #include <time.h>
 #include <errno.h>
 #include <sys/time.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include <math.h>
 #include <float.h>
 #include <limits.h>
 
 #include "kp_inference.h"
 #include "helper_functions.h"
+#include "pixel_convert.h"
 
 #define MIN(a,b) (((a)<(b))?(a):(b))
 #define MAX(a,b) (((a)>(b))?(a):(b))
@@ -122,127 +127,6 @@ static size_t custom_fread(void *ptr, size_t size, size_t count, FILE *stream)
     return read_size;
 }
 
-static void generate_ycbcr_to_ycbcr_order_mapping(kp_image_format_t in_format, kp_image_format_t out_format, int order_mapping[])
-{
-    // initialize
-    int y0_index = 0;
-    int cb_index = 0;
-    int y1_index = 0;
-    int cr_index = 0;
-
-    switch (in_format)
-    {
-        case KP_IMAGE_FORMAT_YCBCR422_CRY1CBY0:
-            cr_index = 0;
-            y1_index = 1;
-            cb_index = 2;
-            y0_index = 3;
-            break;
-        case KP_IMAGE_FORMAT_YCBCR422_CBY1CRY0:
-            cb_index = 0;
-            y1_index = 1;
-            cr_index = 2;
-            y0_index = 3;
-            break;
-        case KP_IMAGE_FORMAT_YCBCR422_Y1CRY0CB:
-            y1_index = 0;
-            cr_index = 1;
-            y0_index = 2;
-            cb_index = 3;
-            break;
-        case KP_IMAGE_FORMAT_YCBCR422_Y1CBY0CR:
-            y1_index = 0;
-            cb_index = 1;
-            y0_index = 2;
-            cr_index = 3;
-            break;
-        case KP_IMAGE_FORMAT_YCBCR422_CRY0CBY1:
-            cr_index = 0;
-            y0_index = 1;
-            cb_index = 2;
-            y1_index = 3;
-            break;
-        case KP_IMAGE_FORMAT_YCBCR422_CBY0CRY1:
-            cb_index = 0;
-            y0_index = 1;
-            cr_index = 2;
-            y1_index = 3;
-            break;
-        case KP_IMAGE_FORMAT_YCBCR422_Y0CRY1CB:
-            y0_index = 0;
-            cr_index = 1;
-            y1_index = 2;
-            cb_index = 3;
-            break;
-        case KP_IMAGE_FORMAT_YUYV:
-        case KP_IMAGE_FORMAT_YCBCR422_Y0CBY1CR:
-            y0_index = 0;
-            cb_index = 1;
-            y1_index = 2;
-            cr_index = 3;
-            break;
-        default:
-            printf("input format is not supported\n");
-            break;
-    }
-
-    switch (out_format)
-    {
-        case KP_IMAGE_FORMAT_YCBCR422_CRY1CBY0:
-            order_mapping[0] = cr_index;
-            order_mapping[1] = y1_index;
-            order_mapping[2] = cb_index;
-            order_mapping[3] = y0_index;
-            break;
-        case KP_IMAGE_FORMAT_YCBCR422_CBY1CRY0:
-            order_mapping[0] = cb_index;
-            order_mapping[1] = y1_index;
-            order_mapping[2] = cr_index;
-            order_mapping[3] = y0_index;
-            break;
-        case KP_IMAGE_FORMAT_YCBCR422_Y1CRY0CB:
-            order_mapping[0] = y1_index;
-            order_mapping[1] = cr_index;
-            order_mapping[2] = y0_index;
-            order_mapping[3] = cb_index;
-            break;
-        case KP_IMAGE_FORMAT_YCBCR422_Y1CBY0CR:
-            order_mapping[0] = y1_index;
-            order_mapping[1] = cb_index;
-            order_mapping[2] = y0_index;
-            order_mapping[3] = cr_index;
-            break;
-        case KP_IMAGE_FORMAT_YCBCR422_CRY0CBY1:
-            order_mapping[0] = cr_index;
-            order_mapping[1] = y0_index;
-            order_mapping[2] = cb_index;
-            order_mapping[3] = y1_index;
-            break;
-        case KP_IMAGE_FORMAT_YCBCR422_CBY0CRY1:
-            order_mapping[0] = cb_index;
-            order_mapping[1] = y0_index;
-            order_mapping[2] = cr_index;
-            order_mapping[3] = y1_index;
-            break;
-        case KP_IMAGE_FORMAT_YCBCR422_Y0CRY1CB:
-            order_mapping[0] = y0_index;
-            order_mapping[1] = cr_index;
-            order_mapping[2] = y1_index;
-            order_mapping[3] = cb_index;
-            break;
-        case KP_IMAGE_FORMAT_YUYV:
-        case KP_IMAGE_FORMAT_YCBCR422_Y0CBY1CR:
-            order_mapping[0] = y0_index;
-            order_mapping[1] = cb_index;
-            order_mapping[2] = y1_index;
-            order_mapping[3] = cr_index;
-            break;
-        default:
-            printf("output format is not supported\n");
-            break;
-    }
-}
-
 static void dump_bmp_file_from_bmp_pixel_data(const char *out_bmp_path, int bmp_width, int bmp_height, unsigned char *pixel_data)
 {
     // Open .bmp file to write
@@ -287,300 +171,97 @@ static void dump_bmp_file_from_bmp_pixel_data(const char *out_bmp_path, int bmp_
 	return;
 }
 
-char *helper_bmp_file_to_raw_buffer(const char *file_path, int *width, int *height, kp_image_format_t format)
+// mapped view of a 24 bit bottom-up bmp file
+typedef struct
 {
-    FILEHEADER header1;
-    INFOHEADER header2;
+    void *map_addr;
+    size_t map_size;
+    int width;
+    int height;
+    int row_stride;               // bytes per bmp row including padding
+    const unsigned char *pixels;  // first (bottom) row of pixel data
+} BMP_MAPPING;
+
+static void unmap_bmp_file(BMP_MAPPING *bmp)
+{
+    if (NULL != bmp->map_addr)
+        munmap(bmp->map_addr, bmp->map_size);
 
-    unsigned short *b16_buf = NULL;
-    unsigned char  *b8_buf  = NULL;
-    unsigned char *bmp_buf = NULL;
+    memset(bmp, 0, sizeof(BMP_MAPPING));
+}
 
-    char *raw_buf = NULL;
+// return 0 on success, -1 on fail
+static int map_bmp_file(const char *file_path, BMP_MAPPING *bmp)
+{
+    FILEHEADER header1;
+    INFOHEADER header2;
+    struct stat file_stat;
 
-    if(NULL == file_path)
-        return NULL;
+    memset(bmp, 0, sizeof(BMP_MAPPING));
 
-    FILE *bmp_file = fopen(file_path, "rb");
+    if (NULL == file_path)
+        return -1;
 
-    if (!bmp_file)
-    {
+    int fd = open(file_path, O_RDONLY);
+    if (0 > fd) {
         printf("file read failed\n");
-        return NULL;
+        return -1;
     }
 
-    size_t read_size = custom_fread(&header1, 1, sizeof(header1), bmp_file);
-
-    if (0 == read_size) {
+    if ((0 != fstat(fd, &file_stat)) || ((size_t)file_stat.st_size < sizeof(FILEHEADER) + sizeof(INFOHEADER))) {
         printf("Error! Read file header failed\n");
-        fclose(bmp_file);
-        return NULL;
+        close(fd);
+        return -1;
     }
 
-    read_size = custom_fread(&header2, 1, sizeof(header2), bmp_file);
+    bmp->map_size = (size_t)file_stat.st_size;
+    bmp->map_addr = mmap(NULL, bmp->map_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
 
-    if (0 == read_size) {
-        printf("Error! Read info header failed\n");
-        fclose(bmp_file);
-        return NULL;
+    if (MAP_FAILED == bmp->map_addr) {
+        printf("Error! %s(): mmap failed, %s\n", __FUNCTION__, strerror(errno));
+        bmp->map_addr = NULL;
+        return -1;
     }
 
-    *width = header2.width;
-    *height = header2.height;
+    madvise(bmp->map_addr, bmp->map_size, MADV_SEQUENTIAL);
 
-    unsigned short bytes_per_pixel = header2.bits / 8;
+    memcpy(&header1, bmp->map_addr, sizeof(FILEHEADER));
+    memcpy(&header2, (unsigned char *)bmp->map_addr + sizeof(FILEHEADER), sizeof(INFOHEADER));
 
-    // length of bmp image width in byte should be aligned with 4
-    int padding_byte_num = 0;
-    if (header2.width * bytes_per_pixel % 4 != 0)
-        padding_byte_num = 4 - header2.width * bytes_per_pixel % 4;
-
-    // bmp_buf is used to store pixel data of bmp image
-    int bmp_buf_size = (header2.width * bytes_per_pixel + padding_byte_num) * header2.height; // image width of bmp file should be a multiple of 4
-    bmp_buf = (unsigned char *)malloc(bmp_buf_size);
-    if (NULL == bmp_buf) {
-        fclose(bmp_file);
-        printf("Error! malloc memory for image buffer failed\n");
+    if (24 != header2.bits) {
+        printf("support only 24 bit bmp\n");
         goto err;
     }
 
-    if (header1.offset != sizeof(FILEHEADER) + sizeof(INFOHEADER))
-    {
-        // move the position indicator of the bmp_file stream to the data offset specified by the FILEHEADER
-        int ret = fseek(bmp_file, (long)header1.offset, SEEK_SET);
-
-        if (0 != ret) {
-            fclose(bmp_file);
-            goto err;
-        }
+    if ((0 >= header2.width) || (0 >= header2.height)) {
+        printf("Error! invalid bmp width or height\n");
+        goto err;
     }
 
-    // read pixel data from bmp_file
-    read_size = custom_fread(bmp_buf, 1, bmp_buf_size, bmp_file);
+    // length of bmp image width in byte should be aligned with 4
+    bmp->row_stride = (header2.width * 3 + 3) & ~3;
 
-    if (0 == read_size) {
+    if ((size_t)header1.offset + (size_t)bmp->row_stride * header2.height > bmp->map_size) {
         printf("Error! %s(): read bmp failed\n", __FUNCTION__);
-        fclose(bmp_file);
         goto err;
     }
 
-    fclose(bmp_file);
-
-    if (header2.bits == 24)
-    {
-        switch (format)
-        {
-        case KP_IMAGE_FORMAT_RGB565:
-        {
-            b16_buf = (unsigned short *)malloc(header2.width * header2.height * 2);
-            if ( NULL == b16_buf ) {
-                printf("Error! malloc memory for converted data failed\n");
-                goto err;
-            }
-            int rgb565_pos = 0;
+    bmp->width = header2.width;
+    bmp->height = header2.height;
+    bmp->pixels = (const unsigned char *)bmp->map_addr + header1.offset;
 
-            for (int row = header2.height - 1; row >= 0; row--)
-            {
-                int bmp_pos = (header2.width * 3 + padding_byte_num) * row; // we only support bmp file with 3 bytes per pixel
-                for (int col = 0; col < header2.width; col++)
-                {
-                    unsigned char blue = bmp_buf[bmp_pos];
-                    unsigned char green = bmp_buf[bmp_pos + 1];
-                    unsigned char red = bmp_buf[bmp_pos + 2];
-
-                    b16_buf[rgb565_pos] = ((red & 0b11111000) << 8) | ((green & 0b11111100) << 3) | (blue >> 3);
-
-                    bmp_pos += 3;
-                    rgb565_pos++;
-                }
-            }
-
-            raw_buf = (char *)b16_buf;
-            break;
-        }
-        case KP_IMAGE_FORMAT_RGBA8888:
-        {
-            b8_buf = (unsigned char *)malloc(header2.width * header2.height * 4);
-            if ( NULL == b8_buf ) {
-                printf("Error! malloc memory for converted data failed\n");
-                goto err;
-            }
-            int rgba8888_pos = 0;
-
-            for (int row = header2.height - 1; row >= 0; row--)
-            {
-                int bmp_pos = (header2.width * 3 + padding_byte_num) * row; // we only support bmp file with 3 bytes per pixel
-                for (int col = 0; col < header2.width; col++)
-                {
-                    unsigned char blue = bmp_buf[bmp_pos];
-                    unsigned char green = bmp_buf[bmp_pos + 1];
-                    unsigned char red = bmp_buf[bmp_pos + 2];
-
-                    b8_buf[rgba8888_pos++] = red;
-                    b8_buf[rgba8888_pos++] = green;
-                    b8_buf[rgba8888_pos++] = blue;
-                    b8_buf[rgba8888_pos++] = 0;
-
-                    bmp_pos += 3;
-                }
-            }
-
-            raw_buf = (char *)b8_buf;
-            break;
-        }
-        case KP_IMAGE_FORMAT_YUYV:
-        case KP_IMAGE_FORMAT_YCBCR422_CRY1CBY0:
-        case KP_IMAGE_FORMAT_YCBCR422_CBY1CRY0:
-        case KP_IMAGE_FORMAT_YCBCR422_Y1CRY0CB:
-        case KP_IMAGE_FORMAT_YCBCR422_Y1CBY0CR:
-        case KP_IMAGE_FORMAT_YCBCR422_CRY0CBY1:
-        case KP_IMAGE_FORMAT_YCBCR422_CBY0CRY1:
-        case KP_IMAGE_FORMAT_YCBCR422_Y0CRY1CB:
-        case KP_IMAGE_FORMAT_YCBCR422_Y0CBY1CR:
-        {
-            b8_buf = (unsigned char *)malloc(header2.width * header2.height * 2);
-            if ( NULL == b8_buf ) {
-                printf("Error! malloc memory for converted data failed\n");
-                goto err;
-            }
-            int write_pos = 0;
-
-            // generate the order mappings of (y0, cb, y1, cr) to (cr, y1, cb, y0), (cb, y1, cr, y0), ... described in the yuyv or ycbcr image format
-            int order_mapping[4] = {0};
-            generate_ycbcr_to_ycbcr_order_mapping(KP_IMAGE_FORMAT_YCBCR422_Y0CBY1CR, format, order_mapping);
-
-            for (int row = header2.height - 1; row >= 0; row--)
-            {
-                int bmp_pos = (header2.width * 3 + padding_byte_num) * row; // we only support bmp file with 3 bytes per pixel
-
-                // FIXME? How if the width is an odd number?
-                for (int col = 0; col < header2.width / 2; col++)
-                {
-                    unsigned char blue0 = bmp_buf[bmp_pos];
-                    unsigned char green0 = bmp_buf[bmp_pos + 1];
-                    unsigned char red0 = bmp_buf[bmp_pos + 2];
-
-                    unsigned char blue1 = bmp_buf[bmp_pos + 3];
-                    unsigned char green1 = bmp_buf[bmp_pos + 4];
-                    unsigned char red1 = bmp_buf[bmp_pos + 5];
-
-                    // FIXME: use integer method to speed up
-                    float output[4];
-                    output[0] = 0.299 * red0 + 0.587 * green0 + 0.114 * blue0; // y0
-                    output[1] = -0.169 * (red0 + red1) / 2 - 0.331 * (green0 + green1) / 2 + 0.5 * (blue0 + blue1) / 2 + 128; // cb
-                    output[2] = 0.299 * red1 + 0.587 * green1 + 0.114 * blue1; // y1
-                    output[3] = 0.5 * (red0 + red1) / 2 - 0.419 * (green0 + green1) / 2 - 0.081 * (blue0 + blue1) / 2 + 128;  // cr
-
-                    b8_buf[write_pos++] = (unsigned char)output[order_mapping[0]];
-                    b8_buf[write_pos++] = (unsigned char)output[order_mapping[1]];
-                    b8_buf[write_pos++] = (unsigned char)output[order_mapping[2]];
-                    b8_buf[write_pos++] = (unsigned char)output[order_mapping[3]];
-
-                    bmp_pos += 6;
-                }
-            }
-
-            raw_buf = (char *)b8_buf;
-            break;
-        }
-        case KP_IMAGE_FORMAT_YUV420:
-        {
-            if ((0 != header2.width % 2) || (0 != header2.height % 2)) {
-                printf("Error! width or height is not even number\n");
-                goto err;
-            }
-
-            b8_buf = (unsigned char *)malloc(header2.width * header2.height * 1.5);
-            if ( NULL == b8_buf ) {
-                printf("Error! malloc memory for converted data failed\n");
-                goto err;
-            }
-
-            int y_bias = header2.width * header2.height;
-            int u_bias = y_bias / 4;
-            int u_pos = y_bias;
-            int v_pos = y_bias + u_bias;
-
-            for (int row = header2.height - 1; row >= 0; row -= 2)
-            {
-                int bmp_pos_row_0 = (header2.width * 3 + padding_byte_num) * row;       // we only support bmp file with 3 bytes per pixel
-                int bmp_pos_row_1 = (header2.width * 3 + padding_byte_num) * (row - 1); // we only support bmp file with 3 bytes per pixel
-                int y_write_pos_row_0 = header2.width * (header2.height - row - 1);
-                int y_write_pos_row_1 = header2.width * (header2.height - row);
-
-                for (int col = 0; col < header2.width; col += 2)
-                {
-                    unsigned char blue0 = bmp_buf[bmp_pos_row_0];
-                    unsigned char green0 = bmp_buf[bmp_pos_row_0 + 1];
-                    unsigned char red0 = bmp_buf[bmp_pos_row_0 + 2];
-
-                    unsigned char blue1 = bmp_buf[bmp_pos_row_0 + 3];
-                    unsigned char green1 = bmp_buf[bmp_pos_row_0 + 4];
-                    unsigned char red1 = bmp_buf[bmp_pos_row_0 + 5];
-
-                    unsigned char blue2 = bmp_buf[bmp_pos_row_1];
-                    unsigned char green2 = bmp_buf[bmp_pos_row_1 + 1];
-                    unsigned char red2 = bmp_buf[bmp_pos_row_1 + 2];
-
-                    unsigned char blue3 = bmp_buf[bmp_pos_row_1 + 3];
-                    unsigned char green3 = bmp_buf[bmp_pos_row_1 + 4];
-                    unsigned char red3 = bmp_buf[bmp_pos_row_1 + 5];
-
-                    float y[2][2];
-                    float u, v;
-
-                    y[0][0] = 0.299 * red0 + 0.587 * green0 + 0.114 * blue0;
-                    y[0][1] = 0.299 * red1 + 0.587 * green1 + 0.114 * blue1;
-                    y[1][0] = 0.299 * red2 + 0.587 * green2 + 0.114 * blue2;
-                    y[1][1] = 0.299 * red3 + 0.587 * green3 + 0.114 * blue3;
-
-                    u = -0.169 * (red0 + red1 + red2 + red3) / 4 - 0.331 * (green0 + green1 + green2 + green3) / 4 + 0.5 * (blue0 + blue1 + blue2 + blue3) / 4 + 128;
-                    v = 0.5 * (red0 + red1 + red2 + red3) / 4 - 0.419 * (green0 + green1 + green2 + green3) / 4 - 0.081 * (blue0 + blue1 + blue2 + blue3) / 4 + 128;
-
-                    b8_buf[y_write_pos_row_0++] = (unsigned char)y[0][0];
-                    b8_buf[y_write_pos_row_0++] = (unsigned char)y[0][1];
-                    b8_buf[y_write_pos_row_1++] = (unsigned char)y[1][0];
-                    b8_buf[y_write_pos_row_1++] = (unsigned char)y[1][0];
-                    b8_buf[u_pos++] = (unsigned char)u;
-                    b8_buf[v_pos++] = (unsigned char)v;
-
-                    bmp_pos_row_0 += 6;
-                    bmp_pos_row_1 += 6;
-                }
-            }
-
-            raw_buf = (char *)b8_buf;
-            break;
-        }
-        case KP_IMAGE_FORMAT_UNKNOWN:
-        default:
-            printf("image format is not supported\n");
-            break;
-        }
-    }
-    else
-    {
-        printf("support only 24 bit bmp\n");
-    }
-
-    free(bmp_buf);
-
-    return raw_buf;
+    return 0;
 
 err:
-    free(bmp_buf);
-    free(b16_buf);
-    free(b8_buf);
-
-    return NULL;
+    unmap_bmp_file(bmp);
+    return -1;
 }
 
-char *helper_bin_file_to_raw_buffer(const char *file_path, int width, int height, kp_image_format_t format)
+int helper_get_raw_buffer_size(int width, int height, kp_image_format_t format)
 {
     if (width <= 0 || height <= 0)
-        return NULL;
-
-    float bytes_per_pixel = 0;
+        return -1;
 
     switch (format)
     {
@@ -594,68 +275,284 @@ char *helper_bin_file_to_raw_buffer(const char *file_path, int width, int height
     case KP_IMAGE_FORMAT_YCBCR422_CBY0CRY1:
     case KP_IMAGE_FORMAT_YCBCR422_Y0CRY1CB:
     case KP_IMAGE_FORMAT_YCBCR422_Y0CBY1CR:
-        bytes_per_pixel = 2;
-        break;
+        return width * height * 2;
     case KP_IMAGE_FORMAT_RGBA8888:
-        bytes_per_pixel = 4;
-        break;
+        return width * height * 4;
     case KP_IMAGE_FORMAT_RAW8:
-        bytes_per_pixel = 1;
-        break;
+        return width * height;
     case KP_IMAGE_FORMAT_YUV420:
         if ((0 != width % 2) || (0 != height % 2)) {
             printf("image width and height must be even number\n");
-            return NULL;
+            return -1;
         }
-
-        bytes_per_pixel = 1.5;
-        break;
+        return width * height * 3 / 2;
     default:
     case KP_IMAGE_FORMAT_UNKNOWN:
         printf("image format is not supported\n");
-        return NULL;
+        return -1;
     }
+}
 
-    FILE *bin_file = fopen(file_path, "rb");
-    if (!bin_file)
-    {
-        printf("%s(): fopen failed, file:%s, %s\n", __FUNCTION__, file_path, strerror(errno));
+static int convert_bmp_mapping_to_raw_buffer(BMP_MAPPING *bmp, kp_image_format_t format, char *raw_buf)
+{
+    // bmp rows are stored bottom-up, so start from the last row and walk backwards
+    const unsigned char *top_row = bmp->pixels + (size_t)bmp->row_stride * (bmp->height - 1);
+
+    return pixel_convert_from_bgr888(top_row, -bmp->row_stride, bmp->width, bmp->height, format, (unsigned char *)raw_buf);
+}
+
+int helper_bmp_file_to_user_buffer(const char *file_path, int *width, int *height, kp_image_format_t format, char *raw_buf, int raw_buf_size)
+{
+    BMP_MAPPING bmp;
+    int ret = -1;
+
+    if (0 != map_bmp_file(file_path, &bmp))
+        return -1;
+
+    *width = bmp.width;
+    *height = bmp.height;
+
+    int required_size = helper_get_raw_buffer_size(bmp.width, bmp.height, format);
+
+    if (0 > required_size) {
+        goto exit;
+    } else if ((NULL == raw_buf) || (raw_buf_size < required_size)) {
+        printf("Error! %s(): user buffer is too small, %d bytes required\n", __FUNCTION__, required_size);
+        goto exit;
+    }
+
+    ret = convert_bmp_mapping_to_raw_buffer(&bmp, format, raw_buf);
+
+exit:
+    unmap_bmp_file(&bmp);
+
+    return ret;
+}
+
+char *helper_bmp_file_to_raw_buffer(const char *file_path, int *width, int *height, kp_image_format_t format)
+{
+    BMP_MAPPING bmp;
+    char *raw_buf = NULL;
+
+    if (0 != map_bmp_file(file_path, &bmp))
         return NULL;
+
+    *width = bmp.width;
+    *height = bmp.height;
+
+    int raw_buf_size = helper_get_raw_buffer_size(bmp.width, bmp.height, format);
+    if (0 > raw_buf_size)
+        goto exit;
+
+    raw_buf = (char *)malloc(raw_buf_size);
+    if (NULL == raw_buf) {
+        printf("Error! malloc memory for converted data failed\n");
+        goto exit;
     }
 
-    fseek(bin_file, 0, SEEK_END);
-    long file_size = ftell(bin_file); //get the size
+    if (0 != convert_bmp_mapping_to_raw_buffer(&bmp, format, raw_buf)) {
+        free(raw_buf);
+        raw_buf = NULL;
+    }
+
+exit:
+    unmap_bmp_file(&bmp);
+
+    return raw_buf;
+}
+
+int helper_bin_file_to_user_buffer(const char *file_path, int width, int height, kp_image_format_t format, char *raw_buf, int raw_buf_size)
+{
+    struct stat file_stat;
+
+    int required_size = helper_get_raw_buffer_size(width, height, format);
+    if (0 > required_size)
+        return -1;
+
+    if ((NULL == raw_buf) || (raw_buf_size < required_size)) {
+        printf("Error! %s(): user buffer is too small, %d bytes required\n", __FUNCTION__, required_size);
+        return -1;
+    }
+
+    int fd = open(file_path, O_RDONLY);
+    if (0 > fd)
+    {
+        printf("%s(): open failed, file:%s, %s\n", __FUNCTION__, file_path, strerror(errno));
+        return -1;
+    }
 
-    if (file_size != width * height * bytes_per_pixel)
+    if ((0 != fstat(fd, &file_stat)) || (file_stat.st_size != required_size))
     {
         printf("%s(): file size does not match input image width, height or format\n", __FUNCTION__);
-        fclose(bin_file);
-        return NULL;
+        close(fd);
+        return -1;
     }
 
-    char *buffer = (char *)malloc(file_size);
+    void *map_addr = mmap(NULL, required_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (MAP_FAILED == map_addr) {
+        printf("Error! %s(): mmap failed, %s\n", __FUNCTION__, strerror(errno));
+        return -1;
+    }
+
+    madvise(map_addr, required_size, MADV_SEQUENTIAL);
+    memcpy(raw_buf, map_addr, required_size);
+    munmap(map_addr, required_size);
+
+    return 0;
+}
+
+char *helper_bin_file_to_raw_buffer(const char *file_path, int width, int height, kp_image_format_t format)
+{
+    int buffer_size = helper_get_raw_buffer_size(width, height, format);
+    if (0 > buffer_size)
+        return NULL;
+
+    char *buffer = (char *)malloc(buffer_size);
     if(NULL == buffer) {
         printf("Error! %s(): malloc for buffer failed\n", __FUNCTION__);
-        fclose(bin_file);
         return NULL;
     }
 
-    fseek(bin_file, 0, SEEK_SET); //move to beginning
-
-    size_t read_size = custom_fread(buffer, 1, file_size, bin_file);
-    if (read_size != (size_t)file_size)
-    {
-        printf("%s(): fread failed, file size: %u, read size %u\n", __FUNCTION__,
-               (unsigned int)file_size, (unsigned int)read_size);
+    if (0 != helper_bin_file_to_user_buffer(file_path, width, height, format, buffer, buffer_size)) {
         free(buffer);
         buffer = NULL;
     }
 
-    fclose(bin_file);
-
     return buffer;
 }
 
+/* ========================= converted image cache ========================= */
+
+#define IMAGE_CACHE_DEFAULT_CAPACITY    8
+
+typedef struct
+{
+    char *file_path;
+    int is_bmp;
+    kp_image_format_t format;
+    int width;
+    int height;
+    time_t mtime;
+    off_t file_size;
+    char *raw_buf;
+    unsigned long last_used;
+} IMAGE_CACHE_ENTRY;
+
+static IMAGE_CACHE_ENTRY *image_cache = NULL;
+static int image_cache_capacity = 0;
+static unsigned long image_cache_tick = 0;
+
+static void image_cache_entry_clear(IMAGE_CACHE_ENTRY *entry)
+{
+    free(entry->file_path);
+    free(entry->raw_buf);
+    memset(entry, 0, sizeof(IMAGE_CACHE_ENTRY));
+}
+
+int helper_image_cache_init(int capacity)
+{
+    helper_image_cache_release();
+
+    if (0 >= capacity)
+        capacity = IMAGE_CACHE_DEFAULT_CAPACITY;
+
+    image_cache = (IMAGE_CACHE_ENTRY *)calloc(capacity, sizeof(IMAGE_CACHE_ENTRY));
+    if (NULL == image_cache) {
+        printf("Error! %s(): calloc for image cache failed\n", __FUNCTION__);
+        return -1;
+    }
+
+    image_cache_capacity = capacity;
+    image_cache_tick = 0;
+
+    return 0;
+}
+
+void helper_image_cache_release()
+{
+    for (int i = 0; i < image_cache_capacity; i++)
+        image_cache_entry_clear(&image_cache[i]);
+
+    free(image_cache);
+    image_cache = NULL;
+    image_cache_capacity = 0;
+}
+
+static const char *image_cache_get(const char *file_path, int is_bmp, int *width, int *height, kp_image_format_t format)
+{
+    struct stat file_stat;
+    IMAGE_CACHE_ENTRY *victim = NULL;
+
+    if ((NULL == file_path) || (0 != stat(file_path, &file_stat)))
+        return NULL;
+
+    if ((NULL == image_cache) && (0 != helper_image_cache_init(IMAGE_CACHE_DEFAULT_CAPACITY)))
+        return NULL;
+
+    image_cache_tick++;
+
+    for (int i = 0; i < image_cache_capacity; i++)
+    {
+        IMAGE_CACHE_ENTRY *entry = &image_cache[i];
+
+        if ((NULL != entry->file_path) && (entry->is_bmp == is_bmp) && (entry->format == format) &&
+            (is_bmp || ((entry->width == *width) && (entry->height == *height))) &&
+            (0 == strcmp(entry->file_path, file_path)))
+        {
+            // a modified file invalidates the entry, reload it in place
+            if ((entry->mtime != file_stat.st_mtime) || (entry->file_size != file_stat.st_size)) {
+                victim = entry;
+                break;
+            }
+
+            entry->last_used = image_cache_tick;
+            *width = entry->width;
+            *height = entry->height;
+            return entry->raw_buf;
+        }
+
+        if ((NULL == victim) || (NULL == entry->file_path) ||
+            ((NULL != victim->file_path) && (entry->last_used < victim->last_used)))
+            victim = entry;
+    }
+
+    image_cache_entry_clear(victim);
+
+    char *raw_buf = is_bmp ? helper_bmp_file_to_raw_buffer(file_path, width, height, format)
+                           : helper_bin_file_to_raw_buffer(file_path, *width, *height, format);
+    if (NULL == raw_buf)
+        return NULL;
+
+    victim->file_path = strdup(file_path);
+    if (NULL == victim->file_path) {
+        free(raw_buf);
+        return NULL;
+    }
+
+    victim->is_bmp = is_bmp;
+    victim->format = format;
+    victim->width = *width;
+    victim->height = *height;
+    victim->mtime = file_stat.st_mtime;
+    victim->file_size = file_stat.st_size;
+    victim->raw_buf = raw_buf;
+    victim->last_used = image_cache_tick;
+
+    return raw_buf;
+}
+
+const char *helper_image_cache_get_bmp(const char *file_path, int *width, int *height, kp_image_format_t format)
+{
+    return image_cache_get(file_path, 1, width, height, format);
+}
+
+const char *helper_image_cache_get_bin(const char *file_path, int width, int height, kp_image_format_t format)
+{
+    return image_cache_get(file_path, 0, &width, &height, format);
+}
+
 static void draw_box_on_bmp_raw_buffer(kp_bounding_box_t boxes[], int box_count, int width, int height, unsigned char *bmp_buf, int padding_byte_num)
 {
     const int thickness = 2;
@@ -872,196 +769,14 @@ err:
     return;
 }
 
-static unsigned char clamp_to_0_255(float num)
-{
-    if (num > 255)
-        return 255;
-    else if (num < 0)
-        return 0;
-    else
-        return (unsigned char)num;
-}
-
 // Passing bmp_padding_byte_num to avoid recalculation
 // bmp_buf is used to store pixel data of bmp image
 static void convert_bin_to_bmp_pixel_data(unsigned char *bin_buf, unsigned char *bmp_buf, int width, int height, kp_image_format_t bin_format, int bmp_padding_byte_num)
 {
-    switch (bin_format)
-    {
-    case KP_IMAGE_FORMAT_RGB565:
-    {
-        unsigned short *rgb565_buf = (unsigned short *)bin_buf;
-
-        int rgb565_pos = 0;
-
-        for (int row = height - 1; row >= 0; row--)
-        {
-            int bmp_pos = (width * 3 + bmp_padding_byte_num) * row; // we only support bmp file with 3 bytes per pixel
-            for (int col = 0; col < width; col++)
-            {
-                bmp_buf[bmp_pos] = (rgb565_buf[rgb565_pos] << 3) & 0b11111000;     // blue
-                bmp_buf[bmp_pos + 1] = (rgb565_buf[rgb565_pos] >> 3) & 0b11111100; // green
-                bmp_buf[bmp_pos + 2] = (rgb565_buf[rgb565_pos] >> 8) & 0b11111000; // red
-
-                bmp_pos += 3;
-                rgb565_pos++;
-            }
-        }
-        break;
-    }
-    case KP_IMAGE_FORMAT_RGBA8888:
-    {
-        // Just an alias for buffer naming consistency
-        unsigned char *rgba8888_buf = bin_buf;
+    int bmp_row_stride = width * 3 + bmp_padding_byte_num; // we only support bmp file with 3 bytes per pixel
 
-        int rgba8888_pos = 0;
-
-        for (int row = height - 1; row >= 0; row--)
-        {
-            int bmp_pos = (width * 3 + bmp_padding_byte_num) * row; // we only support bmp file with 3 bytes per pixel
-            for (int col = 0; col < width; col++)
-            {
-                bmp_buf[bmp_pos] = rgba8888_buf[rgba8888_pos + 2];     // blue
-                bmp_buf[bmp_pos + 1] = rgba8888_buf[rgba8888_pos + 1]; // green
-                bmp_buf[bmp_pos + 2] = rgba8888_buf[rgba8888_pos];     // red
-
-                bmp_pos += 3;
-                rgba8888_pos += 4;
-            }
-        }
-        break;
-    }
-    case KP_IMAGE_FORMAT_YUYV:
-    case KP_IMAGE_FORMAT_YCBCR422_CRY1CBY0:
-    case KP_IMAGE_FORMAT_YCBCR422_CBY1CRY0:
-    case KP_IMAGE_FORMAT_YCBCR422_Y1CRY0CB:
-    case KP_IMAGE_FORMAT_YCBCR422_Y1CBY0CR:
-    case KP_IMAGE_FORMAT_YCBCR422_CRY0CBY1:
-    case KP_IMAGE_FORMAT_YCBCR422_CBY0CRY1:
-    case KP_IMAGE_FORMAT_YCBCR422_Y0CRY1CB:
-    case KP_IMAGE_FORMAT_YCBCR422_Y0CBY1CR:
-    {
-        // Just an alias for buffer naming consistency
-        unsigned char *ycbcr_buf = bin_buf;
-
-        int ycbcr_pos = 0;
-
-        // generate the order mappings of (cr, y1, cb, y0), (cb, y1, cr, y0) to (y0, cb, y1, cr)... described in the yuyv or ycbcr image format
-        int order_mapping[4] = {0};
-        generate_ycbcr_to_ycbcr_order_mapping(bin_format, KP_IMAGE_FORMAT_YCBCR422_Y0CBY1CR, order_mapping);
-
-        for (int row = height - 1; row >= 0; row--)
-        {
-            int bmp_pos = (width * 3 + bmp_padding_byte_num) * row; // we only support bmp file with 3 bytes per pixel
-
-            // FIXME: How if the width is an odd number?
-            for (int col = 0; col < width / 2; col++)
-            {
-                unsigned char output[4];
-                output[0] = ycbcr_buf[ycbcr_pos++]; // one of (y0, cb, y1, cr)
-                output[1] = ycbcr_buf[ycbcr_pos++]; // one of (y0, cb, y1, cr)
-                output[2] = ycbcr_buf[ycbcr_pos++]; // one of (y0, cb, y1, cr)
-                output[3] = ycbcr_buf[ycbcr_pos++]; // one of (y0, cb, y1, cr)
-
-                unsigned char y0 = output[order_mapping[0]];
-                unsigned char cb = output[order_mapping[1]];
-                unsigned char y1 = output[order_mapping[2]];
-                unsigned char cr = output[order_mapping[3]];
-
-                // FIXME: use integer method to speed up
-                float b_diff = 1.77 * (cb - 128);
-                float g_diff = -0.343 * (cb - 128) - 0.714 * (cr - 128);
-                float r_diff = 1.403 * (cr - 128);
-
-                bmp_buf[bmp_pos++] = clamp_to_0_255(y0 + b_diff);
-                bmp_buf[bmp_pos++] = clamp_to_0_255(y0 + g_diff);
-                bmp_buf[bmp_pos++] = clamp_to_0_255(y0 + r_diff);
-                bmp_buf[bmp_pos++] = clamp_to_0_255(y1 + b_diff);
-                bmp_buf[bmp_pos++] = clamp_to_0_255(y1 + g_diff);
-                bmp_buf[bmp_pos++] = clamp_to_0_255(y1 + r_diff);
-            }
-        }
-        break;
-    }
-    case KP_IMAGE_FORMAT_RAW8:
-    {
-        // Just an alias for buffer naming consistency
-        unsigned char *raw8_buf = bin_buf;
-
-        int raw8_pos = 0;
-
-        for (int row = height - 1; row >= 0; row--)
-        {
-            int bmp_pos = (width * 3 + bmp_padding_byte_num) * row; // we only support bmp file with 3 bytes per pixel
-            for (int col = 0; col < width; col++)
-            {
-                memset(bmp_buf + bmp_pos, raw8_buf[raw8_pos++], 3);
-                bmp_pos += 3;
-            }
-        }
-        break;
-    }
-    case KP_IMAGE_FORMAT_YUV420:
-    {
-        if ((0 != width % 2) || (0 != height % 2)) {
-            printf("Error! width or height is not even number\n");
-            return;
-        }
-
-        // Just an alias for buffer naming consistency
-        unsigned char *yuv_buf = bin_buf;
-        int y_bias = width * height;
-        int u_bias = y_bias / 4;
-        int u_pos = y_bias;
-        int v_pos = y_bias + u_bias;
-
-        for (int row = height - 1; row >= 0; row -= 2)
-        {
-            int bmp_pos_row_0 = (width * 3 + bmp_padding_byte_num) * row; // we only support bmp file with 3 bytes per pixel
-            int bmp_pos_row_1 = (width * 3 + bmp_padding_byte_num) * (row - 1); // we only support bmp file with 3 bytes per pixel
-            int y_pos_row_0 = width * (height - row - 1);
-            int y_pos_row_1 = width * (height - row);
-
-            for (int col = 0; col < width; col += 2)
-            {
-                unsigned char y[2][2];
-                unsigned char u, v;
-
-                y[0][0] = yuv_buf[y_pos_row_0++];
-                y[0][1] = yuv_buf[y_pos_row_0++];
-                y[1][0] = yuv_buf[y_pos_row_1++];
-                y[1][1] = yuv_buf[y_pos_row_1++];
-
-                u = yuv_buf[u_pos++];
-                v = yuv_buf[v_pos++];
-
-                // FIXME: use integer method to speed up
-                float b_diff = 1.77 * (u - 128);
-                float g_diff = -0.343 * (u - 128) - 0.714 * (v - 128);
-                float r_diff = 1.403 * (v - 128);
-
-                bmp_buf[bmp_pos_row_0++] = clamp_to_0_255(y[0][0] + b_diff);
-                bmp_buf[bmp_pos_row_0++] = clamp_to_0_255(y[0][0] + g_diff);
-                bmp_buf[bmp_pos_row_0++] = clamp_to_0_255(y[0][0] + r_diff);
-                bmp_buf[bmp_pos_row_0++] = clamp_to_0_255(y[0][1] + b_diff);
-                bmp_buf[bmp_pos_row_0++] = clamp_to_0_255(y[0][1] + g_diff);
-                bmp_buf[bmp_pos_row_0++] = clamp_to_0_255(y[0][1] + r_diff);
-
-                bmp_buf[bmp_pos_row_1++] = clamp_to_0_255(y[1][0] + b_diff);
-                bmp_buf[bmp_pos_row_1++] = clamp_to_0_255(y[1][0] + g_diff);
-                bmp_buf[bmp_pos_row_1++] = clamp_to_0_255(y[1][0] + r_diff);
-                bmp_buf[bmp_pos_row_1++] = clamp_to_0_255(y[1][1] + b_diff);
-                bmp_buf[bmp_pos_row_1++] = clamp_to_0_255(y[1][1] + g_diff);
-                bmp_buf[bmp_pos_row_1++] = clamp_to_0_255(y[1][1] + r_diff);
-            }
-        }
-        break;
-    }
-    default:
-    case KP_IMAGE_FORMAT_UNKNOWN:
-        printf("image format is not supported\n");
-        return;
-    }
+    // bmp rows are stored bottom-up, so start from the last row and walk backwards
+    pixel_convert_to_bgr888(bin_buf, width, height, bin_format, bmp_buf + (size_t)bmp_row_stride * (height - 1), -bmp_row_stride);
 }
 
 void helper_draw_box_on_bmp_from_bin(const char *in_bin_path, int in_bin_width, int in_bin_height, kp_image_format_t in_bin_format,
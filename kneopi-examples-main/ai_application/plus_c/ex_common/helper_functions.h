@@ -16,6 +16,19 @@ void helper_measure_time_begin();
 void helper_measure_time_end(double *measued_time);
 char *helper_bmp_file_to_raw_buffer(const char *file_path, int *width, int *height, kp_image_format_t format);
 char *helper_bin_file_to_raw_buffer(const char *file_path, int width, int height, kp_image_format_t format);
+
+// size in bytes of a width x height image in format, -1 if the format is not supported
+int helper_get_raw_buffer_size(int width, int height, kp_image_format_t format);
+// same as the *_to_raw_buffer functions but write into a caller provided buffer of raw_buf_size bytes, return 0 on success, -1 on fail
+int helper_bmp_file_to_user_buffer(const char *file_path, int *width, int *height, kp_image_format_t format, char *raw_buf, int raw_buf_size);
+int helper_bin_file_to_user_buffer(const char *file_path, int width, int height, kp_image_format_t format, char *raw_buf, int raw_buf_size);
+
+// LRU cache of converted images keyed by (path, format, size), entries are reloaded when the file changes.
+// Returned buffers are owned by the cache and stay valid until the next helper_image_cache_* call. Not thread-safe.
+int helper_image_cache_init(int capacity); // capacity <= 0 selects the default, return 0 on success, -1 on fail
+const char *helper_image_cache_get_bmp(const char *file_path, int *width, int *height, kp_image_format_t format);
+const char *helper_image_cache_get_bin(const char *file_path, int width, int height, kp_image_format_t format);
+void helper_image_cache_release();
 void helper_draw_box_on_bmp(const char *in_bmp_path, const char *out_bmp_path, kp_bounding_box_t boxes[], int box_count);
 void helper_draw_box_on_bmp_from_bin(const char *in_bin_path, int in_bin_width, int in_bin_height, kp_image_format_t in_bin_format,
                                      const char *out_bmp_path, kp_bounding_box_t boxes[], int box_count);
@@ -51,6 +64,7 @@ void helper_get_device_usb_speed_by_port_id(kp_devices_list_t *devices_list, int
 // box_count_last and boxes_last: box count and all boxes info in the last image frame
 // box_count_lastest and boxes_lastest: box count and all boxes info in the current image frame
 // box_count_stabilized and boxes_stabilized: stabilized boxes result and the total count of them
+// superseded by bytetrack_update() in bytetrack.h, which tracks boxes with a Kalman filter and also gives track IDs
 void helper_bounding_box_stabilization(uint32_t box_count_last, kp_bounding_box_t *boxes_last,
                                        uint32_t box_count_latest, kp_bounding_box_t *boxes_latest,
                                        uint32_t *box_count_stabilized, kp_bounding_box_t *boxes_stabilized,
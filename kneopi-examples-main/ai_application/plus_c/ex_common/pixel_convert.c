@@ -0,0 +1,462 @@
+/**
+ * @file        pixel_convert.c
+ * @brief       implementation of pixel format conversion
+ * @version     0.1
+ * @date        2021-03-22
+ *
+ * @copyright   Copyright (c) 2021 Kneron Inc. All rights reserved.
+ */
+
+#include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define PIXEL_CONVERT_NEON
+#endif
+
+#include "pixel_convert.h"
+
+// RGB -> YCbCr, 8 bit fraction. r, g, b of the chroma macros are the sum of (1 << shift) pixels.
+#define RGB_TO_Y(r, g, b)               ((77 * (r) + 150 * (g) + 29 * (b)) >> 8)
+#define RGB_SUM_TO_CB(r, g, b, shift)   ((-43 * (r) - 85 * (g) + 128 * (b) + (128 << (8 + (shift)))) >> (8 + (shift)))
+#define RGB_SUM_TO_CR(r, g, b, shift)   ((128 * (r) - 107 * (g) - 21 * (b) + (128 << (8 + (shift)))) >> (8 + (shift)))
+
+// YCbCr -> RGB, 6 bit fraction so the products fit in 16 bit NEON lanes. Scalar and NEON results are bit exact.
+#define CB_TO_B_COEF    113     // 1.770
+#define CB_TO_G_COEF    22      // 0.343
+#define CR_TO_G_COEF    46      // 0.714
+#define CR_TO_R_COEF    90      // 1.403
+#define YUV_FRAC_BITS   6
+#define YUV_ROUND       (1 << (YUV_FRAC_BITS - 1))
+
+static const pixel_ycbcr422_order_t ycbcr422_order_table[] = {
+    [KP_IMAGE_FORMAT_YCBCR422_CRY1CBY0 - KP_IMAGE_FORMAT_YUYV] = {.y0 = 3, .cb = 2, .y1 = 1, .cr = 0},
+    [KP_IMAGE_FORMAT_YCBCR422_CBY1CRY0 - KP_IMAGE_FORMAT_YUYV] = {.y0 = 3, .cb = 0, .y1 = 1, .cr = 2},
+    [KP_IMAGE_FORMAT_YCBCR422_Y1CRY0CB - KP_IMAGE_FORMAT_YUYV] = {.y0 = 2, .cb = 3, .y1 = 0, .cr = 1},
+    [KP_IMAGE_FORMAT_YCBCR422_Y1CBY0CR - KP_IMAGE_FORMAT_YUYV] = {.y0 = 2, .cb = 1, .y1 = 0, .cr = 3},
+    [KP_IMAGE_FORMAT_YCBCR422_CRY0CBY1 - KP_IMAGE_FORMAT_YUYV] = {.y0 = 1, .cb = 2, .y1 = 3, .cr = 0},
+    [KP_IMAGE_FORMAT_YCBCR422_CBY0CRY1 - KP_IMAGE_FORMAT_YUYV] = {.y0 = 1, .cb = 0, .y1 = 3, .cr = 2},
+    [KP_IMAGE_FORMAT_YCBCR422_Y0CRY1CB - KP_IMAGE_FORMAT_YUYV] = {.y0 = 0, .cb = 3, .y1 = 2, .cr = 1},
+    [KP_IMAGE_FORMAT_YCBCR422_Y0CBY1CR - KP_IMAGE_FORMAT_YUYV] = {.y0 = 0, .cb = 1, .y1 = 2, .cr = 3},
+    [KP_IMAGE_FORMAT_YUYV - KP_IMAGE_FORMAT_YUYV]              = {.y0 = 0, .cb = 1, .y1 = 2, .cr = 3},
+};
+
+static inline uint8_t clamp_u8(int num)
+{
+    num = (num < 0) ? 0 : num;
+    return (uint8_t)((num > 255) ? 255 : num);
+}
+
+int pixel_convert_get_ycbcr422_order(kp_image_format_t format, pixel_ycbcr422_order_t *order)
+{
+    switch (format)
+    {
+    case KP_IMAGE_FORMAT_YUYV:
+    case KP_IMAGE_FORMAT_YCBCR422_CRY1CBY0:
+    case KP_IMAGE_FORMAT_YCBCR422_CBY1CRY0:
+    case KP_IMAGE_FORMAT_YCBCR422_Y1CRY0CB:
+    case KP_IMAGE_FORMAT_YCBCR422_Y1CBY0CR:
+    case KP_IMAGE_FORMAT_YCBCR422_CRY0CBY1:
+    case KP_IMAGE_FORMAT_YCBCR422_CBY0CRY1:
+    case KP_IMAGE_FORMAT_YCBCR422_Y0CRY1CB:
+    case KP_IMAGE_FORMAT_YCBCR422_Y0CBY1CR:
+        *order = ycbcr422_order_table[format - KP_IMAGE_FORMAT_YUYV];
+        return 0;
+    default:
+        return -1;
+    }
+}
+
+/* ============================ from BGR888 ================================ */
+
+void pixel_convert_bgr888_to_rgb565(const uint8_t *restrict bgr, uint16_t *restrict rgb565, int width)
+{
+    int col = 0;
+
+#ifdef PIXEL_CONVERT_NEON
+    for (; col + 8 <= width; col += 8)
+    {
+        uint8x8x3_t pixel = vld3_u8(bgr + 3 * col);
+        uint16x8_t red = vshll_n_u8(vand_u8(pixel.val[2], vdup_n_u8(0xF8)), 8);
+        uint16x8_t green = vshll_n_u8(vand_u8(pixel.val[1], vdup_n_u8(0xFC)), 3);
+        uint16x8_t blue = vmovl_u8(vshr_n_u8(pixel.val[0], 3));
+
+        vst1q_u16(rgb565 + col, vorrq_u16(red, vorrq_u16(green, blue)));
+    }
+#endif
+
+    for (; col < width; col++)
+    {
+        uint16_t blue = bgr[3 * col];
+        uint16_t green = bgr[3 * col + 1];
+        uint16_t red = bgr[3 * col + 2];
+
+        rgb565[col] = ((red & 0b11111000) << 8) | ((green & 0b11111100) << 3) | (blue >> 3);
+    }
+}
+
+void pixel_convert_bgr888_to_rgba8888(const uint8_t *restrict bgr, uint8_t *restrict rgba, int width)
+{
+    int col = 0;
+
+#ifdef PIXEL_CONVERT_NEON
+    for (; col + 8 <= width; col += 8)
+    {
+        uint8x8x3_t pixel = vld3_u8(bgr + 3 * col);
+        uint8x8x4_t out;
+
+        out.val[0] = pixel.val[2];
+        out.val[1] = pixel.val[1];
+        out.val[2] = pixel.val[0];
+        out.val[3] = vdup_n_u8(0);
+        vst4_u8(rgba + 4 * col, out);
+    }
+#endif
+
+    for (; col < width; col++)
+    {
+        rgba[4 * col] = bgr[3 * col + 2];
+        rgba[4 * col + 1] = bgr[3 * col + 1];
+        rgba[4 * col + 2] = bgr[3 * col];
+        rgba[4 * col + 3] = 0;
+    }
+}
+
+void pixel_convert_bgr888_to_ycbcr422(const uint8_t *restrict bgr, uint8_t *restrict ycbcr, int width, const pixel_ycbcr422_order_t *order)
+{
+    const int y0_pos = order->y0, cb_pos = order->cb, y1_pos = order->y1, cr_pos = order->cr;
+
+    for (int col = 0; col < width / 2; col++)
+    {
+        const uint8_t *p = bgr + 6 * col;
+        int b0 = p[0], g0 = p[1], r0 = p[2];
+        int b1 = p[3], g1 = p[4], r1 = p[5];
+        uint8_t *out = ycbcr + 4 * col;
+
+        out[y0_pos] = (uint8_t)RGB_TO_Y(r0, g0, b0);
+        out[cb_pos] = (uint8_t)RGB_SUM_TO_CB(r0 + r1, g0 + g1, b0 + b1, 1);
+        out[y1_pos] = (uint8_t)RGB_TO_Y(r1, g1, b1);
+        out[cr_pos] = (uint8_t)RGB_SUM_TO_CR(r0 + r1, g0 + g1, b0 + b1, 1);
+    }
+}
+
+void pixel_convert_bgr888_to_yuv420(const uint8_t *restrict bgr_row_0, const uint8_t *restrict bgr_row_1,
+                                    uint8_t *restrict y_row_0, uint8_t *restrict y_row_1,
+                                    uint8_t *restrict u, uint8_t *restrict v, int width)
+{
+    for (int col = 0; col < width / 2; col++)
+    {
+        const uint8_t *p0 = bgr_row_0 + 6 * col;
+        const uint8_t *p1 = bgr_row_1 + 6 * col;
+
+        y_row_0[2 * col] = (uint8_t)RGB_TO_Y(p0[2], p0[1], p0[0]);
+        y_row_0[2 * col + 1] = (uint8_t)RGB_TO_Y(p0[5], p0[4], p0[3]);
+        y_row_1[2 * col] = (uint8_t)RGB_TO_Y(p1[2], p1[1], p1[0]);
+        y_row_1[2 * col + 1] = (uint8_t)RGB_TO_Y(p1[5], p1[4], p1[3]);
+
+        int r = p0[2] + p0[5] + p1[2] + p1[5];
+        int g = p0[1] + p0[4] + p1[1] + p1[4];
+        int b = p0[0] + p0[3] + p1[0] + p1[3];
+
+        u[col] = (uint8_t)RGB_SUM_TO_CB(r, g, b, 2);
+        v[col] = (uint8_t)RGB_SUM_TO_CR(r, g, b, 2);
+    }
+}
+
+/* ============================= to BGR888 ================================= */
+
+void pixel_convert_rgb565_to_bgr888(const uint16_t *restrict rgb565, uint8_t *restrict bgr, int width)
+{
+    int col = 0;
+
+#ifdef PIXEL_CONVERT_NEON
+    for (; col + 8 <= width; col += 8)
+    {
+        uint16x8_t pixel = vld1q_u16(rgb565 + col);
+        uint8x8x3_t out;
+
+        out.val[0] = vmovn_u16(vshlq_n_u16(pixel, 3));                          // blue, low 3 bits are shifted in as 0
+        out.val[1] = vand_u8(vshrn_n_u16(pixel, 3), vdup_n_u8(0b11111100));     // green
+        out.val[2] = vand_u8(vshrn_n_u16(pixel, 8), vdup_n_u8(0b11111000));     // red
+        vst3_u8(bgr + 3 * col, out);
+    }
+#endif
+
+    for (; col < width; col++)
+    {
+        bgr[3 * col] = (rgb565[col] << 3) & 0b11111000;      // blue
+        bgr[3 * col + 1] = (rgb565[col] >> 3) & 0b11111100;  // green
+        bgr[3 * col + 2] = (rgb565[col] >> 8) & 0b11111000;  // red
+    }
+}
+
+void pixel_convert_rgba8888_to_bgr888(const uint8_t *restrict rgba, uint8_t *restrict bgr, int width)
+{
+    int col = 0;
+
+#ifdef PIXEL_CONVERT_NEON
+    for (; col + 8 <= width; col += 8)
+    {
+        uint8x8x4_t pixel = vld4_u8(rgba + 4 * col);
+        uint8x8x3_t out;
+
+        out.val[0] = pixel.val[2];
+        out.val[1] = pixel.val[1];
+        out.val[2] = pixel.val[0];
+        vst3_u8(bgr + 3 * col, out);
+    }
+#endif
+
+    for (; col < width; col++)
+    {
+        bgr[3 * col] = rgba[4 * col + 2];
+        bgr[3 * col + 1] = rgba[4 * col + 1];
+        bgr[3 * col + 2] = rgba[4 * col];
+    }
+}
+
+#ifdef PIXEL_CONVERT_NEON
+// chroma offsets for 8 (cb, cr) pairs
+static inline void neon_chroma_offset(uint8x8_t cb, uint8x8_t cr, int16x8_t *b_diff, int16x8_t *g_diff, int16x8_t *r_diff)
+{
+    int16x8_t cb_s = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(cb)), vdupq_n_s16(128));
+    int16x8_t cr_s = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(cr)), vdupq_n_s16(128));
+
+    *b_diff = vrshrq_n_s16(vmulq_n_s16(cb_s, CB_TO_B_COEF), YUV_FRAC_BITS);
+    *g_diff = vrshrq_n_s16(vmlaq_n_s16(vmulq_n_s16(cb_s, -CB_TO_G_COEF), cr_s, -CR_TO_G_COEF), YUV_FRAC_BITS);
+    *r_diff = vrshrq_n_s16(vmulq_n_s16(cr_s, CR_TO_R_COEF), YUV_FRAC_BITS);
+}
+
+// add the chroma offset to 8 luma samples and saturate
+static inline uint8x8_t neon_add_luma(uint8x8_t y, int16x8_t diff)
+{
+    return vqmovun_s16(vaddq_s16(vreinterpretq_s16_u16(vmovl_u8(y)), diff));
+}
+
+// convert 16 pixels sharing 8 chroma pairs, y_even/y_odd are the luma samples of the even/odd pixels
+static inline void neon_store_bgr16(uint8_t *bgr, uint8x8_t y_even, uint8x8_t y_odd, int16x8_t b_diff, int16x8_t g_diff, int16x8_t r_diff)
+{
+    uint8x8x2_t blue = vzip_u8(neon_add_luma(y_even, b_diff), neon_add_luma(y_odd, b_diff));
+    uint8x8x2_t green = vzip_u8(neon_add_luma(y_even, g_diff), neon_add_luma(y_odd, g_diff));
+    uint8x8x2_t red = vzip_u8(neon_add_luma(y_even, r_diff), neon_add_luma(y_odd, r_diff));
+    uint8x16x3_t out;
+
+    out.val[0] = vcombine_u8(blue.val[0], blue.val[1]);
+    out.val[1] = vcombine_u8(green.val[0], green.val[1]);
+    out.val[2] = vcombine_u8(red.val[0], red.val[1]);
+    vst3q_u8(bgr, out);
+}
+#endif
+
+// write the two pixels sharing one (cb, cr) pair
+static inline void store_bgr_pair(uint8_t *bgr, int y0, int y1, int cb, int cr)
+{
+    int b_diff = (CB_TO_B_COEF * (cb - 128) + YUV_ROUND) >> YUV_FRAC_BITS;
+    int g_diff = (-CB_TO_G_COEF * (cb - 128) - CR_TO_G_COEF * (cr - 128) + YUV_ROUND) >> YUV_FRAC_BITS;
+    int r_diff = (CR_TO_R_COEF * (cr - 128) + YUV_ROUND) >> YUV_FRAC_BITS;
+
+    bgr[0] = clamp_u8(y0 + b_diff);
+    bgr[1] = clamp_u8(y0 + g_diff);
+    bgr[2] = clamp_u8(y0 + r_diff);
+    bgr[3] = clamp_u8(y1 + b_diff);
+    bgr[4] = clamp_u8(y1 + g_diff);
+    bgr[5] = clamp_u8(y1 + r_diff);
+}
+
+void pixel_convert_ycbcr422_to_bgr888(const uint8_t *restrict ycbcr, uint8_t *restrict bgr, int width, const pixel_ycbcr422_order_t *order)
+{
+    const int y0_pos = order->y0, cb_pos = order->cb, y1_pos = order->y1, cr_pos = order->cr;
+    int pair = 0;
+
+#ifdef PIXEL_CONVERT_NEON
+    for (; pair + 8 <= width / 2; pair += 8)
+    {
+        uint8x8x4_t macro_pixel = vld4_u8(ycbcr + 4 * pair);
+        int16x8_t b_diff, g_diff, r_diff;
+
+        neon_chroma_offset(macro_pixel.val[cb_pos], macro_pixel.val[cr_pos], &b_diff, &g_diff, &r_diff);
+        neon_store_bgr16(bgr + 6 * pair, macro_pixel.val[y0_pos], macro_pixel.val[y1_pos], b_diff, g_diff, r_diff);
+    }
+#endif
+
+    for (; pair < width / 2; pair++)
+    {
+        const uint8_t *in = ycbcr + 4 * pair;
+
+        store_bgr_pair(bgr + 6 * pair, in[y0_pos], in[y1_pos], in[cb_pos], in[cr_pos]);
+    }
+}
+
+void pixel_convert_yuv420_to_bgr888(const uint8_t *restrict y_row_0, const uint8_t *restrict y_row_1,
+                                    const uint8_t *restrict u, const uint8_t *restrict v,
+                                    uint8_t *restrict bgr_row_0, uint8_t *restrict bgr_row_1, int width)
+{
+    int pair = 0;
+
+#ifdef PIXEL_CONVERT_NEON
+    for (; pair + 8 <= width / 2; pair += 8)
+    {
+        uint8x8x2_t luma_0 = vld2_u8(y_row_0 + 2 * pair);
+        uint8x8x2_t luma_1 = vld2_u8(y_row_1 + 2 * pair);
+        int16x8_t b_diff, g_diff, r_diff;
+
+        neon_chroma_offset(vld1_u8(u + pair), vld1_u8(v + pair), &b_diff, &g_diff, &r_diff);
+        neon_store_bgr16(bgr_row_0 + 6 * pair, luma_0.val[0], luma_0.val[1], b_diff, g_diff, r_diff);
+        neon_store_bgr16(bgr_row_1 + 6 * pair, luma_1.val[0], luma_1.val[1], b_diff, g_diff, r_diff);
+    }
+#endif
+
+    for (; pair < width / 2; pair++)
+    {
+        store_bgr_pair(bgr_row_0 + 6 * pair, y_row_0[2 * pair], y_row_0[2 * pair + 1], u[pair], v[pair]);
+        store_bgr_pair(bgr_row_1 + 6 * pair, y_row_1[2 * pair], y_row_1[2 * pair + 1], u[pair], v[pair]);
+    }
+}
+
+void pixel_convert_raw8_to_bgr888(const uint8_t *restrict raw8, uint8_t *restrict bgr, int width)
+{
+    int col = 0;
+
+#ifdef PIXEL_CONVERT_NEON
+    for (; col + 16 <= width; col += 16)
+    {
+        uint8x16x3_t out;
+
+        out.val[0] = out.val[1] = out.val[2] = vld1q_u8(raw8 + col);
+        vst3q_u8(bgr + 3 * col, out);
+    }
+#endif
+
+    for (; col < width; col++)
+    {
+        bgr[3 * col] = raw8[col];
+        bgr[3 * col + 1] = raw8[col];
+        bgr[3 * col + 2] = raw8[col];
+    }
+}
+
+/* ============================= whole image =============================== */
+
+int pixel_convert_from_bgr888(const uint8_t *bgr, int bgr_stride, int width, int height, kp_image_format_t format, uint8_t *dst)
+{
+    pixel_ycbcr422_order_t order;
+
+    if (width <= 0 || height <= 0)
+        return -1;
+
+    switch (format)
+    {
+    case KP_IMAGE_FORMAT_RGB565:
+        for (int row = 0; row < height; row++)
+            pixel_convert_bgr888_to_rgb565(bgr + (ptrdiff_t)bgr_stride * row, (uint16_t *)dst + (size_t)width * row, width);
+        break;
+    case KP_IMAGE_FORMAT_RGBA8888:
+        for (int row = 0; row < height; row++)
+            pixel_convert_bgr888_to_rgba8888(bgr + (ptrdiff_t)bgr_stride * row, dst + (size_t)width * 4 * row, width);
+        break;
+    case KP_IMAGE_FORMAT_YUYV:
+    case KP_IMAGE_FORMAT_YCBCR422_CRY1CBY0:
+    case KP_IMAGE_FORMAT_YCBCR422_CBY1CRY0:
+    case KP_IMAGE_FORMAT_YCBCR422_Y1CRY0CB:
+    case KP_IMAGE_FORMAT_YCBCR422_Y1CBY0CR:
+    case KP_IMAGE_FORMAT_YCBCR422_CRY0CBY1:
+    case KP_IMAGE_FORMAT_YCBCR422_CBY0CRY1:
+    case KP_IMAGE_FORMAT_YCBCR422_Y0CRY1CB:
+    case KP_IMAGE_FORMAT_YCBCR422_Y0CBY1CR:
+        pixel_convert_get_ycbcr422_order(format, &order);
+        // FIXME? How if the width is an odd number?
+        for (int row = 0; row < height; row++)
+            pixel_convert_bgr888_to_ycbcr422(bgr + (ptrdiff_t)bgr_stride * row, dst + (size_t)(width / 2) * 4 * row, width, &order);
+        break;
+    case KP_IMAGE_FORMAT_YUV420:
+    {
+        if ((0 != width % 2) || (0 != height % 2)) {
+            printf("Error! width or height is not even number\n");
+            return -1;
+        }
+
+        uint8_t *y_plane = dst;
+        uint8_t *u_plane = y_plane + (size_t)width * height;
+        uint8_t *v_plane = u_plane + (size_t)width * height / 4;
+
+        for (int row = 0; row < height; row += 2)
+        {
+            pixel_convert_bgr888_to_yuv420(bgr + (ptrdiff_t)bgr_stride * row, bgr + (ptrdiff_t)bgr_stride * (row + 1),
+                                           y_plane + (size_t)width * row, y_plane + (size_t)width * (row + 1),
+                                           u_plane + (size_t)(width / 2) * (row / 2), v_plane + (size_t)(width / 2) * (row / 2), width);
+        }
+        break;
+    }
+    case KP_IMAGE_FORMAT_UNKNOWN:
+    default:
+        printf("image format is not supported\n");
+        return -1;
+    }
+
+    return 0;
+}
+
+int pixel_convert_to_bgr888(const uint8_t *src, int width, int height, kp_image_format_t format, uint8_t *bgr, int bgr_stride)
+{
+    pixel_ycbcr422_order_t order;
+
+    if (width <= 0 || height <= 0)
+        return -1;
+
+    switch (format)
+    {
+    case KP_IMAGE_FORMAT_RGB565:
+        for (int row = 0; row < height; row++)
+            pixel_convert_rgb565_to_bgr888((const uint16_t *)src + (size_t)width * row, bgr + (ptrdiff_t)bgr_stride * row, width);
+        break;
+    case KP_IMAGE_FORMAT_RGBA8888:
+        for (int row = 0; row < height; row++)
+            pixel_convert_rgba8888_to_bgr888(src + (size_t)width * 4 * row, bgr + (ptrdiff_t)bgr_stride * row, width);
+        break;
+    case KP_IMAGE_FORMAT_YUYV:
+    case KP_IMAGE_FORMAT_YCBCR422_CRY1CBY0:
+    case KP_IMAGE_FORMAT_YCBCR422_CBY1CRY0:
+    case KP_IMAGE_FORMAT_YCBCR422_Y1CRY0CB:
+    case KP_IMAGE_FORMAT_YCBCR422_Y1CBY0CR:
+    case KP_IMAGE_FORMAT_YCBCR422_CRY0CBY1:
+    case KP_IMAGE_FORMAT_YCBCR422_CBY0CRY1:
+    case KP_IMAGE_FORMAT_YCBCR422_Y0CRY1CB:
+    case KP_IMAGE_FORMAT_YCBCR422_Y0CBY1CR:
+        pixel_convert_get_ycbcr422_order(format, &order);
+        // FIXME: How if the width is an odd number?
+        for (int row = 0; row < height; row++)
+            pixel_convert_ycbcr422_to_bgr888(src + (size_t)(width / 2) * 4 * row, bgr + (ptrdiff_t)bgr_stride * row, width, &order);
+        break;
+    case KP_IMAGE_FORMAT_RAW8:
+        for (int row = 0; row < height; row++)
+            pixel_convert_raw8_to_bgr888(src + (size_t)width * row, bgr + (ptrdiff_t)bgr_stride * row, width);
+        break;
+    case KP_IMAGE_FORMAT_YUV420:
+    {
+        if ((0 != width % 2) || (0 != height % 2)) {
+            printf("Error! width or height is not even number\n");
+            return -1;
+        }
+
+        const uint8_t *y_plane = src;
+        const uint8_t *u_plane = y_plane + (size_t)width * height;
+        const uint8_t *v_plane = u_plane + (size_t)width * height / 4;
+
+        for (int row = 0; row < height; row += 2)
+        {
+            pixel_convert_yuv420_to_bgr888(y_plane + (size_t)width * row, y_plane + (size_t)width * (row + 1),
+                                           u_plane + (size_t)(width / 2) * (row / 2), v_plane + (size_t)(width / 2) * (row / 2),
+                                           bgr + (ptrdiff_t)bgr_stride * row, bgr + (ptrdiff_t)bgr_stride * (row + 1), width);
+        }
+        break;
+    }
+    case KP_IMAGE_FORMAT_UNKNOWN:
+    default:
+        printf("image format is not supported\n");
+        return -1;
+    }
+
+    return 0;
+}
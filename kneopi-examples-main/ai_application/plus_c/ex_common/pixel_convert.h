@@ -0,0 +1,88 @@
+/**
+ * @file        pixel_convert.h
+ * @brief       pixel format conversion APIs
+ *
+ * Conversions between BGR888 (the pixel layout of 24 bit bmp files) and the kp_image_format_t
+ * formats accepted by the Kneron PLUS inference APIs. YUV <-> RGB uses fixed-point BT.601 full
+ * range arithmetic. Row functions use NEON on ARM and auto-vectorizable scalar code elsewhere.
+ *
+ * @version     0.1
+ * @date        2021-03-22
+ *
+ * @copyright   Copyright (c) 2021 Kneron Inc. All rights reserved.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "kp_struct.h"
+
+/**
+ * @brief byte positions of (y0, cb, y1, cr) inside one 4-byte YCbCr422 macro pixel.
+ */
+typedef struct
+{
+    uint8_t y0;
+    uint8_t cb;
+    uint8_t y1;
+    uint8_t cr;
+} pixel_ycbcr422_order_t;
+
+/**
+ * @brief get the byte order of a YUYV/YCbCr422 format.
+ *
+ * @param[in] format one of KP_IMAGE_FORMAT_YUYV or KP_IMAGE_FORMAT_YCBCR422_*.
+ * @param[out] order byte positions of (y0, cb, y1, cr).
+ *
+ * @return return 0 means sucessful, -1 if format is not a YCbCr422 format.
+ */
+int pixel_convert_get_ycbcr422_order(kp_image_format_t format, pixel_ycbcr422_order_t *order);
+
+/**
+ * @brief row conversions from BGR888, width is in pixels.
+ *
+ * YCbCr422 and YUV420 expect an even width, YUV420 converts two vertically adjacent rows at a time.
+ */
+void pixel_convert_bgr888_to_rgb565(const uint8_t *bgr, uint16_t *rgb565, int width);
+void pixel_convert_bgr888_to_rgba8888(const uint8_t *bgr, uint8_t *rgba, int width);
+void pixel_convert_bgr888_to_ycbcr422(const uint8_t *bgr, uint8_t *ycbcr, int width, const pixel_ycbcr422_order_t *order);
+void pixel_convert_bgr888_to_yuv420(const uint8_t *bgr_row_0, const uint8_t *bgr_row_1,
+                                    uint8_t *y_row_0, uint8_t *y_row_1, uint8_t *u, uint8_t *v, int width);
+
+/**
+ * @brief row conversions to BGR888, width is in pixels.
+ */
+void pixel_convert_rgb565_to_bgr888(const uint16_t *rgb565, uint8_t *bgr, int width);
+void pixel_convert_rgba8888_to_bgr888(const uint8_t *rgba, uint8_t *bgr, int width);
+void pixel_convert_ycbcr422_to_bgr888(const uint8_t *ycbcr, uint8_t *bgr, int width, const pixel_ycbcr422_order_t *order);
+void pixel_convert_yuv420_to_bgr888(const uint8_t *y_row_0, const uint8_t *y_row_1, const uint8_t *u, const uint8_t *v,
+                                    uint8_t *bgr_row_0, uint8_t *bgr_row_1, int width);
+void pixel_convert_raw8_to_bgr888(const uint8_t *raw8, uint8_t *bgr, int width);
+
+/**
+ * @brief convert a BGR888 image into a packed image of the given format.
+ *
+ * @param[in] bgr first (top) image row.
+ * @param[in] bgr_stride byte distance between image rows, negative for bottom-up bmp pixel data.
+ * @param[in] width image width.
+ * @param[in] height image height.
+ * @param[in] format output image format.
+ * @param[out] dst output buffer, it must hold the whole image in format.
+ *
+ * @return return 0 means sucessful, otherwise failed.
+ */
+int pixel_convert_from_bgr888(const uint8_t *bgr, int bgr_stride, int width, int height, kp_image_format_t format, uint8_t *dst);
+
+/**
+ * @brief convert a packed image of the given format into a BGR888 image.
+ *
+ * @param[in] src input image.
+ * @param[in] width image width.
+ * @param[in] height image height.
+ * @param[in] format input image format, KP_IMAGE_FORMAT_RAW8 is expanded to gray.
+ * @param[out] bgr first (top) output image row.
+ * @param[in] bgr_stride byte distance between image rows, negative for bottom-up bmp pixel data.
+ *
+ * @return return 0 means sucessful, otherwise failed.
+ */
+int pixel_convert_to_bgr888(const uint8_t *src, int width, int height, kp_image_format_t format, uint8_t *bgr, int bgr_stride);
@@ -19,6 +19,7 @@ extern "C"
 #include "kp_inference.h"
 #include "helper_functions.h"
 #include "postprocess.h"
+#include "bytetrack.h"
 }
 
 #include <opencv2/opencv.hpp>
@@ -116,10 +117,10 @@ void *result_receive_function(void *data)
         free(output_nodes[1]);
         free(output_nodes[2]);
 
-        ++_cur_result_index;
-
+        /******* publish the result and its index together, the display tracks each result once *******/
         _mutex_result.lock();
         memcpy((void *)&_yolo_result_latest, (void *)&yolo_result, sizeof(kp_yolo_result_t));
+        ++_cur_result_index;
         _mutex_result.unlock();
     }
 
@@ -146,13 +147,23 @@ void dispalay() {
     char box_info[128];
     int image_count     = 0;
     int result_count    = 0;
-
-    /******* record last result *******/
-    static kp_yolo_result_t _yolo_result_last = {0};
-
-    /******* record stabilized bounding boxes result *******/
-    static uint32_t box_count_stabilized;
-    static kp_bounding_box_t boxes_stabilized[YOLO_GOOD_BOX_MAX];
+    int result_index    = 0;
+
+    /******* tracked objects of the latest result *******/
+    static bytetrack_object_t tracked_objects[YOLO_GOOD_BOX_MAX];
+    int tracked_count           = 0;
+    int tracked_result_index    = 0;
+
+    /******* create tracker, track_thresh 0.5 is the ByteTrack demo setting *******/
+    bytetrack_config_t tracker_config;
+    bytetrack_get_default_config(&tracker_config);
+    tracker_config.track_thresh = 0.5;
+
+    bytetrack_t *tracker = bytetrack_create(&tracker_config);
+    if (NULL == tracker) {
+        _receive_running = false;
+        return;
+    }
 
     /******* initialize cv mat for display *******/
     cv::Mat cv_img_show;
@@ -166,7 +177,9 @@ void dispalay() {
 
     /******* initial FPS calculate variables *******/
     image_count     = _cur_image_index;
+    _mutex_result.lock();
     result_count    = _cur_result_index;
+    _mutex_result.unlock();
     helper_measure_time_begin();
 
     while (true) {
@@ -177,31 +190,37 @@ void dispalay() {
 
         _mutex_result.lock();
 
-        /******* This function is optional to avoid box "jumping" *******/
-        helper_bounding_box_stabilization(_yolo_result_last.box_count, _yolo_result_last.boxes, _yolo_result_latest.box_count, _yolo_result_latest.boxes,
-                                          &box_count_stabilized, boxes_stabilized, 20, 0.3);
+        result_index = _cur_result_index;
 
-        /******* Draw all bounding boxes *******/
-        for (uint32_t i = 0; i < box_count_stabilized; i++)
+        /******* Track boxes once per inference result, it gives stable boxes and IDs across frames *******/
+        if (tracked_result_index != result_index)
         {
-            int x1 = boxes_stabilized[i].x1;
-            int y1 = boxes_stabilized[i].y1;
-            int x2 = boxes_stabilized[i].x2;
-            int y2 = boxes_stabilized[i].y2;
+            tracked_count = bytetrack_update(tracker, _yolo_result_latest.box_count, _yolo_result_latest.boxes,
+                                             YOLO_GOOD_BOX_MAX, tracked_objects);
+            tracked_count = (0 > tracked_count) ? 0 : tracked_count;
+            tracked_result_index = result_index;
+        }
+
+        /******* Draw all tracked bounding boxes *******/
+        for (int i = 0; i < tracked_count; i++)
+        {
+            kp_bounding_box_t *box = &tracked_objects[i].box;
+            int x1 = box->x1;
+            int y1 = box->y1;
+            int x2 = box->x2;
+            int y2 = box->y2;
 
             int textX = x1;
             int textY = y1 - 10;
             if (textY < 0)
                 textY = y1 + 5;
 
-            sprintf(box_info, "class %d (%.2f)", boxes_stabilized[i].class_num, boxes_stabilized[i].score);
+            sprintf(box_info, "id %u class %d (%.2f)", tracked_objects[i].track_id, box->class_num, box->score);
 
             cv::rectangle(cv_img_show, cv::Point(x1, y1), cv::Point(x2, y2), cv::Scalar(50, 255, 50), 2);
             cv::putText(cv_img_show, box_info, cv::Point(textX, textY), cv::FONT_HERSHEY_COMPLEX_SMALL, 1, cv::Scalar(50, 50, 255), 1);
         }
 
-        memcpy((void *)&_yolo_result_last, (void *)&_yolo_result_latest, sizeof(kp_yolo_result_t));
-
         _mutex_result.unlock();
 
         /******* calculate FPS every 60 frames *******/
@@ -210,10 +229,10 @@ void dispalay() {
             double time_spent;
             helper_measure_time_end(&time_spent);
             sprintf(imgFPS, "image FPS: %.2lf", (_cur_image_index - image_count) / time_spent);
-            sprintf(infFPS, "inference FPS: %.2lf", (_cur_result_index - result_count) / time_spent);
+            sprintf(infFPS, "inference FPS: %.2lf", (result_index - result_count) / time_spent);
 
             image_count = _cur_image_index;
-            result_count = _cur_result_index;
+            result_count = result_index;
             helper_measure_time_begin();
         }
 
@@ -234,6 +253,8 @@ void dispalay() {
 
     _receive_running = false;
     cv::destroyAllWindows();
+
+    bytetrack_destroy(tracker);
 }
 
 int main(int argc, char *argv[])
@@ -0,0 +1,215 @@
+/**
+ * @file        pixel_convert_benchmark.c
+ * @brief       throughput and accuracy of the pixel format conversions in ex_common/pixel_convert.c
+ *
+ * For every kp_image_format_t supported by the helper functions, converts a synthetic BGR888 image
+ * into the format and back, and compares the BGR888 result with a per-pixel floating-point reference
+ * (the conversion previously used by helper_functions.c).
+ *
+ * usage: pixel_convert_benchmark [width] [height] [loop]
+ *
+ * @version     0.1
+ * @date        2021-03-22
+ *
+ * @copyright   Copyright (c) 2021 Kneron Inc. All rights reserved.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include "pixel_convert.h"
+
+typedef struct
+{
+    kp_image_format_t format;
+    const char *name;
+    int bits_per_pixel;
+} FORMAT_INFO;
+
+static const FORMAT_INFO _formats[] = {
+    {KP_IMAGE_FORMAT_RGB565, "RGB565", 16},
+    {KP_IMAGE_FORMAT_RGBA8888, "RGBA8888", 32},
+    {KP_IMAGE_FORMAT_YUYV, "YUYV", 16},
+    {KP_IMAGE_FORMAT_YCBCR422_CRY1CBY0, "YCBCR422_CRY1CBY0", 16},
+    {KP_IMAGE_FORMAT_YCBCR422_CBY1CRY0, "YCBCR422_CBY1CRY0", 16},
+    {KP_IMAGE_FORMAT_YCBCR422_Y1CRY0CB, "YCBCR422_Y1CRY0CB", 16},
+    {KP_IMAGE_FORMAT_YCBCR422_Y1CBY0CR, "YCBCR422_Y1CBY0CR", 16},
+    {KP_IMAGE_FORMAT_YCBCR422_CRY0CBY1, "YCBCR422_CRY0CBY1", 16},
+    {KP_IMAGE_FORMAT_YCBCR422_CBY0CRY1, "YCBCR422_CBY0CRY1", 16},
+    {KP_IMAGE_FORMAT_YCBCR422_Y0CRY1CB, "YCBCR422_Y0CRY1CB", 16},
+    {KP_IMAGE_FORMAT_YCBCR422_Y0CBY1CR, "YCBCR422_Y0CBY1CR", 16},
+    {KP_IMAGE_FORMAT_RAW8, "RAW8", 8},
+    {KP_IMAGE_FORMAT_YUV420, "YUV420", 12},
+};
+
+static double now_ms()
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec * 1000.0 + tv.tv_usec / 1000.0;
+}
+
+static unsigned char clamp_to_0_255(float num)
+{
+    if (num > 255)
+        return 255;
+    else if (num < 0)
+        return 0;
+    else
+        return (unsigned char)num;
+}
+
+// per-pixel floating-point reference of pixel_convert_to_bgr888()
+static void reference_to_bgr888(const uint8_t *src, int width, int height, kp_image_format_t format, uint8_t *bgr)
+{
+    pixel_ycbcr422_order_t order;
+
+    for (int row = 0; row < height; row++)
+    {
+        for (int col = 0; col < width; col++)
+        {
+            uint8_t *out = bgr + ((size_t)width * row + col) * 3;
+            float y, cb, cr;
+
+            switch (format)
+            {
+            case KP_IMAGE_FORMAT_RGB565:
+            {
+                uint16_t pixel = ((const uint16_t *)src)[(size_t)width * row + col];
+                out[0] = (pixel << 3) & 0b11111000;
+                out[1] = (pixel >> 3) & 0b11111100;
+                out[2] = (pixel >> 8) & 0b11111000;
+                continue;
+            }
+            case KP_IMAGE_FORMAT_RGBA8888:
+            {
+                const uint8_t *pixel = src + ((size_t)width * row + col) * 4;
+                out[0] = pixel[2];
+                out[1] = pixel[1];
+                out[2] = pixel[0];
+                continue;
+            }
+            case KP_IMAGE_FORMAT_RAW8:
+                memset(out, src[(size_t)width * row + col], 3);
+                continue;
+            case KP_IMAGE_FORMAT_YUV420:
+            {
+                const uint8_t *u_plane = src + (size_t)width * height;
+                const uint8_t *v_plane = u_plane + (size_t)width * height / 4;
+                size_t chroma_pos = (size_t)(width / 2) * (row / 2) + col / 2;
+
+                y = src[(size_t)width * row + col];
+                cb = u_plane[chroma_pos];
+                cr = v_plane[chroma_pos];
+                break;
+            }
+            default:
+            {
+                const uint8_t *macro_pixel = src + ((size_t)(width / 2) * row + col / 2) * 4;
+
+                pixel_convert_get_ycbcr422_order(format, &order);
+                y = macro_pixel[(col & 1) ? order.y1 : order.y0];
+                cb = macro_pixel[order.cb];
+                cr = macro_pixel[order.cr];
+                break;
+            }
+            }
+
+            out[0] = clamp_to_0_255(y + 1.77 * (cb - 128));
+            out[1] = clamp_to_0_255(y - 0.343 * (cb - 128) - 0.714 * (cr - 128));
+            out[2] = clamp_to_0_255(y + 1.403 * (cr - 128));
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    int width = (argc > 1) ? atoi(argv[1]) : 640;
+    int height = (argc > 2) ? atoi(argv[2]) : 480;
+    int loop = (argc > 3) ? atoi(argv[3]) : 100;
+
+    if (width <= 0 || height <= 0 || loop <= 0 || (width % 2) || (height % 2)) {
+        printf("usage: %s [width] [height] [loop], width and height must be positive even numbers\n", argv[0]);
+        return -1;
+    }
+
+    size_t bgr_size = (size_t)width * height * 3;
+    uint8_t *bgr = (uint8_t *)malloc(bgr_size);
+    uint8_t *bgr_out = (uint8_t *)malloc(bgr_size);
+    uint8_t *bgr_ref = (uint8_t *)malloc(bgr_size);
+    uint8_t *raw = (uint8_t *)malloc((size_t)width * height * 4);
+
+    if (!bgr || !bgr_out || !bgr_ref || !raw) {
+        printf("Error! malloc for image buffer failed\n");
+        goto exit;
+    }
+
+    // smooth gradients plus noise, so both chroma and luma paths are exercised
+    srand(0);
+    for (int row = 0; row < height; row++)
+    {
+        for (int col = 0; col < width; col++)
+        {
+            uint8_t *pixel = bgr + ((size_t)width * row + col) * 3;
+            pixel[0] = (uint8_t)((col * 255 / width + (rand() & 15)) & 0xFF);
+            pixel[1] = (uint8_t)((row * 255 / height + (rand() & 15)) & 0xFF);
+            pixel[2] = (uint8_t)(((col + row) * 127 / (width + height) + (rand() & 63)) & 0xFF);
+        }
+    }
+
+    printf("image %dx%d, %d loops\n\n", width, height, loop);
+    printf("%-18s %14s %14s %14s %10s\n", "format", "from BGR MP/s", "to BGR MP/s", "ref MP/s", "max diff");
+
+    double mega_pixels = (double)width * height * loop / 1000000.0;
+
+    for (size_t i = 0; i < sizeof(_formats) / sizeof(_formats[0]); i++)
+    {
+        const FORMAT_INFO *info = &_formats[i];
+        double from_ms = 0, to_ms, ref_ms, start;
+
+        if (KP_IMAGE_FORMAT_RAW8 == info->format) {
+            // no BGR888 -> RAW8 conversion, use the blue channel as gray input
+            for (size_t pos = 0; pos < (size_t)width * height; pos++)
+                raw[pos] = bgr[pos * 3];
+        } else {
+            start = now_ms();
+            for (int l = 0; l < loop; l++)
+                pixel_convert_from_bgr888(bgr, width * 3, width, height, info->format, raw);
+            from_ms = now_ms() - start;
+        }
+
+        start = now_ms();
+        for (int l = 0; l < loop; l++)
+            pixel_convert_to_bgr888(raw, width, height, info->format, bgr_out, width * 3);
+        to_ms = now_ms() - start;
+
+        start = now_ms();
+        for (int l = 0; l < loop; l++)
+            reference_to_bgr888(raw, width, height, info->format, bgr_ref);
+        ref_ms = now_ms() - start;
+
+        int max_diff = 0;
+        for (size_t pos = 0; pos < bgr_size; pos++)
+        {
+            int diff = abs((int)bgr_out[pos] - (int)bgr_ref[pos]);
+            max_diff = (diff > max_diff) ? diff : max_diff;
+        }
+
+        if (KP_IMAGE_FORMAT_RAW8 == info->format)
+            printf("%-18s %14s", info->name, "-");
+        else
+            printf("%-18s %14.1f", info->name, mega_pixels * 1000.0 / from_ms);
+
+        printf(" %14.1f %14.1f %10d\n", mega_pixels * 1000.0 / to_ms, mega_pixels * 1000.0 / ref_ms, max_diff);
+    }
+
+exit:
+    free(bgr);
+    free(bgr_out);
+    free(bgr_ref);
+    free(raw);
+
+    return 0;
+}
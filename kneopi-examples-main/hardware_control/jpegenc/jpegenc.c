@@ -23,11 +23,13 @@
 #include <unistd.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/time.h>
 #include <iniparser.h>
 #include <mem_broker.h>
 #include <video_buf.h>
 #include <video_snapshot_mechanism.h>
 #include <sync_shared_memory.h>
+#include <vector_dma.h>
 
 
 char *g_InputPath = NULL;
@@ -35,6 +37,13 @@ char *g_OutputPath = NULL;
 unsigned int g_dwImgWidth = 0;
 unsigned int g_dwImgHeight = 0;
 unsigned int g_dwImgQP = 0;
+unsigned int g_dwFrameNum = 1;
+
+typedef struct
+{
+    VMF_DMA_HANDLE_T* ptDmaHandle;
+    VMF_DMA_DESCRIPTOR_T* ptDmaDesc;
+} DMA_INFO_T;
 
 static void print_usage(const char *name)
 {
@@ -82,6 +91,7 @@ static int loadConfig(char *configPath)
         g_dwImgWidth = iniparser_getint(ini, "config:img_width", 0);
         g_dwImgHeight = iniparser_getint(ini, "config:img_height", 0);
         g_dwImgQP = iniparser_getint(ini, "config:img_qp", 100);
+        g_dwFrameNum = iniparser_getint(ini, "config:framenum", 1);
 
         ret = 0;
     } while(0);
@@ -90,6 +100,102 @@ static int loadConfig(char *configPath)
     return ret;
 }
 
+static int dma2d_init(DMA_INFO_T *ptDmaInfo)
+{
+    VMF_DMA_2DCF_INIT_T init;
+
+    ptDmaInfo->ptDmaHandle = VMF_DMA_Init(1, 128);
+    if (NULL == ptDmaInfo->ptDmaHandle) {
+        printf("dma2d_init failed\n");
+        return -1;
+    }
+
+    memset(&init, 0, sizeof(VMF_DMA_2DCF_INIT_T));
+    init.dwProcessCbCr = 1;
+    ptDmaInfo->ptDmaDesc = VMF_DMA_Descriptor_Create(DMA_2D, &init);
+    if (NULL == ptDmaInfo->ptDmaDesc) {
+        VMF_DMA_Release(ptDmaInfo->ptDmaHandle);
+        ptDmaInfo->ptDmaHandle = NULL;
+        printf("dma_desc init failed\n");
+        return -1;
+    }
+    return 0;
+}
+
+static void dma2d_release(DMA_INFO_T *ptDmaInfo)
+{
+    if (ptDmaInfo->ptDmaDesc)
+        VMF_DMA_Descriptor_Destroy(ptDmaInfo->ptDmaDesc);
+    if (ptDmaInfo->ptDmaHandle)
+        VMF_DMA_Release(ptDmaInfo->ptDmaHandle);
+    memset(ptDmaInfo, 0, sizeof(DMA_INFO_T));
+}
+
+//! Expand a packed I420 frame in pbySrc to the 16-aligned stride layout expected by the encoder.
+static int dma2d_stride_copy(DMA_INFO_T *ptDmaInfo, unsigned char *pbyDst, unsigned char *pbySrc,
+                             unsigned int dwDstStride, unsigned int dwDstYSize)
+{
+    int ret = 0;
+    VMF_DMA_ADDR_T dma_addr;
+    unsigned int dwSrcYSize = g_dwImgWidth * g_dwImgHeight;
+
+    memset(&dma_addr, 0, sizeof(VMF_DMA_ADDR_T));
+    dma_addr.dwCopyWidth = g_dwImgWidth;
+    dma_addr.dwCopyHeight = g_dwImgHeight;
+    dma_addr.pbySrcYPhysAddr = (unsigned char*)MemBroker_GetPhysAddr(pbySrc);
+    dma_addr.pbySrcCbPhysAddr = dma_addr.pbySrcYPhysAddr + dwSrcYSize;
+    dma_addr.pbySrcCrPhysAddr = dma_addr.pbySrcCbPhysAddr + (dwSrcYSize >> 2);
+    dma_addr.dwSrcStride = g_dwImgWidth;
+
+    dma_addr.pbyDstYPhysAddr = (unsigned char*)MemBroker_GetPhysAddr(pbyDst);
+    dma_addr.pbyDstCbPhysAddr = dma_addr.pbyDstYPhysAddr + dwDstYSize;
+    dma_addr.pbyDstCrPhysAddr = dma_addr.pbyDstCbPhysAddr + (dwDstYSize >> 2);
+    dma_addr.dwDstStride = dwDstStride;
+
+    ret |= VMF_DMA_Descriptor_Update_Addr(ptDmaInfo->ptDmaDesc, &dma_addr);
+    ret |= VMF_DMA_Setup(ptDmaInfo->ptDmaHandle, &ptDmaInfo->ptDmaDesc, 1);
+    ret |= VMF_DMA_Process(ptDmaInfo->ptDmaHandle);
+    return ret;
+}
+
+//! Fallback for platforms without a free DMA channel.
+static void cpu_stride_copy(unsigned char *pbyDst, unsigned char *pbySrc,
+                            unsigned int dwDstStride, unsigned int dwDstYSize)
+{
+    unsigned int dwSrcYSize = g_dwImgWidth * g_dwImgHeight;
+    unsigned char *pbySrcU = pbySrc + dwSrcYSize;
+    unsigned char *pbySrcV = pbySrcU + (dwSrcYSize >> 2);
+    unsigned char *pbyDstU = pbyDst + dwDstYSize;
+    unsigned char *pbyDstV = pbyDstU + (dwDstYSize >> 2);
+
+    //! Y
+    for (unsigned int i = 0; i < g_dwImgHeight; i++) {
+        memcpy(pbyDst + i*dwDstStride, pbySrc + i*g_dwImgWidth, g_dwImgWidth);
+    }
+    //! U, V
+    for (unsigned int i = 0; i < g_dwImgHeight>>1; i++) {
+        memcpy(pbyDstU + (i*dwDstStride>>1), pbySrcU + (i*g_dwImgWidth>>1), g_dwImgWidth>>1);
+        memcpy(pbyDstV + (i*dwDstStride>>1), pbySrcV + (i*g_dwImgWidth>>1), g_dwImgWidth>>1);
+    }
+}
+
+//! Read one packed I420 frame with a single fread, rewinding at EOF so short inputs can be looped in batch mode.
+static int read_frame(FILE *pfInput, unsigned char *pbyDst, unsigned int dwYuvSize)
+{
+    unsigned int dwReadCount = fread(pbyDst, sizeof(unsigned char), dwYuvSize, pfInput);
+
+    if (dwReadCount == 0 && feof(pfInput)) {
+        rewind(pfInput);
+        dwReadCount = fread(pbyDst, sizeof(unsigned char), dwYuvSize, pfInput);
+    }
+
+    if (dwReadCount != dwYuvSize) {
+        printf("Read yuv file failed, read total %d, should be %d.\n", dwReadCount, dwYuvSize);
+        return -1;
+    }
+    return 0;
+}
+
 int main (int argc, char **argv)
 {
     FILE *pfOutput = NULL;
@@ -102,11 +208,18 @@ int main (int argc, char **argv)
     char *configPath = NULL;
     unsigned char *pbyOutBuf = NULL;
     unsigned char *pbyInbuf = NULL;
-    unsigned int dwReadCount;
+    unsigned char *pbyStageBuf = NULL;
     unsigned int dwOutputBufSize = 0;
     unsigned int dwYSize = 0;
+    unsigned int dwYuvSize = 0;
     unsigned int dwInBufSize = 0;
     unsigned int dwYOffset = 0;
+    unsigned int dwFrameCount = 0;
+    unsigned long long ullEncTotalUs = 0;
+    unsigned long long ullTotalUs = 0;
+    struct timeval tBegin, tEncBegin, tEnd;
+    DMA_INFO_T tDmaInfo;
+    int bStrided;
     int ret;
 
     while (-1 != (opt = getopt(argc, argv, "c:h:"))) {
@@ -123,7 +236,7 @@ int main (int argc, char **argv)
     }
 
 
-    if(0 != loadConfig(configPath) || (g_dwImgWidth == 0)|| (g_dwImgHeight == 0) || !g_InputPath || !g_OutputPath) {
+    if(0 != loadConfig(configPath) || (g_dwImgWidth == 0)|| (g_dwImgHeight == 0) || (g_dwFrameNum == 0) || !g_InputPath || !g_OutputPath) {
         print_usage(argv[0]);
         return -1;
     }
@@ -131,19 +244,27 @@ int main (int argc, char **argv)
     memset(&tSsmBuff, 0, sizeof(SSM_BUFFER_T));
     memset(&tCropInfo, 0, sizeof(VMF_SNAP_CROP_PARAMS_T));
     memset(&tVsrcSsmInfo, 0, sizeof(VMF_VSRC_SSM_OUTPUT_INFO_T));
+    memset(&tDmaInfo, 0, sizeof(DMA_INFO_T));
 
     if ((pfInput=fopen(g_InputPath, "rb")) == NULL) {
         printf("Open input bitstream file fail !!\n");
         goto EXIT;
     }
 
+    if ((pfOutput=fopen(g_OutputPath, "wb")) == NULL) {
+        printf("Open output JPEG file fail !!\n");
+        goto EXIT;
+    }
+
     //out buffer    
     unsigned int dwImgWStride = VMF_16_ALIGN(g_dwImgWidth);
     unsigned int dwImgHStride = VMF_16_ALIGN(g_dwImgHeight);
     
     dwYSize = dwOutputBufSize = g_dwImgWidth * g_dwImgHeight;    
+    dwYuvSize = dwYSize*3/2;
     dwYOffset = dwImgWStride * dwImgHStride;
     dwInBufSize = (dwYOffset * 3 >> 1) + VMF_MAX_SSM_HEADER_SIZE;
+    bStrided = (dwImgWStride != g_dwImgWidth || dwImgHStride != g_dwImgHeight);
     
     pbyOutBuf = (unsigned char *)MemBroker_GetMemory(dwOutputBufSize , VMF_ALIGN_TYPE_DEFAULT);
     if (!pbyOutBuf) {
@@ -158,31 +279,17 @@ int main (int argc, char **argv)
         goto EXIT;
     }
     memset(pbyInbuf, 0, dwInBufSize);
-    
-    if(dwImgWStride == g_dwImgWidth && dwImgHStride == g_dwImgHeight) {
-        unsigned int dwYuvSize = dwYSize*3/2;
-		dwReadCount = fread(pbyInbuf + VMF_MAX_SSM_HEADER_SIZE, sizeof(unsigned char), dwYuvSize, pfInput);
-        if (dwReadCount != dwYuvSize) {
-            printf("Read yuv file failed, read total %d, should be %d.\n", dwReadCount, dwYuvSize);
+
+    //! Unaligned frames are read packed into a staging buffer and expanded to the aligned stride by DMA.
+    if (bStrided) {
+        pbyStageBuf = (unsigned char *)MemBroker_GetMemory(dwYuvSize, VMF_ALIGN_TYPE_DEFAULT);
+        if (!pbyStageBuf) {
+            printf("Allocate staging buffer fail !! Size = %d\n", dwYuvSize);
             goto EXIT;
-        } else
-            printf("Read yuv total size of %d\n", dwReadCount);
-	} else {
-        //! Y
-        for (unsigned int i = 0; i < g_dwImgHeight; i++) {
-            fread(pbyInbuf + VMF_MAX_SSM_HEADER_SIZE + i*dwImgWStride, g_dwImgWidth, 1, pfInput);	
         }
-        //! U
-        for (unsigned int i = 0; i < g_dwImgHeight>>1; i++) {
-            fread((char*)pbyInbuf + VMF_MAX_SSM_HEADER_SIZE + dwYOffset + (i*dwImgWStride>>1), g_dwImgWidth>>1, 1, pfInput);
-	    }	
-	    //! V
-        for (unsigned int i = 0; i < g_dwImgHeight>>1; i++) {
-            fread((char*)pbyInbuf + VMF_MAX_SSM_HEADER_SIZE + dwYOffset + (dwYOffset>>2) + (i*dwImgWStride>>1), g_dwImgWidth>>1, 1, pfInput);
-        }
-	}
-  
-    MemBroker_CacheFlush(pbyInbuf, dwInBufSize);
+        if (0 != dma2d_init(&tDmaInfo))
+            printf("DMA unavailable, use CPU stride copy\n");
+    }
 
     tSsmBuff.buffer = pbyInbuf;
     tSsmBuff.buffer_phys_addr = MemBroker_GetPhysAddr(pbyInbuf);
@@ -195,7 +302,6 @@ int main (int argc, char **argv)
     tVsrcSsmInfo.dwWidth = g_dwImgWidth;
     tVsrcSsmInfo.dwHeight = g_dwImgHeight;
     tVsrcSsmInfo.dwType = 0;
-    VMF_VSRC_SSM_SetInfo(tSsmBuff.buffer, &tVsrcSsmInfo);
 
     tCropInfo.dwStartX = 0;
     tCropInfo.dwStartY = 0;
@@ -205,22 +311,62 @@ int main (int argc, char **argv)
     tCropInfo.pOutBuffer = (void *)pbyOutBuf;
     tCropInfo.dwQp = g_dwImgQP;
 
-    ret = VMF_SNAP_ProcessOneFrame_YUV(&tSsmBuff, &tCropInfo);
-    if (ret == -1) {
-        printf("Jpeg encode failed\n");
-        goto EXIT;
-    }
+    gettimeofday(&tBegin, NULL);
+
+    //! Batch mode: input/output buffers are reused, encoded frames are appended to the output file.
+    for (dwFrameCount = 0; dwFrameCount < g_dwFrameNum; dwFrameCount++)
+    {
+        if (!bStrided) {
+            if (0 != read_frame(pfInput, pbyInbuf + VMF_MAX_SSM_HEADER_SIZE, dwYuvSize))
+                break;
+            MemBroker_CacheFlush(pbyInbuf, dwInBufSize);
+        } else {
+            if (0 != read_frame(pfInput, pbyStageBuf, dwYuvSize))
+                break;
+            if (tDmaInfo.ptDmaDesc) {
+                MemBroker_CacheFlush(pbyStageBuf, dwYuvSize);
+                MemBroker_CacheFlush(pbyInbuf, dwInBufSize);
+                if (0 != dma2d_stride_copy(&tDmaInfo, pbyInbuf + VMF_MAX_SSM_HEADER_SIZE, pbyStageBuf, dwImgWStride, dwYOffset)) {
+                    printf("DMA stride copy failed\n");
+                    break;
+                }
+            } else {
+                cpu_stride_copy(pbyInbuf + VMF_MAX_SSM_HEADER_SIZE, pbyStageBuf, dwImgWStride, dwYOffset);
+                MemBroker_CacheFlush(pbyInbuf, dwInBufSize);
+            }
+        }
 
-    if ((pfOutput=fopen(g_OutputPath, "wb")) == NULL) {
-        printf("Open output YUV file fail !!\n");
-        goto EXIT;
+        VMF_VSRC_SSM_SetInfo(tSsmBuff.buffer, &tVsrcSsmInfo);
+
+        gettimeofday(&tEncBegin, NULL);
+        ret = VMF_SNAP_ProcessOneFrame_YUV(&tSsmBuff, &tCropInfo);
+        gettimeofday(&tEnd, NULL);
+        if (ret == -1) {
+            printf("Jpeg encode failed\n");
+            break;
+        }
+        ullEncTotalUs += (tEnd.tv_sec - tEncBegin.tv_sec) * 1000000ULL + (tEnd.tv_usec - tEncBegin.tv_usec);
+
+        if (g_dwFrameNum == 1)
+            printf("Jpeg Encode done, size is %d, (buffer size is %d)\n",ret , dwOutputBufSize);
+        fwrite(tCropInfo.pOutBuffer, sizeof(unsigned char), ret, pfOutput);
     }
 
-    printf("Jpeg Encode done, size is %d, (buffer size is %d)\n",ret , dwOutputBufSize);
-    fwrite(tCropInfo.pOutBuffer, sizeof(unsigned char), ret, pfOutput);
+    gettimeofday(&tEnd, NULL);
+    ullTotalUs = (tEnd.tv_sec - tBegin.tv_sec) * 1000000ULL + (tEnd.tv_usec - tBegin.tv_usec);
+    if (dwFrameCount > 0 && ullTotalUs > 0 && ullEncTotalUs > 0) {
+        printf("Encoded %d frame(s) in %llu us, %.2f fps (encode only %.2f fps)\n",
+               dwFrameCount, ullTotalUs,
+               dwFrameCount * 1000000.0 / ullTotalUs,
+               dwFrameCount * 1000000.0 / ullEncTotalUs);
+    }
 
 EXIT:
 
+    dma2d_release(&tDmaInfo);
+
+    if (pbyStageBuf)
+        MemBroker_FreeMemory(pbyStageBuf);
 
     if (pbyOutBuf)
         MemBroker_FreeMemory(pbyOutBuf);
@@ -7,8 +7,10 @@
 #include <fcntl.h>
 #include <sys/ioctl.h>
 #include <linux/i2c-dev.h>
+#include <linux/i2c.h>
 
 static int file_i2c = 0;
+static int i2c_addr = 0;
 
 uint8_t _i2c_init(int i2c, int dev_addr)
 {
@@ -28,6 +30,7 @@ uint8_t _i2c_init(int i2c, int dev_addr)
 			file_i2c = 0;
 			return 1;
 		}
+		i2c_addr = dev_addr;
 		return 0;
 	}
 	
@@ -57,6 +60,39 @@ uint8_t _i2c_write(uint8_t* ptr, int16_t len)
 	return 0;
 }
 
+// send several writes as one I2C transaction (repeated start between them)
+uint8_t _i2c_write_burst(uint8_t** ptr, uint16_t* len, uint8_t count)
+{
+	struct i2c_msg msgs[I2C_RDWR_IOCTL_MAX_MSGS];
+	struct i2c_rdwr_ioctl_data rdwr;
+	uint8_t i;
+
+	if (file_i2c == 0 || ptr == 0 || len == 0 || count == 0 || count > I2C_RDWR_IOCTL_MAX_MSGS)
+		return 1;
+
+	for (i = 0; i < count; i++)
+	{
+		msgs[i].addr = i2c_addr;
+		msgs[i].flags = 0;
+		msgs[i].len = len[i];
+		msgs[i].buf = ptr[i];
+	}
+	rdwr.msgs = msgs;
+	rdwr.nmsgs = count;
+
+	if (ioctl(file_i2c, I2C_RDWR, &rdwr) >= 0)
+		return 0;
+
+	// adapter without I2C_RDWR support, one write per message
+	for (i = 0; i < count; i++)
+	{
+		if (write(file_i2c, ptr[i], len[i]) != len[i])
+			return 1;
+	}
+
+	return 0;
+}
+
 uint8_t _i2c_read(uint8_t *ptr, int16_t len)
 {
 	if (file_i2c == 0 || ptr == 0 || len <= 0)
@@ -4,5 +4,6 @@
 uint8_t _i2c_init(int i2c, int dev_addr);
 uint8_t _i2c_close();
 uint8_t _i2c_write(uint8_t* ptr, int16_t len);
+uint8_t _i2c_write_burst(uint8_t** ptr, uint16_t* len, uint8_t count);
 uint8_t _i2c_read(uint8_t *ptr, int16_t len);
 #endif
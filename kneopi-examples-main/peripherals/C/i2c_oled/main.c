@@ -6,9 +6,50 @@
 #include <string.h>
 #include <fcntl.h>
 #include <sys/ioctl.h>
+#include <time.h>
 
 #include "ssd1306.h"
 
+static double now_ms()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+// status screen composed in the framebuffer, only the changed pages are sent
+uint8_t status_screen_test(int frames, uint8_t font)
+{
+    uint8_t rc = 0;
+    char buf[32];
+    int i, x;
+    double start = now_ms();
+    
+    rc += ssd1306_fb_clear();
+    rc += ssd1306_fb_invalidate();
+    rc += ssd1306_fb_write_line(0, 0, font, "status");
+    
+    for (i = 0; i < frames && rc == 0; i++)
+    {
+        snprintf(buf, sizeof(buf), "frame %d", i);
+        rc += ssd1306_fb_write_line(0, 1, font, buf);
+        snprintf(buf, sizeof(buf), "%.1f ms", now_ms() - start);
+        rc += ssd1306_fb_clear_page(2);
+        rc += ssd1306_fb_write_line(0, 2, font, buf);
+        
+        // progress bar on page 3
+        for (x = 0; x < SSD1306_FB_COLUMNS; x++)
+            ssd1306_fb_set_pixel(x, 28, x <= (i % SSD1306_FB_COLUMNS));
+        
+        rc += ssd1306_fb_update();
+    }
+    
+    double elapsed = now_ms() - start;
+    printf("%d frames in %.1f ms, %.1f fps\n", i, elapsed, i * 1000.0 / elapsed);
+    
+    return rc;
+}
+
 void print_help()
 {
     printf("help message\n\n");
@@ -22,6 +63,7 @@ void print_help()
     printf("-m\t\tput your strings to oled\n");
     printf("-n\t\tI2C device node address (0,1,2..., default 0)\n");
     printf("-r\t\t0/normal 180/rotate\n");
+    printf("-t\t\trefresh test, frames of a status screen drawn in the framebuffer\n");
     printf("-x\t\tx position\n");
     printf("-y\t\ty position\n");
 }
@@ -40,12 +82,13 @@ int main(int argc, char **argv)
     int inverted = -1;
     int display = -1;
     int font = 0;
+    int frames = 0;
     
     int cmd_opt = 0;
     
     while(cmd_opt != -1) 
     {
-        cmd_opt = getopt(argc, argv, "I:c::d:f:hi:l:m:n:r:x:y:");
+        cmd_opt = getopt(argc, argv, "I:c::d:f:hi:l:m:n:r:t:x:y:");
 
         /* Lets parse */
         switch (cmd_opt) {
@@ -91,6 +134,9 @@ int main(int argc, char **argv)
                     return 1;
                 }
                 break;
+            case 't':
+                frames = atoi(optarg);
+                break;
             case 'x':
                 x = atoi(optarg);
                 break;
@@ -127,6 +173,11 @@ int main(int argc, char **argv)
                     printf("prams -%c missing 0 or 180 fields\n", optopt);
                     return 1;
                 }
+                else if (optopt == 't')
+                {
+                    printf("prams -%c missing number of frames\n", optopt);
+                    return 1;
+                }
                 else if (optopt == 'x' || optopt == 'y')
                 {
                     printf("prams -%c missing coordinate values\n", optopt);
@@ -218,6 +269,12 @@ int main(int argc, char **argv)
         rc += ssd1306_oled_write_line(font, line);
     }    
     
+    // refresh test
+    if (frames > 0)
+    {
+        rc += status_screen_test(frames, font);
+    }
+    
     // close the I2C device node
     ssd1306_end();
     
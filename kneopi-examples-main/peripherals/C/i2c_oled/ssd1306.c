@@ -21,6 +21,10 @@ static uint8_t max_columns = 0;
 static uint8_t global_x = 0;
 static uint8_t global_y = 0;
 
+// framebuffer, byte 0 of each page is the data control byte so a page is sent as is
+static uint8_t fb[SSD1306_FB_PAGES][1 + SSD1306_FB_COLUMNS];
+static uint8_t fb_dirty = 0;    // bit n set: page n changed since the last update
+
 uint8_t ssd1306_init(uint8_t i2c_dev)
 {
     uint8_t rc;
@@ -464,3 +468,164 @@ uint8_t ssd1306_oled_load_resolution()
     
     return 0;
 }
+
+static uint8_t ssd1306_fb_valid(uint8_t x, uint8_t page)
+{
+    return x < max_columns && x < SSD1306_FB_COLUMNS && page < (max_lines / 8) && page < SSD1306_FB_PAGES;
+}
+
+// only a changed byte makes its page dirty
+static void ssd1306_fb_put(uint8_t x, uint8_t page, uint8_t value)
+{
+    uint8_t* col = &fb[page][1 + x];
+
+    if (*col != value)
+    {
+        *col = value;
+        fb_dirty |= 1 << page;
+    }
+}
+
+uint8_t ssd1306_fb_clear()
+{
+    uint8_t rc = 0;
+    uint8_t i;
+    
+    if (max_lines == 0)
+        return 1;
+    
+    for (i = 0; i < (max_lines / 8); i++)
+    {
+        rc += ssd1306_fb_clear_page(i);
+    }
+    
+    return rc;
+}
+
+uint8_t ssd1306_fb_clear_page(uint8_t page)
+{
+    uint8_t i;
+    
+    if (!ssd1306_fb_valid(0, page))
+        return 1;
+    
+    for (i = 0; i < max_columns && i < SSD1306_FB_COLUMNS; i++)
+        ssd1306_fb_put(i, page, 0x00);
+    
+    return 0;
+}
+
+uint8_t ssd1306_fb_set_pixel(uint8_t x, uint8_t y, uint8_t on)
+{
+    uint8_t page = y / 8;
+    
+    if (!ssd1306_fb_valid(x, page))
+        return 1;
+    
+    if (on)
+        ssd1306_fb_put(x, page, fb[page][1 + x] | (1 << (y % 8)));
+    else
+        ssd1306_fb_put(x, page, fb[page][1 + x] & ~(1 << (y % 8)));
+    
+    return 0;
+}
+
+// same glyphs as ssd1306_oled_write_line(), text is clipped at the right edge
+uint8_t ssd1306_fb_write_line(uint8_t x, uint8_t page, uint8_t size, char* ptr)
+{
+    uint16_t index = 0;
+    uint8_t* font_table = 0;
+    uint8_t font_table_width = 0;
+    
+    if (ptr == 0 || !ssd1306_fb_valid(x, page))
+        return 1;
+    
+    if (size == SSD1306_FONT_SMALL) // 5x7
+    {
+        font_table = (uint8_t*)font5x7;
+        font_table_width = 5;
+    }
+    else if (size == SSD1306_FONT_NORMAL) // 8x8
+    {
+        font_table = (uint8_t*)font8x8;
+        font_table_width = 8;
+    }
+    else
+        return 1;
+    
+    // font table range in ascii table is from 0x20(space) to 0x7e(~)
+    while (ptr[index] != 0)
+    {
+        if ((ptr[index] < ' ') || (ptr[index] > '~'))
+            return 1;
+
+        uint8_t* font_ptr = &font_table[(ptr[index] - 0x20) * font_table_width];
+        uint8_t j = 0;
+        for (j = 0; j < font_table_width && ssd1306_fb_valid(x, page); j++)
+            ssd1306_fb_put(x++, page, font_ptr[j]);
+        // insert 1 col space for small font size)
+        if (size == SSD1306_FONT_SMALL && ssd1306_fb_valid(x, page))
+            ssd1306_fb_put(x++, page, 0x00);
+        index++;
+    }
+    
+    return 0;
+}
+
+// send every page on the next update, the panel content is unknown
+uint8_t ssd1306_fb_invalidate()
+{
+    if (max_lines == 0)
+        return 1;
+    
+    fb_dirty = (uint8_t)((1 << (max_lines / 8)) - 1);
+    
+    return 0;
+}
+
+uint8_t ssd1306_fb_update()
+{
+    static uint8_t cmd_buf[SSD1306_FB_PAGES + 1][4];
+    uint8_t* msg[2 * SSD1306_FB_PAGES + 1];
+    uint16_t len[2 * SSD1306_FB_PAGES + 1];
+    uint8_t count = 0;
+    uint8_t page;
+    
+    if (max_lines == 0)
+        return 1;
+    if (fb_dirty == 0)
+        return 0;
+    
+    // page mode: address each dirty page at column 0 and send its columns
+    for (page = 0; page < (max_lines / 8) && page < SSD1306_FB_PAGES; page++)
+    {
+        if ((fb_dirty & (1 << page)) == 0)
+            continue;
+
+        cmd_buf[page][0] = SSD1306_COMM_CONTROL_BYTE;
+        cmd_buf[page][1] = SSD1306_COMM_PAGE_NUMBER | page;
+        cmd_buf[page][2] = SSD1306_COMM_LOW_COLUMN;
+        cmd_buf[page][3] = SSD1306_COMM_HIGH_COLUMN;
+        msg[count] = cmd_buf[page];
+        len[count++] = 4;
+
+        fb[page][0] = SSD1306_DATA_CONTROL_BYTE;
+        msg[count] = fb[page];
+        len[count++] = 1 + (max_columns < SSD1306_FB_COLUMNS ? max_columns : SSD1306_FB_COLUMNS);
+    }
+    
+    // put the cursor back for ssd1306_oled_write_line()
+    cmd_buf[SSD1306_FB_PAGES][0] = SSD1306_COMM_CONTROL_BYTE;
+    cmd_buf[SSD1306_FB_PAGES][1] = SSD1306_COMM_PAGE_NUMBER | (global_y & 0x0f);
+    cmd_buf[SSD1306_FB_PAGES][2] = SSD1306_COMM_LOW_COLUMN | (global_x & 0x0f);
+    cmd_buf[SSD1306_FB_PAGES][3] = SSD1306_COMM_HIGH_COLUMN | ((global_x >> 4) & 0x0f);
+    msg[count] = cmd_buf[SSD1306_FB_PAGES];
+    len[count++] = 4;
+    
+    if (_i2c_write_burst(msg, len, count) != 0)
+        return 1;
+    
+    fb_dirty = 0;
+    
+    return 0;
+}
@@ -53,6 +53,10 @@
 #define SSD1306_128_32_COLUMNS      128
 #define SSD1306_64_48_COLUMNS       64
 
+// framebuffer, one byte is 8 vertical pixels of a page
+#define SSD1306_FB_PAGES            (SSD1306_128_64_LINES / 8)
+#define SSD1306_FB_COLUMNS          SSD1306_128_64_COLUMNS
+
 
 uint8_t ssd1306_init(uint8_t i2c_dev);
 uint8_t ssd1306_end();
@@ -82,4 +86,11 @@ uint8_t ssd1306_oled_clear_screen();
 uint8_t ssd1306_oled_save_resolution(uint8_t column, uint8_t row);
 uint8_t ssd1306_oled_load_resolution();
 
+uint8_t ssd1306_fb_clear();
+uint8_t ssd1306_fb_clear_page(uint8_t page);
+uint8_t ssd1306_fb_set_pixel(uint8_t x, uint8_t y, uint8_t on);
+uint8_t ssd1306_fb_write_line(uint8_t x, uint8_t page, uint8_t size, char* ptr);
+uint8_t ssd1306_fb_invalidate();
+uint8_t ssd1306_fb_update();
+
 #endif
@@ -0,0 +1,2 @@
+#!/bin/bash
+gcc -o pca9685_control pca9685_control.c pca9685.c -lm
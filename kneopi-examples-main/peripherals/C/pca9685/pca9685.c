@@ -0,0 +1,253 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <string.h>
+#include <errno.h>
+#include <math.h>
+#include <time.h>
+#include <sys/ioctl.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+
+#include "pca9685.h"
+
+// Registers
+#define MODE1           0x00
+#define MODE2           0x01
+#define LED0_ON_L       0x06
+#define ALL_LED_ON_L    0xFA
+#define PRESCALE        0xFE
+
+// MODE1 / MODE2 bits
+#define MODE1_RESTART   0x80
+#define MODE1_AI        0x20
+#define MODE1_SLEEP     0x10
+#define MODE1_ALLCALL   0x01
+#define MODE2_OUTDRV    0x04
+
+#define OSC_CLOCK       25000000.0
+
+struct pca9685 {
+    int fd;
+    int addr;
+    int use_rdwr;               // 0 when the adapter has no I2C_RDWR, one write() per message
+    double freq;
+    uint16_t off[PCA9685_CHANNELS];
+    uint16_t dirty;             // bit per channel staged since the last flush
+    pca9685_stats_t stats;
+    double write_sum_us;
+    // one message per run of channels: register address + 4 bytes per channel
+    uint8_t buf[PCA9685_CHANNELS][1 + 4 * PCA9685_CHANNELS];
+};
+
+static double now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000.0 + ts.tv_nsec / 1000.0;
+}
+
+static int pca9685_transfer(pca9685_t *dev, struct i2c_msg *msgs, int count)
+{
+    struct i2c_rdwr_ioctl_data rdwr;
+    int i;
+
+    if (dev->use_rdwr) {
+        rdwr.msgs = msgs;
+        rdwr.nmsgs = count;
+        if (ioctl(dev->fd, I2C_RDWR, &rdwr) >= 0)
+            return 0;
+        if (errno != EOPNOTSUPP && errno != EINVAL && errno != ENOTTY) {
+            perror("pca9685 I2C_RDWR");
+            return -1;
+        }
+
+        // adapter without I2C_RDWR support, one write per message from now on
+        if (ioctl(dev->fd, I2C_SLAVE, dev->addr) < 0) {
+            perror("pca9685 I2C_SLAVE");
+            return -1;
+        }
+        dev->use_rdwr = 0;
+    }
+
+    for (i = 0; i < count; i++) {
+        if (write(dev->fd, msgs[i].buf, msgs[i].len) != msgs[i].len) {
+            perror("pca9685 write");
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+static int pca9685_write_reg(pca9685_t *dev, uint8_t reg, uint8_t value)
+{
+    uint8_t data[2] = { reg, value };
+    struct i2c_msg msg;
+
+    msg.addr = dev->addr;
+    msg.flags = 0;
+    msg.len = sizeof(data);
+    msg.buf = data;
+
+    return pca9685_transfer(dev, &msg, 1);
+}
+
+pca9685_t *pca9685_open(int bus, int addr, double freq_hz)
+{
+    char filename[32];
+    uint8_t all_off[5] = { ALL_LED_ON_L, 0, 0, 0, PCA9685_FULL_OFF >> 8 };
+    struct i2c_msg msg;
+    pca9685_t *dev;
+    int prescale, i;
+
+    dev = calloc(1, sizeof(pca9685_t));
+    if (!dev)
+        return NULL;
+
+    snprintf(filename, sizeof(filename), "/dev/i2c-%d", bus);
+    dev->fd = open(filename, O_RDWR);
+    if (dev->fd < 0) {
+        perror(filename);
+        free(dev);
+        return NULL;
+    }
+    dev->addr = addr;
+    dev->use_rdwr = 1;
+
+    // 25MHz / (4096 * (prescale + 1)), prescale 3-255
+    prescale = (int)lround(OSC_CLOCK / (PCA9685_COUNTS * freq_hz)) - 1;
+    if (prescale < 3) prescale = 3;
+    if (prescale > 255) prescale = 255;
+    dev->freq = OSC_CLOCK / (PCA9685_COUNTS * (prescale + 1));
+
+    // The prescaler is only writable in sleep mode, outputs start fully off
+    msg.addr = addr;
+    msg.flags = 0;
+    msg.len = sizeof(all_off);
+    msg.buf = all_off;
+    if (pca9685_write_reg(dev, MODE1, MODE1_SLEEP | MODE1_AI | MODE1_ALLCALL) != 0 ||
+        pca9685_transfer(dev, &msg, 1) != 0 ||
+        pca9685_write_reg(dev, PRESCALE, prescale) != 0 ||
+        pca9685_write_reg(dev, MODE2, MODE2_OUTDRV) != 0 ||
+        pca9685_write_reg(dev, MODE1, MODE1_AI | MODE1_ALLCALL) != 0) {
+        fprintf(stderr, "pca9685: no response at 0x%02x on %s\n", addr, filename);
+        close(dev->fd);
+        free(dev);
+        return NULL;
+    }
+
+    // The oscillator needs 500us after wake-up before the PWM restarts
+    usleep(500);
+    pca9685_write_reg(dev, MODE1, MODE1_RESTART | MODE1_AI | MODE1_ALLCALL);
+
+    for (i = 0; i < PCA9685_CHANNELS; i++)
+        dev->off[i] = PCA9685_FULL_OFF;
+
+    return dev;
+}
+
+double pca9685_get_freq(const pca9685_t *dev)
+{
+    return dev->freq;
+}
+
+int pca9685_set_count(pca9685_t *dev, int channel, uint16_t count)
+{
+    if (channel < 0 || channel >= PCA9685_CHANNELS || (count >= PCA9685_COUNTS && count != PCA9685_FULL_OFF))
+        return -1;
+
+    if (dev->off[channel] != count) {
+        dev->off[channel] = count;
+        dev->dirty |= 1 << channel;
+    }
+
+    return 0;
+}
+
+int pca9685_set_pulse_us(pca9685_t *dev, int channel, double pulse_us)
+{
+    long count = lround(pulse_us * dev->freq * PCA9685_COUNTS / 1000000.0);
+
+    if (count < 0) count = 0;
+    if (count > PCA9685_COUNTS - 1) count = PCA9685_COUNTS - 1;
+
+    return pca9685_set_count(dev, channel, (uint16_t)count);
+}
+
+int pca9685_flush(pca9685_t *dev)
+{
+    struct i2c_msg msgs[PCA9685_CHANNELS];
+    int count = 0, bytes = 0;
+    int channel = 0, i;
+    double start;
+
+    if (dev->dirty == 0)
+        return 0;
+
+    start = now_us();
+    while (channel < PCA9685_CHANNELS) {
+        if (!(dev->dirty & (1 << channel))) {
+            channel++;
+            continue;
+        }
+
+        // ON = 0, OFF = count for each channel of the run, auto-increment walks the registers
+        uint8_t *buf = dev->buf[count];
+        int len = 0;
+
+        buf[len++] = LED0_ON_L + 4 * channel;
+        for (i = channel; i < PCA9685_CHANNELS && (dev->dirty & (1 << i)); i++) {
+            buf[len++] = 0;
+            buf[len++] = 0;
+            buf[len++] = dev->off[i] & 0xFF;
+            buf[len++] = dev->off[i] >> 8;
+        }
+
+        msgs[count].addr = dev->addr;
+        msgs[count].flags = 0;
+        msgs[count].len = len;
+        msgs[count].buf = buf;
+        count++;
+        bytes += len;
+        channel = i;
+    }
+
+    if (pca9685_transfer(dev, msgs, count) != 0)
+        return -1;
+    dev->dirty = 0;
+
+    double spent = now_us() - start;
+    dev->stats.flushes++;
+    dev->stats.messages += count;
+    dev->stats.bytes += bytes;
+    dev->write_sum_us += spent;
+    dev->stats.write_avg_us = dev->write_sum_us / dev->stats.flushes;
+    if (spent > dev->stats.write_max_us)
+        dev->stats.write_max_us = spent;
+
+    return 0;
+}
+
+void pca9685_get_stats(const pca9685_t *dev, pca9685_stats_t *stats)
+{
+    *stats = dev->stats;
+}
+
+void pca9685_close(pca9685_t *dev)
+{
+    int i;
+
+    if (!dev)
+        return;
+
+    for (i = 0; i < PCA9685_CHANNELS; i++)
+        pca9685_set_count(dev, i, PCA9685_FULL_OFF);
+    pca9685_flush(dev);
+    pca9685_write_reg(dev, MODE1, MODE1_SLEEP | MODE1_AI | MODE1_ALLCALL);
+
+    close(dev->fd);
+    free(dev);
+}
@@ -0,0 +1,56 @@
+#ifndef __PCA9685_H__
+#define __PCA9685_H__
+
+#include <stdint.h>
+
+#define PCA9685_CHANNELS        16
+#define PCA9685_DEFAULT_ADDR    0x40
+#define PCA9685_COUNTS          4096        // 12-bit counter per PWM period
+#define PCA9685_FULL_OFF        0x1000      // OFF count with the full-off bit set
+
+// KNEO Pi Pin Header (/dev/i2c-0)          PCA9685
+// PIN1 3V3                         <->     VCC
+// PIN3 I2C_0_IO_SDA                <->     SDA
+// PIN5 I2C_0_IO_SCL                <->     SCL
+// PIN9 GND                         <->     GND
+
+typedef struct pca9685 pca9685_t;
+
+// Transfer statistics since pca9685_open()
+typedef struct {
+    unsigned long flushes;      // pca9685_flush() calls which wrote something
+    unsigned long messages;     // I2C messages, one per run of adjacent dirty channels
+    unsigned long bytes;        // register address and data bytes
+    double write_avg_us;        // time of one flush
+    double write_max_us;
+} pca9685_stats_t;
+
+/**
+ * Open /dev/i2c-<bus>, reset the chip and set the PWM frequency.
+ * Register auto-increment is enabled so a block of channels is written in one message.
+ * Returns the device, NULL on failure.
+ */
+pca9685_t *pca9685_open(int bus, int addr, double freq_hz);
+
+// PWM frequency after rounding to the prescaler
+double pca9685_get_freq(const pca9685_t *dev);
+
+// Stage the OFF count (0-4095, or PCA9685_FULL_OFF) of a channel, written by the next pca9685_flush()
+int pca9685_set_count(pca9685_t *dev, int channel, uint16_t count);
+
+// Stage a pulse width in microseconds, e.g. 500-2400 for a servo at 50Hz
+int pca9685_set_pulse_us(pca9685_t *dev, int channel, double pulse_us);
+
+/**
+ * Write all staged channels in one I2C transaction, adjacent channels share one message.
+ * The outputs change together at the STOP condition.
+ * Returns 0 on success, -1 on failure.
+ */
+int pca9685_flush(pca9685_t *dev);
+
+void pca9685_get_stats(const pca9685_t *dev, pca9685_stats_t *stats);
+
+// Turn all channels fully off, put the chip to sleep and close the bus
+void pca9685_close(pca9685_t *dev);
+
+#endif
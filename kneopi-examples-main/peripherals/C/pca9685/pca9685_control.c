@@ -0,0 +1,82 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <time.h>
+
+#include "pca9685.h"
+
+#define I2C_BUS         0       // KNEO Pi, /dev/i2c-0
+#define PWM_FREQ        50      // servo frame, 20ms
+
+// For TowerPro Micro Servo 9g SG90
+#define MIN_PULSE_US    500     // 0 degrees
+#define MAX_PULSE_US    2400    // 180 degrees
+
+#define BENCH_ROUNDS    100
+
+static double now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000.0 + ts.tv_nsec / 1000.0;
+}
+
+static double angle_to_pulse_us(double angle)
+{
+    return MIN_PULSE_US + angle * (MAX_PULSE_US - MIN_PULSE_US) / 180.0;
+}
+
+// Update all 16 channels, either one flush per channel or all of them in one flush
+static double bench(pca9685_t *dev, int batched)
+{
+    double start = now_us();
+    int round, ch;
+
+    for (round = 0; round < BENCH_ROUNDS; round++) {
+        for (ch = 0; ch < PCA9685_CHANNELS; ch++) {
+            pca9685_set_pulse_us(dev, ch, angle_to_pulse_us((round + ch) % 180));
+            if (!batched)
+                pca9685_flush(dev);
+        }
+        if (batched)
+            pca9685_flush(dev);
+    }
+
+    return (now_us() - start) / BENCH_ROUNDS;
+}
+
+// Usage: ./pca9685_control [bus] [address], default bus 0 address 0x40
+int main(int argc, char *argv[]) {
+    int bus = argc > 1 ? atoi(argv[1]) : I2C_BUS;
+    int addr = argc > 2 ? (int)strtol(argv[2], NULL, 0) : PCA9685_DEFAULT_ADDR;
+    pca9685_stats_t stats;
+    pca9685_t *dev;
+    int angle;
+
+    dev = pca9685_open(bus, addr, PWM_FREQ);
+    if (!dev)
+        return 1;
+    printf("PCA9685 0x%02x on /dev/i2c-%d, %.2f Hz\n", addr, bus, pca9685_get_freq(dev));
+
+    // 16 channel update, per channel transactions against one batched transaction
+    double single_us = bench(dev, 0);
+    double batched_us = bench(dev, 1);
+    printf("16 channels: per channel %.1f us, batched %.1f us\n", single_us, batched_us);
+
+    // Sweep servos on channel 0 and 1 in opposite directions, both change at the same STOP condition
+    for (angle = 0; angle <= 180; angle += 10) {
+        pca9685_set_pulse_us(dev, 0, angle_to_pulse_us(angle));
+        pca9685_set_pulse_us(dev, 1, angle_to_pulse_us(180 - angle));
+        pca9685_flush(dev);
+        usleep(200000);
+    }
+
+    pca9685_get_stats(dev, &stats);
+    printf("flushes %lu, messages %lu, bytes %lu\n", stats.flushes, stats.messages, stats.bytes);
+    printf("flush avg %.1f us, max %.1f us\n", stats.write_avg_us, stats.write_max_us);
+
+    // Turn the outputs off before exiting
+    pca9685_close(dev);
+
+    return 0;
+}
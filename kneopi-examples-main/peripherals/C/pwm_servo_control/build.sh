@@ -1,2 +1,2 @@
 #!/bin/bash
-gcc -o servo_control servo_control.c
+gcc -o servo_control servo_control.c servo.c -lpthread -lm
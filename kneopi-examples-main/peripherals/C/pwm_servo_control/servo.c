@@ -0,0 +1,321 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <string.h>
+#include <errno.h>
+#include <math.h>
+#include <time.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/timerfd.h>
+
+#include "servo.h"
+
+typedef struct {
+    servo_config_t config;
+    int duty_fd;                // pwmN/duty_cycle, open while the servo runs
+    int enabled;                // enable was written to 1, written back to 0 on close
+    int last_duty;              // last value written
+    double angle;               // sent in the last frame
+    double target;
+} servo_channel_t;
+
+static char pwm_path[128];
+static servo_channel_t servos[SERVO_MAX_CHANNELS];
+static int servo_count = 0;
+
+static pthread_t servo_thread;
+static pthread_mutex_t servo_mutex = PTHREAD_MUTEX_INITIALIZER;
+static int timer_fd = -1;
+static volatile int running = 0;
+
+static double timer_start_us = 0;     // the frame grid starts here
+
+static servo_stats_t stats;
+static double jitter_sum_us = 0;
+static double write_sum_us = 0;
+
+static double now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000.0 + ts.tv_nsec / 1000.0;
+}
+
+// Write a value to a sysfs file, only used while setting up a channel
+static int pwm_write(const char *path, const char *value)
+{
+    int fd = open(path, O_WRONLY);
+    if (fd < 0) {
+        perror(path);
+        return -1;
+    }
+    int rc = (write(fd, value, strlen(value)) == (ssize_t)strlen(value)) ? 0 : -1;
+    if (rc != 0)
+        perror(path);
+    close(fd);
+    return rc;
+}
+
+static int pwm_channel_write(unsigned int channel, const char *file, long value)
+{
+    char path[192];
+    char str[32];
+
+    snprintf(path, sizeof(path), "%s/pwm%u/%s", pwm_path, channel, file);
+    snprintf(str, sizeof(str), "%ld", value);
+    return pwm_write(path, str);
+}
+
+static int angle_to_duty(const servo_config_t *config, double angle)
+{
+    return config->min_duty + (int)lround(angle * (config->max_duty - config->min_duty) / config->max_angle);
+}
+
+static double clamp_angle(const servo_config_t *config, double angle)
+{
+    if (angle < 0) angle = 0;
+    if (angle > config->max_angle) angle = config->max_angle;
+    return angle;
+}
+
+// One pwrite() on the open file, sysfs takes the whole value at offset 0
+static void servo_write_duty(servo_channel_t *servo, int duty)
+{
+    char str[32];
+    int len = snprintf(str, sizeof(str), "%d", duty);
+    double start = now_us();
+
+    if (pwrite(servo->duty_fd, str, len, 0) != len) {
+        perror("write duty_cycle");
+        return;
+    }
+    servo->last_duty = duty;
+
+    double spent = now_us() - start;
+    stats.writes++;
+    write_sum_us += spent;
+    stats.write_avg_us = write_sum_us / stats.writes;
+    if (spent > stats.write_max_us)
+        stats.write_max_us = spent;
+}
+
+static int export_channel(unsigned int channel)
+{
+    char path[192];
+    char str[16];
+    int i;
+
+    snprintf(path, sizeof(path), "%s/pwm%u", pwm_path, channel);
+    if (access(path, F_OK) != 0) {
+        snprintf(path, sizeof(path), "%s/export", pwm_path);
+        snprintf(str, sizeof(str), "%u", channel);
+        if (pwm_write(path, str) != 0)
+            return -1;
+    }
+
+    // Allow some time for the PWM channel to be available
+    snprintf(path, sizeof(path), "%s/pwm%u/duty_cycle", pwm_path, channel);
+    for (i = 0; i < 50 && access(path, W_OK) != 0; i++)
+        usleep(20000);
+
+    return 0;
+}
+
+static void *servo_update_thread(void *arg)
+{
+    double frame_us = SERVO_PERIOD_NS / 1000.0;
+    double next_us = timer_start_us + frame_us;
+    uint64_t expirations;
+    int i;
+
+    (void)arg;
+
+    while (running) {
+        if (read(timer_fd, &expirations, sizeof(expirations)) != sizeof(expirations)) {
+            if (errno == EINTR)
+                continue;
+            perror("read timerfd");
+            break;
+        }
+
+        // Lateness of this wake-up against the frame it is handling
+        next_us += frame_us * (expirations - 1);
+        double jitter = now_us() - next_us;
+        next_us += frame_us;
+
+        pthread_mutex_lock(&servo_mutex);
+        stats.frames += expirations;
+        stats.overruns += expirations - 1;
+        jitter_sum_us += fabs(jitter);
+        stats.jitter_avg_us = jitter_sum_us / (stats.frames - stats.overruns);
+        if (fabs(jitter) > stats.jitter_max_us)
+            stats.jitter_max_us = fabs(jitter);
+
+        for (i = 0; i < servo_count; i++) {
+            servo_channel_t *servo = &servos[i];
+            double step = servo->config.max_speed * frame_us * expirations / 1000000.0;
+            double delta = servo->target - servo->angle;
+
+            if (servo->config.max_speed <= 0 || fabs(delta) <= step)
+                servo->angle = servo->target;
+            else
+                servo->angle += (delta > 0) ? step : -step;
+
+            int duty = angle_to_duty(&servo->config, servo->angle);
+            if (duty != servo->last_duty)
+                servo_write_duty(servo, duty);
+        }
+        pthread_mutex_unlock(&servo_mutex);
+    }
+
+    return NULL;
+}
+
+int servo_open(const char *pwm_chip, const servo_config_t *configs, int count)
+{
+    struct itimerspec its;
+    struct sched_param param;
+    pthread_attr_t attr;
+    char path[192];
+    int i;
+
+    if (running || count <= 0 || count > SERVO_MAX_CHANNELS) {
+        fprintf(stderr, "servo_open: already open or bad channel count %d\n", count);
+        return -1;
+    }
+
+    snprintf(pwm_path, sizeof(pwm_path), "%s", pwm_chip);
+    memset(servos, 0, sizeof(servos));
+    memset(&stats, 0, sizeof(stats));
+    jitter_sum_us = 0;
+    write_sum_us = 0;
+
+    for (i = 0; i < count; i++) {
+        servo_channel_t *servo = &servos[i];
+        servo->config = configs[i];
+        servo->duty_fd = -1;
+        servo_count = i + 1;
+
+        if (servo->config.max_angle <= 0)
+            servo->config.max_angle = 180;
+        servo->angle = servo->target = clamp_angle(&servo->config, servo->config.init_angle);
+        servo->last_duty = angle_to_duty(&servo->config, servo->angle);
+
+        // duty_cycle must not exceed the period, set both before enabling
+        if (export_channel(servo->config.channel) != 0 ||
+            pwm_channel_write(servo->config.channel, "period", SERVO_PERIOD_NS) != 0 ||
+            pwm_channel_write(servo->config.channel, "duty_cycle", servo->last_duty) != 0 ||
+            pwm_channel_write(servo->config.channel, "enable", 1) != 0)
+            goto error;
+        servo->enabled = 1;
+
+        snprintf(path, sizeof(path), "%s/pwm%u/duty_cycle", pwm_path, servo->config.channel);
+        servo->duty_fd = open(path, O_WRONLY);
+        if (servo->duty_fd < 0) {
+            perror(path);
+            goto error;
+        }
+    }
+
+    // Periodic timer on the servo frame, the thread catches up when it wakes late
+    timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+    if (timer_fd < 0) {
+        perror("timerfd_create");
+        goto error;
+    }
+    its.it_interval.tv_sec = 0;
+    its.it_interval.tv_nsec = SERVO_PERIOD_NS;
+    its.it_value = its.it_interval;
+    timer_start_us = now_us();
+    if (timerfd_settime(timer_fd, 0, &its, NULL) != 0) {
+        perror("timerfd_settime");
+        goto error;
+    }
+
+    running = 1;
+    pthread_attr_init(&attr);
+    pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+    pthread_attr_setschedpolicy(&attr, SCHED_FIFO);
+    param.sched_priority = sched_get_priority_min(SCHED_FIFO) + 10;
+    pthread_attr_setschedparam(&attr, &param);
+    if (pthread_create(&servo_thread, &attr, servo_update_thread, NULL) != 0) {
+        // Not allowed to use a real-time policy, run as a normal thread
+        printf("servo: SCHED_FIFO not permitted, update jitter is not bounded\n");
+        if (pthread_create(&servo_thread, NULL, servo_update_thread, NULL) != 0) {
+            pthread_attr_destroy(&attr);
+            running = 0;
+            perror("pthread_create");
+            goto error;
+        }
+    }
+    pthread_attr_destroy(&attr);
+
+    return 0;
+
+error:
+    servo_close();
+    return -1;
+}
+
+int servo_set_angle(int index, double angle)
+{
+    if (index < 0 || index >= servo_count)
+        return -1;
+
+    pthread_mutex_lock(&servo_mutex);
+    servos[index].target = clamp_angle(&servos[index].config, angle);
+    pthread_mutex_unlock(&servo_mutex);
+
+    return 0;
+}
+
+double servo_get_angle(int index)
+{
+    double angle;
+
+    if (index < 0 || index >= servo_count)
+        return -1;
+
+    pthread_mutex_lock(&servo_mutex);
+    angle = servos[index].angle;
+    pthread_mutex_unlock(&servo_mutex);
+
+    return angle;
+}
+
+void servo_get_stats(servo_stats_t *out)
+{
+    pthread_mutex_lock(&servo_mutex);
+    *out = stats;
+    pthread_mutex_unlock(&servo_mutex);
+}
+
+void servo_close(void)
+{
+    int i;
+
+    if (running) {
+        running = 0;
+        pthread_join(servo_thread, NULL);
+    }
+    if (timer_fd >= 0) {
+        close(timer_fd);
+        timer_fd = -1;
+    }
+
+    // Disable PWM before exiting
+    for (i = 0; i < servo_count; i++) {
+        if (servos[i].duty_fd >= 0) {
+            close(servos[i].duty_fd);
+            servos[i].duty_fd = -1;
+        }
+        if (servos[i].enabled) {
+            pwm_channel_write(servos[i].config.channel, "enable", 0);
+            servos[i].enabled = 0;
+        }
+    }
+    servo_count = 0;
+}
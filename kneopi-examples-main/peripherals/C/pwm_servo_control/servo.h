@@ -0,0 +1,46 @@
+#ifndef __SERVO_H__
+#define __SERVO_H__
+
+#define SERVO_MAX_CHANNELS  4
+#define SERVO_PERIOD_NS     20000000    // 20ms (50Hz), one update per servo frame
+
+// Channel of a pwmchip driving one servo
+typedef struct {
+    unsigned int channel;       // pwm channel of the chip
+    int min_duty;               // duty cycle in ns at 0 degrees
+    int max_duty;               // duty cycle in ns at max_angle
+    double max_angle;           // degrees
+    double max_speed;           // degrees per second toward the target, 0 jumps in one frame
+    double init_angle;          // angle set before the PWM is enabled
+} servo_config_t;
+
+// Update thread statistics since servo_open()
+typedef struct {
+    unsigned long frames;       // timer expirations handled
+    unsigned long overruns;     // frames missed because the thread woke up late
+    unsigned long writes;       // duty_cycle writes
+    double jitter_avg_us;       // wake-up time against the frame grid
+    double jitter_max_us;
+    double write_avg_us;        // time of one duty_cycle write
+    double write_max_us;
+} servo_stats_t;
+
+/**
+ * Export and enable the channels, keep their duty_cycle files open and start the update thread.
+ * The thread runs with SCHED_FIFO when the process is allowed to.
+ * Returns 0 on success, -1 on failure.
+ */
+int servo_open(const char *pwm_chip, const servo_config_t *configs, int count);
+
+// Set the target angle of a servo, the update thread moves toward it at max_speed
+int servo_set_angle(int index, double angle);
+
+// Angle sent in the last frame
+double servo_get_angle(int index);
+
+void servo_get_stats(servo_stats_t *stats);
+
+// Stop the update thread, disable the channels and close their files
+void servo_close(void);
+
+#endif
@@ -66,8 +66,10 @@ void LCD_1IN47_test(void)
 
     // /*3.Refresh the picture in RAM to LCD*/
     LCD_1IN47_Display(BlackImage);
+    Paint_ClearDirty();
     DEV_Delay_ms(2000);
 
+    UDOUBLE Flush_Bytes = 0, Flush_Count = 0;
     PAINT_TIME sPaint_time;	//time struct
     sPaint_time.Hour = 12;
     sPaint_time.Min = 34;
@@ -120,10 +122,13 @@ void LCD_1IN47_test(void)
         Paint_DrawString_EN(1, 105, "AaBbCc123", &Font24, RED, WHITE);
         Paint_DrawString_CN(1,125, "΢ѩAbc",  &Font24CN, WHITE, BLUE);
 
-        LCD_1IN47_Display(BlackImage);
+        Flush_Bytes += Paint_Flush(LCD_1IN47_DisplayWindows);
+        Flush_Count++;
 
         // DEV_Delay_ms(500);
     }
+    printf("partial refresh: %d bytes per update, full frame %d bytes\r\n",
+           Flush_Count ? Flush_Bytes / Flush_Count : 0, Imagesize);
 
     // /* show bmp */
     // printf("show bmp\r\n");
@@ -64,9 +64,11 @@ void LCD_1IN69_test(void)
 
     // /*3.Refresh the picture in RAM to LCD*/
     LCD_1IN69_Display(BlackImage);
+    Paint_ClearDirty();
     DEV_Delay_ms(2000);
 
-    Paint_NewImage(BlackImage, 40, 110, 90, WHITE, 16);
+    // /*4.Only the changed windows are sent from now on*/
+    UDOUBLE Flush_Bytes = 0, Flush_Count = 0;
     PAINT_TIME sPaint_time; //time struct
     sPaint_time.Hour = 12;
     sPaint_time.Min = 34;
@@ -88,16 +90,19 @@ void LCD_1IN69_test(void)
             }
         }
         
-        Paint_Clear(WHITE);
-        Paint_DrawTime(5, 10, &sPaint_time, &Font20, WHITE, BLACK);
+        Paint_ClearWindow(170, 70, 280, 110, WHITE);
+        Paint_DrawTime(175, 80, &sPaint_time, &Font20, WHITE, BLACK);
 
         if(num-- == 0) {
             break;
         }
 
-        LCD_1IN69_DisplayWindows(130, 170, 170, 280, BlackImage);
+        Flush_Bytes += Paint_Flush(LCD_1IN69_DisplayWindows);
+        Flush_Count++;
         // DEV_Delay_ms(500);
     }
+    printf("partial refresh: %d bytes per update, full frame %d bytes\r\n",
+           Flush_Count ? Flush_Bytes / Flush_Count : 0, Imagesize);
     DEV_Delay_ms(1000);
     
     // /* show bmp */
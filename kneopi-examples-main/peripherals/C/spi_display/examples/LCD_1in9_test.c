@@ -64,8 +64,10 @@ void LCD_1IN9_test(void)
 
     // /*3.Refresh the picture in RAM to LCD*/
     LCD_1IN9_Display(BlackImage);
+    Paint_ClearDirty();
     DEV_Delay_ms(2000);
    
+    UDOUBLE Flush_Bytes = 0, Flush_Count = 0;
     PAINT_TIME sPaint_time; //time struct
     sPaint_time.Hour = 12;
     sPaint_time.Min = 34;
@@ -117,9 +119,12 @@ void LCD_1IN9_test(void)
         Paint_DrawString_EN(1, 105, "AaBbCc123", &Font24, RED, WHITE);   
         Paint_DrawString_CN(1, 125, "΢ѩAbc",  &Font24CN, WHITE, BLUE);
         
-        LCD_1IN9_Display(BlackImage);
+        Flush_Bytes += Paint_Flush(LCD_1IN9_DisplayWindows);
+        Flush_Count++;
         // DEV_Delay_ms(100);
     }
+    printf("partial refresh: %d bytes per update, full frame %d bytes\r\n",
+           Flush_Count ? Flush_Bytes / Flush_Count : 0, Imagesize);
     DEV_Delay_ms(1000);
     
     // /* show bmp */
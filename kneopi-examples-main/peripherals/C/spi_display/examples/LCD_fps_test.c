@@ -0,0 +1,183 @@
+#include "DEV_Config.h"
+#include "LCD_0in96.h"
+#include "LCD_1in14.h"
+#include "LCD_1in28.h"
+#include "LCD_1in3.h"
+#include "LCD_1in47.h"
+#include "LCD_1in54.h"
+#include "LCD_1in69.h"
+#include "LCD_1in8.h"
+#include "LCD_1in9.h"
+#include "LCD_2inch.h"
+#include "LCD_2inch4.h"
+#include "GUI_Paint.h"
+#include "GUI_Flush.h"
+#include "test.h"
+#include <stdio.h>		//printf()
+#include <stdlib.h>		//exit()
+#include <signal.h>     //signal()
+#include <time.h>
+
+#define FPS_FRAMES  100
+
+/**
+ * Panel under test, Width and Height are the dimensions of the Paint image
+**/
+typedef struct {
+    double Size;
+    void (*Init)(UWORD *Width, UWORD *Height);
+    PAINT_DISPLAY_WINDOWS DisplayWindows;
+    void (*Handler)(int signo);
+} LCD_FPS_PANEL;
+
+static void Init_0IN96(UWORD *Width, UWORD *Height) { LCD_0IN96_Init(); *Width = LCD_0IN96_WIDTH; *Height = LCD_0IN96_HEIGHT; }
+static void Init_1IN14(UWORD *Width, UWORD *Height) { LCD_1IN14_Init(HORIZONTAL); *Width = LCD_1IN14.WIDTH; *Height = LCD_1IN14.HEIGHT; }
+static void Init_1IN28(UWORD *Width, UWORD *Height) { LCD_1IN28_Init(HORIZONTAL); *Width = LCD_1IN28_WIDTH; *Height = LCD_1IN28_HEIGHT; }
+static void Init_1IN3(UWORD *Width, UWORD *Height)  { LCD_1IN3_Init(HORIZONTAL); *Width = LCD_1IN3_WIDTH; *Height = LCD_1IN3_HEIGHT; }
+static void Init_1IN47(UWORD *Width, UWORD *Height) { LCD_1IN47_Init(HORIZONTAL); *Width = LCD_1IN47_WIDTH; *Height = LCD_1IN47_HEIGHT; }
+static void Init_1IN54(UWORD *Width, UWORD *Height) { LCD_1IN54_Init(HORIZONTAL); *Width = LCD_1IN54_WIDTH; *Height = LCD_1IN54_HEIGHT; }
+static void Init_1IN69(UWORD *Width, UWORD *Height) { LCD_1IN69_Init(VERTICAL); *Width = LCD_1IN69_WIDTH; *Height = LCD_1IN69_HEIGHT; }
+static void Init_1IN8(UWORD *Width, UWORD *Height)  { LCD_1IN8_Init(SCAN_DIR_DFT); *Width = LCD_1IN8_WIDTH; *Height = LCD_1IN8_HEIGHT; }
+static void Init_1IN9(UWORD *Width, UWORD *Height)  { LCD_1IN9_Init(HORIZONTAL); *Width = LCD_1IN9_WIDTH; *Height = LCD_1IN9_HEIGHT; }
+static void Init_2IN(UWORD *Width, UWORD *Height)   { LCD_2IN_Init(); *Width = LCD_2IN_WIDTH; *Height = LCD_2IN_HEIGHT; }
+static void Init_2IN4(UWORD *Width, UWORD *Height)  { LCD_2IN4_Init(); *Width = LCD_2IN4_WIDTH; *Height = LCD_2IN4_HEIGHT; }
+
+static const LCD_FPS_PANEL Panels[] = {
+    {0.96, Init_0IN96, LCD_0IN96_DisplayWindows, Handler_0IN96_LCD},
+    {1.14, Init_1IN14, LCD_1IN14_DisplayWindows, Handler_1IN14_LCD},
+    {1.28, Init_1IN28, LCD_1IN28_DisplayWindows, Handler_1IN28_LCD},
+    {1.3,  Init_1IN3,  LCD_1IN3_DisplayWindows,  Handler_1IN3_LCD},
+    {1.47, Init_1IN47, LCD_1IN47_DisplayWindows, Handler_1IN47_LCD},
+    {1.54, Init_1IN54, LCD_1IN54_DisplayWindows, Handler_1IN54_LCD},
+    {1.69, Init_1IN69, LCD_1IN69_DisplayWindows, Handler_1IN69_LCD},
+    {1.8,  Init_1IN8,  LCD_1IN8_DisplayWindows,  Handler_1IN8_LCD},
+    {1.9,  Init_1IN9,  LCD_1IN9_DisplayWindows,  Handler_1IN9_LCD},
+    {2,    Init_2IN,   LCD_2IN_DisplayWindows,   Handler_2IN_LCD},
+    {2.4,  Init_2IN4,  LCD_2IN4_DisplayWindows,  Handler_2IN4_LCD},
+};
+
+static double Now_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+/**
+ * One frame of the benchmark: a moving bar over the whole image and a frame counter
+**/
+static void Draw_Frame(UWORD Frame)
+{
+    UWORD Bar = Paint.Width / 8;
+    UWORD X = (Frame * 4) % (Paint.Width - Bar);
+
+    Paint_ClearWindow(0, 0, Paint.Width, Paint.Height, WHITE);
+    Paint_DrawRectangle(X, 20, X + Bar, Paint.Height, BLUE, DOT_PIXEL_1X1, DRAW_FILL_FULL);
+    Paint_DrawNum(2, 2, Frame + 1, &Font12, BLACK, WHITE);
+}
+
+/**
+ * A dashboard frame: only the frame counter and a small box change
+**/
+static void Draw_Dashboard(UWORD Frame)
+{
+    UWORD X = (Frame * 2) % (Paint.Width - 20);
+
+    Paint_ClearWindow(0, 0, Paint.Width, 16, WHITE);
+    Paint_DrawNum(2, 2, Frame + 1, &Font12, BLACK, WHITE);
+    Paint_ClearWindow(0, 40, Paint.Width, 60, WHITE);
+    Paint_DrawRectangle(X, 40, X + 20, 60, RED, DOT_PIXEL_1X1, DRAW_FILL_FULL);
+}
+
+void LCD_FPS_test(double size)
+{
+    const LCD_FPS_PANEL *Panel = NULL;
+    UWORD Width, Height, i;
+    UWORD *Image[2];
+    GUI_FLUSH_STATS Stats;
+    double Start, Sync_Fps, Async_Fps, Partial_Fps;
+    UDOUBLE Partial_Bytes;
+
+    for (i = 0; i < sizeof(Panels) / sizeof(Panels[0]); i++) {
+        if (Panels[i].Size == size)
+            Panel = &Panels[i];
+    }
+    if (Panel == NULL) {
+        printf("error: can not find the LCD\r\n");
+        return;
+    }
+
+    // Exception handling:ctrl + c
+    signal(SIGINT, Panel->Handler);
+
+    /* Module Init */
+    if(DEV_ModuleInit() != 0){
+        DEV_ModuleExit();
+        exit(0);
+    }
+
+    /* LCD Init */
+    printf("%.2f inch LCD frame rate...\r\n", size);
+    Panel->Init(&Width, &Height);
+
+    UDOUBLE Imagesize = (UDOUBLE)Width * Height * 2;
+    Image[0] = (UWORD *)malloc(Imagesize);
+    Image[1] = (UWORD *)malloc(Imagesize);
+    if (Image[0] == NULL || Image[1] == NULL) {
+        printf("Failed to apply for image memory...\r\n");
+        exit(0);
+    }
+    Paint_NewImage(Image[0], Width, Height, 0, WHITE, 16);
+    Paint_Clear(WHITE);
+    Paint_Flush(Panel->DisplayWindows);
+
+    /* 1.Draw and send in turn, the whole frame */
+    Start = Now_ms();
+    for (i = 0; i < FPS_FRAMES; i++) {
+        Draw_Frame(i);
+        Paint_SetDirty(0, 0, Paint.Width, Paint.Height);
+        Paint_Flush(Panel->DisplayWindows);
+    }
+    Sync_Fps = FPS_FRAMES * 1000.0 / (Now_ms() - Start);
+
+    /* 2.Draw the next frame while the current one is sent, the whole frame */
+    if (GUI_Flush_Init(Image[0], Image[1], Panel->DisplayWindows) != 0)
+        exit(0);
+    for (i = 0; i < FPS_FRAMES; i++) {
+        Draw_Frame(i);
+        Paint_SetDirty(0, 0, Paint.Width, Paint.Height);
+        GUI_Flush_Submit();
+    }
+    GUI_Flush_Wait();
+    GUI_Flush_GetStats(&Stats);
+    Async_Fps = Stats.Frames * 1000.0 / Stats.Elapsed_ms;
+    printf("async full frame: transfer %.2f ms/frame, waited %.2f ms/frame\r\n",
+           Stats.Transfer_ms / Stats.Frames, Stats.Wait_ms / Stats.Frames);
+    GUI_Flush_Exit();
+
+    /* 3.Dashboard, only the dirty windows */
+    Paint_NewImage(Paint.Image, Width, Height, 0, WHITE, 16);
+    Paint_Clear(WHITE);
+    Paint_Flush(Panel->DisplayWindows);
+    if (GUI_Flush_Init(Paint.Image, Paint.Image == Image[0] ? Image[1] : Image[0], Panel->DisplayWindows) != 0)
+        exit(0);
+    for (i = 0; i < FPS_FRAMES; i++) {
+        Draw_Dashboard(i);
+        GUI_Flush_Submit();
+    }
+    GUI_Flush_Wait();
+    GUI_Flush_GetStats(&Stats);
+    Partial_Fps = Stats.Frames * 1000.0 / Stats.Elapsed_ms;
+    Partial_Bytes = Stats.Frames ? Stats.Bytes / Stats.Frames : 0;
+    GUI_Flush_Exit();
+
+    printf("%-6s %-9s %-10s %-10s %-10s %-14s %-14s\r\n",
+           "inch", "pixels", "sync fps", "async fps", "dash fps", "dash B/frame", "SPI transfer");
+    printf("%-6.2f %3dx%-5d %-10.1f %-10.1f %-10.1f %-14d %-14d\r\n",
+           size, Width, Height, Sync_Fps, Async_Fps, Partial_Fps, Partial_Bytes, DEV_SPI_Get_Transfer_Size());
+
+    /* Module Exit */
+    free(Image[0]);
+    free(Image[1]);
+    DEV_ModuleExit();
+}
@@ -0,0 +1,144 @@
+#include "GUI_Paint.h"
+#include "test.h"
+#include <stdio.h>		//printf()
+#include <stdlib.h>		//exit()
+#include <string.h>
+#include <time.h>
+
+#define TEXT_WIDTH      240
+#define TEXT_HEIGHT     240
+#define TEXT_FRAMES     50
+
+/**
+ * Text benchmark, drawn into a Paint image only, no LCD is needed
+**/
+typedef struct {
+    const char *Name;
+    sFONT *Font;
+    cFONT *Font_CN;
+} LCD_TEXT_FONT;
+
+static const LCD_TEXT_FONT Fonts[] = {
+    {"Font8",    &Font8,  NULL},
+    {"Font12",   &Font12, NULL},
+    {"Font16",   &Font16, NULL},
+    {"Font20",   &Font20, NULL},
+    {"Font24",   &Font24, NULL},
+    {"Font12CN", NULL,    &Font12CN},
+    {"Font24CN", NULL,    &Font24CN},
+};
+
+static double Now_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+/**
+ * A string of the characters of a CN font, in the encoding of its table
+**/
+static void Make_String_CN(cFONT *Font, char *String, UWORD Size)
+{
+    UWORD i, Len = 0;
+
+    for (i = 0; i < Font->size && Len + 3 < Size; i++) {
+        String[Len++] = Font->table[i].index[0];
+        if ((unsigned char)Font->table[i].index[0] > 0x7F)
+            String[Len++] = Font->table[i].index[1];
+    }
+    String[Len] = '\0';
+}
+
+/**
+ * Fill the image with text lines which change every frame, like a dashboard.
+ * Transparent text keeps the image under it, opaque text paints its box.
+ * Return the number of characters drawn.
+**/
+static UDOUBLE Draw_Text(const LCD_TEXT_FONT *Font, UWORD Frame, UBYTE Transparent, const char *String_CN)
+{
+    UWORD Fg = BLACK, Bg = Transparent ? FONT_BACKGROUND : YELLOW;
+    UDOUBLE Chars = 0;
+    UWORD Y, Line = 0;
+    char String[64];
+
+    if (Font->Font != NULL) {
+        for (Y = 0; Y + Font->Font->Height <= Paint.Height; Y += Font->Font->Height, Line++) {
+            snprintf(String, sizeof(String), "%02d:%02d %5.1fC #%05d",
+                     (Frame / 60) % 24, Frame % 60, 20 + (Frame + Line) % 200 / 10.0, Frame * 7 + Line);
+            if (strlen(String) > Paint.Width / Font->Font->Width)
+                String[Paint.Width / Font->Font->Width] = '\0';
+            //Paint_DrawString_EN() draws the glyphs in its last color
+            Paint_DrawString_EN(0, Y, String, Font->Font, Bg, Fg);
+            Chars += strlen(String);
+        }
+    } else {
+        for (Y = 0; Y + Font->Font_CN->Height <= Paint.Height; Y += Font->Font_CN->Height, Line++) {
+            Paint_DrawString_CN((Frame + Line) % 4, Y, String_CN, Font->Font_CN, Bg, Fg);
+            Chars += strlen(String_CN);
+        }
+    }
+    Paint_ClearDirty();
+
+    return Chars;
+}
+
+static double Run(const LCD_TEXT_FONT *Font, UBYTE Transparent, UBYTE Cache, const char *String_CN)
+{
+    UDOUBLE Chars = 0;
+    UWORD i;
+    double Start;
+
+    Paint_SetGlyphCache(Cache);
+    Paint_ClearGlyphCache();
+    Paint_Clear(WHITE);
+
+    Start = Now_ms();
+    for (i = 0; i < TEXT_FRAMES; i++)
+        Chars += Draw_Text(Font, i, Transparent, String_CN);
+
+    return (Now_ms() - Start) * 1000.0 / Chars;
+}
+
+void LCD_Text_test(void)
+{
+    UWORD Rotate[2] = {ROTATE_0, ROTATE_90};
+    PAINT_GLYPH_STATS Stats;
+    char String_CN[64];
+    UWORD *Image;
+    UWORD i, r, t;
+
+    Image = (UWORD *)malloc(TEXT_WIDTH * TEXT_HEIGHT * 2);
+    if (Image == NULL) {
+        printf("Failed to apply for image memory...\r\n");
+        exit(0);
+    }
+
+    printf("glyph cache, %dx%d image, %d frames\r\n", TEXT_WIDTH, TEXT_HEIGHT, TEXT_FRAMES);
+    printf("%-9s %-7s %-12s %-12s %-12s %-8s %-8s %-9s\r\n",
+           "font", "rotate", "text", "pixel us/ch", "cache us/ch", "speedup", "hit %", "cache KB");
+
+    for (i = 0; i < sizeof(Fonts) / sizeof(Fonts[0]); i++) {
+        if (Fonts[i].Font_CN != NULL)
+            Make_String_CN(Fonts[i].Font_CN, String_CN, sizeof(String_CN));
+
+        for (r = 0; r < 2; r++) {
+            Paint_NewImage(Image, TEXT_WIDTH, TEXT_HEIGHT, Rotate[r], WHITE, 16);
+
+            for (t = 0; t < 2; t++) {
+                double Pixel_us = Run(&Fonts[i], t, 0, String_CN);
+                double Cache_us = Run(&Fonts[i], t, 1, String_CN);
+
+                Paint_GetGlyphStats(&Stats);
+                printf("%-9s %-7d %-12s %-12.3f %-12.3f %-8.1f %-8.1f %-9.1f\r\n",
+                       Fonts[i].Name, Rotate[r], t ? "transparent" : "opaque", Pixel_us, Cache_us,
+                       Pixel_us / Cache_us, Stats.Hits * 100.0 / (Stats.Hits + Stats.Misses + 1e-9),
+                       Stats.Bytes / 1024.0);
+            }
+        }
+    }
+
+    Paint_ClearGlyphCache();
+    Paint_SetGlyphCache(1);
+    free(Image);
+}
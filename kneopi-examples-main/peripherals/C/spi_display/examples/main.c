@@ -2,13 +2,21 @@
 #include <math.h>
 #include <stdlib.h>     //exit()
 #include <stdio.h>
+#include <string.h>     //strcmp()
 
 
 int main(int argc, char *argv[])
 {
-    if (argc != 2){
+    if (argc == 2 && strcmp(argv[1], "text") == 0) {
+        LCD_Text_test();
+        return 0;
+    }
+
+    if (argc != 2 && !(argc == 3 && strcmp(argv[2], "fps") == 0)){
         printf("please input LCD type!\r\n");
         printf("example: sudo ./main -1.3\r\n");
+        printf("frame rate: sudo ./main -1.3 fps\r\n");
+        printf("text drawing, no LCD needed: ./main text\r\n");
         exit(1);
     }
     
@@ -24,7 +32,8 @@ int main(int argc, char *argv[])
         printf("%.2lf inch LCD Moudule\r\n",size);
     }
     
-    if(size==0.96)LCD_0IN96_test();
+    if(argc == 3)LCD_FPS_test(size);
+    else if(size==0.96)LCD_0IN96_test();
     else if(size==1.14)LCD_1IN14_test();
     else if(size==1.28)LCD_1IN28_test();
     else if(size==1.3)LCD_1IN3_test();
@@ -39,6 +39,10 @@ void    LCD_2IN_test(void);
 
 void    LCD_2IN4_test(void);
 
+void    LCD_FPS_test(double size);
+
+void    LCD_Text_test(void);
+
 
 
 
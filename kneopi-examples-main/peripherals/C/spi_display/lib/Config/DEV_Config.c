@@ -17,6 +17,9 @@ int GPIO_Handle;
 int GPIO_Handle1;
 int SPI_Handle;
 
+static UDOUBLE SPI_Transfer_Size = SPIDEV_BUFSIZ_DEFAULT;
+static uint8_t *SPI_Buffer = NULL;     //Gathers strided rows and fill patterns into one transfer
+
 /*****************************************
                 PWM
 *****************************************/
@@ -213,6 +216,25 @@ void DEV_Delay_ms(UDOUBLE xms)
     lguSleep(xms/1000.0);
 }
 
+/**
+ * Largest transfer spidev accepts and the bounce buffer of that size
+**/
+static void DEV_SPI_Init_Transfer(void)
+{
+    char buffer[16];
+    long bufsiz = 0;
+
+    if (access(SPIDEV_BUFSIZ_PATH, R_OK) == 0 && read_sysfs_file(SPIDEV_BUFSIZ_PATH, buffer, sizeof(buffer)) == 0)
+        bufsiz = atol(buffer);
+    SPI_Transfer_Size = bufsiz > 0 ? bufsiz : SPIDEV_BUFSIZ_DEFAULT;
+
+    free(SPI_Buffer);
+    SPI_Buffer = (uint8_t *)malloc(SPI_Transfer_Size);
+    if (SPI_Buffer == NULL)
+        DEBUG("SPI transfer buffer malloc failed, rows are sent one by one\n");
+    DEBUG("SPI transfer size %d\n", SPI_Transfer_Size);
+}
+
 static void DEV_GPIO_Init(void)
 {
     DEV_GPIO_Mode(LCD_RST, 1);
@@ -253,6 +275,7 @@ UBYTE DEV_ModuleInit(void)
         }
     }
     SPI_Handle = lgSpiOpen(1, 0, 25000000, 0);
+    DEV_SPI_Init_Transfer();
     DEV_GPIO_Init();
     DEV_SetBacklight(100);
 
@@ -264,9 +287,98 @@ void DEV_SPI_WriteByte(uint8_t Value)
     lgSpiWrite(SPI_Handle,(char*)&Value, 1);
 }
 
+/******************************************************************************
+function:	Write a buffer in as few transfers as spidev accepts
+parameter:
+    pData : data
+    Len   : bytes
+******************************************************************************/
 void DEV_SPI_Write_nByte(uint8_t *pData, uint32_t Len)
 {
-    lgSpiWrite(SPI_Handle,(char*) pData, Len);
+    while (Len > 0) {
+        uint32_t Size = Len < SPI_Transfer_Size ? Len : SPI_Transfer_Size;
+        lgSpiWrite(SPI_Handle, (char *)pData, Size);
+        pData += Size;
+        Len -= Size;
+    }
+}
+
+/******************************************************************************
+function:	Write a window of a frame buffer, rows are gathered into
+            maximal-size transfers instead of one transfer per row
+parameter:
+    pData   : first byte of the window
+    Row_Len : bytes of a window row
+    Stride  : bytes of a frame buffer row
+    Rows    : rows of the window
+******************************************************************************/
+void DEV_SPI_Write_Rows(const uint8_t *pData, uint32_t Row_Len, uint32_t Stride, uint32_t Rows)
+{
+    uint32_t Fill = 0;
+
+    if (Row_Len == Stride || Rows == 1 || SPI_Buffer == NULL) {
+        if (Row_Len == Stride) {
+            DEV_SPI_Write_nByte((uint8_t *)pData, Row_Len * Rows);
+        } else {
+            for (; Rows > 0; Rows--, pData += Stride)
+                DEV_SPI_Write_nByte((uint8_t *)pData, Row_Len);
+        }
+        return;
+    }
+
+    for (; Rows > 0; Rows--, pData += Stride) {
+        const uint8_t *pRow = pData;
+        uint32_t Left = Row_Len;
+        while (Left > 0) {
+            uint32_t Size = SPI_Transfer_Size - Fill;
+            if (Size > Left)
+                Size = Left;
+            memcpy(SPI_Buffer + Fill, pRow, Size);
+            Fill += Size;
+            pRow += Size;
+            Left -= Size;
+            if (Fill == SPI_Transfer_Size) {
+                lgSpiWrite(SPI_Handle, (char *)SPI_Buffer, Fill);
+                Fill = 0;
+            }
+        }
+    }
+    if (Fill > 0)
+        lgSpiWrite(SPI_Handle, (char *)SPI_Buffer, Fill);
+}
+
+/******************************************************************************
+function:	Write the same 16-bit pixel Count times, high byte first
+parameter:
+    Value : RGB565 color
+    Count : pixels
+******************************************************************************/
+void DEV_SPI_Write_Fill(UWORD Value, uint32_t Count)
+{
+    UBYTE Pattern[2] = {Value >> 8, Value & 0xFF};
+    uint32_t i, Size;
+
+    if (SPI_Buffer == NULL) {
+        for (; Count > 0; Count--)
+            lgSpiWrite(SPI_Handle, (char *)Pattern, 2);
+        return;
+    }
+
+    Size = Count * 2 < SPI_Transfer_Size ? Count * 2 : (SPI_Transfer_Size & ~1);
+    for (i = 0; i < Size; i += 2) {
+        SPI_Buffer[i] = Pattern[0];
+        SPI_Buffer[i + 1] = Pattern[1];
+    }
+    for (Count *= 2; Count > 0; Count -= Size) {
+        if (Size > Count)
+            Size = Count;
+        lgSpiWrite(SPI_Handle, (char *)SPI_Buffer, Size);
+    }
+}
+
+UDOUBLE DEV_SPI_Get_Transfer_Size(void)
+{
+    return SPI_Transfer_Size;
 }
 
 /******************************************************************************
@@ -277,6 +389,8 @@ Info:
 void DEV_ModuleExit(void)
 {
     lgSpiClose(SPI_Handle);
+    free(SPI_Buffer);
+    SPI_Buffer = NULL;
     lgGpiochipClose(GPIO_Handle);
     lgGpiochipClose(GPIO_Handle1);
     unexport_pwm();
@@ -24,6 +24,13 @@
 #define LFLAGS 0
 #define NUM_MAXBUF  4
 
+/**
+ * spidev rejects a transfer larger than its bufsiz module parameter,
+ * raise it (e.g. spidev.bufsiz=131072) to send a whole frame at once
+**/
+#define SPIDEV_BUFSIZ_PATH      "/sys/module/spidev/parameters/bufsiz"
+#define SPIDEV_BUFSIZ_DEFAULT   4096
+
 /**
  * data
 **/
@@ -56,5 +63,8 @@ void DEV_Delay_ms(UDOUBLE xms);
 
 void DEV_SPI_WriteByte(UBYTE Value);
 void DEV_SPI_Write_nByte(uint8_t *pData, uint32_t Len);
+void DEV_SPI_Write_Rows(const uint8_t *pData, uint32_t Row_Len, uint32_t Stride, uint32_t Rows);
+void DEV_SPI_Write_Fill(UWORD Value, uint32_t Count);
+UDOUBLE DEV_SPI_Get_Transfer_Size(void);
 UBYTE DEV_SetBacklight(UWORD Value);
 #endif
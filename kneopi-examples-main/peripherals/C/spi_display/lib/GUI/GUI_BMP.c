@@ -3,8 +3,11 @@
 * | Author      :   Waveshare team
 * | Function    :   Hardware underlying interface
 * | Info        :
-*                Used to shield the underlying layers of each master 
+*                Used to shield the underlying layers of each master
 *                and enhance portability
+*                The file is mapped once, decoded a row at a time into
+*                byte swapped RGB565 and copied into the image with
+*                Paint_BlitRect(). Decoded bitmaps are cached by path.
 *----------------
 * |	This version:   V1.0
 * | Date        :   2018-01-11
@@ -12,140 +15,342 @@
 *
 ******************************************************************************/
 #include "GUI_BMP.h"
-#include <stdio.h>	//fseek fread
+#include <stdio.h>	//printf
 #include <fcntl.h>
 #include <unistd.h>
 #include <stdint.h>
-#include <stdlib.h>	//memset
+#include <stdlib.h>	//malloc
+#include <string.h>	//memcpy
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 #include "GUI_Paint.h"
-// #include "GUI_Cache.h"
 
+/**
+ * Pixel formats of the rows
+**/
+typedef enum {
+    BMP_FORMAT_PALETTE = 0,     //1, 4 and 8 bits
+    BMP_FORMAT_RGB565,
+    BMP_FORMAT_XRGB1555,
+    BMP_FORMAT_RGB888,
+    BMP_FORMAT_XRGB8888,        //Alpha is dropped
+} BMP_FORMAT;
 
+typedef struct {
+    char *Path;                 //Key, with the size and time of the file
+    off_t Size;
+    time_t Mtime;
+    UWORD Width;
+    UWORD Height;
+    UWORD *Pixels;              //Byte swapped RGB565, top row first
+    UDOUBLE Last_Use;
+} GUI_BMP_ASSET;
+
+static GUI_BMP_ASSET Bmp_Cache[GUI_BMP_CACHE_ENTRIES];
+static GUI_BMP_CACHE_STATS Bmp_Stats;
+static UDOUBLE Bmp_Use;
+
+/******************************************************************************
+function:	Convert one row of the file, Dst gets byte swapped RGB565
+parameter:
+    Dst     : Width pixels
+    Src     : first byte of the row in the file
+    Bits    : bits per pixel of a palette row
+    Palette : byte swapped colors of a palette row
+******************************************************************************/
+static void GUI_BmpRow(UWORD *Dst, const UBYTE *Src, UWORD Width, BMP_FORMAT Format,
+                       UWORD Bits, const UWORD *Palette)
+{
+    UWORD i, Color;
+
+    switch (Format) {
+    case BMP_FORMAT_PALETTE:
+        if (Bits == 8) {
+            for (i = 0; i < Width; i++)
+                Dst[i] = Palette[Src[i]];
+        } else if (Bits == 4) {
+            for (i = 0; i < Width; i++)
+                Dst[i] = Palette[(Src[i / 2] >> (i & 1 ? 0 : 4)) & 0x0f];
+        } else {
+            for (i = 0; i < Width; i++)
+                Dst[i] = Palette[(Src[i / 8] >> (7 - i % 8)) & 0x01];
+        }
+        break;
+    case BMP_FORMAT_RGB565:
+        for (i = 0; i < Width; i++)
+            Dst[i] = Src[2*i] << 8 | Src[2*i+1];
+        break;
+    case BMP_FORMAT_XRGB1555:
+        for (i = 0; i < Width; i++) {
+            Color = Src[2*i+1] << 8 | Src[2*i];
+            //Green from 5 to 6 bits, red moves up one bit
+            Color = (((Color >> 5) & 0x1f) * 0x3f / 0x1f) << 5 | (Color & 0x1f) | (Color & 0x7c00) << 1;
+            Dst[i] = PAINT_SWAP_COLOR(Color);
+        }
+        break;
+    case BMP_FORMAT_RGB888:
+        for (i = 0; i < Width; i++) {
+            Color = RGB(Src[3*i+2], Src[3*i+1], Src[3*i]);
+            Dst[i] = PAINT_SWAP_COLOR(Color);
+        }
+        break;
+    case BMP_FORMAT_XRGB8888:
+        for (i = 0; i < Width; i++) {
+            Color = RGB(Src[4*i+2], Src[4*i+1], Src[4*i]);
+            Dst[i] = PAINT_SWAP_COLOR(Color);
+        }
+        break;
+    }
+}
+
+/******************************************************************************
+function:	Decode a bitmap file in memory
+parameter:
+    File   : the whole file
+    Size   : bytes of the file
+    Width  : width of the bitmap
+    Height : height of the bitmap
+return:
+    Width * Height byte swapped pixels, top row first, NULL if the file is
+    not a supported bitmap
+******************************************************************************/
+static UWORD *GUI_DecodeBmp(const UBYTE *File, size_t Size, UWORD *Width, UWORD *Height)
+{
+    BMPFILEHEADER bmpFileHeader;
+    BMPINF bmpInfoHeader;
+    UWORD Palette[256];
+    BMP_FORMAT Format;
+    UDOUBLE Stride, Palette_Offset;
+    int32_t Rows;
+    UWORD Bits, Row, i;
+    UBYTE Top_Down = 0;
+    UWORD *Pixels;
+
+    if (Size < sizeof(BMPFILEHEADER) + sizeof(BMPINF)) {
+        DEBUG("GUI_DecodeBmp: file too short\r\n");
+        return NULL;
+    }
+    memcpy(&bmpFileHeader, File, sizeof(BMPFILEHEADER));
+    memcpy(&bmpInfoHeader, File + sizeof(BMPFILEHEADER), sizeof(BMPINF));
+    printf("bBitCount=%d \n", bmpInfoHeader.bBitCount);
+
+    //A negative height is a top-down bitmap
+    Rows = (int32_t)bmpInfoHeader.bHeight;
+    if (Rows < 0) {
+        Rows = -Rows;
+        Top_Down = 1;
+    }
+    if (bmpFileHeader.bType != 0x4D42 || bmpInfoHeader.bWidth == 0 || bmpInfoHeader.bWidth > 0xffff ||
+        Rows == 0 || Rows > 0xffff) {
+        DEBUG("GUI_DecodeBmp: not a bitmap\r\n");
+        return NULL;
+    }
+
+    Bits = bmpInfoHeader.bBitCount;
+    if (Bits == 1 || Bits == 4 || Bits == 8) {
+        Format = BMP_FORMAT_PALETTE;
+    } else if (Bits == 16 && bmpInfoHeader.bInfoSize == 0x38) {
+        //ARGB4444 format cannot be recognized for the time being. It can only be used to identify RGB565 format information!!
+        Format = BMP_FORMAT_RGB565;
+    } else if (Bits == 16 && bmpInfoHeader.bInfoSize == 0x28 && bmpInfoHeader.bCompression == 0x00) {
+        Format = BMP_FORMAT_XRGB1555;
+    } else if (Bits == 24) {
+        Format = BMP_FORMAT_RGB888;
+    } else if (Bits == 32) {
+        Format = BMP_FORMAT_XRGB8888;
+    } else {
+        DEBUG("GUI_DecodeBmp: %d bits per pixel is not supported\r\n", Bits);
+        return NULL;
+    }
+
+    //In Windows each row data must be divisible by 4 byte
+    Stride = ((UDOUBLE)bmpInfoHeader.bWidth * Bits + 31) / 32 * 4;
+    if (bmpFileHeader.bOffset > Size || (uint64_t)Stride * Rows > Size - bmpFileHeader.bOffset) {
+        DEBUG("GUI_DecodeBmp: file too short\r\n");
+        return NULL;
+    }
+
+    //The palette follows the info header, 4 bytes per color
+    if (Format == BMP_FORMAT_PALETTE) {
+        Palette_Offset = sizeof(BMPFILEHEADER) + bmpInfoHeader.bInfoSize;
+        for (i = 0; i < (1 << Bits); i++) {
+            const UBYTE *Quad = File + Palette_Offset + i * 4;
+            UWORD Color = 0;
+            if (Palette_Offset + i * 4 + sizeof(RGBQUAD) <= Size)
+                Color = RGB(Quad[2], Quad[1], Quad[0]);
+            Palette[i] = PAINT_SWAP_COLOR(Color);
+        }
+    }
+
+    *Width = bmpInfoHeader.bWidth;
+    *Height = Rows;
+    Pixels = (UWORD *)malloc((UDOUBLE)*Width * *Height * sizeof(UWORD));
+    if (Pixels == NULL) {
+        DEBUG("GUI_DecodeBmp: out of memory\r\n");
+        return NULL;
+    }
+
+    for (Row = 0; Row < *Height; Row++) {
+        UWORD Y = Top_Down ? Row : *Height - Row - 1;
+        GUI_BmpRow(Pixels + (UDOUBLE)Y * *Width, File + bmpFileHeader.bOffset + (UDOUBLE)Row * Stride,
+                   *Width, Format, Bits, Palette);
+    }
+
+    return Pixels;
+}
+
+/******************************************************************************
+function:	Map and decode a bitmap file
+parameter:
+    path   : file name
+    Width  : width of the bitmap
+    Height : height of the bitmap
+******************************************************************************/
+static UWORD *GUI_LoadBmp(const char *path, struct stat *St, UWORD *Width, UWORD *Height)
+{
+    UWORD *Pixels = NULL;
+    void *File;
+    int fd;
+
+    if ((fd = open(path, O_RDONLY)) < 0) {
+        DEBUG("Cann't open the file!\n");
+        return NULL;
+    }
+    printf("open:%s \n", path);
+
+    if (fstat(fd, St) != 0 || St->st_size == 0) {
+        close(fd);
+        return NULL;
+    }
+    File = mmap(NULL, St->st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (File == MAP_FAILED) {
+        perror("mmap bmp");
+        return NULL;
+    }
+
+    Pixels = GUI_DecodeBmp((const UBYTE *)File, St->st_size, Width, Height);
+    munmap(File, St->st_size);
+
+    return Pixels;
+}
+
+static void GUI_FreeBmpAsset(GUI_BMP_ASSET *Asset)
+{
+    if (Asset->Pixels != NULL)
+        Bmp_Stats.Bytes -= (UDOUBLE)Asset->Width * Asset->Height * sizeof(UWORD);
+    free(Asset->Path);
+    free(Asset->Pixels);
+    memset(Asset, 0, sizeof(GUI_BMP_ASSET));
+}
+
+//Keep a decoded bitmap, return 0 if the cache took it
+static UBYTE GUI_CacheBmp(const char *path, const struct stat *St, UWORD Width, UWORD Height, UWORD *Pixels)
+{
+    UDOUBLE Bytes = (UDOUBLE)Width * Height * sizeof(UWORD);
+    GUI_BMP_ASSET *Asset;
+    UWORD i;
+
+    if (Bytes > GUI_BMP_CACHE_MAX_BYTES)
+        return 1;
+
+    for (;;) {
+        GUI_BMP_ASSET *Oldest = NULL;
+        Asset = NULL;
+        for (i = 0; i < GUI_BMP_CACHE_ENTRIES; i++) {
+            if (Bmp_Cache[i].Path == NULL)
+                Asset = &Bmp_Cache[i];
+            else if (Oldest == NULL || Bmp_Cache[i].Last_Use < Oldest->Last_Use)
+                Oldest = &Bmp_Cache[i];
+        }
+        if (Asset != NULL && Bmp_Stats.Bytes + Bytes <= GUI_BMP_CACHE_MAX_BYTES)
+            break;
+        GUI_FreeBmpAsset(Oldest);
+    }
+
+    Asset->Path = strdup(path);
+    if (Asset->Path == NULL)
+        return 1;
+    Asset->Size = St->st_size;
+    Asset->Mtime = St->st_mtime;
+    Asset->Width = Width;
+    Asset->Height = Height;
+    Asset->Pixels = Pixels;
+    Asset->Last_Use = ++Bmp_Use;
+    Bmp_Stats.Bytes += Bytes;
+
+    return 0;
+}
+
+/******************************************************************************
+function:	Draw a bitmap file at the origin of the image
+parameter:
+    path : file name, 1, 4, 8 bit palette, RGB565, XRGB1555, RGB888 or
+           XRGB8888
+return:
+    0 if successful
+info:
+    A file which is unchanged since it was decoded is drawn from the cache.
+******************************************************************************/
 UBYTE GUI_ReadBmp(const char *path)
 {
-    FILE *fp;                     //Define a file pointer 
-    BMPFILEHEADER bmpFileHeader;  //Define a bmp file header structure
-    BMPINF bmpInfoHeader;         //Define a bmp bitmap header structure 
-	//UBYTE rgbReversed;
-    // Binary file open
-    if((fp = fopen(path, "rb")) == NULL) { 	// fp = 0x00426aa0
+    GUI_BMP_ASSET *Asset = NULL;
+    struct stat St;
+    UWORD Width, Height, i;
+    UWORD *Pixels;
+
+    if (stat(path, &St) != 0) {
         DEBUG("Cann't open the file!\n");
+        return 1;
+    }
+
+    for (i = 0; i < GUI_BMP_CACHE_ENTRIES; i++) {
+        if (Bmp_Cache[i].Path != NULL && strcmp(Bmp_Cache[i].Path, path) == 0) {
+            Asset = &Bmp_Cache[i];
+            break;
+        }
+    }
+    if (Asset != NULL && (Asset->Size != St.st_size || Asset->Mtime != St.st_mtime))
+        GUI_FreeBmpAsset(Asset);
+    else if (Asset != NULL) {
+        Bmp_Stats.Hits++;
+        Asset->Last_Use = ++Bmp_Use;
+        Paint_BlitRect(0, 0, Asset->Width, Asset->Height, Asset->Pixels, Asset->Width);
         return 0;
     }
-    printf("open:%s \n",path);
-    
-    fseek(fp, 0, SEEK_SET); 								//Set the file pointer from the beginning	
-    fread(&bmpFileHeader, sizeof(BMPFILEHEADER), 1, fp);	//Gets the BMP file header
-	fread(&bmpInfoHeader, sizeof(BMPINF), 1, fp);			//Gets BMP Info Header
-	printf("bBitCount=%d \n",bmpInfoHeader.bBitCount);		//Print a pixel takes several bit!!!
-	
-	
-	//Get palette information, Max 256 color information
-	//You can use the malloc function to reduce the memory required to run this program
-	/*
-			bBitCount	RGBPAD
-				1		   2
-				4		  16
-				8		 256
-	 */
-	RGBQUAD RGBPAD[256];	
-	if(bmpInfoHeader.bBitCount<16)
-	{	
-		
-		uint16_t i=0;
-		for(i=0;i<(1<<(bmpInfoHeader.bBitCount));i++)
-		{
-			fseek(fp,(0X36)+(i*4), SEEK_SET);
-			fread(&RGBPAD[i], sizeof(RGBQUAD), 1, fp);			
-		}
-	}
-	
-	//In Windows each row data must be divisible by 4 byte
-	//Calculate how many bytes per row of data need to be indented
-
-	int32_t  indent;
-	if(bmpInfoHeader.bBitCount<8)	indent=(4-((bmpInfoHeader.bWidth/(8/bmpInfoHeader.bBitCount))%4))%4;
-	else 							indent=(4-((bmpInfoHeader.bWidth*(bmpInfoHeader.bBitCount/8))%4))%4;
-	
-	
-	int 		row, col; 	
-    short 		data;			//All data formats are converted to RGB565 format
-	char		pixels,temp;		
-	int len  = 	bmpInfoHeader.bBitCount / 8;
-	ARGBQUAD 	argb;
-	/*
-	fseek(fp, bmpFileHeader.bOffset, SEEK_SET);
-	printf("frist add:0x%x \r\n",bmpFileHeader.bOffset);
-	printf("BMP height:%d\r\n",bmpInfoHeader.bHeight);
-	printf("BMP width :%d\r\n",bmpInfoHeader.bWidth);
-	*/
-	// get bmp data and show
-	for(row = 0; row < bmpInfoHeader.bHeight;row++) 
-	{		
-		for(col = 0; col < bmpInfoHeader.bWidth; ) 
-		{
-			if(bmpInfoHeader.bBitCount==16)
-			{
-				if(fread((char *)&data, 1, len, fp) != len)
-				{
-					perror("get bmpdata:\r\n");
-					break;
-				}  
-				//ARGB4444 format cannot be recognized for the time being. It can only be used to identify RGB565 format information!!
-				if(bmpInfoHeader.bInfoSize==0x38)
-				{	
-					Paint_SetPixel(col, bmpInfoHeader.bHeight - row - 1, data);
-				}
-				//Used to identify the XRGB1555 format
-				else if((bmpInfoHeader.bInfoSize==0x28)&&(bmpInfoHeader.bCompression==0x00))
-				{
-					data=((((long)((data>>5)&0x1f)*0X3F)/0X1F)<<5)+(data&0x1f)+((data&0xEC00)<<1);
-					Paint_SetPixel(col, bmpInfoHeader.bHeight - row - 1, data);
-				}
-				col++;
-			}
-			//For RGB888 ARGB8888 XRGB8888 format uniform compression and removal of alpha
-			else if(bmpInfoHeader.bBitCount>16)
-			{
-				if(fread((char *)&argb, 1, len, fp) != len)
-				{
-					printf("x:%d,y:%d\r\n",col,row);
-					perror("get bmpdata: \r\n");
-					break;
-				}
-				data = RGB((argb.rgbRed), (argb.rgbGreen), (argb.rgbBlue));
-				Paint_SetPixel(col, bmpInfoHeader.bHeight - row - 1, data);
-				col++;
-			}	
-			//bBitCount<8 format
-			else		
-			{
-				if(fread((char *)&pixels, 1, 1, fp) != 1)
-				{
-					perror("get bmpdata:\r\n");
-					break;
-				}
-				for(temp=0;(temp<(8/bmpInfoHeader.bBitCount))&&(col < bmpInfoHeader.bWidth);temp++,col++)
-				{
-					if(bmpInfoHeader.bBitCount==1){
-						data=(pixels<<temp)>>7;
-						data&=0x01;
-					}
-					else if(bmpInfoHeader.bBitCount==4){	
-						data=(pixels<<(temp*4))>>4;
-						data&=0x0f;					
-					}
-					else {data=pixels;}
-					data=RGB((RGBPAD[data].rgbRed), (RGBPAD[data].rgbGreen), (RGBPAD[data].rgbBlue));					
-					Paint_SetPixel(col, bmpInfoHeader.bHeight - row - 1, data);
-				}				
-			}	
-		}
-		//indent!4 byte alignment
-		fseek(fp, indent, SEEK_CUR);
-	}
-	
-	fclose(fp);
+
+    Bmp_Stats.Misses++;
+    Pixels = GUI_LoadBmp(path, &St, &Width, &Height);
+    if (Pixels == NULL)
+        return 1;
+
+    Paint_BlitRect(0, 0, Width, Height, Pixels, Width);
+
+    if (GUI_CacheBmp(path, &St, Width, Height, Pixels) != 0)
+        free(Pixels);
     return 0;
-}
\ No newline at end of file
+}
+
+/******************************************************************************
+function:	Free the decoded bitmaps and reset the statistics
+parameter:
+******************************************************************************/
+void GUI_ClearBmpCache(void)
+{
+    UWORD i;
+
+    for (i = 0; i < GUI_BMP_CACHE_ENTRIES; i++)
+        GUI_FreeBmpAsset(&Bmp_Cache[i]);
+    memset(&Bmp_Stats, 0, sizeof(Bmp_Stats));
+}
+
+/******************************************************************************
+function:	Get the bitmap cache statistics
+parameter:
+    Stats : hits and misses since GUI_ClearBmpCache(), memory in use
+******************************************************************************/
+void GUI_GetBmpCacheStats(GUI_BMP_CACHE_STATS *Stats)
+{
+    *Stats = Bmp_Stats;
+}
@@ -65,5 +65,20 @@ typedef struct ARGB_QUAD {
 } __attribute__ ((packed)) ARGBQUAD;
 /**************************************** end ***********************************************/
 
+/**
+ * Decoded bitmaps are kept by path, the least recently used ones are
+ * dropped when an entry or the memory runs out
+**/
+#define GUI_BMP_CACHE_ENTRIES       8
+#define GUI_BMP_CACHE_MAX_BYTES     (1024 * 1024)
+
+typedef struct {
+    UDOUBLE Hits;
+    UDOUBLE Misses;
+    UDOUBLE Bytes;                      //Memory held by the decoded bitmaps
+} GUI_BMP_CACHE_STATS;
+
 UBYTE GUI_ReadBmp(const char *path);
+void GUI_ClearBmpCache(void);
+void GUI_GetBmpCacheStats(GUI_BMP_CACHE_STATS *Stats);
 #endif
\ No newline at end of file
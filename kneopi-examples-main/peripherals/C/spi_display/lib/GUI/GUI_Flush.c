@@ -0,0 +1,222 @@
+/*****************************************************************************
+* | File      	:   GUI_Flush.c
+* | Function    :   Double-buffered asynchronous flush of the Paint image
+* | Info        :
+*   Paint_NewImage() must select Image0 before GUI_Flush_Init(), both
+*   buffers have the size of the Paint image. GUI_Flush_Submit() hands the
+*   current buffer and its dirty windows to the flush thread, copies it into
+*   the other buffer and selects that one for drawing the next frame. It
+*   only blocks when the previous frame is still being sent.
+*   Other LCD_* calls must not run while a frame is in flight, call
+*   GUI_Flush_Wait() first.
+*----------------
+* |	This version:   V1.0
+* | Date        :   2019-07-11
+* | Info        :
+*
+******************************************************************************/
+#include "GUI_Flush.h"
+
+#include <pthread.h>
+#include <string.h>
+#include <time.h>
+
+typedef struct {
+    UWORD *Image[2];
+    PAINT_DISPLAY_WINDOWS DisplayWindows;
+
+    pthread_t Thread;
+    pthread_mutex_t Mutex;
+    pthread_cond_t Start;
+    pthread_cond_t Done;
+    UBYTE Running;
+    UBYTE Busy;                         //A frame is in flight
+    UBYTE Exit;
+
+    //Frame in flight
+    UWORD *Job_Image;
+    PAINT_RECT Job_Dirty[PAINT_DIRTY_MAX];
+    UBYTE Job_Count;
+
+    GUI_FLUSH_STATS Stats;
+    double First_Submit_ms;
+} GUI_FLUSH;
+
+static GUI_FLUSH Flush;
+
+static double GUI_Flush_Now_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static void *GUI_Flush_Thread(void *arg)
+{
+    UBYTE i;
+
+    pthread_mutex_lock(&Flush.Mutex);
+    for (;;) {
+        while (!Flush.Busy && !Flush.Exit)
+            pthread_cond_wait(&Flush.Start, &Flush.Mutex);
+        if (!Flush.Busy)
+            break;
+        pthread_mutex_unlock(&Flush.Mutex);
+
+        double Start = GUI_Flush_Now_ms();
+        UDOUBLE Bytes = 0;
+        for (i = 0; i < Flush.Job_Count; i++) {
+            PAINT_RECT *Rect = &Flush.Job_Dirty[i];
+            Flush.DisplayWindows(Rect->Xstart, Rect->Ystart, Rect->Xend, Rect->Yend, Flush.Job_Image);
+            Bytes += (UDOUBLE)(Rect->Xend - Rect->Xstart) * (Rect->Yend - Rect->Ystart) * 2;
+        }
+        double End = GUI_Flush_Now_ms();
+
+        pthread_mutex_lock(&Flush.Mutex);
+        Flush.Stats.Frames++;
+        Flush.Stats.Bytes += Bytes;
+        Flush.Stats.Transfer_ms += End - Start;
+        Flush.Stats.Elapsed_ms = End - Flush.First_Submit_ms;
+        Flush.Busy = 0;
+        pthread_cond_broadcast(&Flush.Done);
+    }
+    pthread_mutex_unlock(&Flush.Mutex);
+
+    return NULL;
+}
+
+/******************************************************************************
+function:	Start the flush thread
+parameter:
+    Image0         : buffer selected by Paint_NewImage()
+    Image1         : second buffer of the same size
+    DisplayWindows : LCD_*_DisplayWindows() of the panel
+return:
+    0 if successful
+******************************************************************************/
+UBYTE GUI_Flush_Init(UWORD *Image0, UWORD *Image1, PAINT_DISPLAY_WINDOWS DisplayWindows)
+{
+    if (Flush.Running) {
+        DEBUG("GUI_Flush is already running\r\n");
+        return 1;
+    }
+    if (Image0 == NULL || Image1 == NULL || DisplayWindows == NULL || Paint.Image != Image0) {
+        DEBUG("GUI_Flush_Init: Paint must draw into Image0\r\n");
+        return 1;
+    }
+
+    memset(&Flush, 0, sizeof(Flush));
+    Flush.Image[0] = Image0;
+    Flush.Image[1] = Image1;
+    Flush.DisplayWindows = DisplayWindows;
+
+    pthread_mutex_init(&Flush.Mutex, NULL);
+    pthread_cond_init(&Flush.Start, NULL);
+    pthread_cond_init(&Flush.Done, NULL);
+    if (pthread_create(&Flush.Thread, NULL, GUI_Flush_Thread, NULL) != 0) {
+        DEBUG("GUI_Flush_Init: create flush thread failed\r\n");
+        pthread_cond_destroy(&Flush.Done);
+        pthread_cond_destroy(&Flush.Start);
+        pthread_mutex_destroy(&Flush.Mutex);
+        return 1;
+    }
+    Flush.Running = 1;
+
+    return 0;
+}
+
+/******************************************************************************
+function:	Send the dirty windows of the current frame in the background
+            and continue drawing in the other buffer
+parameter:
+******************************************************************************/
+void GUI_Flush_Submit(void)
+{
+    UWORD *Image = Paint.Image;
+    UWORD *Next;
+
+    if (!Flush.Running) {
+        //Synchronous after GUI_Flush_Exit()
+        if (Flush.DisplayWindows != NULL)
+            Paint_Flush(Flush.DisplayWindows);
+        return;
+    }
+    if (Paint.DirtyCount == 0)
+        return;
+
+    double Start = GUI_Flush_Now_ms();
+    pthread_mutex_lock(&Flush.Mutex);
+    while (Flush.Busy)
+        pthread_cond_wait(&Flush.Done, &Flush.Mutex);
+
+    if (Flush.Stats.Frames == 0)
+        Flush.First_Submit_ms = Start;
+    Flush.Stats.Wait_ms += GUI_Flush_Now_ms() - Start;
+
+    Flush.Job_Image = Image;
+    memcpy(Flush.Job_Dirty, Paint.Dirty, sizeof(PAINT_RECT) * Paint.DirtyCount);
+    Flush.Job_Count = Paint.DirtyCount;
+    Flush.Busy = 1;
+    pthread_cond_signal(&Flush.Start);
+    pthread_mutex_unlock(&Flush.Mutex);
+
+    //Both sides only read Image now, the next frame starts from its content
+    Next = (Image == Flush.Image[0]) ? Flush.Image[1] : Flush.Image[0];
+    memcpy(Next, Image, (size_t)Paint.WidthByte * Paint.HeightByte * sizeof(UWORD));
+    Paint.Image = Next;
+    Paint_ClearDirty();
+}
+
+/******************************************************************************
+function:	Wait until the frame in flight is sent
+parameter:
+******************************************************************************/
+void GUI_Flush_Wait(void)
+{
+    if (!Flush.Running)
+        return;
+
+    pthread_mutex_lock(&Flush.Mutex);
+    while (Flush.Busy)
+        pthread_cond_wait(&Flush.Done, &Flush.Mutex);
+    pthread_mutex_unlock(&Flush.Mutex);
+}
+
+/******************************************************************************
+function:	Get the flush statistics
+parameter:
+    Stats : statistics since GUI_Flush_Init()
+******************************************************************************/
+void GUI_Flush_GetStats(GUI_FLUSH_STATS *Stats)
+{
+    if (!Flush.Running) {
+        memset(Stats, 0, sizeof(*Stats));
+        return;
+    }
+
+    pthread_mutex_lock(&Flush.Mutex);
+    *Stats = Flush.Stats;
+    pthread_mutex_unlock(&Flush.Mutex);
+}
+
+/******************************************************************************
+function:	Send the frame in flight and stop the flush thread, Paint keeps
+            drawing into the buffer it currently selects
+parameter:
+******************************************************************************/
+void GUI_Flush_Exit(void)
+{
+    if (!Flush.Running)
+        return;
+
+    pthread_mutex_lock(&Flush.Mutex);
+    Flush.Exit = 1;
+    pthread_cond_signal(&Flush.Start);
+    pthread_mutex_unlock(&Flush.Mutex);
+    pthread_join(Flush.Thread, NULL);
+
+    pthread_cond_destroy(&Flush.Done);
+    pthread_cond_destroy(&Flush.Start);
+    pthread_mutex_destroy(&Flush.Mutex);
+    Flush.Running = 0;
+}
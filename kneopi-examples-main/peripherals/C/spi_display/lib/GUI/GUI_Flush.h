@@ -0,0 +1,36 @@
+/*****************************************************************************
+* | File      	:   GUI_Flush.h
+* | Function    :   Double-buffered asynchronous flush of the Paint image
+* | Info        :
+*   A background thread sends the dirty windows of one frame buffer through
+*   LCD_*_DisplayWindows() while the next frame is drawn into the other one,
+*   so drawing overlaps the SPI transfer.
+*----------------
+* |	This version:   V1.0
+* | Date        :   2019-07-11
+* | Info        :
+*
+******************************************************************************/
+#ifndef __GUI_FLUSH_H
+#define __GUI_FLUSH_H
+
+#include "GUI_Paint.h"
+
+/**
+ * Flush statistics
+**/
+typedef struct {
+    UDOUBLE Frames;         //Submitted frames which had dirty windows
+    UDOUBLE Bytes;          //Pixel data sent
+    double Transfer_ms;     //Time spent in LCD_*_DisplayWindows()
+    double Wait_ms;         //Time GUI_Flush_Submit() waited for the previous frame
+    double Elapsed_ms;      //From the first submit to the end of the last transfer
+} GUI_FLUSH_STATS;
+
+UBYTE GUI_Flush_Init(UWORD *Image0, UWORD *Image1, PAINT_DISPLAY_WINDOWS DisplayWindows);
+void GUI_Flush_Submit(void);
+void GUI_Flush_Wait(void);
+void GUI_Flush_GetStats(GUI_FLUSH_STATS *Stats);
+void GUI_Flush_Exit(void);
+
+#endif
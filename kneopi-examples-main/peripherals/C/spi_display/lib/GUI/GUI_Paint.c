@@ -43,6 +43,54 @@
 
 PAINT Paint;
 
+/******************************************************************************
+function: Precompute the transform of Rotate and Mirror, a point (x, y) of
+          the rotated and mirrored image is at memory (X, Y):
+    X = MapX0 + x * MapXx + y * MapXy
+    Y = MapY0 + x * MapYx + y * MapYy
+******************************************************************************/
+static void Paint_UpdateTransform(void)
+{
+    int32_t Xmax = Paint.WidthMemory - 1, Ymax = Paint.HeightMemory - 1;
+
+    switch(Paint.Rotate) {
+    case ROTATE_90:
+        Paint.MapX0 = Xmax; Paint.MapXx = 0;  Paint.MapXy = -1;
+        Paint.MapY0 = 0;    Paint.MapYx = 1;  Paint.MapYy = 0;
+        break;
+    case ROTATE_180:
+        Paint.MapX0 = Xmax; Paint.MapXx = -1; Paint.MapXy = 0;
+        Paint.MapY0 = Ymax; Paint.MapYx = 0;  Paint.MapYy = -1;
+        break;
+    case ROTATE_270:
+        Paint.MapX0 = 0;    Paint.MapXx = 0;  Paint.MapXy = 1;
+        Paint.MapY0 = Ymax; Paint.MapYx = -1; Paint.MapYy = 0;
+        break;
+    default:
+        Paint.MapX0 = 0;    Paint.MapXx = 1;  Paint.MapXy = 0;
+        Paint.MapY0 = 0;    Paint.MapYx = 0;  Paint.MapYy = 1;
+        break;
+    }
+
+    if(Paint.Mirror & MIRROR_HORIZONTAL) {
+        Paint.MapX0 = Xmax - Paint.MapX0;
+        Paint.MapXx = -Paint.MapXx;
+        Paint.MapXy = -Paint.MapXy;
+    }
+    if(Paint.Mirror & MIRROR_VERTICAL) {
+        Paint.MapY0 = Ymax - Paint.MapY0;
+        Paint.MapYx = -Paint.MapYx;
+        Paint.MapYy = -Paint.MapYy;
+    }
+}
+
+static inline UDOUBLE Paint_MapAddr(UWORD Xpoint, UWORD Ypoint)
+{
+    int32_t X = Paint.MapX0 + Xpoint * Paint.MapXx + Ypoint * Paint.MapXy;
+    int32_t Y = Paint.MapY0 + Xpoint * Paint.MapYx + Ypoint * Paint.MapYy;
+    return (UDOUBLE)X + (UDOUBLE)Y * Paint.WidthByte;
+}
+
 /******************************************************************************
 function: Create Image
 parameter:
@@ -75,6 +123,10 @@ void Paint_NewImage(UWORD *image, UWORD Width, UWORD Height, UWORD Rotate, UWORD
         Paint.Width = Height;
         Paint.Height = Width;
     }
+    Paint_UpdateTransform();
+
+    Paint_ClearDirty();
+    Paint_SetDirty(0, 0, Paint.Width, Paint.Height);
 }
 
 /******************************************************************************
@@ -85,6 +137,9 @@ parameter:
 void Paint_SelectImage(UWORD *image)
 {
     Paint.Image = image;
+
+    Paint_ClearDirty();
+    Paint_SetDirty(0, 0, Paint.Width, Paint.Height);
 }
 
 /******************************************************************************
@@ -104,6 +159,7 @@ void Paint_SetRotate(UWORD Rotate)
         Paint.Width = Paint.HeightMemory;
         Paint.Height = Paint.WidthMemory;
     }
+    Paint_UpdateTransform();
     } else {
         DEBUG("rotate = 0, 90, 180, 270\r\n");
     }
@@ -120,12 +176,143 @@ void Paint_SetMirroring(UBYTE mirror)
         mirror == MIRROR_VERTICAL || mirror == MIRROR_ORIGIN) {
         DEBUG("mirror image x:%s, y:%s\r\n",(mirror & 0x01)? "mirror":"none", ((mirror >> 1) & 0x01)? "mirror":"none");
         Paint.Mirror = mirror;
+        Paint_UpdateTransform();
     } else {
         DEBUG("mirror should be MIRROR_NONE, MIRROR_HORIZONTAL, \
         MIRROR_VERTICAL or MIRROR_ORIGIN\r\n");
     }    
 }
 
+/******************************************************************************
+function: Dirty rectangle bookkeeping, in memory coordinates
+info:
+    Pixels are accumulated into at most PAINT_DIRTY_MAX rectangles. A pixel
+    or rectangle is merged into an existing one when the merged rectangle
+    adds at most PAINT_DIRTY_MERGE_SLACK clean pixels, which costs less than
+    the commands and the extra SPI transfers of a separate window.
+******************************************************************************/
+static UDOUBLE Paint_RectArea(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend)
+{
+    return (UDOUBLE)(Xend - Xstart) * (Yend - Ystart);
+}
+
+static UDOUBLE Paint_UnionArea(const PAINT_RECT *A, const PAINT_RECT *B)
+{
+    return Paint_RectArea(A->Xstart < B->Xstart ? A->Xstart : B->Xstart,
+                          A->Ystart < B->Ystart ? A->Ystart : B->Ystart,
+                          A->Xend > B->Xend ? A->Xend : B->Xend,
+                          A->Yend > B->Yend ? A->Yend : B->Yend);
+}
+
+static void Paint_UnionRect(PAINT_RECT *A, const PAINT_RECT *B)
+{
+    if(B->Xstart < A->Xstart) A->Xstart = B->Xstart;
+    if(B->Ystart < A->Ystart) A->Ystart = B->Ystart;
+    if(B->Xend > A->Xend) A->Xend = B->Xend;
+    if(B->Yend > A->Yend) A->Yend = B->Yend;
+}
+
+static void Paint_RemoveDirty(UBYTE Index)
+{
+    Paint.DirtyCount--;
+    Paint.Dirty[Index] = Paint.Dirty[Paint.DirtyCount];
+    if(Paint.DirtyLast >= Paint.DirtyCount)
+        Paint.DirtyLast = 0;
+}
+
+//Clean pixels added by merging rectangle A and B
+static UDOUBLE Paint_MergeCost(const PAINT_RECT *A, const PAINT_RECT *B)
+{
+    UDOUBLE Union = Paint_UnionArea(A, B);
+    UDOUBLE Sum = Paint_RectArea(A->Xstart, A->Ystart, A->Xend, A->Yend) +
+                  Paint_RectArea(B->Xstart, B->Ystart, B->Xend, B->Yend);
+    return Union > Sum ? Union - Sum : 0;
+}
+
+//Rectangle Index has grown, absorb the rectangles which are now cheap to merge
+static void Paint_MergeDirty(UBYTE Index)
+{
+    UBYTE i = 0;
+    while(i < Paint.DirtyCount) {
+        if(i != Index && Paint_MergeCost(&Paint.Dirty[Index], &Paint.Dirty[i]) <= PAINT_DIRTY_MERGE_SLACK) {
+            Paint_UnionRect(&Paint.Dirty[Index], &Paint.Dirty[i]);
+            if(Index == Paint.DirtyCount - 1)
+                Index = i;
+            Paint_RemoveDirty(i);
+            i = 0;
+        } else {
+            i++;
+        }
+    }
+    Paint.DirtyLast = Index;
+}
+
+static void Paint_AddDirty(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend)
+{
+    PAINT_RECT Rect = {Xstart, Ystart, Xend, Yend};
+    PAINT_RECT *Last = &Paint.Dirty[Paint.DirtyLast];
+    UDOUBLE Cost, Best_Cost = PAINT_DIRTY_MERGE_SLACK + 1;
+    UBYTE i, j, Best_i = 0, Best_j = 0;
+
+    if(Xstart >= Xend || Ystart >= Yend)
+        return;
+
+    //Consecutive pixels of a primitive usually land in the same rectangle
+    if(Paint.DirtyCount > 0 &&
+       Xstart >= Last->Xstart && Xend <= Last->Xend && Ystart >= Last->Ystart && Yend <= Last->Yend)
+        return;
+
+    for(i = 0; i < Paint.DirtyCount; i++) {
+        Cost = Paint_MergeCost(&Paint.Dirty[i], &Rect);
+        if(Cost < Best_Cost) {
+            Best_Cost = Cost;
+            Best_i = i;
+        }
+    }
+    if(Best_Cost <= PAINT_DIRTY_MERGE_SLACK) {
+        Paint_UnionRect(&Paint.Dirty[Best_i], &Rect);
+        Paint_MergeDirty(Best_i);
+        return;
+    }
+
+    if(Paint.DirtyCount == PAINT_DIRTY_MAX) {
+        //Full, merge the closest pair to make room
+        Best_Cost = (UDOUBLE)-1;
+        for(i = 0; i < Paint.DirtyCount; i++) {
+            for(j = i + 1; j < Paint.DirtyCount; j++) {
+                Cost = Paint_MergeCost(&Paint.Dirty[i], &Paint.Dirty[j]);
+                if(Cost < Best_Cost) {
+                    Best_Cost = Cost;
+                    Best_i = i;
+                    Best_j = j;
+                }
+            }
+        }
+        Paint_UnionRect(&Paint.Dirty[Best_i], &Paint.Dirty[Best_j]);
+        Paint_RemoveDirty(Best_j);
+        Paint_MergeDirty(Best_i);
+    }
+
+    Paint.Dirty[Paint.DirtyCount] = Rect;
+    Paint.DirtyLast = Paint.DirtyCount;
+    Paint.DirtyCount++;
+}
+
+/******************************************************************************
+function: Map a point of the rotated and mirrored image to the memory
+parameter:
+    Xpoint : At point X
+    Ypoint : At point Y
+    X      : X in memory
+    Y      : Y in memory
+******************************************************************************/
+static UBYTE Paint_MapPoint(UWORD Xpoint, UWORD Ypoint, UWORD *X, UWORD *Y)
+{
+    *X = Paint.MapX0 + Xpoint * Paint.MapXx + Ypoint * Paint.MapXy;
+    *Y = Paint.MapY0 + Xpoint * Paint.MapYx + Ypoint * Paint.MapYy;
+    return 0;
+}
+
 /******************************************************************************
 function: Draw Pixels
 parameter:
@@ -135,56 +322,14 @@ parameter:
 ******************************************************************************/
 void Paint_SetPixel(UWORD Xpoint, UWORD Ypoint, UWORD Color)
 {
-    if(Xpoint > Paint.Width || Ypoint > Paint.Height){
+    if(Xpoint >= Paint.Width || Ypoint >= Paint.Height){
        // DEBUG("Exceeding display boundaries\r\n");
         return;
     }      
     UWORD X, Y;
 
-    switch(Paint.Rotate) {
-    case 0:
-        X = Xpoint;
-        Y = Ypoint;  
-        break;
-    case 90:
-        X = Paint.WidthMemory - Ypoint - 1;
-        Y = Xpoint;
-        break;
-    case 180:
-        X = Paint.WidthMemory - Xpoint - 1;
-        Y = Paint.HeightMemory - Ypoint - 1;
-        break;
-    case 270:
-        X = Ypoint;
-        Y = Paint.HeightMemory - Xpoint - 1;
-        break;
-    default:
-        return;
-    }
-    
-    switch(Paint.Mirror) {
-    case MIRROR_NONE:
-        break;
-    case MIRROR_HORIZONTAL:
-        X = Paint.WidthMemory - X - 1;
-        break;
-    case MIRROR_VERTICAL:
-        Y = Paint.HeightMemory - Y - 1;
-        break;
-    case MIRROR_ORIGIN:
-        X = Paint.WidthMemory - X - 1;
-        Y = Paint.HeightMemory - Y - 1;
-        break;
-    default:
-        return;
-    }
+    Paint_MapPoint(Xpoint, Ypoint, &X, &Y);
 
-    if(X > Paint.WidthMemory || Y > Paint.HeightMemory){
-        DEBUG("Exceeding display boundaries\r\n");
-        return;
-    }
-    
-    
     if(Paint.Depth == 1){
         UDOUBLE Addr = X / 8 + Y * Paint.WidthByte;
         UBYTE Rdata = Paint.Image[Addr];
@@ -193,10 +338,216 @@ void Paint_SetPixel(UWORD Xpoint, UWORD Ypoint, UWORD Color)
         else
             Paint.Image[Addr] = Rdata | (0x80 >> (X % 8));
     } else {
-        Color = ((Color<<8)&0xff00)|(Color>>8);
+        Color = PAINT_SWAP_COLOR(Color);
         UDOUBLE Addr = X  + Y * Paint.WidthByte;
+        //Redrawing an unchanged pixel does not need a refresh
+        if(Paint.Image[Addr] == Color)
+            return;
         Paint.Image[Addr] = Color;
     }
+    Paint_AddDirty(X, Y, X + 1, Y + 1);
+}
+
+/******************************************************************************
+function: Span fills and blits of a 16-bit image
+info:
+    A rectangle of the rotated and mirrored image is a rectangle in memory,
+    so fills run along memory rows whatever Rotate and Mirror are. Pixels
+    which already have the color are skipped and only the changed ones are
+    marked dirty.
+******************************************************************************/
+//Fill Count pixels with a byte swapped color at memset/memcpy speed
+static void Paint_FillWords(UWORD *Dst, UWORD Color, UDOUBLE Count)
+{
+    UDOUBLE Done = 1, Len;
+
+    if((Color >> 8) == (Color & 0xff)) {
+        memset(Dst, Color & 0xff, Count * 2);
+        return;
+    }
+
+    Dst[0] = Color;
+    while(Done < Count) {
+        Len = Done < Count - Done ? Done : Count - Done;
+        memcpy(Dst + Done, Dst, Len * 2);
+        Done += Len;
+    }
+}
+
+//Fill a window of the memory with a byte swapped color
+static void Paint_FillMemory(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD Color)
+{
+    UWORD Dirty_Xstart = Xend, Dirty_Ystart = Yend, Dirty_Xend = Xstart, Dirty_Yend = Ystart;
+    UWORD Y, First, Last;
+
+    for(Y = Ystart; Y < Yend; Y++) {
+        UWORD *Row = Paint.Image + (UDOUBLE)Y * Paint.WidthByte;
+
+        for(First = Xstart; First < Xend && Row[First] == Color; First++);
+        if(First == Xend)
+            continue;
+        for(Last = Xend; Row[Last - 1] == Color; Last--);
+
+        Paint_FillWords(Row + First, Color, Last - First);
+
+        if(First < Dirty_Xstart) Dirty_Xstart = First;
+        if(Last > Dirty_Xend) Dirty_Xend = Last;
+        if(Y < Dirty_Ystart) Dirty_Ystart = Y;
+        Dirty_Yend = Y + 1;
+    }
+
+    Paint_AddDirty(Dirty_Xstart, Dirty_Ystart, Dirty_Xend, Dirty_Yend);
+}
+
+//Fill a window of the image, the window may be partly outside of it
+static void Paint_FillClipped(int32_t Xstart, int32_t Ystart, int32_t Xend, int32_t Yend, UWORD Color)
+{
+    UWORD X0, Y0, X1, Y1;
+
+    if(Xstart < 0) Xstart = 0;
+    if(Ystart < 0) Ystart = 0;
+    if(Xend > Paint.Width) Xend = Paint.Width;
+    if(Yend > Paint.Height) Yend = Paint.Height;
+    if(Xstart >= Xend || Ystart >= Yend)
+        return;
+
+    if(Paint.Depth != 16) {
+        UWORD X, Y;
+        for(Y = Ystart; Y < Yend; Y++)
+            for(X = Xstart; X < Xend; X++)
+                Paint_SetPixel(X, Y, Color);
+        return;
+    }
+
+    Paint_MapPoint(Xstart, Ystart, &X0, &Y0);
+    Paint_MapPoint(Xend - 1, Yend - 1, &X1, &Y1);
+    Paint_FillMemory(X0 < X1 ? X0 : X1, Y0 < Y1 ? Y0 : Y1,
+                     (X0 > X1 ? X0 : X1) + 1, (Y0 > Y1 ? Y0 : Y1) + 1, PAINT_SWAP_COLOR(Color));
+}
+
+/******************************************************************************
+function: Copy a window of pixels into the image
+parameter:
+    Pixels : first pixel, 2 bytes each
+    Stride : bytes between two rows of Pixels
+    Swap   : 1 if Pixels are little endian RGB565, 0 if they are byte swapped
+******************************************************************************/
+static void Paint_Blit(UWORD Xstart, UWORD Ystart, UWORD Width, UWORD Height,
+                       const UBYTE *Pixels, UDOUBLE Stride, UBYTE Swap)
+{
+    UWORD Dirty_Xstart = Width, Dirty_Ystart = Height, Dirty_Xend = 0, Dirty_Yend = 0;
+    UWORD i, j, First, Last;
+
+    if(Xstart >= Paint.Width || Ystart >= Paint.Height)
+        return;
+    if(Width > Paint.Width - Xstart) Width = Paint.Width - Xstart;
+    if(Height > Paint.Height - Ystart) Height = Paint.Height - Ystart;
+
+    if(Paint.Depth != 16) {
+        for(j = 0; j < Height; j++) {
+            const UBYTE *Src = Pixels + j * Stride;
+            for(i = 0; i < Width; i++)
+                Paint_SetPixel(Xstart + i, Ystart + j, Swap ? Src[2*i+1] << 8 | Src[2*i] : Src[2*i] << 8 | Src[2*i+1]);
+        }
+        return;
+    }
+
+    //Memory step of one pixel along a row of the window
+    int32_t Step = Paint.MapXx + Paint.MapYx * (int32_t)Paint.WidthByte;
+
+    for(j = 0; j < Height; j++) {
+        const UBYTE *Src = Pixels + j * Stride;
+        UWORD *Dst = Paint.Image + Paint_MapAddr(Xstart, Ystart + j);
+
+        First = Width;
+        Last = 0;
+        if(Step == 1 && !Swap) {
+            const UBYTE *Row = (const UBYTE *)Dst;
+            if(memcmp(Row, Src, Width * 2) == 0)
+                continue;
+            for(First = 0; Row[2*First] == Src[2*First] && Row[2*First+1] == Src[2*First+1]; First++);
+            for(Last = Width; Row[2*Last-2] == Src[2*Last-2] && Row[2*Last-1] == Src[2*Last-1]; Last--);
+            memcpy(Dst + First, Src + 2 * First, (Last - First) * 2);
+        } else {
+            UWORD *Pixel = Dst;
+            for(i = 0; i < Width; i++, Pixel += Step) {
+                UWORD Color = Swap ? Src[2*i] << 8 | Src[2*i+1] : Src[2*i+1] << 8 | Src[2*i];
+                if(*Pixel != Color) {
+                    *Pixel = Color;
+                    if(i < First) First = i;
+                    Last = i + 1;
+                }
+            }
+            if(First == Width)
+                continue;
+        }
+
+        if(First < Dirty_Xstart) Dirty_Xstart = First;
+        if(Last > Dirty_Xend) Dirty_Xend = Last;
+        if(j < Dirty_Ystart) Dirty_Ystart = j;
+        Dirty_Yend = j + 1;
+    }
+
+    if(Dirty_Xstart < Dirty_Xend)
+        Paint_SetDirty(Xstart + Dirty_Xstart, Ystart + Dirty_Ystart, Xstart + Dirty_Xend, Ystart + Dirty_Yend);
+}
+
+/******************************************************************************
+function: Fill a window
+parameter:
+    Xstart : x starting point
+    Ystart : Y starting point
+    Xend   : x end point, exclusive
+    Yend   : y end point, exclusive
+    Color  : Painted colors
+******************************************************************************/
+void Paint_FillRect(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD Color)
+{
+    Paint_FillClipped(Xstart, Ystart, Xend, Yend, Color);
+}
+
+/******************************************************************************
+function: Draw a horizontal span
+parameter:
+    Xstart : x starting point
+    Xend   : x end point, exclusive
+    Ypoint : Y coordinate
+    Color  : Painted colors
+******************************************************************************/
+void Paint_DrawSpanH(UWORD Xstart, UWORD Xend, UWORD Ypoint, UWORD Color)
+{
+    Paint_FillClipped(Xstart, Ypoint, Xend, Ypoint + 1, Color);
+}
+
+/******************************************************************************
+function: Draw a vertical span
+parameter:
+    Xpoint : X coordinate
+    Ystart : Y starting point
+    Yend   : y end point, exclusive
+    Color  : Painted colors
+******************************************************************************/
+void Paint_DrawSpanV(UWORD Xpoint, UWORD Ystart, UWORD Yend, UWORD Color)
+{
+    Paint_FillClipped(Xpoint, Ystart, Xpoint + 1, Yend, Color);
+}
+
+/******************************************************************************
+function: Copy a window of byte swapped pixels into the image
+parameter:
+    Xstart : x starting point
+    Ystart : Y starting point
+    Width  : width of the window
+    Height : height of the window
+    Pixels : first pixel, in the order of the image, see PAINT_SWAP_COLOR()
+    Stride : pixels between two rows of Pixels
+info:
+    Rows are copied with memcpy() when Rotate and Mirror keep them in
+    memory order.
+******************************************************************************/
+void Paint_BlitRect(UWORD Xstart, UWORD Ystart, UWORD Width, UWORD Height, const UWORD *Pixels, UWORD Stride)
+{
+    Paint_Blit(Xstart, Ystart, Width, Height, (const UBYTE *)Pixels, (UDOUBLE)Stride * 2, 0);
 }
 
 /******************************************************************************
@@ -206,12 +557,27 @@ parameter:
 ******************************************************************************/
 void Paint_Clear(UWORD Color)
 {
+    if(Paint.Depth == 16) {
+        Paint_FillMemory(0, 0, Paint.WidthByte, Paint.HeightByte, PAINT_SWAP_COLOR(Color));
+        return;
+    }
+
+    UWORD Xstart = Paint.WidthByte, Ystart = Paint.HeightByte, Xend = 0, Yend = 0;
+
     for (UWORD Y = 0; Y < Paint.HeightByte; Y++) {
         for (UWORD X = 0; X < Paint.WidthByte; X++ ) {//8 pixel =  1 byte
             UDOUBLE Addr = X + Y*Paint.WidthByte;
-            Paint.Image[Addr] = Color;
+            if (Paint.Image[Addr] != Color) {
+                Paint.Image[Addr] = Color;
+                if (X < Xstart) Xstart = X;
+                if (X >= Xend) Xend = X + 1;
+                if (Y < Ystart) Ystart = Y;
+                Yend = Y + 1;
+            }
         }
     }
+
+    Paint_AddDirty(Xstart, Ystart, Xend, Yend);
 }
 
 /******************************************************************************
@@ -225,12 +591,7 @@ parameter:
 ******************************************************************************/
 void Paint_ClearWindow(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD Color)
 {
-    UWORD X, Y;
-    for (Y = Ystart; Y < Yend; Y++) {
-        for (X = Xstart; X < Xend; X++) {//8 pixel =  1 byte
-            Paint_SetPixel(X, Y, Color);
-        }
-    }
+    Paint_FillClipped(Xstart, Ystart, Xend, Yend, Color);
 }
 
 /******************************************************************************
@@ -252,15 +613,9 @@ void Paint_DrawPoint(UWORD Xpoint, UWORD Ypoint, UWORD Color,
 
     int16_t XDir_Num , YDir_Num;
     if (Dot_Style == DOT_FILL_AROUND) {
-        for (XDir_Num = 0; XDir_Num < 2 * Dot_Pixel - 1; XDir_Num++) {
-            for (YDir_Num = 0; YDir_Num < 2 * Dot_Pixel - 1; YDir_Num++) {
-                if(Xpoint + XDir_Num - Dot_Pixel < 0 || Ypoint + YDir_Num - Dot_Pixel < 0)
-                    break;
-				//DEBUG("Paint_DrawPoint x:%d y:%d color:0x%x\r\n",Xpoint + XDir_Num - Dot_Pixel, Ypoint + YDir_Num - Dot_Pixel,Color);
-                //printf("x = %d, y = %d\r\n", Xpoint + XDir_Num - Dot_Pixel, Ypoint + YDir_Num - Dot_Pixel);
-                Paint_SetPixel(Xpoint + XDir_Num - Dot_Pixel, Ypoint + YDir_Num - Dot_Pixel, Color);
-            }
-        }
+        //The square around the point, the part outside of the image is clipped
+        int32_t Size = Dot_Pixel;
+        Paint_FillClipped(Xpoint - Size, Ypoint - Size, Xpoint + Size - 1, Ypoint + Size - 1, Color);
     } else {
         for (XDir_Num = 0; XDir_Num <  Dot_Pixel; XDir_Num++) {
             for (YDir_Num = 0; YDir_Num <  Dot_Pixel; YDir_Num++) {
@@ -292,6 +647,15 @@ void Paint_DrawLine(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend,
         return;
     }
 
+    //Horizontal and vertical lines are spans of points, see Paint_DrawPoint()
+    if (Line_Style == LINE_STYLE_SOLID && (Xstart == Xend || Ystart == Yend)) {
+        int32_t X0 = Xstart < Xend ? Xstart : Xend, X1 = Xstart < Xend ? Xend : Xstart;
+        int32_t Y0 = Ystart < Yend ? Ystart : Yend, Y1 = Ystart < Yend ? Yend : Ystart;
+        int32_t Size = Line_width;
+        Paint_FillClipped(X0 - Size, Y0 - Size, X1 + Size - 1, Y1 + Size - 1, Color);
+        return;
+    }
+
     UWORD Xpoint = Xstart;
     UWORD Ypoint = Ystart;
     int dx = (int)Xend - (int)Xstart >= 0 ? Xend - Xstart : Xstart - Xend;
@@ -351,10 +715,11 @@ void Paint_DrawRectangle(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend,
     }
 
     if (Draw_Fill) {
-        UWORD Ypoint;
-        for(Ypoint = Ystart; Ypoint < Yend; Ypoint++) {
-            Paint_DrawLine(Xstart, Ypoint, Xend, Ypoint, Color , Line_width, LINE_STYLE_SOLID);
-        }
+        //Same pixels as a horizontal line for each Ypoint from Ystart to Yend - 1
+        int32_t X0 = Xstart < Xend ? Xstart : Xend, X1 = Xstart < Xend ? Xend : Xstart;
+        int32_t Size = Line_width;
+        if (Ystart < Yend)
+            Paint_FillClipped(X0 - Size, Ystart - Size, X1 + Size - 1, Yend + Size - 2, Color);
     } else {
         Paint_DrawLine(Xstart, Ystart, Xend, Ystart, Color, Line_width, LINE_STYLE_SOLID);
         Paint_DrawLine(Xstart, Ystart, Xstart, Yend, Color, Line_width, LINE_STYLE_SOLID);
@@ -390,19 +755,18 @@ void Paint_DrawCircle(UWORD X_Center, UWORD Y_Center, UWORD Radius,
     //Cumulative error,judge the next point of the logo
     int16_t Esp = 3 - (Radius << 1 );
 
-    int16_t sCountY;
     if (Draw_Fill == DRAW_FILL_FULL) {
+        //The 8 octants are spans, points are drawn up and left of (x, y), see Paint_DrawPoint()
+        int32_t X = X_Center - 1, Y = Y_Center - 1;
         while (XCurrent <= YCurrent ) { //Realistic circles
-            for (sCountY = XCurrent; sCountY <= YCurrent; sCountY ++ ) {
-                Paint_DrawPoint(X_Center + XCurrent, Y_Center + sCountY, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);//1
-                Paint_DrawPoint(X_Center - XCurrent, Y_Center + sCountY, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);//2
-                Paint_DrawPoint(X_Center - sCountY, Y_Center + XCurrent, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);//3
-                Paint_DrawPoint(X_Center - sCountY, Y_Center - XCurrent, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);//4
-                Paint_DrawPoint(X_Center - XCurrent, Y_Center - sCountY, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);//5
-                Paint_DrawPoint(X_Center + XCurrent, Y_Center - sCountY, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);//6
-                Paint_DrawPoint(X_Center + sCountY, Y_Center - XCurrent, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);//7
-                Paint_DrawPoint(X_Center + sCountY, Y_Center + XCurrent, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);
-            }
+            Paint_FillClipped(X + XCurrent, Y + XCurrent, X + XCurrent + 1, Y + YCurrent + 1, Color);//1
+            Paint_FillClipped(X - XCurrent, Y + XCurrent, X - XCurrent + 1, Y + YCurrent + 1, Color);//2
+            Paint_FillClipped(X - YCurrent, Y + XCurrent, X - XCurrent + 1, Y + XCurrent + 1, Color);//3
+            Paint_FillClipped(X - YCurrent, Y - XCurrent, X - XCurrent + 1, Y - XCurrent + 1, Color);//4
+            Paint_FillClipped(X - XCurrent, Y - YCurrent, X - XCurrent + 1, Y - XCurrent + 1, Color);//5
+            Paint_FillClipped(X + XCurrent, Y - YCurrent, X + XCurrent + 1, Y - XCurrent + 1, Color);//6
+            Paint_FillClipped(X + XCurrent, Y - XCurrent, X + YCurrent + 1, Y - XCurrent + 1, Color);//7
+            Paint_FillClipped(X + XCurrent, Y + XCurrent, X + YCurrent + 1, Y + XCurrent + 1, Color);//0
             if (Esp < 0 )
                 Esp += 4 * XCurrent + 6;
             else {
@@ -433,6 +797,287 @@ void Paint_DrawCircle(UWORD X_Center, UWORD Y_Center, UWORD Radius,
     }
 }
 
+/******************************************************************************
+function: Glyph cache
+info:
+    A glyph is rasterized once for a color pair and an orientation into a
+    tile in memory order, then drawn with one compare and memcpy() per row.
+    With the FONT_BACKGROUND background a glyph keeps the pixels under it,
+    so its tile holds the foreground runs of each row instead. The cache is
+    2-way set associative, a new glyph replaces the least recently used one
+    of its set. Glyphs partly outside of the image and images other than
+    16-bit are drawn pixel by pixel.
+******************************************************************************/
+typedef struct {
+    const UBYTE *Bitmap;                //Key: glyph, colors and orientation
+    UWORD Width;
+    UWORD Height;
+    UWORD Foreground;
+    UWORD Background;
+    UBYTE Orient;
+    UWORD Tile_Width;                   //In memory
+    UWORD Tile_Height;
+    UWORD Offset_X;                     //Glyph origin in the tile
+    UWORD Offset_Y;
+    UWORD *Tile;                        //Byte swapped pixels, or Y, Xstart, Xend of each run
+    UDOUBLE Size;                       //Words of Tile
+} PAINT_GLYPH;
+
+static PAINT_GLYPH Glyph_Cache[PAINT_GLYPH_CACHE_SIZE];
+static PAINT_GLYPH_STATS Glyph_Stats;
+static UBYTE Glyph_Cache_Enable = 1;
+
+//Signs of the transform, 2 bits each
+static UBYTE Paint_GlyphOrient(void)
+{
+    return (UBYTE)((Paint.MapXx + 1) | (Paint.MapXy + 1) << 2 | (Paint.MapYx + 1) << 4 | (Paint.MapYy + 1) << 6);
+}
+
+//Rows of a glyph are Width / 8 bytes rounded up, MSB first
+static UBYTE Paint_GlyphBit(const UBYTE *Bitmap, UWORD Width, UWORD Column, UWORD Page)
+{
+    return Bitmap[Page * (Width / 8 + (Width % 8 ? 1 : 0)) + Column / 8] & (0x80 >> (Column % 8));
+}
+
+static void Paint_DrawGlyphPixels(UWORD Xpoint, UWORD Ypoint, const UBYTE *Bitmap, UWORD Width, UWORD Height,
+                                  UWORD Color_Foreground, UWORD Color_Background)
+{
+    UWORD Page, Column;
+
+    for (Page = 0; Page < Height; Page ++) {
+        for (Column = 0; Column < Width; Column ++) {
+            if (Paint_GlyphBit(Bitmap, Width, Column, Page))
+                Paint_SetPixel(Xpoint + Column, Ypoint + Page, Color_Foreground);
+            else if (FONT_BACKGROUND != Color_Background)
+                Paint_SetPixel(Xpoint + Column, Ypoint + Page, Color_Background);
+        }
+    }
+}
+
+static UBYTE Paint_GlyphMatch(const PAINT_GLYPH *Glyph, const UBYTE *Bitmap, UWORD Width, UWORD Height,
+                              UWORD Color_Foreground, UWORD Color_Background, UBYTE Orient)
+{
+    return Glyph->Bitmap == Bitmap && Glyph->Width == Width && Glyph->Height == Height &&
+           Glyph->Foreground == Color_Foreground && Glyph->Background == Color_Background && Glyph->Orient == Orient;
+}
+
+static void Paint_FreeGlyph(PAINT_GLYPH *Glyph)
+{
+    if (Glyph->Tile != NULL) {
+        Glyph_Stats.Bytes -= Glyph->Size * sizeof(UWORD);
+        free(Glyph->Tile);
+    }
+    memset(Glyph, 0, sizeof(PAINT_GLYPH));
+}
+
+static UBYTE Paint_RasterizeGlyph(PAINT_GLYPH *Glyph)
+{
+    UWORD Width = Glyph->Width, Height = Glyph->Height;
+    int32_t Min_X = 0, Min_Y = 0;
+    UWORD Page, Column, X, Y, Xend;
+    UWORD *Pixels, *Run;
+    UDOUBLE Runs = 0;
+
+    if (Paint.MapXx < 0) Min_X += Paint.MapXx * (Width - 1);
+    if (Paint.MapXy < 0) Min_X += Paint.MapXy * (Height - 1);
+    if (Paint.MapYx < 0) Min_Y += Paint.MapYx * (Width - 1);
+    if (Paint.MapYy < 0) Min_Y += Paint.MapYy * (Height - 1);
+    Glyph->Offset_X = -Min_X;
+    Glyph->Offset_Y = -Min_Y;
+    Glyph->Tile_Width = Paint.MapXx ? Width : Height;
+    Glyph->Tile_Height = Paint.MapYx ? Width : Height;
+
+    Pixels = (UWORD *)malloc((UDOUBLE)Glyph->Tile_Width * Glyph->Tile_Height * sizeof(UWORD));
+    if (Pixels == NULL)
+        return 1;
+
+    //A transparent glyph is a mask first
+    for (Page = 0; Page < Height; Page ++) {
+        for (Column = 0; Column < Width; Column ++) {
+            UBYTE Bit = Paint_GlyphBit(Glyph->Bitmap, Width, Column, Page) ? 1 : 0;
+            X = Glyph->Offset_X + Column * Paint.MapXx + Page * Paint.MapXy;
+            Y = Glyph->Offset_Y + Column * Paint.MapYx + Page * Paint.MapYy;
+            if (FONT_BACKGROUND == Glyph->Background)
+                Pixels[(UDOUBLE)Y * Glyph->Tile_Width + X] = Bit;
+            else
+                Pixels[(UDOUBLE)Y * Glyph->Tile_Width + X] = PAINT_SWAP_COLOR(Bit ? Glyph->Foreground : Glyph->Background);
+        }
+    }
+
+    if (FONT_BACKGROUND != Glyph->Background) {
+        Glyph->Tile = Pixels;
+        Glyph->Size = (UDOUBLE)Glyph->Tile_Width * Glyph->Tile_Height;
+    } else {
+        for (Y = 0; Y < Glyph->Tile_Height; Y++) {
+            const UWORD *Row = Pixels + (UDOUBLE)Y * Glyph->Tile_Width;
+            for (X = 0; X < Glyph->Tile_Width; X++)
+                if (Row[X] && (X == 0 || !Row[X - 1]))
+                    Runs++;
+        }
+        Run = Runs ? (UWORD *)malloc(Runs * 3 * sizeof(UWORD)) : NULL;
+        if (Runs && Run == NULL) {
+            free(Pixels);
+            return 1;
+        }
+        Glyph->Tile = Run;
+        Glyph->Size = Runs * 3;
+        for (Y = 0; Y < Glyph->Tile_Height; Y++) {
+            const UWORD *Row = Pixels + (UDOUBLE)Y * Glyph->Tile_Width;
+            for (X = 0; X < Glyph->Tile_Width; X = Xend) {
+                for (Xend = X; Xend < Glyph->Tile_Width && Row[Xend]; Xend++);
+                if (Xend > X) {
+                    *Run++ = Y;
+                    *Run++ = X;
+                    *Run++ = Xend;
+                } else {
+                    Xend++;
+                }
+            }
+        }
+        free(Pixels);
+    }
+
+    Glyph_Stats.Bytes += Glyph->Size * sizeof(UWORD);
+    return 0;
+}
+
+/******************************************************************************
+function: Draw a glyph, through the cache when it lies inside of the image
+parameter:
+    Xpoint           : X coordinate
+    Ypoint           : Y coordinate
+    Bitmap           : Glyph in the font table
+    Width            : Width of the glyph
+    Height           : Height of the glyph
+    Color_Foreground : Color of the set bits
+    Color_Background : Color of the clear bits, FONT_BACKGROUND keeps them
+******************************************************************************/
+static void Paint_DrawGlyph(UWORD Xpoint, UWORD Ypoint, const UBYTE *Bitmap, UWORD Width, UWORD Height,
+                            UWORD Color_Foreground, UWORD Color_Background)
+{
+    UWORD Dirty_Xstart, Dirty_Ystart, Dirty_Xend = 0, Dirty_Yend = 0;
+    UWORD X0, Y0, Y, First, Last;
+    UDOUBLE Hash, i;
+    UBYTE Orient;
+    PAINT_GLYPH *Set, *Glyph;
+
+    if (!Glyph_Cache_Enable || Paint.Depth != 16 || Width == 0 || Height == 0 ||
+        Xpoint + Width > Paint.Width || Ypoint + Height > Paint.Height) {
+        Paint_DrawGlyphPixels(Xpoint, Ypoint, Bitmap, Width, Height, Color_Foreground, Color_Background);
+        return;
+    }
+
+    Orient = Paint_GlyphOrient();
+    Hash = ((UDOUBLE)(uintptr_t)Bitmap ^ (UDOUBLE)Color_Foreground << 16 ^ Color_Background ^ (UDOUBLE)Orient << 8) * 2654435761u;
+    Set = &Glyph_Cache[(Hash >> 20) & (PAINT_GLYPH_CACHE_SIZE - 2)];
+    Glyph = &Set[0];
+
+    //Two ways per set, the most recently used one first
+    if (Paint_GlyphMatch(&Set[1], Bitmap, Width, Height, Color_Foreground, Color_Background, Orient)) {
+        PAINT_GLYPH Swap = Set[0];
+        Set[0] = Set[1];
+        Set[1] = Swap;
+    }
+
+    if (!Paint_GlyphMatch(Glyph, Bitmap, Width, Height, Color_Foreground, Color_Background, Orient)) {
+        Paint_FreeGlyph(&Set[1]);
+        Set[1] = Set[0];
+        memset(Glyph, 0, sizeof(PAINT_GLYPH));
+        Glyph->Bitmap = Bitmap;
+        Glyph->Width = Width;
+        Glyph->Height = Height;
+        Glyph->Foreground = Color_Foreground;
+        Glyph->Background = Color_Background;
+        Glyph->Orient = Orient;
+        if (Paint_RasterizeGlyph(Glyph) != 0) {
+            Paint_FreeGlyph(Glyph);
+            Paint_DrawGlyphPixels(Xpoint, Ypoint, Bitmap, Width, Height, Color_Foreground, Color_Background);
+            return;
+        }
+        Glyph_Stats.Misses++;
+    } else {
+        Glyph_Stats.Hits++;
+    }
+
+    Paint_MapPoint(Xpoint, Ypoint, &X0, &Y0);
+    X0 -= Glyph->Offset_X;
+    Y0 -= Glyph->Offset_Y;
+    Dirty_Xstart = Glyph->Tile_Width;
+    Dirty_Ystart = Glyph->Tile_Height;
+
+    if (FONT_BACKGROUND != Color_Background) {
+        for (Y = 0; Y < Glyph->Tile_Height; Y++) {
+            UWORD *Row = Paint.Image + (UDOUBLE)(Y0 + Y) * Paint.WidthByte + X0;
+            const UWORD *Src = Glyph->Tile + (UDOUBLE)Y * Glyph->Tile_Width;
+
+            for (First = 0; First < Glyph->Tile_Width && Row[First] == Src[First]; First++);
+            if (First == Glyph->Tile_Width)
+                continue;
+            for (Last = Glyph->Tile_Width; Row[Last - 1] == Src[Last - 1]; Last--);
+            memcpy(Row + First, Src + First, (Last - First) * sizeof(UWORD));
+
+            if (First < Dirty_Xstart) Dirty_Xstart = First;
+            if (Last > Dirty_Xend) Dirty_Xend = Last;
+            if (Y < Dirty_Ystart) Dirty_Ystart = Y;
+            Dirty_Yend = Y + 1;
+        }
+    } else {
+        UWORD Color = PAINT_SWAP_COLOR(Color_Foreground);
+        const UWORD *Run = Glyph->Tile;
+
+        for (i = 0; i < Glyph->Size; i += 3, Run += 3) {
+            UWORD *Row = Paint.Image + (UDOUBLE)(Y0 + Run[0]) * Paint.WidthByte + X0;
+
+            for (First = Run[1]; First < Run[2] && Row[First] == Color; First++);
+            if (First == Run[2])
+                continue;
+            for (Last = Run[2]; Row[Last - 1] == Color; Last--);
+            Paint_FillWords(Row + First, Color, Last - First);
+
+            if (First < Dirty_Xstart) Dirty_Xstart = First;
+            if (Last > Dirty_Xend) Dirty_Xend = Last;
+            if (Run[0] < Dirty_Ystart) Dirty_Ystart = Run[0];
+            if (Run[0] + 1 > Dirty_Yend) Dirty_Yend = Run[0] + 1;
+        }
+    }
+
+    if (Dirty_Xstart < Dirty_Xend)
+        Paint_AddDirty(X0 + Dirty_Xstart, Y0 + Dirty_Ystart, X0 + Dirty_Xend, Y0 + Dirty_Yend);
+}
+
+/******************************************************************************
+function: Enable or bypass the glyph cache, the cached glyphs are kept
+parameter:
+    Enable : 1 to draw text through the cache
+******************************************************************************/
+void Paint_SetGlyphCache(UBYTE Enable)
+{
+    Glyph_Cache_Enable = Enable;
+}
+
+/******************************************************************************
+function: Free the cached glyphs and reset the statistics
+parameter:
+******************************************************************************/
+void Paint_ClearGlyphCache(void)
+{
+    UWORD i;
+
+    for (i = 0; i < PAINT_GLYPH_CACHE_SIZE; i++)
+        Paint_FreeGlyph(&Glyph_Cache[i]);
+    memset(&Glyph_Stats, 0, sizeof(Glyph_Stats));
+}
+
+/******************************************************************************
+function: Get the glyph cache statistics
+parameter:
+    Stats : hits and misses since Paint_ClearGlyphCache(), memory in use
+******************************************************************************/
+void Paint_GetGlyphStats(PAINT_GLYPH_STATS *Stats)
+{
+    *Stats = Glyph_Stats;
+}
+
 /******************************************************************************
 function: Show English characters
 parameter:
@@ -446,40 +1091,15 @@ parameter:
 void Paint_DrawChar(UWORD Xpoint, UWORD Ypoint, const char Acsii_Char,
                     sFONT* Font, UWORD Color_Foreground, UWORD Color_Background)
 {
-    UWORD Page, Column;
-
     if (Xpoint > Paint.Width || Ypoint > Paint.Height) {
         DEBUG("Paint_DrawChar Input exceeds the normal display range\r\n");
         return;
     }
 
     uint32_t Char_Offset = (Acsii_Char - ' ') * Font->Height * (Font->Width / 8 + (Font->Width % 8 ? 1 : 0));
-    const unsigned char *ptr = &Font->table[Char_Offset];
-
-    for (Page = 0; Page < Font->Height; Page ++ ) {
-        for (Column = 0; Column < Font->Width; Column ++ ) {
-
-            //To determine whether the font background color and screen background color is consistent
-            if (FONT_BACKGROUND == Color_Background) { //this process is to speed up the scan
-                if (*ptr & (0x80 >> (Column % 8)))
-                    Paint_SetPixel(Xpoint + Column, Ypoint + Page, Color_Foreground);
-                    // Paint_DrawPoint(Xpoint + Column, Ypoint + Page, Color_Foreground, DOT_PIXEL_DFT, DOT_STYLE_DFT);
-            } else {
-                if (*ptr & (0x80 >> (Column % 8))) {
-                    Paint_SetPixel(Xpoint + Column, Ypoint + Page, Color_Foreground);
-                    // Paint_DrawPoint(Xpoint + Column, Ypoint + Page, Color_Foreground, DOT_PIXEL_DFT, DOT_STYLE_DFT);
-                } else {
-                    Paint_SetPixel(Xpoint + Column, Ypoint + Page, Color_Background);
-                    // Paint_DrawPoint(Xpoint + Column, Ypoint + Page, Color_Background, DOT_PIXEL_DFT, DOT_STYLE_DFT);
-                }
-            }
-            //One pixel is 8 bits
-            if (Column % 8 == 7)
-                ptr++;
-        }// Write a line
-        if (Font->Width % 8 != 0)
-            ptr++;
-    }// Write all
+
+    Paint_DrawGlyph(Xpoint, Ypoint, &Font->table[Char_Offset], Font->Width, Font->Height,
+                    Color_Foreground, Color_Background);
 }
 
 /******************************************************************************
@@ -541,39 +1161,15 @@ void Paint_DrawString_CN(UWORD Xstart, UWORD Ystart, const char * pString, cFONT
 {
     const char* p_text = pString;
     int x = Xstart, y = Ystart;
-    int i, j,Num;
+    int Num;
 
     /* Send the string character by character on EPD */
     while (*p_text != 0) {
         if(*p_text <= 0x7F) {  //ASCII < 126
             for(Num = 0; Num < font->size; Num++) {
                 if(*p_text== font->table[Num].index[0]) {
-                    const char* ptr = &font->table[Num].matrix[0];
-
-                    for (j = 0; j < font->Height; j++) {
-                        for (i = 0; i < font->Width; i++) {
-                            if (FONT_BACKGROUND == Color_Background) { //this process is to speed up the scan
-                                if (*ptr & (0x80 >> (i % 8))) {
-                                    Paint_SetPixel(x + i, y + j, Color_Foreground);
-                                    // Paint_DrawPoint(x + i, y + j, Color_Foreground, DOT_PIXEL_DFT, DOT_STYLE_DFT);
-                                }
-                            } else {
-                                if (*ptr & (0x80 >> (i % 8))) {
-                                    Paint_SetPixel(x + i, y + j, Color_Foreground);
-                                    // Paint_DrawPoint(x + i, y + j, Color_Foreground, DOT_PIXEL_DFT, DOT_STYLE_DFT);
-                                } else {
-                                    Paint_SetPixel(x + i, y + j, Color_Background);
-                                    // Paint_DrawPoint(x + i, y + j, Color_Background, DOT_PIXEL_DFT, DOT_STYLE_DFT);
-                                }
-                            }
-                            if (i % 8 == 7) {
-                                ptr++;
-                            }
-                        }
-                        if (font->Width % 8 != 0) {
-                            ptr++;
-                        }
-                    }
+                    Paint_DrawGlyph(x, y, (const UBYTE *)font->table[Num].matrix, font->Width, font->Height,
+                                    Color_Foreground, Color_Background);
                     break;
                 }
             }
@@ -584,32 +1180,8 @@ void Paint_DrawString_CN(UWORD Xstart, UWORD Ystart, const char * pString, cFONT
         } else {        //Chinese
             for(Num = 0; Num < font->size; Num++) {
                 if((*p_text== font->table[Num].index[0]) && (*(p_text+1) == font->table[Num].index[1])) {
-                    const char* ptr = &font->table[Num].matrix[0];
-
-                    for (j = 0; j < font->Height; j++) {
-                        for (i = 0; i < font->Width; i++) {
-                            if (FONT_BACKGROUND == Color_Background) { //this process is to speed up the scan
-                                if (*ptr & (0x80 >> (i % 8))) {
-                                    Paint_SetPixel(x + i, y + j, Color_Foreground);
-                                    // Paint_DrawPoint(x + i, y + j, Color_Foreground, DOT_PIXEL_DFT, DOT_STYLE_DFT);
-                                }
-                            } else {
-                                if (*ptr & (0x80 >> (i % 8))) {
-                                    Paint_SetPixel(x + i, y + j, Color_Foreground);
-                                    // Paint_DrawPoint(x + i, y + j, Color_Foreground, DOT_PIXEL_DFT, DOT_STYLE_DFT);
-                                } else {
-                                    Paint_SetPixel(x + i, y + j, Color_Background);
-                                    // Paint_DrawPoint(x + i, y + j, Color_Background, DOT_PIXEL_DFT, DOT_STYLE_DFT);
-                                }
-                            }
-                            if (i % 8 == 7) {
-                                ptr++;
-                            }
-                        }
-                        if (font->Width % 8 != 0) {
-                            ptr++;
-                        }
-                    }
+                    Paint_DrawGlyph(x, y, (const UBYTE *)font->table[Num].matrix, font->Width, font->Height,
+                                    Color_Foreground, Color_Background);
                     break;
                 }
             }
@@ -727,17 +1299,18 @@ parameter:
 ******************************************************************************/
 void Paint_DrawImage(const unsigned char *image, UWORD xStart, UWORD yStart, UWORD W_Image, UWORD H_Image) 
 {
-    int i,j; 
-		for(j = 0; j < H_Image; j++){
-			for(i = 0; i < W_Image; i++){
-				if(xStart+i < Paint.WidthMemory  &&  yStart+j < Paint.HeightMemory)//Exceeded part does not display
-					Paint_SetPixel(xStart + i, yStart + j, (*(image + j*W_Image*2 + i*2+1))<<8 | (*(image + j*W_Image*2 + i*2)));
-				//Using arrays is a property of sequential storage, accessing the original array by algorithm
-				//j*W_Image*2 			   Y offset
-				//i*2              	   X offset
-			}
-		}
-      
+    UWORD Width = W_Image, Height = H_Image;
+
+    //Exceeded part does not display
+    if (xStart >= Paint.WidthMemory || yStart >= Paint.HeightMemory)
+        return;
+    if (Width > Paint.WidthMemory - xStart)
+        Width = Paint.WidthMemory - xStart;
+    if (Height > Paint.HeightMemory - yStart)
+        Height = Paint.HeightMemory - yStart;
+
+    //Little endian RGB565 rows of W_Image pixels
+    Paint_Blit(xStart, yStart, Width, Height, image, (UDOUBLE)W_Image * 2, 1);
 }
 
 /******************************************************************************
@@ -759,39 +1332,65 @@ void Paint_DrawBitMap(const unsigned char* image_buffer)
             Paint.Image[Addr] = (unsigned char)image_buffer[Addr];
         }
     }
+    Paint_AddDirty(0, 0, Paint.WidthMemory, Paint.HeightMemory);
 }
 
 
-/*
-void GUI_Partial_Refresh(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend)
+/******************************************************************************
+function:	Mark a window as dirty, e.g. after writing Paint.Image directly
+parameter:
+    Xstart : x starting point
+    Ystart : Y starting point
+    Xend   : x end point, exclusive
+    Yend   : y end point, exclusive
+******************************************************************************/
+void Paint_SetDirty(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend)
 {
     UWORD X0, Y0, X1, Y1;
-    switch(Paint.Rotate) {
-    case 0:
-        X0 = Xstart;
-        Y0 = Ystart;
-        X1 = Xend;
-        Y1 = Yend;
-        break;
-    case 90:
-        X0 = Ystart;
-        Y0 = Paint.WidthMemory  - Xend ;
-        X1 = Yend;
-        Y1 = Paint.WidthMemory  - Xstart ;
-        break;
-    case 180:
-        X0 = Paint.WidthMemory  - Xend ;
-        Y0 = Paint.HeightMemory - Yend ;
-        X1 = Paint.WidthMemory  - Xstart ;
-        Y1 = Paint.HeightMemory - Ystart ;
-        break;
-    case 270:
-        X0 = Paint.WidthMemory  - Xend ;
-        Y0 = Xstart;
-        X1 = Paint.HeightMemory - Ystart ;
-        Y1 = Paint.HeightMemory - Yend ;
-        break;
+
+    if (Xend > Paint.Width) Xend = Paint.Width;
+    if (Yend > Paint.Height) Yend = Paint.Height;
+    if (Xstart >= Xend || Ystart >= Yend)
+        return;
+
+    if (Paint_MapPoint(Xstart, Ystart, &X0, &Y0) || Paint_MapPoint(Xend - 1, Yend - 1, &X1, &Y1))
+        return;
+
+    Paint_AddDirty(X0 < X1 ? X0 : X1, Y0 < Y1 ? Y0 : Y1,
+                   (X0 > X1 ? X0 : X1) + 1, (Y0 > Y1 ? Y0 : Y1) + 1);
+}
+
+/******************************************************************************
+function:	Forget the dirty windows, e.g. after a full LCD_*_Display()
+parameter:
+******************************************************************************/
+void Paint_ClearDirty(void)
+{
+    Paint.DirtyCount = 0;
+    Paint.DirtyLast = 0;
+}
+
+/******************************************************************************
+function:	Send the dirty windows of the image to the LCD
+parameter:
+    DisplayWindows : LCD_*_DisplayWindows() of the panel
+return:
+    Bytes of pixel data sent
+info:
+    Only for 16-bit images, the windows are in memory coordinates, which
+    are the LCD coordinates of the buffer passed to LCD_*_Display().
+******************************************************************************/
+UDOUBLE Paint_Flush(PAINT_DISPLAY_WINDOWS DisplayWindows)
+{
+    UDOUBLE Bytes = 0;
+    UBYTE i;
+
+    for (i = 0; i < Paint.DirtyCount; i++) {
+        PAINT_RECT *Rect = &Paint.Dirty[i];
+        DisplayWindows(Rect->Xstart, Rect->Ystart, Rect->Xend, Rect->Yend, Paint.Image);
+        Bytes += Paint_RectArea(Rect->Xstart, Rect->Ystart, Rect->Xend, Rect->Yend) * 2;
     }
-    LCD_1in54_DisplayWindows(X0, Y0, X1, Y1, Paint.Image);
+    Paint_ClearDirty();
+
+    return Bytes;
 }
-*/
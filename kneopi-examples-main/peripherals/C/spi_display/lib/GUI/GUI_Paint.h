@@ -46,6 +46,36 @@ typedef enum {
     MIRROR_ORIGIN = 0x03,
 } MIRROR_IMAGE;
 #define MIRROR_IMAGE_DFT MIRROR_NONE
+/**
+ * Dirty rectangle, in memory coordinates, Xend and Yend are exclusive
+**/
+#define PAINT_DIRTY_MAX             8       //Rectangles kept before the closest two are merged
+#define PAINT_DIRTY_MERGE_SLACK     256     //Clean pixels allowed in a merge, cheaper than another SPI window
+
+typedef struct {
+    UWORD Xstart;
+    UWORD Ystart;
+    UWORD Xend;
+    UWORD Yend;
+} PAINT_RECT;
+
+/**
+ * Glyph cache, each entry is one glyph of a font in one color pair, Rotate
+ * and Mirror, 2 bytes per pixel (a Font24 glyph is 816 bytes)
+**/
+#define PAINT_GLYPH_CACHE_SIZE      256     //Entries, a power of 2, 2 per set
+
+typedef struct {
+    UDOUBLE Hits;
+    UDOUBLE Misses;
+    UDOUBLE Bytes;                      //Memory held by the cached glyphs
+} PAINT_GLYPH_STATS;
+
+/**
+ * Same prototype as LCD_*_DisplayWindows()
+**/
+typedef void (*PAINT_DISPLAY_WINDOWS)(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD *Image);
+
 /**
  * Image attributes
 **/
@@ -63,6 +93,12 @@ typedef struct {
     UWORD HeightByte;
     UWORD Depth;
     UBYTE Mode;
+    PAINT_RECT Dirty[PAINT_DIRTY_MAX];
+    UBYTE DirtyCount;
+    UBYTE DirtyLast;
+    //Rotate and Mirror as a transform to memory, X = MapX0 + x * MapXx + y * MapXy
+    int32_t MapX0, MapXx, MapXy;
+    int32_t MapY0, MapYx, MapYy;
 } PAINT;
 extern PAINT Paint;
 
@@ -84,6 +120,11 @@ extern PAINT Paint;
 #define BRRED 		   0XFC07
 #define GRAY  		   0X8430
 
+/**
+ * Colors are kept byte swapped in a 16-bit image, the order the LCD reads them
+**/
+#define PAINT_SWAP_COLOR(Color)    ((UWORD)((((Color) << 8) & 0xff00) | (((Color) >> 8) & 0x00ff)))
+
 #define IMAGE_BACKGROUND    WHITE
 #define FONT_FOREGROUND     BLACK
 #define FONT_BACKGROUND     WHITE
@@ -151,6 +192,12 @@ void Paint_SetPixel(UWORD Xpoint, UWORD Ypoint, UWORD Color);
 void Paint_Clear(UWORD Color);
 void Paint_ClearWindow(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD Color);
 
+//Spans and blits, Xend and Yend are exclusive, Pixels are byte swapped
+void Paint_DrawSpanH(UWORD Xstart, UWORD Xend, UWORD Ypoint, UWORD Color);
+void Paint_DrawSpanV(UWORD Xpoint, UWORD Ystart, UWORD Yend, UWORD Color);
+void Paint_FillRect(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD Color);
+void Paint_BlitRect(UWORD Xstart, UWORD Ystart, UWORD Width, UWORD Height, const UWORD *Pixels, UWORD Stride);
+
 //Drawing
 void Paint_DrawPoint(UWORD Xpoint, UWORD Ypoint, UWORD Color, DOT_PIXEL Dot_Pixel, DOT_STYLE Dot_FillWay);
 void Paint_DrawLine(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD Color, DOT_PIXEL Line_width, LINE_STYLE Line_Style);
@@ -165,11 +212,19 @@ void Paint_DrawNum(UWORD Xpoint, UWORD Ypoint, int32_t Nummber, sFONT* Font, UWO
 void Paint_DrawFloatNum(UWORD Xpoint, UWORD Ypoint, double Nummber,  UBYTE Decimal_Point,	sFONT* Font,  UWORD Color_Foreground, UWORD  Color_Background);
 void Paint_DrawTime(UWORD Xstart, UWORD Ystart, PAINT_TIME *pTime, sFONT* Font, UWORD Color_Foreground, UWORD Color_Background);
 
+//Glyph cache
+void Paint_SetGlyphCache(UBYTE Enable);
+void Paint_ClearGlyphCache(void);
+void Paint_GetGlyphStats(PAINT_GLYPH_STATS *Stats);
+
 //pic
 void Paint_DrawImage(const unsigned char *image,UWORD Startx, UWORD Starty,UWORD Endx, UWORD Endy); 
 
 
-//void GUI_Partial_Refresh(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend);
+//partial refresh
+void Paint_SetDirty(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend);
+void Paint_ClearDirty(void);
+UDOUBLE Paint_Flush(PAINT_DISPLAY_WINDOWS DisplayWindows);
 #endif
 
 
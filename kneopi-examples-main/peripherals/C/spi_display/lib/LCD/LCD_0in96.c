@@ -243,20 +243,9 @@ parameter	:
 ******************************************************************************/
 void LCD_0IN96_Clear(UWORD Color)
 {
-	unsigned int i,j;  
-	Color = 0xffff;
-    UWORD Image[LCD_0IN96_WIDTH*LCD_0IN96_HEIGHT];
-    
-    Color = ((Color<<8)&0xff00)|(Color>>8);
-   
-    for (j = 0; j < LCD_0IN96_HEIGHT*LCD_0IN96_WIDTH; j++) {
-        Image[j] = Color;
-    }
 	LCD_0IN96_SetWindow(0, 0, LCD_0IN96_WIDTH-1, LCD_0IN96_HEIGHT-1);
 	DEV_Digital_Write(LCD_DC, 1);
-	for(i = 0; i < LCD_0IN96_HEIGHT; i++){
-        DEV_SPI_Write_nByte((uint8_t *)&Image[i*LCD_0IN96_WIDTH], LCD_0IN96_WIDTH*2); 
-	 }
+	DEV_SPI_Write_Fill(Color, (UDOUBLE)LCD_0IN96_WIDTH * LCD_0IN96_HEIGHT);
 }
 
 /******************************************************************************
@@ -270,13 +259,9 @@ parameter	:
 ******************************************************************************/
 void LCD_0IN96_ClearWindow(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend,UWORD color)
 {          
-	UWORD i,j; 
 	LCD_0IN96_SetWindow(Xstart, Ystart, Xend-1,Yend-1);
-	for(i = Ystart; i <= Yend-1; i++){
-		for(j = Xstart; j <= Xend-1; j++){
-			LCD_0IN96_WriteData_Word(color);
-		}
-	}
+	DEV_Digital_Write(LCD_DC, 1);
+	DEV_SPI_Write_Fill(color, (UDOUBLE)(Xend-Xstart) * (Yend-Ystart));
 }
 
 /******************************************************************************
@@ -298,26 +283,19 @@ parameter:
 ******************************************************************************/
 void LCD_0IN96_Display(UWORD *Image)
 {
-    UWORD j;
     LCD_0IN96_SetWindow(0, 0, LCD_0IN96_WIDTH-1, LCD_0IN96_HEIGHT-1);
     DEV_Digital_Write(LCD_DC, 1);
-    for (j = 0; j < LCD_0IN96_HEIGHT; j++) {
-        DEV_SPI_Write_nByte((uint8_t *)&Image[j*LCD_0IN96_WIDTH], LCD_0IN96_WIDTH*2);
-    }
+    DEV_SPI_Write_nByte((uint8_t *)Image, (UDOUBLE)LCD_0IN96_WIDTH * LCD_0IN96_HEIGHT * 2);
 }
 
 void LCD_0IN96_DisplayWindows(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD *Image)
 {
     // display
-    UDOUBLE Addr = 0;
+    UDOUBLE Addr = Xstart + (UDOUBLE)Ystart * LCD_0IN96_WIDTH;
 
-    UWORD j;
     LCD_0IN96_SetWindow(Xstart, Ystart, Xend-1 , Yend-1);
     DEV_Digital_Write(LCD_DC, 1);
-    for (j = Ystart; j < Yend - 1; j++) {
-        Addr = Xstart + j * LCD_0IN96_WIDTH ;
-        DEV_SPI_Write_nByte((uint8_t *)&Image[Addr], (Xend-Xstart-1)*2);
-    }
+    DEV_SPI_Write_Rows((uint8_t *)&Image[Addr], (Xend-Xstart)*2, LCD_0IN96_WIDTH*2, Yend-Ystart);
 }
 
 void  Handler_0IN96_LCD(int signo)
@@ -255,22 +255,9 @@ parameter:
 ******************************************************************************/
 void LCD_1IN47_Clear(UWORD Color)
 {
-	UWORD j;
-	UWORD Image[LCD_1IN47_WIDTH * LCD_1IN47_HEIGHT];
-
-	Color = ((Color << 8) & 0xff00) | (Color >> 8);
-
-	for (j = 0; j < LCD_1IN47_HEIGHT * LCD_1IN47_WIDTH; j++)
-	{
-		Image[j] = Color;
-	}
-
 	LCD_1IN47_SetWindows(0, 0, LCD_1IN47.HEIGHT, LCD_1IN47.WIDTH);
 	LCD_1IN47_DC_1;
-	for (j = 0; j < LCD_1IN47.WIDTH; j++)
-	{
-		DEV_SPI_Write_nByte((uint8_t *)&Image[j * LCD_1IN47.HEIGHT], LCD_1IN47.HEIGHT * 2);
-	}
+	DEV_SPI_Write_Fill(Color, (UDOUBLE)LCD_1IN47.WIDTH * LCD_1IN47.HEIGHT);
 }
 
 /******************************************************************************
@@ -279,28 +266,18 @@ parameter:
 ******************************************************************************/
 void LCD_1IN47_Display(UWORD *Image)
 {
-	UWORD j;
 	LCD_1IN47_SetWindows(0, 0, LCD_1IN47.HEIGHT, LCD_1IN47.WIDTH);
 	LCD_1IN47_DC_1;
-	for (j = 0; j < LCD_1IN47.WIDTH; j++)
-	{
-		DEV_SPI_Write_nByte((uint8_t *)&Image[j * LCD_1IN47.HEIGHT], LCD_1IN47.HEIGHT * 2);
-	}
-
+	DEV_SPI_Write_nByte((uint8_t *)Image, (UDOUBLE)LCD_1IN47.WIDTH * LCD_1IN47.HEIGHT * 2);
 }
 
 void LCD_1IN47_DisplayWindows(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD *Image)
 {
 	// display
-	UDOUBLE Addr = 0;
-	UWORD j;
+	UDOUBLE Addr = Xstart + (UDOUBLE)Ystart * LCD_1IN47.HEIGHT;
 	LCD_1IN47_SetWindows(Xstart, Ystart, Xend, Yend);
 	LCD_1IN47_DC_1;
-	for (j = Ystart; j < Yend - 1; j++)
-	{
-		Addr = Xstart + j * LCD_1IN47.HEIGHT;
-		DEV_SPI_Write_nByte((uint8_t *)&Image[Addr], (Xend - Xstart) * 2);
-	}
+	DEV_SPI_Write_Rows((uint8_t *)&Image[Addr], (Xend - Xstart) * 2, LCD_1IN47.HEIGHT * 2, Yend - Ystart);
 }
 
 void LCD_1IN47_DisplayPoint(UWORD X, UWORD Y, UWORD Color)
@@ -231,20 +231,9 @@ parameter:
 ******************************************************************************/
 void LCD_1IN54_Clear(UWORD Color)
 {
-    UWORD j;
-    UWORD Image[LCD_1IN54_WIDTH*LCD_1IN54_HEIGHT];
-    
-    Color = ((Color<<8)&0xff00)|(Color>>8);
-   
-    for (j = 0; j < LCD_1IN54_HEIGHT*LCD_1IN54_WIDTH; j++) {
-        Image[j] = Color;
-    }
-    
     LCD_1IN54_SetWindows(0, 0, LCD_1IN54_WIDTH, LCD_1IN54_HEIGHT);
     LCD_1IN54_DC_1;
-    for(j = 0; j < LCD_1IN54_HEIGHT; j++){
-        DEV_SPI_Write_nByte((uint8_t *)&Image[j*LCD_1IN54_WIDTH], LCD_1IN54_WIDTH*2);
-    }
+    DEV_SPI_Write_Fill(Color, (UDOUBLE)LCD_1IN54_WIDTH * LCD_1IN54_HEIGHT);
 }
 
 /******************************************************************************
@@ -253,26 +242,19 @@ parameter:
 ******************************************************************************/
 void LCD_1IN54_Display(UWORD *Image)
 {
-    UWORD j;
     LCD_1IN54_SetWindows(0, 0, LCD_1IN54_WIDTH, LCD_1IN54_HEIGHT);
     LCD_1IN54_DC_1;
-    for (j = 0; j < LCD_1IN54_HEIGHT; j++) {
-        DEV_SPI_Write_nByte((uint8_t *)&Image[j*LCD_1IN54_WIDTH], LCD_1IN54_WIDTH*2);
-    }
+    DEV_SPI_Write_nByte((uint8_t *)Image, (UDOUBLE)LCD_1IN54_WIDTH * LCD_1IN54_HEIGHT * 2);
 }
 
 void LCD_1IN54_DisplayWindows(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD *Image)
 {
     // display
-    UDOUBLE Addr = 0;
+    UDOUBLE Addr = Xstart + (UDOUBLE)Ystart * LCD_1IN54_WIDTH;
 
-    UWORD j;
     LCD_1IN54_SetWindows(Xstart, Ystart, Xend , Yend);
     LCD_1IN54_DC_1;
-    for (j = Ystart; j < Yend - 1; j++) {
-        Addr = Xstart + j * LCD_1IN54_WIDTH ;
-        DEV_SPI_Write_nByte((uint8_t *)&Image[Addr], (Xend-Xstart)*2);
-    }
+    DEV_SPI_Write_Rows((uint8_t *)&Image[Addr], (Xend-Xstart)*2, LCD_1IN54_WIDTH*2, Yend-Ystart);
 }
 
 void LCD_1IN54_DisplayPoint(UWORD X, UWORD Y, UWORD Color)
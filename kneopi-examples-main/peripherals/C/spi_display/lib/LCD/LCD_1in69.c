@@ -258,18 +258,9 @@ parameter:
 ******************************************************************************/
 void LCD_1IN69_Clear(UWORD Color)
 {
-    UWORD j;
-    UWORD Image[LCD_1IN69_WIDTH];
-    for (j=0; j<LCD_1IN69_WIDTH; j++) {
-        Image[j] = Color;
-    }
-
     LCD_1IN69_SetWindows(0, 0, LCD_1IN69.WIDTH, LCD_1IN69.HEIGHT);
     LCD_1IN69_DC_1;
-    for (j=0; j<LCD_1IN69.HEIGHT; j++) {
-        DEV_SPI_Write_nByte((uint8_t *)&Image, LCD_1IN69.WIDTH * 2);
-    }
-
+    DEV_SPI_Write_Fill(Color, (UDOUBLE)LCD_1IN69.WIDTH * LCD_1IN69.HEIGHT);
 }
 
 /******************************************************************************
@@ -278,24 +269,19 @@ parameter:
 ******************************************************************************/
 void LCD_1IN69_Display(UWORD *Image)
 {
-    UWORD j;
-    
     LCD_1IN69_SetWindows(0, 0, LCD_1IN69.WIDTH, LCD_1IN69.HEIGHT);
     LCD_1IN69_DC_1;
-    for (j=0; j<LCD_1IN69.HEIGHT; j++) {
-        DEV_SPI_Write_nByte((uint8_t *)&Image[j * LCD_1IN69.WIDTH], LCD_1IN69.WIDTH * 2);
-    }
+    DEV_SPI_Write_nByte((uint8_t *)Image, (UDOUBLE)LCD_1IN69.WIDTH * LCD_1IN69.HEIGHT * 2);
 }
 
 void LCD_1IN69_DisplayWindows(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD *Image)
 {
-    UWORD j;
+    // display
+    UDOUBLE Addr = Xstart + (UDOUBLE)Ystart * LCD_1IN69.WIDTH;
     
     LCD_1IN69_SetWindows(Xstart, Ystart, Xend, Yend);
     LCD_1IN69_DC_1;
-    for (j=0; j<Yend-Ystart; j++) {
-        DEV_SPI_Write_nByte((uint8_t *)&Image[j * (Xend-Xstart)], (Xend-Xstart) * 2);
-    }
+    DEV_SPI_Write_Rows((uint8_t *)&Image[Addr], (Xend-Xstart) * 2, LCD_1IN69.WIDTH * 2, Yend-Ystart);
 }
 
 void LCD_1IN69_DrawPoint(UWORD X, UWORD Y, UWORD Color)
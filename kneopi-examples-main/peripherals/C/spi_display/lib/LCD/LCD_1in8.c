@@ -60,13 +60,9 @@ static void LCD_1IN8_WriteData_16Bit(uint16_t Data)
 
 static void LCD_1IN8_WriteData_NLen16Bit(uint16_t Data,uint32_t DataLen)
 {
-    uint32_t i;
     LCD_1IN8_DC_1;
     //LCD_1IN8_CS_0;
-    for(i = 0; i < DataLen; i++) {
-        DEV_SPI_WriteByte( (uint8_t)(Data >> 8) );
-        DEV_SPI_WriteByte( (uint8_t)(Data & 0XFF) );
-    }
+    DEV_SPI_Write_Fill(Data, DataLen);
     //LCD_1IN8_CS_1;
 }
 
@@ -344,43 +340,25 @@ function:
 ********************************************************************************/
 void LCD_1IN8_Clear(COLOR  Color)
 {
-    UWORD j;
-    UWORD Image[LCD_1IN8_HEIGHT*LCD_1IN8_WIDTH];
-    
-    Color = ((Color<<8)&0xff00)|(Color>>8);
-   
-    for (j = 0; j < LCD_1IN8_HEIGHT*LCD_1IN8_WIDTH; j++) {
-        Image[j] = Color;
-    }
-    
     LCD_1IN8_SetWindows(0, 0, LCD_1IN8_WIDTH,LCD_1IN8_HEIGHT);
     LCD_1IN8_DC_1;
-    for(j = 0; j <LCD_1IN8_HEIGHT; j++){
-        DEV_SPI_Write_nByte((uint8_t *)&Image[j*LCD_1IN8_WIDTH], LCD_1IN8_WIDTH*2);
-    }
+    DEV_SPI_Write_Fill(Color, (UDOUBLE)LCD_1IN8_WIDTH * LCD_1IN8_HEIGHT);
 }
 
 void LCD_1IN8_Display(UWORD *Image)
 {
-    UWORD j;
     LCD_1IN8_SetWindows(0, 0, LCD_1IN8_WIDTH-1, LCD_1IN8_HEIGHT-1);
     LCD_1IN8_DC_1;
-    for (j = 0; j < LCD_1IN8_HEIGHT; j++) {
-        DEV_SPI_Write_nByte((uint8_t *)&Image[j*LCD_1IN8_WIDTH], LCD_1IN8_WIDTH*2);
-    }
+    DEV_SPI_Write_nByte((uint8_t *)Image, (UDOUBLE)LCD_1IN8_WIDTH * LCD_1IN8_HEIGHT * 2);
 }
 
 void LCD_1IN8_DisplayWindows(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD *Image)
 {
-    UDOUBLE Addr = 0;
+    UDOUBLE Addr = Xstart + (UDOUBLE)Ystart * LCD_1IN8_WIDTH;
 
-    UWORD j;
     LCD_1IN8_SetWindows(Xstart, Ystart, Xend-1 , Yend-1);
     LCD_1IN8_DC_1;
-    for (j = Ystart; j < Yend - 1; j++) {
-        Addr = Xstart + j * LCD_1IN8_WIDTH ;
-        DEV_SPI_Write_nByte((uint8_t *)&Image[Addr], (Xend-Xstart)*2);
-    }
+    DEV_SPI_Write_Rows((uint8_t *)&Image[Addr], (Xend-Xstart)*2, LCD_1IN8_WIDTH*2, Yend-Ystart);
 }
 
 void  Handler_1IN8_LCD(int signo)
@@ -247,19 +247,9 @@ parameter:
 ******************************************************************************/
 void LCD_1IN9_Clear(UWORD Color)
 {
-    UWORD j;
-    UWORD Image[LCD_1IN9_WIDTH*LCD_1IN9_HEIGHT];
-
-    for (j=0; j<LCD_1IN9_HEIGHT*LCD_1IN9_WIDTH; j++) {
-        Image[j] = Color;
-    }
-
     LCD_1IN9_SetWindows(0, 0, LCD_1IN9.HEIGHT, LCD_1IN9.WIDTH);
     LCD_1IN9_DC_1;
-    for (j=0; j<LCD_1IN9.HEIGHT; j++) {
-        DEV_SPI_Write_nByte((uint8_t *)&Image[j * LCD_1IN9.WIDTH], LCD_1IN9.WIDTH * 2);
-    }
-
+    DEV_SPI_Write_Fill(Color, (UDOUBLE)LCD_1IN9.WIDTH * LCD_1IN9.HEIGHT);
 }
 
 /******************************************************************************
@@ -268,28 +258,19 @@ parameter:
 ******************************************************************************/
 void LCD_1IN9_Display(UWORD *Image)
 {
-    UWORD j;
-    
     LCD_1IN9_SetWindows(0, 0, LCD_1IN9.HEIGHT, LCD_1IN9.WIDTH);
     LCD_1IN9_DC_1;
-    for (j=0; j<LCD_1IN9.HEIGHT; j++) {
-        DEV_SPI_Write_nByte((uint8_t *)&Image[j * LCD_1IN9.WIDTH], LCD_1IN9.WIDTH * 2);
-    }
+    DEV_SPI_Write_nByte((uint8_t *)Image, (UDOUBLE)LCD_1IN9.WIDTH * LCD_1IN9.HEIGHT * 2);
 }
 
 void LCD_1IN9_DisplayWindows(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD *Image)
 {
     // display
-    UDOUBLE Addr = 0;
-    UWORD j;
+    UDOUBLE Addr = Xstart + (UDOUBLE)Ystart * LCD_1IN9.HEIGHT;
     
     LCD_1IN9_SetWindows(Xstart, Ystart, Xend, Yend);
     LCD_1IN9_DC_1;
-    
-    for (j=Ystart; j<Yend-1; j++) {
-        Addr = Xstart + j * LCD_1IN9.HEIGHT;
-        DEV_SPI_Write_nByte((uint8_t *)&Image[Addr], (Xend-Xstart) * 2);
-    }
+    DEV_SPI_Write_Rows((uint8_t *)&Image[Addr], (Xend-Xstart) * 2, LCD_1IN9.HEIGHT * 2, Yend-Ystart);
 }
 
 void LCD_1IN9_DrawPoint(UWORD X, UWORD Y, UWORD Color)
@@ -51,6 +51,7 @@
 void LCD_2IN_Init(void); 
 void LCD_2IN_Clear(UWORD Color);
 void LCD_2IN_Display(UBYTE *image);
+void LCD_2IN_DisplayWindows(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD *Image);
 void LCD_2IN_DrawPaint(UWORD x, UWORD y, UWORD Color);
 void  Handler_2IN_LCD(int signo);
 
@@ -225,17 +225,9 @@ parameter	:
 ******************************************************************************/
 void LCD_2IN4_Clear(UWORD Color)
 {
-	UWORD i;
-	UWORD image[LCD_2IN4_WIDTH];
-	for(i=0;i<LCD_2IN4_WIDTH;i++){
-		image[i] = Color>>8 | (Color&0xff)<<8;
-	}
-	UBYTE *p = (UBYTE *)(image);
 	LCD_2IN4_SetWindow(0, 0, LCD_2IN4_WIDTH, LCD_2IN4_HEIGHT);
 	DEV_Digital_Write(LCD_DC, 1);
-	for(i = 0; i < LCD_2IN4_HEIGHT; i++){
-		DEV_SPI_Write_nByte(p,LCD_2IN4_WIDTH*2);
-	}
+	DEV_SPI_Write_Fill(Color, (UDOUBLE)LCD_2IN4_WIDTH * LCD_2IN4_HEIGHT);
 }
 
 /******************************************************************************
@@ -249,13 +241,9 @@ parameter	:
 ******************************************************************************/
 void LCD_2IN4_ClearWindow(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend,UWORD color)
 {          
-	UWORD i,j; 
-	LCD_2IN4_SetWindow(Xstart, Ystart, Xend-1,Yend-1);
-	for(i = Ystart; i <= Yend-1; i++){
-		for(j = Xstart; j <= Xend-1; j++){
-			LCD_2IN4_WriteData_Word(color);
-		}
-	}
+	LCD_2IN4_SetWindow(Xstart, Ystart, Xend, Yend);
+	DEV_Digital_Write(LCD_DC, 1);
+	DEV_SPI_Write_Fill(color, (UDOUBLE)(Xend-Xstart) * (Yend-Ystart));
 }
 
 /******************************************************************************
@@ -265,12 +253,26 @@ parameter	:
 ******************************************************************************/
 void LCD_2IN4_Display(UBYTE *image)
 {
-	UWORD i;
 	LCD_2IN4_SetWindow(0, 0, LCD_2IN4_WIDTH, LCD_2IN4_HEIGHT);
 	DEV_Digital_Write(LCD_DC, 1);
-	for(i = 0; i < LCD_2IN4_HEIGHT; i++){
-		DEV_SPI_Write_nByte((UBYTE *)image+LCD_2IN4_WIDTH*2*i,LCD_2IN4_WIDTH*2);
-	}
+	DEV_SPI_Write_nByte(image, (UDOUBLE)LCD_2IN4_WIDTH * LCD_2IN4_HEIGHT * 2);
+}
+
+/******************************************************************************
+function: Show a window of a picture
+parameter	:
+	  Xstart: Start UWORD x coordinate
+	  Ystart:	Start UWORD y coordinate
+	  Xend  :	End UWORD coordinates, exclusive
+	  Yend  :	End UWORD coordinates, exclusive
+		image: Picture buffer of the whole screen
+******************************************************************************/
+void LCD_2IN4_DisplayWindows(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD *Image)
+{
+	UDOUBLE Addr = Xstart + (UDOUBLE)Ystart * LCD_2IN4_WIDTH;
+	LCD_2IN4_SetWindow(Xstart, Ystart, Xend, Yend);
+	DEV_Digital_Write(LCD_DC, 1);
+	DEV_SPI_Write_Rows((UBYTE *)&Image[Addr], (Xend-Xstart)*2, LCD_2IN4_WIDTH*2, Yend-Ystart);
 }
 
 /******************************************************************************
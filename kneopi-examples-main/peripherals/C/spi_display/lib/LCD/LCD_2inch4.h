@@ -51,6 +51,7 @@
 void LCD_2IN4_Init(void); 
 void LCD_2IN4_Clear(UWORD Color);
 void LCD_2IN4_Display(UBYTE *image);
+void LCD_2IN4_DisplayWindows(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD *Image);
 void LCD_2IN4_DrawPaint(UWORD x, UWORD y, UWORD Color);
 void  Handler_2IN4_LCD(int signo);
 